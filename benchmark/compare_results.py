@@ -0,0 +1,55 @@
+"""Compare two benchmark result files written by benchmark.py or finmath_bench.
+
+Usage: python compare_results.py BASELINE.json CANDIDATE.json [--threshold 0.05]
+
+Prints the change in mean time for every test present in both files and exits
+with status 1 when any test got slower by more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_tests(path):
+    with open(path) as file:
+        results = json.load(file)
+    tests = {}
+    for group, entries in results.items():
+        if group == "environment_info" or not isinstance(entries, dict):
+            continue
+        for name, test in entries.items():
+            if isinstance(test, dict) and test.get("mean") is not None:
+                tests[(group, name)] = test
+    return tests
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown reported as a regression (default 0.05)")
+    args = parser.parse_args()
+
+    baseline = load_tests(args.baseline)
+    candidate = load_tests(args.candidate)
+    regressions = 0
+    for key in sorted(baseline.keys() & candidate.keys()):
+        before = baseline[key]["mean"]
+        after = candidate[key]["mean"]
+        change = after / before - 1.0 if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{key[0]:<20} {key[1]:<70} {before:12.4e} {after:12.4e} {change:+8.1%}{flag}")
+
+    for key in sorted(baseline.keys() - candidate.keys()):
+        print(f"{key[0]:<20} {key[1]:<70} missing from {args.candidate}")
+    print(f"{regressions} regression(s) above {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,159 @@
+// Benchmarks for finmath/InterestAndAnnuities. Names are GROUP/function, followed by the
+// arguments; the group becomes the top-level key in the results JSON.
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "bench_data.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/InterestAndAnnuities/cash_flows.h"
+
+namespace {
+
+// Monthly payment grid of a 30 year book
+constexpr size_t kPaymentTimes = 360;
+
+// Level-payment loans of random size and rate: -principal at t = 0, then kPaymentTimes - 1
+// monthly installments
+std::vector<double> loan_schedules(size_t n) {
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> principal(1e4, 1e6);
+    std::uniform_real_distribution<double> rate(0.01, 0.12);
+    std::vector<double> flows(n * kPaymentTimes);
+    for (size_t s = 0; s < n; ++s) {
+        double amount = principal(rng);
+        double payment = annuity_payment(amount, rate(rng) / 12.0, static_cast<int>(kPaymentTimes - 1));
+        flows[s * kPaymentTimes] = -amount;
+        for (size_t k = 1; k < kPaymentTimes; ++k) {
+            flows[s * kPaymentTimes + k] = payment;
+        }
+    }
+    return flows;
+}
+
+// (kPaymentTimes x n) discount factors of n parallel-shifted scenario curves
+std::vector<double> scenario_factors(size_t n) {
+    std::vector<double> grid(kPaymentTimes);
+    for (size_t k = 0; k < kPaymentTimes; ++k) {
+        grid[k] = static_cast<double>(k) / 12.0;
+    }
+    std::vector<DiscountCurve> curves;
+    for (size_t j = 0; j < n; ++j) {
+        double shift = 0.0002 * (static_cast<double>(j % 200) - 100.0);
+        curves.push_back(DiscountCurve::from_zero_rates({0.25, 1.0, 2.0, 5.0, 10.0, 30.0},
+                                                        {0.040 + shift, 0.038 + shift, 0.036 + shift,
+                                                         0.037 + shift, 0.039 + shift, 0.041 + shift}));
+    }
+    std::vector<double> factors(kPaymentTimes * n);
+    discount_factor_matrix(curves.data(), n, grid.data(), kPaymentTimes, factors.data());
+    return factors;
+}
+
+// Scenario discounting
+
+// simd = 0 runs the scalar loops, 1 the widest panel kernel the CPU supports
+void BM_present_value_matrix(benchmark::State& state) {
+    const size_t schedules = static_cast<size_t>(state.range(0));
+    const size_t scenarios = static_cast<size_t>(state.range(1));
+    std::vector<double> flows = loan_schedules(schedules);
+    std::vector<double> factors = scenario_factors(scenarios);
+    std::vector<double> out(schedules * scenarios);
+    const SimdLevel detected = active_simd_level();
+    set_simd_level(state.range(2) == 0 ? SimdLevel::SCALAR : detected);
+    for (auto _ : state) {
+        present_value_matrix(flows.data(), schedules, kPaymentTimes, factors.data(), scenarios, out.data());
+        benchmark::ClobberMemory();
+    }
+    set_simd_level(detected);
+    // Items are multiply-adds: one per schedule, scenario and payment time
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1) * kPaymentTimes);
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_present_value_matrix)
+    ->Name("CASH_FLOWS/present_value_matrix")
+    ->ArgsProduct({{1000, 10000}, {100, 1000}, {0, 1}})
+    ->ArgNames({"num_schedules", "num_scenarios", "simd"})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_parallel_present_value_matrix(benchmark::State& state) {
+    const size_t schedules = static_cast<size_t>(state.range(0));
+    const size_t scenarios = static_cast<size_t>(state.range(1));
+    std::vector<double> flows = loan_schedules(schedules);
+    std::vector<double> factors = scenario_factors(scenarios);
+    std::vector<double> out(schedules * scenarios);
+    for (auto _ : state) {
+        parallel_present_value_matrix(flows.data(), schedules, kPaymentTimes, factors.data(), scenarios,
+                                      out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1) * kPaymentTimes);
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_parallel_present_value_matrix)
+    ->Name("CASH_FLOWS/parallel_present_value_matrix")
+    ->ArgsProduct({{10000, 100000}, {1000}})
+    ->ArgNames({"num_schedules", "num_scenarios"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_discount_batch(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    DiscountCurve curve = DiscountCurve::from_zero_rates({0.25, 1.0, 2.0, 5.0, 10.0, 30.0},
+                                                         {0.040, 0.038, 0.036, 0.037, 0.039, 0.041});
+    std::vector<double> times(n);
+    for (size_t i = 0; i < n; ++i) {
+        times[i] = 30.0 * static_cast<double>(i) / static_cast<double>(n);
+    }
+    std::vector<double> out(n);
+    for (auto _ : state) {
+        curve.discount_batch(times.data(), out.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_discount_batch)
+    ->Name("CASH_FLOWS/DiscountCurve::discount_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, 1000000)})
+    ->ArgName("num_elem");
+
+// IRR: one scalar solve per schedule against the batched solver
+
+void BM_internal_rate_of_return(benchmark::State& state) {
+    const size_t schedules = static_cast<size_t>(state.range(0));
+    std::vector<double> flows = loan_schedules(schedules);
+    for (auto _ : state) {
+        for (size_t s = 0; s < schedules; ++s) {
+            benchmark::DoNotOptimize(internal_rate_of_return(flows.data() + s * kPaymentTimes, kPaymentTimes));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_internal_rate_of_return)
+    ->Name("CASH_FLOWS/internal_rate_of_return")
+    ->ArgsProduct({decade_sizes(kMinSize, 100000)})
+    ->ArgName("num_schedules");
+
+void BM_internal_rate_of_return_batch(benchmark::State& state) {
+    const size_t schedules = static_cast<size_t>(state.range(0));
+    std::vector<double> flows = loan_schedules(schedules);
+    std::vector<double> out(schedules);
+    const SimdLevel detected = active_simd_level();
+    set_simd_level(state.range(1) == 0 ? SimdLevel::SCALAR : detected);
+    for (auto _ : state) {
+        internal_rate_of_return_batch(flows.data(), schedules, kPaymentTimes, out.data());
+        benchmark::ClobberMemory();
+    }
+    set_simd_level(detected);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_internal_rate_of_return_batch)
+    ->Name("CASH_FLOWS/internal_rate_of_return_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, 100000), {0, 1}})
+    ->ArgNames({"num_schedules", "simd"});
+
+} // namespace
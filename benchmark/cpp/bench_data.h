@@ -0,0 +1,97 @@
+#ifndef BENCH_DATA_H
+#define BENCH_DATA_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "finmath/OptionPricing/black_scholes.h"
+
+// Inputs shared by the benchmarks. Seeds are fixed so every run times the same data.
+
+// Input sizes: 1e3 to 1e8 prices for the time series kernels (800 MB per array at the top).
+// The structure-of-arrays pricers read six arrays and write one, so they stop at 1e7.
+constexpr int64_t kMinSize = 1000;
+constexpr int64_t kMaxSeriesSize = 100000000;
+constexpr int64_t kMaxBatchSize = 10000000;
+// Inputs per iteration for functions that take one value at a time
+constexpr int64_t kScalarBatch = 1024;
+
+// Window sizes for the rolling indicators
+const std::vector<int64_t> kWindowSizes = {10, 200};
+
+inline std::vector<int64_t> decade_sizes(int64_t lo, int64_t hi) {
+    std::vector<int64_t> sizes;
+    for (int64_t n = lo; n <= hi; n *= 10) {
+        sizes.push_back(n);
+    }
+    return sizes;
+}
+
+// Geometric random walk from 100 with 1% daily moves. The longest series is built once
+// and shorter ones are its prefixes, so large sizes are not regenerated per benchmark.
+inline const std::vector<double>& random_walk_prices() {
+    static const std::vector<double> prices = [] {
+        std::vector<double> walk(kMaxSeriesSize);
+        std::mt19937_64 rng(1);
+        std::normal_distribution<double> step(0.0, 0.01);
+        double price = 100.0;
+        for (double& p : walk) {
+            price *= std::exp(step(rng));
+            p = price;
+        }
+        return walk;
+    }();
+    return prices;
+}
+
+// The same walk rounded to float, for the single-precision kernels (built on first use)
+inline const std::vector<float>& random_walk_prices_float() {
+    static const std::vector<float> prices(random_walk_prices().begin(), random_walk_prices().end());
+    return prices;
+}
+
+// Random option contracts around a spot of 100 in structure-of-arrays form, with their
+// Black-Scholes prices as quotes for the implied volatility benchmarks
+struct OptionBatch {
+    std::vector<OptionType> types;
+    std::vector<double> strikes;
+    std::vector<double> prices;
+    std::vector<double> times;
+    std::vector<double> rates;
+    std::vector<double> volatilities;
+    std::vector<double> quotes;
+    size_t size() const { return types.size(); }
+};
+
+inline OptionBatch random_options(size_t n) {
+    OptionBatch batch;
+    std::mt19937_64 rng(2);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    batch.types.resize(n);
+    batch.strikes.resize(n);
+    batch.prices.assign(n, 100.0);
+    batch.times.resize(n);
+    batch.rates.assign(n, 0.04);
+    batch.volatilities.resize(n);
+    batch.quotes.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        batch.types[i] = uniform(rng) < 0.5 ? OptionType::CALL : OptionType::PUT;
+        batch.strikes[i] = 60.0 + 80.0 * uniform(rng);
+        batch.times[i] = 7.0 / 365.0 + 2.0 * uniform(rng);
+        batch.volatilities[i] = 0.1 + 0.6 * uniform(rng);
+    }
+    black_scholes_batch(batch.types.data(), batch.strikes.data(), batch.prices.data(), batch.times.data(),
+                        batch.rates.data(), batch.volatilities.data(), batch.quotes.data(), n);
+    return batch;
+}
+
+// Bytes per contract read and written by the structure-of-arrays pricers
+constexpr int64_t kContractBytes = sizeof(OptionType) + 6 * sizeof(double);
+constexpr int64_t kContractBytesFloat = sizeof(OptionType) + 6 * sizeof(float);
+
+#endif // BENCH_DATA_H
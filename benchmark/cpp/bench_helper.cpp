@@ -0,0 +1,210 @@
+// Benchmarks for finmath/Helper and finmath/InterestAndAnnuities
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bench_data.h"
+#include "finmath/Helper/brownian_bridge.h"
+#include "finmath/Helper/helper.h"
+#include "finmath/Helper/normal_distribution.h"
+#include "finmath/Helper/philox.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/Helper/sobol.h"
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/InterestAndAnnuities/compound_interest.h"
+#include "finmath/InterestAndAnnuities/simple_interest.h"
+
+namespace {
+
+// kScalarBatch evenly spaced values in [lo, hi)
+std::vector<double> scalar_inputs(double lo, double hi) {
+    std::vector<double> values(kScalarBatch);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = lo + (hi - lo) * static_cast<double>(i) / static_cast<double>(values.size());
+    }
+    return values;
+}
+
+template <typename Function>
+void run_scalar(benchmark::State& state, const std::vector<double>& inputs, Function function) {
+    for (auto _ : state) {
+        for (double x : inputs) {
+            benchmark::DoNotOptimize(function(x));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(inputs.size()));
+    state.SetLabel("double");
+}
+
+// Normal distribution: accuracy is 0 for EXACT, 1 for HIGH and 2 for FAST
+
+void BM_normal_cdf(benchmark::State& state) {
+    const NormalAccuracy accuracy = static_cast<NormalAccuracy>(state.range(1));
+    run_scalar(state, scalar_inputs(-8.0, 8.0), [accuracy](double x) { return normal_cdf(x, accuracy); });
+}
+BENCHMARK(BM_normal_cdf)
+    ->Name("HELPER/normal_cdf")
+    ->ArgsProduct({{kScalarBatch}, {0, 1, 2}})
+    ->ArgNames({"num_elem", "accuracy"});
+
+void BM_normal_pdf(benchmark::State& state) {
+    const NormalAccuracy accuracy = static_cast<NormalAccuracy>(state.range(1));
+    run_scalar(state, scalar_inputs(-8.0, 8.0), [accuracy](double x) { return normal_pdf(x, accuracy); });
+}
+BENCHMARK(BM_normal_pdf)
+    ->Name("HELPER/normal_pdf")
+    ->ArgsProduct({{kScalarBatch}, {0, 1, 2}})
+    ->ArgNames({"num_elem", "accuracy"});
+
+// simd = 0 runs the scalar loop, 1 the widest kernel the CPU supports (EXACT is always scalar)
+template <typename Function>
+void run_normal_batch(benchmark::State& state, Function function) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const NormalAccuracy accuracy = static_cast<NormalAccuracy>(state.range(1));
+    std::vector<double> x(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = -8.0 + 16.0 * static_cast<double>(i) / static_cast<double>(n);
+    }
+    const SimdLevel detected = active_simd_level();
+    set_simd_level(state.range(2) == 0 ? SimdLevel::SCALAR : detected);
+    for (auto _ : state) {
+        function(x.data(), out.data(), n, accuracy);
+        benchmark::ClobberMemory();
+    }
+    set_simd_level(detected);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel("double*");
+}
+
+void BM_normal_cdf_batch(benchmark::State& state) {
+    run_normal_batch(state, normal_cdf_batch);
+}
+BENCHMARK(BM_normal_cdf_batch)
+    ->Name("HELPER/normal_cdf_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, 1000000), {0, 1, 2}, {0, 1}})
+    ->ArgNames({"num_elem", "accuracy", "simd"});
+
+void BM_normal_pdf_batch(benchmark::State& state) {
+    run_normal_batch(state, normal_pdf_batch);
+}
+BENCHMARK(BM_normal_pdf_batch)
+    ->Name("HELPER/normal_pdf_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, 1000000), {0, 1, 2}, {0, 1}})
+    ->ArgNames({"num_elem", "accuracy", "simd"});
+
+void BM_inverse_normal_cdf(benchmark::State& state) {
+    run_scalar(state, scalar_inputs(1e-6, 1.0), inverse_normal_cdf);
+}
+BENCHMARK(BM_inverse_normal_cdf)->Name("HELPER/inverse_normal_cdf")->Arg(kScalarBatch)->ArgName("num_elem");
+
+// Random numbers
+
+void BM_philox4x32(benchmark::State& state) {
+    const PhiloxKey key = philox_key(42);
+    const uint32_t n = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < n; ++i) {
+            benchmark::DoNotOptimize(philox4x32(PhiloxCounter{{i, 0, 0, 0}}, key));
+        }
+    }
+    // Four 32-bit outputs per call
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 16);
+    state.SetLabel("uint32");
+}
+BENCHMARK(BM_philox4x32)->Name("HELPER/philox4x32")->Arg(kScalarBatch)->ArgName("num_elem");
+
+void BM_sobol_next(benchmark::State& state) {
+    const size_t dimensions = static_cast<size_t>(state.range(1));
+    const uint64_t n = static_cast<uint64_t>(state.range(0));
+    SobolSequence sobol(dimensions, 42);
+    std::vector<uint32_t> x(dimensions);
+    for (auto _ : state) {
+        sobol.point(0, x.data());
+        for (uint64_t i = 0; i + 1 < n; ++i) {
+            sobol.next(i, x.data());
+        }
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    state.SetLabel("uint32");
+}
+BENCHMARK(BM_sobol_next)
+    ->Name("HELPER/SobolSequence::next")
+    ->ArgsProduct({{kScalarBatch}, {12, 252}})
+    ->ArgNames({"num_elem", "dimensions"});
+
+void BM_sobol_point(benchmark::State& state) {
+    const size_t dimensions = static_cast<size_t>(state.range(1));
+    SobolSequence sobol(dimensions, 42);
+    std::vector<uint32_t> x(dimensions);
+    for (auto _ : state) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            sobol.point(static_cast<uint64_t>(i) * 7919, x.data());
+            benchmark::DoNotOptimize(x.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    state.SetLabel("uint32");
+}
+BENCHMARK(BM_sobol_point)
+    ->Name("HELPER/SobolSequence::point")
+    ->ArgsProduct({{kScalarBatch}, {12, 252}})
+    ->ArgNames({"num_elem", "dimensions"});
+
+void BM_brownian_bridge(benchmark::State& state) {
+    const size_t steps = static_cast<size_t>(state.range(1));
+    const size_t lanes = static_cast<size_t>(state.range(0));
+    BrownianBridge bridge(steps);
+    std::vector<double> z(steps * lanes, 0.5);
+    std::vector<double> w(steps * lanes);
+    for (auto _ : state) {
+        bridge.build(z.data(), w.data(), lanes);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(1) * 2 *
+                            static_cast<int64_t>(sizeof(double)));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_brownian_bridge)
+    ->Name("HELPER/BrownianBridge::build")
+    ->ArgsProduct({{1, 8, 64}, {12, 252}})
+    ->ArgNames({"num_elem", "steps"});
+
+// Thread pool overhead: parallel_for over num_elem indices with an empty body
+
+void BM_parallel_for(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(1)));
+    const size_t n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        pool.parallel_for(n, 1024, [](size_t begin, size_t end) { benchmark::DoNotOptimize(begin + end); });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel("size_t");
+}
+BENCHMARK(BM_parallel_for)
+    ->Name("HELPER/ThreadPool::parallel_for")
+    ->ArgsProduct({decade_sizes(kMinSize, 1000000), {1, 0}})
+    ->ArgNames({"num_elem", "threads"})
+    ->UseRealTime();
+
+// Interest
+
+void BM_compound_interest(benchmark::State& state) {
+    const int frequency = static_cast<int>(state.range(1));
+    run_scalar(state, scalar_inputs(0.0, 0.2),
+               [frequency](double rate) { return compound_interest(1000.0, rate, 10, frequency); });
+}
+BENCHMARK(BM_compound_interest)
+    ->Name("INTEREST/compound_interest")
+    ->ArgsProduct({{kScalarBatch}, {1, 12, 365}})
+    ->ArgNames({"num_elem", "frequency"});
+
+void BM_simple_interest(benchmark::State& state) {
+    run_scalar(state, scalar_inputs(0.0, 0.2), [](double rate) { return simple_interest(1000.0, rate, 10.0); });
+}
+BENCHMARK(BM_simple_interest)->Name("INTEREST/simple_interest")->Arg(kScalarBatch)->ArgName("num_elem");
+
+} // namespace
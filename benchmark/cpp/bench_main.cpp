@@ -0,0 +1,312 @@
+// Entry point of finmath_bench. Runs the Google Benchmark suite with the usual console
+// output and also writes the results as JSON in the layout of benchmark/results (the
+// same as benchmark.py), so C++ runs can be diffed against each other and against the
+// Python ones.
+//
+// Benchmark names are GROUP/function/arg:value/...; GROUP becomes the top-level key and
+// each run an entry under it. Extra flag: --finmath_out=PATH (default
+// results/<timestamp>_cpp.json when ./results exists, otherwise <timestamp>_cpp.json).
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <sys/stat.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+#include "finmath/Helper/simd.h"
+
+namespace {
+
+std::string json_string(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string json_number(double x) {
+    if (!std::isfinite(x)) {
+        return "null";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", x);
+    return buffer;
+}
+
+// Timings of one benchmark (one name and label) across its repetitions
+struct TestResult {
+    std::string group;
+    std::string function;
+    std::vector<std::pair<std::string, std::string>> arguments;
+    std::string input_type;
+    std::string error;
+    std::vector<double> seconds;  // per iteration, one entry per repetition
+    int64_t iterations = 0;
+    std::map<std::string, std::vector<double>> counters;
+};
+
+// Console output as usual, plus collection of every repetition for the JSON file
+class ResultsReporter : public benchmark::ConsoleReporter {
+public:
+    explicit ResultsReporter(std::string path) : path_(std::move(path)) {}
+
+    bool ReportContext(const Context& context) override {
+        cpu_mhz_ = context.cpu_info.cycles_per_second / 1e6;
+        cpu_count_ = context.cpu_info.num_cpus;
+        return ConsoleReporter::ReportContext(context);
+    }
+
+    void ReportRuns(const std::vector<Run>& runs) override {
+        ConsoleReporter::ReportRuns(runs);
+        for (const Run& run : runs) {
+            // Mean, median and stddev rows are recomputed from the repetitions
+            if (run.run_type != Run::RT_Iteration) {
+                continue;
+            }
+            std::string key = run.benchmark_name();
+            if (!run.report_label.empty()) {
+                key += "/" + run.report_label;
+            }
+            auto inserted = index_.emplace(key, tests_.size());
+            if (inserted.second) {
+                tests_.push_back(parse(run.benchmark_name()));
+                tests_.back().input_type = run.report_label;
+            }
+            TestResult& test = tests_[inserted.first->second];
+            if (run.error_occurred) {
+                test.error = run.error_message;
+                continue;
+            }
+            test.seconds.push_back(run.real_accumulated_time / static_cast<double>(run.iterations));
+            test.iterations += run.iterations;
+            for (const auto& counter : run.counters) {
+                test.counters[counter.first].push_back(counter.second.value);
+            }
+        }
+    }
+
+    void Finalize() override {
+        ConsoleReporter::Finalize();
+        std::ofstream file(path_);
+        if (!file) {
+            std::cerr << "finmath_bench: cannot write " << path_ << std::endl;
+            return;
+        }
+        write(file);
+        std::cerr << "finmath_bench: results written to " << path_ << std::endl;
+    }
+
+private:
+    static TestResult parse(const std::string& name) {
+        TestResult test;
+        std::vector<std::string> parts;
+        std::stringstream stream(name);
+        std::string part;
+        while (std::getline(stream, part, '/')) {
+            parts.push_back(part);
+        }
+        test.group = parts.size() > 1 ? parts[0] : "MISC";
+        test.function = parts.size() > 1 ? parts[1] : name;
+        for (size_t i = 2; i < parts.size(); ++i) {
+            size_t colon = parts[i].find(':');
+            if (colon != std::string::npos) {
+                test.arguments.emplace_back(parts[i].substr(0, colon), parts[i].substr(colon + 1));
+            }
+        }
+        return test;
+    }
+
+    static void mean_stdev(const std::vector<double>& values, double& mean, double& stdev) {
+        mean = 0.0;
+        for (double v : values) {
+            mean += v;
+        }
+        mean /= static_cast<double>(values.size());
+        // Sample standard deviation, as statistics.stdev in benchmark.py
+        double sum = 0.0;
+        for (double v : values) {
+            sum += (v - mean) * (v - mean);
+        }
+        stdev = values.size() > 1 ? std::sqrt(sum / static_cast<double>(values.size() - 1)) : 0.0;
+    }
+
+    void write_environment(std::ostream& out) const {
+        std::string os = "unknown";
+        std::string os_version = "unknown";
+        std::string machine = "unknown";
+        double ram_gb = 0.0;
+#if defined(__unix__) || defined(__APPLE__)
+        struct utsname names;
+        if (uname(&names) == 0) {
+            os = names.sysname;
+            os_version = names.version;
+            machine = names.machine;
+        }
+        long pages = sysconf(_SC_PHYS_PAGES);
+        long page_size = sysconf(_SC_PAGESIZE);
+        if (pages > 0 && page_size > 0) {
+            ram_gb = static_cast<double>(pages) * static_cast<double>(page_size) / (1024.0 * 1024.0 * 1024.0);
+        }
+#endif
+        std::string cpu_brand = "unknown";
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line)) {
+            if (line.compare(0, 10, "model name") == 0) {
+                size_t colon = line.find(':');
+                cpu_brand = colon == std::string::npos ? line : line.substr(line.find_first_not_of(' ', colon + 1));
+                break;
+            }
+        }
+#if defined(__clang__)
+        std::string compiler = std::string("Clang ") + __clang_version__;
+#elif defined(__GNUC__)
+        std::string compiler = std::string("GCC ") + __VERSION__;
+#elif defined(_MSC_VER)
+        std::string compiler = "MSVC " + std::to_string(_MSC_VER);
+#else
+        std::string compiler = "unknown";
+#endif
+
+        out << "    \"environment_info\": {\n";
+        out << "        \"OS\": " << json_string(os) << ",\n";
+        out << "        \"OS Version\": " << json_string(os_version) << ",\n";
+        out << "        \"Machine\": " << json_string(machine) << ",\n";
+        out << "        \"Compiler\": " << json_string(compiler) << ",\n";
+        out << "        \"SIMD Level\": " << json_string(simd_level_name(active_simd_level())) << ",\n";
+        out << "        \"CPU Brand\": " << json_string(cpu_brand) << ",\n";
+        out << "        \"CPU Cores (Logical)\": " << cpu_count_ << ",\n";
+        out << "        \"CPU Frequency (MHz)\": " << json_number(cpu_mhz_) << ",\n";
+        out << "        \"Total RAM (GB)\": " << json_number(std::round(ram_gb * 100.0) / 100.0) << "\n";
+        out << "    }";
+    }
+
+    void write(std::ostream& out) const {
+        // Groups in the order their first benchmark ran
+        std::vector<std::string> groups;
+        for (const TestResult& test : tests_) {
+            if (std::find(groups.begin(), groups.end(), test.group) == groups.end()) {
+                groups.push_back(test.group);
+            }
+        }
+
+        out << "{\n";
+        write_environment(out);
+        for (const std::string& group : groups) {
+            out << ",\n    " << json_string(group) << ": {";
+            bool first = true;
+            for (const TestResult& test : tests_) {
+                if (test.group != group) {
+                    continue;
+                }
+                std::string name = test.function;
+                for (const auto& argument : test.arguments) {
+                    name += "/" + argument.first + ":" + argument.second;
+                }
+                if (!test.input_type.empty()) {
+                    name += "/" + test.input_type;
+                }
+
+                out << (first ? "\n" : ",\n");
+                first = false;
+                out << "        " << json_string(name) << ": {\n";
+                out << "            \"test_name\": " << json_string(name) << ",\n";
+                out << "            \"test_func\": " << json_string("finmath::" + test.function) << ",\n";
+                out << "            \"num_iter\": " << test.seconds.size() << ",\n";
+                out << "            \"iterations\": " << test.iterations << ",\n";
+                for (const auto& argument : test.arguments) {
+                    out << "            " << json_string(argument.first) << ": " << argument.second << ",\n";
+                }
+                out << "            \"input_type\": " << json_string(test.input_type) << ",\n";
+                if (!test.error.empty()) {
+                    out << "            \"error\": " << json_string(test.error) << ",\n";
+                }
+                // Counters (items_per_second, bytes_per_second, hardware events) averaged over repetitions
+                for (const auto& counter : test.counters) {
+                    double mean;
+                    double stdev;
+                    mean_stdev(counter.second, mean, stdev);
+                    out << "            " << json_string(counter.first) << ": " << json_number(mean) << ",\n";
+                }
+                double mean = NAN;
+                double stdev = NAN;
+                if (!test.seconds.empty()) {
+                    mean_stdev(test.seconds, mean, stdev);
+                }
+                out << "            \"mean\": " << json_number(mean) << ",\n";
+                out << "            \"stdev\": " << json_number(stdev) << "\n";
+                out << "        }";
+            }
+            out << "\n    }";
+        }
+        out << "\n}\n";
+    }
+
+    std::string path_;
+    double cpu_mhz_ = 0.0;
+    int cpu_count_ = 0;
+    std::vector<TestResult> tests_;
+    std::map<std::string, size_t> index_;
+};
+
+std::string default_output_path() {
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    struct stat info;
+    bool has_results = stat("results", &info) == 0 && (info.st_mode & S_IFDIR);
+    return (has_results ? std::string("results/") : std::string()) + timestamp + "_cpp.json";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // Take out --finmath_out before Google Benchmark sees the arguments
+    std::string path = default_output_path();
+    const char* flag = "--finmath_out=";
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i) {
+        if (std::strncmp(argv[i], flag, std::strlen(flag)) == 0) {
+            path = argv[i] + std::strlen(flag);
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    int count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    ResultsReporter reporter(path);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    return 0;
+}
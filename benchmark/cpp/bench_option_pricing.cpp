@@ -0,0 +1,663 @@
+// Benchmarks for finmath/OptionPricing. Names are GROUP/function, followed by the
+// arguments; the group becomes the top-level key in the results JSON.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bench_data.h"
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/OptionPricing/binomial_tree.h"
+#include "finmath/OptionPricing/black_scholes.h"
+#include "finmath/OptionPricing/finite_difference.h"
+#include "finmath/OptionPricing/greeks.h"
+#include "finmath/OptionPricing/implied_volatility.h"
+#include "finmath/OptionPricing/monte_carlo.h"
+#include "finmath/OptionPricing/parallel_pricing.h"
+#include "finmath/OptionPricing/pricing_cache.h"
+#include "finmath/OptionPricing/pricing_service.h"
+#include "finmath/OptionPricing/scenario_engine.h"
+#include "finmath/OptionPricing/trinomial_tree.h"
+#include "finmath/OptionPricing/vol_surface.h"
+
+namespace {
+
+// Black-Scholes
+
+void BM_black_scholes(benchmark::State& state) {
+    OptionBatch batch = random_options(kScalarBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            benchmark::DoNotOptimize(black_scholes(batch.types[i], batch.strikes[i], batch.prices[i], batch.times[i],
+                                                   batch.rates[i], batch.volatilities[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kScalarBatch);
+    state.SetLabel("double");
+}
+BENCHMARK(BM_black_scholes)->Name("BLACK_SCHOLES/black_scholes")->Arg(kScalarBatch)->ArgName("num_elem");
+
+void BM_black_scholes_batch(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    std::vector<double> out(n);
+    for (auto _ : state) {
+        black_scholes_batch(batch.types.data(), batch.strikes.data(), batch.prices.data(), batch.times.data(),
+                            batch.rates.data(), batch.volatilities.data(), out.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * kContractBytes);
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_black_scholes_batch)
+    ->Name("BLACK_SCHOLES/black_scholes_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxBatchSize)})
+    ->ArgName("num_elem");
+
+void BM_black_scholes_batch_float(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    std::vector<float> strikes(batch.strikes.begin(), batch.strikes.end());
+    std::vector<float> prices(batch.prices.begin(), batch.prices.end());
+    std::vector<float> times(batch.times.begin(), batch.times.end());
+    std::vector<float> rates(batch.rates.begin(), batch.rates.end());
+    std::vector<float> volatilities(batch.volatilities.begin(), batch.volatilities.end());
+    std::vector<float> out(n);
+    for (auto _ : state) {
+        black_scholes_batch(batch.types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                            volatilities.data(), out.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * kContractBytesFloat);
+    state.SetLabel("float*");
+}
+BENCHMARK(BM_black_scholes_batch_float)
+    ->Name("BLACK_SCHOLES/black_scholes_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxBatchSize)})
+    ->ArgName("num_elem");
+
+// Greeks
+
+void BM_black_scholes_greeks(benchmark::State& state) {
+    OptionBatch batch = random_options(kScalarBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            benchmark::DoNotOptimize(black_scholes_greeks(batch.types[i], batch.strikes[i], batch.prices[i],
+                                                          batch.times[i], batch.rates[i], batch.volatilities[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kScalarBatch);
+    state.SetLabel("double");
+}
+BENCHMARK(BM_black_scholes_greeks)->Name("GREEKS/black_scholes_greeks")->Arg(kScalarBatch)->ArgName("num_elem");
+
+void BM_black_scholes_greeks_batch(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    std::vector<Greeks> out(n);
+    for (auto _ : state) {
+        black_scholes_greeks_batch(batch.types.data(), batch.strikes.data(), batch.prices.data(), batch.times.data(),
+                                   batch.rates.data(), batch.volatilities.data(), out.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(kContractBytes - sizeof(double) + sizeof(Greeks)));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_black_scholes_greeks_batch)
+    ->Name("GREEKS/black_scholes_greeks_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxBatchSize)})
+    ->ArgName("num_elem");
+
+// Implied volatility
+
+void BM_implied_volatility(benchmark::State& state) {
+    OptionBatch batch = random_options(kScalarBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            benchmark::DoNotOptimize(implied_volatility(batch.types[i], batch.quotes[i], batch.strikes[i],
+                                                        batch.prices[i], batch.times[i], batch.rates[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kScalarBatch);
+    state.SetLabel("double");
+}
+BENCHMARK(BM_implied_volatility)
+    ->Name("IMPLIED_VOLATILITY/implied_volatility")
+    ->Arg(kScalarBatch)
+    ->ArgName("num_elem");
+
+void BM_implied_volatility_batch(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    std::vector<double> out(n);
+    std::vector<ImpliedVolStatus> status(n);
+    for (auto _ : state) {
+        implied_volatility_batch(batch.types.data(), batch.quotes.data(), batch.strikes.data(), batch.prices.data(),
+                                 batch.times.data(), batch.rates.data(), out.data(), status.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<int64_t>(kContractBytes + sizeof(ImpliedVolStatus)));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_implied_volatility_batch)
+    ->Name("IMPLIED_VOLATILITY/implied_volatility_batch")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxBatchSize)})
+    ->ArgName("num_elem")
+    ->Unit(benchmark::kMillisecond);
+
+// Volatility surface: a 40 strike x 16 expiry desk grid covering the random_options contracts.
+// Second argument: 0 = BICUBIC, 1 = SVI.
+
+VolSurface desk_surface(VolInterpolation method) {
+    std::vector<double> strikes;
+    for (int i = 0; i < 40; ++i) {
+        strikes.push_back(55.0 + 2.25 * i);
+    }
+    std::vector<double> expiries = {1.0 / 365.0, 7.0 / 365.0, 14.0 / 365.0, 1.0 / 12.0, 2.0 / 12.0, 0.25, 0.375,
+                                    0.5, 0.75, 1.0, 1.25, 1.5, 2.0, 2.5, 3.0, 5.0};
+    std::vector<double> vols;
+    for (double time : expiries) {
+        for (double strike : strikes) {
+            double x = std::log(strike / 100.0);
+            vols.push_back(0.2 + 0.15 * x * x / std::sqrt(time) - 0.1 * x + 0.02 * std::sqrt(time));
+        }
+    }
+    return VolSurface(strikes, expiries, vols, method);
+}
+
+const char* surface_label(int64_t method) {
+    return method == 0 ? "bicubic" : "svi";
+}
+
+void BM_vol_surface_lookup(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    VolSurface surface = desk_surface(static_cast<VolInterpolation>(state.range(1)));
+    std::vector<double> out(n);
+    for (auto _ : state) {
+        surface.volatility_batch(batch.strikes.data(), batch.times.data(), out.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(surface_label(state.range(1)));
+}
+BENCHMARK(BM_vol_surface_lookup)
+    ->Name("VOL_SURFACE/volatility_batch")
+    ->ArgsProduct({{kScalarBatch, 1000000}, {0, 1}})
+    ->ArgNames({"num_elem", "method"});
+
+void BM_black_scholes_batch_surface(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    VolSurface surface = desk_surface(static_cast<VolInterpolation>(state.range(1)));
+    std::vector<double> out(n);
+    for (auto _ : state) {
+        black_scholes_batch(batch.types.data(), batch.strikes.data(), batch.prices.data(), batch.times.data(),
+                            batch.rates.data(), surface, out.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(surface_label(state.range(1)));
+}
+BENCHMARK(BM_black_scholes_batch_surface)
+    ->Name("VOL_SURFACE/black_scholes_batch")
+    ->ArgsProduct({{kScalarBatch, 1000000}, {0, 1}})
+    ->ArgNames({"num_elem", "method"});
+
+// Intraday refresh: one quote changed in place against building the surface from scratch
+void BM_vol_surface_update(benchmark::State& state) {
+    VolSurface surface = desk_surface(static_cast<VolInterpolation>(state.range(0)));
+    double base = surface.quote(20, 8);
+    int64_t tick = 0;
+    for (auto _ : state) {
+        surface.update(20, 8, base + 1e-4 * static_cast<double>(++tick % 8));
+    }
+    state.SetLabel(surface_label(state.range(0)));
+}
+BENCHMARK(BM_vol_surface_update)
+    ->Name("VOL_SURFACE/update")
+    ->ArgsProduct({{0, 1}})
+    ->ArgName("method")
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_vol_surface_build(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(desk_surface(static_cast<VolInterpolation>(state.range(0))));
+    }
+    state.SetLabel(surface_label(state.range(0)));
+}
+BENCHMARK(BM_vol_surface_build)
+    ->Name("VOL_SURFACE/build")
+    ->ArgsProduct({{0, 1}})
+    ->ArgName("method")
+    ->Unit(benchmark::kMicrosecond);
+
+// Binomial lattice: items are tree nodes, N (N + 1) / 2 per price
+
+int64_t lattice_nodes(int64_t N) {
+    return N * (N + 1) / 2;
+}
+
+void BM_binomial_option_pricing(benchmark::State& state) {
+    const long N = static_cast<long>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(binomial_option_pricing(OptionType::PUT, 100.0, 100.0, 1.0, 0.05, 0.2, N));
+    }
+    state.SetItemsProcessed(state.iterations() * lattice_nodes(N));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_binomial_option_pricing)
+    ->Name("BINOMIAL/binomial_option_pricing")
+    ->ArgsProduct({{100, 1000, 10000}})
+    ->ArgName("N")
+    ->Unit(benchmark::kMicrosecond);
+
+template <typename Real>
+void BM_binomial_lattice_pricing(benchmark::State& state) {
+    const long N = static_cast<long>(state.range(0));
+    const ExerciseStyle style = static_cast<ExerciseStyle>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(binomial_lattice_pricing<Real>(OptionType::PUT, style, Real(100), Real(100), Real(1),
+                                                                Real(0.05), Real(0.2), N));
+    }
+    state.SetItemsProcessed(state.iterations() * lattice_nodes(N));
+    state.SetLabel(std::is_same<Real, float>::value ? "float" : "double");
+}
+BENCHMARK_TEMPLATE(BM_binomial_lattice_pricing, double)
+    ->Name("BINOMIAL/binomial_lattice_pricing")
+    ->ArgsProduct({{100, 1000, 10000},
+                   {static_cast<int64_t>(ExerciseStyle::EUROPEAN), static_cast<int64_t>(ExerciseStyle::AMERICAN)}})
+    ->ArgNames({"N", "style"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_binomial_lattice_pricing, float)
+    ->Name("BINOMIAL/binomial_lattice_pricing")
+    ->ArgsProduct({{100, 1000, 10000},
+                   {static_cast<int64_t>(ExerciseStyle::EUROPEAN), static_cast<int64_t>(ExerciseStyle::AMERICAN)}})
+    ->ArgNames({"N", "style"})
+    ->Unit(benchmark::kMicrosecond);
+
+// Trinomial lattice: items are coarse tree nodes, (N + 1)^2 per price. European prices report
+// abs_error against Black-Scholes, to compare accuracy per node with and without the adaptive
+// mesh (and with the binomial benchmarks above).
+
+void BM_trinomial_lattice_pricing(benchmark::State& state) {
+    const long N = static_cast<long>(state.range(0));
+    const ExerciseStyle style = static_cast<ExerciseStyle>(state.range(1));
+    TrinomialSettings settings;
+    settings.refinement_levels = static_cast<int>(state.range(2));
+    double price = 0.0;
+    for (auto _ : state) {
+        price = trinomial_lattice_pricing(OptionType::PUT, style, 100.0, 100.0, 1.0, 0.05, 0.2, N,
+                                          PathPayoff::EUROPEAN, 0.0, settings);
+        benchmark::DoNotOptimize(price);
+    }
+    if (style == ExerciseStyle::EUROPEAN) {
+        state.counters["abs_error"] = std::abs(price - black_scholes(OptionType::PUT, 100.0, 100.0, 1.0, 0.05, 0.2));
+    }
+    state.SetItemsProcessed(state.iterations() * (N + 1) * (N + 1));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_trinomial_lattice_pricing)
+    ->Name("TRINOMIAL/trinomial_lattice_pricing")
+    ->ArgsProduct({{100, 1000, 10000},
+                   {static_cast<int64_t>(ExerciseStyle::EUROPEAN), static_cast<int64_t>(ExerciseStyle::AMERICAN)},
+                   {0, 2}})
+    ->ArgNames({"N", "style", "levels"})
+    ->Unit(benchmark::kMicrosecond);
+
+// Crank-Nicolson PDE: items are grid nodes, (space_steps + 1) x time_steps per price. The
+// default settings (space_steps 200, extrapolated) price this put within about 1e-5, which
+// the binomial benchmarks above need N of several thousand for.
+
+void BM_finite_difference_pricing(benchmark::State& state) {
+    FiniteDifferenceSettings settings;
+    settings.space_steps = static_cast<size_t>(state.range(0));
+    settings.time_steps = settings.space_steps / 2;
+    settings.extrapolate = state.range(2) != 0;
+    const ExerciseStyle style = static_cast<ExerciseStyle>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            finite_difference_pricing(OptionType::PUT, style, 100.0, 100.0, 1.0, 0.05, 0.2, settings));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>((settings.space_steps + 1) * settings.time_steps));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_finite_difference_pricing)
+    ->Name("FINITE_DIFFERENCE/finite_difference_pricing")
+    ->ArgsProduct({{200, 800},
+                   {static_cast<int64_t>(ExerciseStyle::EUROPEAN), static_cast<int64_t>(ExerciseStyle::AMERICAN)},
+                   {0, 1}})
+    ->ArgNames({"space_steps", "style", "extrapolate"})
+    ->Unit(benchmark::kMicrosecond);
+
+// Monte Carlo: items are simulated path steps
+
+void BM_monte_carlo_price(benchmark::State& state) {
+    MonteCarloSettings settings;
+    settings.paths = static_cast<size_t>(state.range(0));
+    settings.steps = static_cast<size_t>(state.range(1));
+    ThreadPool pool(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(monte_carlo_price(OptionType::CALL, PathPayoff::ASIAN_ARITHMETIC, 100.0, 100.0,
+                                                   1.0, 0.05, 0.2, 0.0, settings, pool));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_monte_carlo_price)
+    ->Name("MONTE_CARLO/monte_carlo_price")
+    ->ArgsProduct({decade_sizes(kMinSize, 1000000), {12, 252}})
+    ->ArgNames({"num_elem", "steps"})
+    ->Unit(benchmark::kMillisecond);
+
+// Parallel pricing across a pool of `threads` threads
+
+void BM_parallel_price(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    std::vector<double> out(n);
+    ThreadPool pool(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        parallel_price(batch.types.data(), batch.strikes.data(), batch.prices.data(), batch.times.data(),
+                       batch.rates.data(), batch.volatilities.data(), out.data(), n, pool);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * kContractBytes);
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_parallel_price)
+    ->Name("PARALLEL/parallel_price")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxBatchSize), {1, 0}})
+    ->ArgNames({"num_elem", "threads"})
+    ->UseRealTime();
+
+void BM_parallel_binomial_price(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const long N = static_cast<long>(state.range(1));
+    OptionBatch batch = random_options(n);
+    std::vector<double> out(n);
+    ThreadPool pool(static_cast<size_t>(state.range(2)));
+    for (auto _ : state) {
+        parallel_binomial_price(batch.types.data(), batch.strikes.data(), batch.prices.data(), batch.times.data(),
+                                batch.rates.data(), batch.volatilities.data(), ExerciseStyle::AMERICAN, N,
+                                BinomialMethod::CRR, out.data(), n, pool);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * lattice_nodes(N));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_parallel_binomial_price)
+    ->Name("PARALLEL/parallel_binomial_price")
+    ->ArgsProduct({{64}, {100, 1000}, {1, 0}})
+    ->ArgNames({"num_elem", "N", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+void BM_parallel_implied_volatility(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    OptionBatch batch = random_options(n);
+    std::vector<double> out(n);
+    std::vector<ImpliedVolStatus> status(n);
+    ThreadPool pool(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        parallel_implied_volatility(batch.types.data(), batch.quotes.data(), batch.strikes.data(),
+                                    batch.prices.data(), batch.times.data(), batch.rates.data(), out.data(),
+                                    status.data(), n, pool);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_parallel_implied_volatility)
+    ->Name("PARALLEL/parallel_implied_volatility")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxBatchSize), {1, 0}})
+    ->ArgNames({"num_elem", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+
+// Pricing cache: a book of contracts quoted over and over, priced directly (cached = 0) or
+// through a PricingCache (cached = 1) that the first pass fills, so the cached rows time hits
+
+void BM_pricing_cache_black_scholes(benchmark::State& state) {
+    const bool cached = state.range(0) != 0;
+    OptionBatch batch = random_options(kScalarBatch);
+    PricingCache cache(2 * kScalarBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            double value = cached ? cache.black_scholes(batch.types[i], batch.strikes[i], batch.prices[i],
+                                                        batch.times[i], batch.rates[i], batch.volatilities[i])
+                                  : black_scholes(batch.types[i], batch.strikes[i], batch.prices[i], batch.times[i],
+                                                  batch.rates[i], batch.volatilities[i]);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kScalarBatch);
+    state.SetLabel("double");
+}
+BENCHMARK(BM_pricing_cache_black_scholes)
+    ->Name("PRICING_CACHE/black_scholes")
+    ->ArgsProduct({{0, 1}})
+    ->ArgName("cached");
+
+void BM_pricing_cache_binomial(benchmark::State& state) {
+    const long N = static_cast<long>(state.range(0));
+    const bool cached = state.range(1) != 0;
+    OptionBatch batch = random_options(64);
+    PricingCache cache(256);
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            double value = cached ? cache.binomial_lattice_pricing(batch.types[i], ExerciseStyle::AMERICAN,
+                                                                   batch.prices[i], batch.strikes[i], batch.times[i],
+                                                                   batch.rates[i], batch.volatilities[i], N)
+                                  : binomial_lattice_pricing(batch.types[i], ExerciseStyle::AMERICAN, batch.prices[i],
+                                                             batch.strikes[i], batch.times[i], batch.rates[i],
+                                                             batch.volatilities[i], N);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch.size()));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_pricing_cache_binomial)
+    ->Name("PRICING_CACHE/binomial_lattice_pricing")
+    ->ArgsProduct({{100, 1000}, {0, 1}})
+    ->ArgNames({"N", "cached"})
+    ->Unit(benchmark::kMicrosecond);
+
+// Hits from several threads on one shared cache, each thread walking the book from its own offset
+void BM_pricing_cache_shared_hits(benchmark::State& state) {
+    static const OptionBatch batch = random_options(kScalarBatch);
+    static PricingCache cache(4 * kScalarBatch);
+    size_t i = static_cast<size_t>(state.thread_index()) * 97;
+    for (auto _ : state) {
+        for (int64_t k = 0; k < kScalarBatch; ++k) {
+            i = i + 1 == batch.size() ? 0 : i + 1;
+            benchmark::DoNotOptimize(cache.black_scholes(batch.types[i], batch.strikes[i], batch.prices[i],
+                                                         batch.times[i], batch.rates[i], batch.volatilities[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kScalarBatch);
+    state.SetLabel("double");
+}
+BENCHMARK(BM_pricing_cache_shared_hits)
+    ->Name("PRICING_CACHE/shared_hits")
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Pricing service under load: `clients` threads each keep `in_flight` requests outstanding
+// and send 2000 each, waiting on the oldest future before sending the next. batch = 1
+// dispatches every request alone; otherwise up to 256 coalesce within 50 us. Latency runs
+// from submit() until the client holds the result; p50_us / p99_us are over every request of
+// every iteration, and items/s is the service's throughput.
+
+constexpr size_t kRequestsPerClient = 2000;
+
+void BM_pricing_service_load(benchmark::State& state) {
+    static const OptionBatch batch = random_options(kScalarBatch);
+    const size_t clients = static_cast<size_t>(state.range(0));
+    const size_t in_flight = static_cast<size_t>(state.range(1));
+    const bool implied = state.range(3) != 0;
+    PricingServiceSettings settings;
+    settings.max_batch_size = static_cast<size_t>(state.range(2));
+    PricingService service(settings);
+    std::vector<std::vector<double>> latencies(clients);
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (size_t c = 0; c < clients; ++c) {
+            threads.emplace_back([&, c] {
+                using Clock = std::chrono::steady_clock;
+                std::deque<std::pair<std::future<double>, Clock::time_point>> pending;
+                auto finish_oldest = [&] {
+                    benchmark::DoNotOptimize(pending.front().first.get());
+                    latencies[c].push_back(
+                        std::chrono::duration<double, std::micro>(Clock::now() - pending.front().second).count());
+                    pending.pop_front();
+                };
+                for (size_t k = 0; k < kRequestsPerClient; ++k) {
+                    size_t i = (c * 131 + k) % batch.size();
+                    Clock::time_point sent = Clock::now();
+                    if (implied) {
+                        pending.emplace_back(service.implied_volatility(batch.types[i], batch.quotes[i],
+                                                                        batch.strikes[i], batch.prices[i],
+                                                                        batch.times[i], batch.rates[i]),
+                                             sent);
+                    } else {
+                        pending.emplace_back(service.black_scholes(batch.types[i], batch.strikes[i], batch.prices[i],
+                                                                   batch.times[i], batch.rates[i],
+                                                                   batch.volatilities[i]),
+                                             sent);
+                    }
+                    if (pending.size() == in_flight) {
+                        finish_oldest();
+                    }
+                }
+                while (!pending.empty()) {
+                    finish_oldest();
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::vector<double> all;
+    for (const std::vector<double>& client : latencies) {
+        all.insert(all.end(), client.begin(), client.end());
+    }
+    std::sort(all.begin(), all.end());
+    if (!all.empty()) {
+        state.counters["p50_us"] = all[all.size() / 2];
+        state.counters["p99_us"] = all[std::min(all.size() - 1, all.size() * 99 / 100)];
+    }
+    state.counters["avg_batch"] = service.stats().average_batch_size();
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(clients * kRequestsPerClient));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_pricing_service_load)
+    ->Name("PRICING_SERVICE/load")
+    ->ArgsProduct({{1, 4, 16}, {1, 32}, {1, 256}, {0, 1}})
+    ->ArgNames({"clients", "in_flight", "batch", "implied"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+
+// Scenario engine: a 41 x 21 x 5 spot x vol x time stress grid over a book of `num_elem`
+// positions. Items are position-cells. The naive rows price every cell with the scalar pricer
+// on one thread, as a Python loop over black_scholes / binomial_lattice_pricing would.
+
+StressGrid stress_grid() {
+    StressGrid grid;
+    for (int s = -20; s <= 20; ++s) {
+        grid.spot_shocks.push_back(0.01 * s);
+    }
+    for (int v = -10; v <= 10; ++v) {
+        grid.vol_shocks.push_back(0.005 * v);
+    }
+    grid.time_shifts = {0.0, 1.0 / 252, 5.0 / 252, 21.0 / 252, 63.0 / 252};
+    return grid;
+}
+
+void BM_scenario_pnl(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    ScenarioSettings settings;
+    settings.model = static_cast<ScenarioModel>(state.range(1));
+    settings.style = ExerciseStyle::AMERICAN;
+    settings.steps = 100;
+    OptionBatch batch = random_options(n);
+    std::vector<double> quantities(n, 1.0);
+    std::vector<size_t> books(n);
+    for (size_t i = 0; i < n; ++i) {
+        books[i] = i % 8;
+    }
+    const StressGrid grid = stress_grid();
+    std::vector<double> out(8 * grid.cells());
+    ThreadPool pool(static_cast<size_t>(state.range(2)));
+    for (auto _ : state) {
+        scenario_pnl(batch.types.data(), batch.strikes.data(), batch.prices.data(), batch.times.data(),
+                     batch.rates.data(), batch.volatilities.data(), quantities.data(), books.data(), n, 8, grid,
+                     out.data(), settings, pool);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(grid.cells()));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_scenario_pnl)
+    ->Name("SCENARIO/scenario_pnl")
+    ->Args({1000, static_cast<int64_t>(ScenarioModel::BLACK_SCHOLES), 1})
+    ->Args({1000, static_cast<int64_t>(ScenarioModel::BLACK_SCHOLES), 0})
+    ->Args({4, static_cast<int64_t>(ScenarioModel::BINOMIAL), 1})
+    ->Args({4, static_cast<int64_t>(ScenarioModel::BINOMIAL), 0})
+    ->ArgNames({"num_elem", "model", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+void BM_scenario_naive(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const bool binomial = static_cast<ScenarioModel>(state.range(1)) == ScenarioModel::BINOMIAL;
+    OptionBatch batch = random_options(n);
+    const StressGrid grid = stress_grid();
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            for (double shift : grid.time_shifts) {
+                for (double vol_shock : grid.vol_shocks) {
+                    for (double spot_shock : grid.spot_shocks) {
+                        double S = batch.prices[i] * (1.0 + spot_shock);
+                        double sigma = batch.volatilities[i] + vol_shock;
+                        double T = batch.times[i] - shift;
+                        benchmark::DoNotOptimize(
+                            binomial ? binomial_lattice_pricing(batch.types[i], ExerciseStyle::AMERICAN, S,
+                                                                batch.strikes[i], T, batch.rates[i], sigma, 100)
+                                     : black_scholes(batch.types[i], batch.strikes[i], S, T, batch.rates[i], sigma));
+                    }
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(grid.cells()));
+    state.SetLabel("double");
+}
+BENCHMARK(BM_scenario_naive)
+    ->Name("SCENARIO/naive")
+    ->Args({1000, static_cast<int64_t>(ScenarioModel::BLACK_SCHOLES)})
+    ->Args({4, static_cast<int64_t>(ScenarioModel::BINOMIAL)})
+    ->ArgNames({"num_elem", "model"})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
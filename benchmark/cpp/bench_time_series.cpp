@@ -0,0 +1,694 @@
+// Benchmarks for finmath/TimeSeries. Inputs are prefixes of one random walk, swept over
+// num_elem from 1e3 to 1e8 prices and over the window sizes in kWindowSizes.
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "bench_data.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/TimeSeries/indicator_pipeline.h"
+#include "finmath/TimeSeries/moving_averages.h"
+#include "finmath/TimeSeries/parallel_indicators.h"
+#include "finmath/TimeSeries/rolling_statistics.h"
+#include "finmath/TimeSeries/rolling_volatility.h"
+#include "finmath/TimeSeries/rolling_window.h"
+#include "finmath/TimeSeries/rsi.h"
+#include "finmath/TimeSeries/simple_moving_average.h"
+#include "finmath/TimeSeries/streaming_indicators.h"
+
+namespace {
+
+// Sizes above this are skipped for the std::vector entry points, which copy their input
+constexpr int64_t kMaxVectorSize = 10000000;
+
+std::vector<double> price_prefix(int64_t n) {
+    const std::vector<double>& walk = random_walk_prices();
+    return std::vector<double>(walk.begin(), walk.begin() + n);
+}
+
+void set_series_throughput(benchmark::State& state, const char* input_type, size_t value_size = sizeof(double)) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(value_size));
+    state.SetLabel(input_type);
+}
+
+// The random walk and the label of the pointer entry points, per scalar type
+template <typename Real>
+const Real* walk_data();
+
+template <>
+const double* walk_data<double>() {
+    return random_walk_prices().data();
+}
+
+template <>
+const float* walk_data<float>() {
+    return random_walk_prices_float().data();
+}
+
+template <typename Real>
+void set_pointer_throughput(benchmark::State& state) {
+    set_series_throughput(state, std::is_same<Real, float>::value ? "float*" : "double*", sizeof(Real));
+}
+
+// Rolling window kernels over caller-owned buffers
+
+template <typename Real>
+void BM_rolling_mean(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_output_size(n, window_size));
+    for (auto _ : state) {
+        rolling_mean(prices, n, window_size, out.data());
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_rolling_mean, double)
+    ->Name("ROLLING_WINDOW/rolling_mean")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_rolling_mean, float)
+    ->Name("ROLLING_WINDOW/rolling_mean")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+template <typename Real>
+void BM_rolling_stddev(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_output_size(n, window_size));
+    for (auto _ : state) {
+        rolling_stddev(prices, n, window_size, out.data());
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_rolling_stddev, double)
+    ->Name("ROLLING_WINDOW/rolling_stddev")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_rolling_stddev, float)
+    ->Name("ROLLING_WINDOW/rolling_stddev")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_rolling_moments_slide(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    RollingMoments moments(window_size);
+    for (auto _ : state) {
+        moments.reset();
+        for (size_t i = 0; i < window_size; ++i) {
+            moments.push(prices[i]);
+        }
+        for (size_t i = window_size; i < n; ++i) {
+            moments.slide(prices[i], prices[i - window_size]);
+        }
+        benchmark::DoNotOptimize(moments.m2());
+    }
+    set_series_throughput(state, "double");
+}
+BENCHMARK(BM_rolling_moments_slide)
+    ->Name("ROLLING_WINDOW/RollingMoments::slide")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_rolling_moments_resync(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    RollingMoments moments(window_size);
+    for (auto _ : state) {
+        moments.resync(prices, window_size);
+        benchmark::DoNotOptimize(moments.m2());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.SetLabel("double*");
+}
+BENCHMARK(BM_rolling_moments_resync)
+    ->Name("ROLLING_WINDOW/RollingMoments::resync")
+    ->ArgsProduct({{kMinSize}, kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+// Simple moving average
+
+template <typename Real>
+void BM_simple_moving_average(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_output_size(n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simple_moving_average(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_simple_moving_average, double)
+    ->Name("SMA/simple_moving_average")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_simple_moving_average, float)
+    ->Name("SMA/simple_moving_average")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_simple_moving_average_vector(benchmark::State& state) {
+    const std::vector<double> prices = price_prefix(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simple_moving_average(prices, window_size));
+    }
+    set_series_throughput(state, "vector");
+}
+BENCHMARK(BM_simple_moving_average_vector)
+    ->Name("SMA/simple_moving_average")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+// Rolling volatility
+
+template <typename Real>
+void BM_rolling_volatility(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_volatility_output_size(n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rolling_volatility(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_rolling_volatility, double)
+    ->Name("VOLATILITY/rolling_volatility")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_rolling_volatility, float)
+    ->Name("VOLATILITY/rolling_volatility")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_rolling_volatility_vector(benchmark::State& state) {
+    const std::vector<double> prices = price_prefix(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rolling_volatility(prices, window_size));
+    }
+    set_series_throughput(state, "vector");
+}
+BENCHMARK(BM_rolling_volatility_vector)
+    ->Name("VOLATILITY/rolling_volatility")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_compute_log_returns(benchmark::State& state) {
+    const std::vector<double> prices = price_prefix(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compute_log_returns(prices));
+    }
+    set_series_throughput(state, "vector");
+}
+BENCHMARK(BM_compute_log_returns)
+    ->Name("VOLATILITY/compute_log_returns")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize)})
+    ->ArgName("num_elem");
+
+void BM_compute_std(benchmark::State& state) {
+    const std::vector<double> prices = price_prefix(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compute_std(prices));
+    }
+    set_series_throughput(state, "vector");
+}
+BENCHMARK(BM_compute_std)
+    ->Name("VOLATILITY/compute_std")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize)})
+    ->ArgName("num_elem");
+
+// RSI
+
+template <typename Real>
+void BM_compute_rsi(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rsi_output_size(n));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compute_rsi(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_compute_rsi, double)
+    ->Name("RSI/compute_rsi")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_compute_rsi, float)
+    ->Name("RSI/compute_rsi")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_compute_rsi_vector(benchmark::State& state) {
+    const std::vector<double> prices = price_prefix(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compute_rsi(prices, window_size));
+    }
+    set_series_throughput(state, "vector");
+}
+BENCHMARK(BM_compute_rsi_vector)
+    ->Name("RSI/compute_rsi")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_compute_avg_gain_loss(benchmark::State& state) {
+    const std::vector<double> prices = price_prefix(state.range(0) + 1);
+    std::vector<double> changes(prices.size() - 1);
+    for (size_t i = 0; i + 1 < prices.size(); ++i) {
+        changes[i] = prices[i + 1] - prices[i];
+    }
+    const size_t window_size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compute_avg_gain(changes, window_size));
+        benchmark::DoNotOptimize(compute_avg_loss(changes, window_size));
+    }
+    set_series_throughput(state, "vector");
+}
+BENCHMARK(BM_compute_avg_gain_loss)
+    ->Name("RSI/compute_avg_gain_loss")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize)})
+    ->ArgName("num_elem");
+
+// Exponential and weighted moving averages
+
+// simd = 0 runs the scalar recurrence, 1 the widest EMA scan the CPU supports
+template <typename Real>
+void BM_exponential_moving_average(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t span = static_cast<size_t>(state.range(1));
+    const SimdLevel detected = active_simd_level();
+    set_simd_level(state.range(2) == 0 ? SimdLevel::SCALAR : detected);
+    std::vector<Real> out(ema_output_size(n, span));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(exponential_moving_average(prices, n, span, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_simd_level(detected);
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_exponential_moving_average, double)
+    ->Name("MOVING_AVERAGE/exponential_moving_average")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), {20}, {0, 1}})
+    ->ArgNames({"num_elem", "span", "simd"});
+BENCHMARK_TEMPLATE(BM_exponential_moving_average, float)
+    ->Name("MOVING_AVERAGE/exponential_moving_average")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), {20}, {0, 1}})
+    ->ArgNames({"num_elem", "span", "simd"});
+
+template <typename Real>
+void BM_weighted_moving_average(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(wma_output_size(n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(weighted_moving_average(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_weighted_moving_average, double)
+    ->Name("MOVING_AVERAGE/weighted_moving_average")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+// Eight TEMA spans: one blocked pass (fused = 1) against one call per span
+void BM_moving_averages_spans(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const std::vector<size_t> spans = {5, 10, 20, 50, 100, 200, 500, 1000};
+    std::vector<std::vector<double>> results(spans.size());
+    std::vector<double*> outs(spans.size());
+    for (size_t k = 0; k < spans.size(); ++k) {
+        results[k].resize(tema_output_size(n, spans[k]));
+        outs[k] = results[k].data();
+    }
+    for (auto _ : state) {
+        if (state.range(1) != 0) {
+            moving_averages(IndicatorType::TEMA, prices, n, spans.data(), spans.size(), outs.data());
+        } else {
+            for (size_t k = 0; k < spans.size(); ++k) {
+                triple_exponential_moving_average(prices, n, spans[k], outs[k]);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_moving_averages_spans)
+    ->Name("MOVING_AVERAGE/moving_averages")
+    ->ArgsProduct({decade_sizes(100000, kMaxSeriesSize), {0, 1}})
+    ->ArgNames({"num_elem", "fused"});
+
+// Rolling order statistics and higher moments
+
+template <typename Real>
+void BM_rolling_max(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_output_size(n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rolling_max(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_rolling_max, double)
+    ->Name("ROLLING_STATS/rolling_max")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_rolling_max, float)
+    ->Name("ROLLING_STATS/rolling_max")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+template <typename Real>
+void BM_rolling_median(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_output_size(n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rolling_median(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_rolling_median, double)
+    ->Name("ROLLING_STATS/rolling_median")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+// Three quantiles from one sorted window (fused = 1) against one pass per quantile
+void BM_rolling_quantiles(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    const double qs[] = {0.05, 0.5, 0.95};
+    std::vector<std::vector<double>> results(3, std::vector<double>(rolling_output_size(n, window_size)));
+    double* outs[] = {results[0].data(), results[1].data(), results[2].data()};
+    for (auto _ : state) {
+        if (state.range(2) != 0) {
+            rolling_quantiles(prices, n, window_size, qs, 3, outs);
+        } else {
+            for (size_t k = 0; k < 3; ++k) {
+                rolling_quantile(prices, n, window_size, qs[k], outs[k]);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_rolling_quantiles)
+    ->Name("ROLLING_STATS/rolling_quantiles")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes, {0, 1}})
+    ->ArgNames({"num_elem", "window_size", "fused"});
+
+template <typename Real>
+void BM_rolling_skewness(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_output_size(n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rolling_skewness(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_rolling_skewness, double)
+    ->Name("ROLLING_STATS/rolling_skewness")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_rolling_skewness, float)
+    ->Name("ROLLING_STATS/rolling_skewness")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+template <typename Real>
+void BM_rolling_zscore(benchmark::State& state) {
+    const Real* prices = walk_data<Real>();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<Real> out(rolling_output_size(n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rolling_zscore(prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_pointer_throughput<Real>(state);
+}
+BENCHMARK_TEMPLATE(BM_rolling_zscore, double)
+    ->Name("ROLLING_STATS/rolling_zscore")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+// Streaming indicators: one update() per tick
+
+template <typename Indicator>
+void BM_streaming_update(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    Indicator indicator(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        indicator.reset();
+        for (size_t i = 0; i < n; ++i) {
+            benchmark::DoNotOptimize(indicator.update(prices[i]));
+        }
+    }
+    set_series_throughput(state, "double");
+}
+BENCHMARK_TEMPLATE(BM_streaming_update, RollingSMA)
+    ->Name("STREAMING/RollingSMA::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_streaming_update, RollingVolatility)
+    ->Name("STREAMING/RollingVolatility::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_streaming_update, WilderRSI)
+    ->Name("STREAMING/WilderRSI::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_streaming_update, RollingEMA)
+    ->Name("STREAMING/RollingEMA::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_streaming_update, RollingWMA)
+    ->Name("STREAMING/RollingWMA::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_streaming_update, RollingMax)
+    ->Name("STREAMING/RollingMax::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_streaming_update, RollingSkewness)
+    ->Name("STREAMING/RollingSkewness::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+BENCHMARK_TEMPLATE(BM_streaming_update, RollingZScore)
+    ->Name("STREAMING/RollingZScore::update")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_ring_buffer_push(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    RingBuffer buffer(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            buffer.push(prices[i]);
+        }
+        benchmark::DoNotOptimize(buffer.oldest());
+    }
+    set_series_throughput(state, "double");
+}
+BENCHMARK(BM_ring_buffer_push)
+    ->Name("STREAMING/RingBuffer::push")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_streaming_snapshot_restore(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    RollingVolatility indicator(window_size);
+    for (size_t i = 0; i <= window_size; ++i) {
+        indicator.update(prices[i]);
+    }
+    for (auto _ : state) {
+        std::vector<double> snapshot = indicator.snapshot();
+        indicator.restore(snapshot);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel("vector");
+}
+BENCHMARK(BM_streaming_snapshot_restore)
+    ->Name("STREAMING/RollingVolatility::snapshot_restore")
+    ->ArgsProduct({{1}, kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+// Single indicator dispatch and many series across the pool
+
+void BM_compute_indicator(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const IndicatorType indicator = static_cast<IndicatorType>(state.range(1));
+    const size_t window_size = 20;
+    std::vector<double> out(indicator_output_size(indicator, n, window_size));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(compute_indicator(indicator, prices, n, window_size, out.data()));
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_compute_indicator)
+    ->Name("PARALLEL/compute_indicator")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxVectorSize),
+                   {static_cast<int64_t>(IndicatorType::SMA), static_cast<int64_t>(IndicatorType::VOLATILITY),
+                    static_cast<int64_t>(IndicatorType::RSI)}})
+    ->ArgNames({"num_elem", "indicator"});
+
+// num_elem prices split into 500 short series, each given volatility, TEMA and a rolling
+// median on one thread, with scratch from the heap (arena = 0) or a reused ScratchArena
+void BM_indicator_panel_scratch(benchmark::State& state) {
+    const size_t count = 500;
+    const double* prices = random_walk_prices().data();
+    const size_t length = static_cast<size_t>(state.range(0)) / count;
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    const bool use_arena = state.range(2) != 0;
+    std::vector<double> out(length);
+    ScratchArena arena;
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            const double* series = prices + i * length;
+            if (use_arena) {
+                rolling_volatility(series, length, window_size, out.data(), arena);
+                triple_exponential_moving_average(series, length, window_size, out.data(), arena);
+                rolling_median(series, length, window_size, out.data(), arena);
+            } else {
+                rolling_volatility(series, length, window_size, out.data());
+                triple_exponential_moving_average(series, length, window_size, out.data());
+                rolling_median(series, length, window_size, out.data());
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_indicator_panel_scratch)
+    ->Name("PARALLEL/indicator_panel_scratch")
+    ->ArgsProduct({{100000, 1000000}, {10, 30}, {0, 1}})
+    ->ArgNames({"num_elem", "window_size", "arena"});
+
+// num_elem prices split into 500 series (a universe of tickers)
+void BM_parallel_indicators(benchmark::State& state) {
+    const size_t count = 500;
+    const double* prices = random_walk_prices().data();
+    const size_t length = static_cast<size_t>(state.range(0)) / count;
+    const IndicatorType indicator = static_cast<IndicatorType>(state.range(1));
+    const size_t window_size = 20;
+    ThreadPool pool(static_cast<size_t>(state.range(2)));
+
+    std::vector<const double*> series(count);
+    std::vector<size_t> lengths(count, length);
+    std::vector<std::vector<double>> outputs(count);
+    std::vector<double*> out(count);
+    for (size_t i = 0; i < count; ++i) {
+        series[i] = prices + i * length;
+        outputs[i].resize(indicator_output_size(indicator, length, window_size));
+        out[i] = outputs[i].data();
+    }
+    for (auto _ : state) {
+        parallel_indicators(series.data(), lengths.data(), count, indicator, window_size, out.data(), pool);
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_parallel_indicators)
+    ->Name("PARALLEL/parallel_indicators")
+    ->ArgsProduct({decade_sizes(100000, kMaxSeriesSize),
+                   {static_cast<int64_t>(IndicatorType::SMA), static_cast<int64_t>(IndicatorType::VOLATILITY),
+                    static_cast<int64_t>(IndicatorType::RSI)},
+                   {1, 0}})
+    ->ArgNames({"num_elem", "indicator", "threads"})
+    ->UseRealTime();
+
+// SMA, RSI and volatility of one series: three separate calls against one fused pipeline
+
+void BM_separate_indicators(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    std::vector<double> sma(rolling_output_size(n, window_size));
+    std::vector<double> rsi(rsi_output_size(n));
+    std::vector<double> vol(rolling_volatility_output_size(n, window_size));
+    for (auto _ : state) {
+        simple_moving_average(prices, n, window_size, sma.data());
+        compute_rsi(prices, n, window_size, rsi.data());
+        rolling_volatility(prices, n, window_size, vol.data());
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_separate_indicators)
+    ->Name("PIPELINE/separate_indicators")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+void BM_indicator_pipeline(benchmark::State& state) {
+    const double* prices = random_walk_prices().data();
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t window_size = static_cast<size_t>(state.range(1));
+    IndicatorPipeline pipeline({{IndicatorType::SMA, window_size},
+                                {IndicatorType::RSI, window_size},
+                                {IndicatorType::VOLATILITY, window_size}});
+    std::vector<double> out(pipeline.column_size(n));
+    for (auto _ : state) {
+        pipeline.compute(prices, n, out.data());
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_indicator_pipeline)
+    ->Name("PIPELINE/IndicatorPipeline::compute")
+    ->ArgsProduct({decade_sizes(kMinSize, kMaxSeriesSize), kWindowSizes})
+    ->ArgNames({"num_elem", "window_size"});
+
+// num_elem prices split into 500 columns
+void BM_indicator_pipeline_panel(benchmark::State& state) {
+    const size_t columns = 500;
+    const size_t rows = static_cast<size_t>(state.range(0)) / columns;
+    IndicatorPipeline pipeline({{IndicatorType::SMA, 20}, {IndicatorType::RSI, 14}, {IndicatorType::VOLATILITY, 20}});
+    std::vector<double> out(pipeline.column_size(rows) * columns);
+    ThreadPool pool(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        pipeline.compute(random_walk_prices().data(), rows, columns, out.data(), pool);
+        benchmark::ClobberMemory();
+    }
+    set_series_throughput(state, "double*");
+}
+BENCHMARK(BM_indicator_pipeline_panel)
+    ->Name("PIPELINE/IndicatorPipeline::compute_panel")
+    ->ArgsProduct({decade_sizes(100000, kMaxSeriesSize), {1, 0}})
+    ->ArgNames({"num_elem", "threads"})
+    ->UseRealTime();
+
+} // namespace
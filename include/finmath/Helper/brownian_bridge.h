@@ -0,0 +1,35 @@
+#ifndef BROWNIAN_BRIDGE_H
+#define BROWNIAN_BRIDGE_H
+
+#include <cstddef>
+#include <vector>
+
+// Brownian bridge construction on the grid t_k = k, k = 1..steps. The first normal
+// sets the terminal value W(steps), the next the midpoint, then the quarter points
+// and so on. Paths built from quasi-random points therefore put the best-distributed
+// dimensions on the coarse path shape, which is what most payoffs depend on.
+// Scale the result by sqrt(dt) for a grid of spacing dt.
+class BrownianBridge {
+public:
+    explicit BrownianBridge(size_t steps);
+
+    size_t steps() const { return steps_; }
+
+    // Build the path values W(1..steps) from steps independent normals
+    void build(const double* z, double* w) const;
+
+    // Same for `lanes` paths at once in structure-of-arrays layout: element k of path j
+    // is at [k * lanes + j] in both z and w
+    void build(const double* z, double* w, size_t lanes) const;
+
+private:
+    size_t steps_;
+    std::vector<size_t> left_index_;   // 0 means the left end is W(0) = 0, otherwise W(left - 1)
+    std::vector<size_t> right_index_;
+    std::vector<size_t> bridge_index_;
+    std::vector<double> left_weight_;
+    std::vector<double> right_weight_;
+    std::vector<double> std_dev_;
+};
+
+#endif // BROWNIAN_BRIDGE_H
@@ -1,8 +1,14 @@
 #ifndef HELPER_H
 #define HELPER_H
 
+// Standard normal CDF and PDF at the tier set by set_normal_accuracy (EXACT unless changed,
+// see normal_distribution.h)
 double normal_cdf(double x);
 double normal_pdf(double x);
+
+// Inverse of the standard normal CDF for p in (0, 1): Acklam's rational approximation
+// refined with one Halley step, accurate to about 1e-15 relative
+double inverse_normal_cdf(double p);
 double combinations(int n, int k);
 
 #endif
\ No newline at end of file
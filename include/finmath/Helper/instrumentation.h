@@ -0,0 +1,146 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Opt-in instrumentation of the library's entry points: call counts, items processed
+// (options, prices, paths) and a latency histogram per function. It is compiled in only
+// with the CMake option FINMATH_INSTRUMENTATION=ON (which defines the macro of the same
+// name); otherwise FINMATH_INSTRUMENT expands to nothing and the functions below report
+// that nothing was recorded.
+//
+// Counters live in per-thread blocks and are written only by their own thread, with
+// relaxed atomic loads and stores: recording takes no lock and no locked instruction.
+// Dumps sum the blocks of all threads, and threads that exit fold their counts into a
+// shared total. Latencies are taken from the time-stamp counter and kept in log-linear
+// buckets, 8 per power of two, so percentiles are within 12.5%. Reading the counter costs
+// 5-30 ns depending on the machine, so functions that may return within a few
+// microseconds use FINMATH_INSTRUMENT_SAMPLED, which times one call in
+// kInstrumentationSamplePeriod; their counts stay exact.
+
+// Whether this build records instrumentation
+bool instrumentation_enabled();
+
+// Everything recorded since start-up or the last reset, as JSON:
+//     {"enabled": true, "functions": {"<name>": {"calls": ..., "items": ..., "timed_calls": ...,
+//      "mean_ns": ..., "p50_ns": ..., "p90_ns": ..., "p99_ns": ..., "p999_ns": ..., "max_ns": ...,
+//      "histogram": [[upper_ns, count], ...]}, ...}}
+// Percentiles and max are bucket upper bounds; the histogram lists non-empty buckets only.
+std::string instrumentation_json();
+
+// Start all counters from zero again
+void reset_instrumentation();
+
+constexpr uint64_t kInstrumentationSamplePeriod = 256;
+
+// Distinct instrumented functions; later names share the last slot, "(other)"
+constexpr size_t kMaxInstrumentedFunctions = 128;
+
+// Latency buckets: 0..7 ticks one each, then 8 per power of two up to 2^48 ticks
+constexpr size_t kInstrumentationBuckets = 368;
+
+// One thread's counters for one function
+struct InstrumentationCounters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> items;
+    std::atomic<uint64_t> timed_calls;
+    std::atomic<uint64_t> total_ticks;
+    std::atomic<uint64_t> buckets[kInstrumentationBuckets];
+};
+
+// Id of the function called `name`, the same for every call with that name; takes a lock
+int instrumentation_register(const char* name);
+
+// The calling thread's counters of function id
+InstrumentationCounters& instrumentation_counters(int id);
+
+inline uint64_t instrumentation_ticks() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+#endif
+}
+
+inline size_t instrumentation_bucket(uint64_t ticks) {
+    if (ticks < 8) {
+        return static_cast<size_t>(ticks);
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(ticks));
+#else
+    size_t exponent = 0;
+    for (uint64_t rest = ticks; rest > 1; rest >>= 1) {
+        ++exponent;
+    }
+#endif
+    if (exponent > 47) {
+        return kInstrumentationBuckets - 1;
+    }
+    return (exponent - 2) * 8 + static_cast<size_t>((ticks >> (exponent - 3)) & 7);
+}
+
+// Records one call: counts on construction, latency on destruction when the call is timed
+template <uint64_t SamplePeriod>
+class InstrumentationScope {
+public:
+    // cached is the call site's thread_local copy of the counters' address, so the
+    // registry is consulted only on the first call on each thread
+    InstrumentationScope(const char* name, uint64_t items, InstrumentationCounters*& cached)
+        : counters_(cached != nullptr ? *cached : *(cached = &instrumentation_counters(instrumentation_register(name)))) {
+        // Only this thread writes these counters, so a plain load and store is enough
+        uint64_t calls = counters_.calls.load(std::memory_order_relaxed) + 1;
+        counters_.calls.store(calls, std::memory_order_relaxed);
+        counters_.items.store(counters_.items.load(std::memory_order_relaxed) + items, std::memory_order_relaxed);
+        timed_ = (calls - 1) % SamplePeriod == 0;
+        start_ = timed_ ? instrumentation_ticks() : 0;
+    }
+
+    ~InstrumentationScope() {
+        if (timed_) {
+            uint64_t elapsed = instrumentation_ticks() - start_;
+            bump(counters_.timed_calls, 1);
+            bump(counters_.total_ticks, elapsed);
+            bump(counters_.buckets[instrumentation_bucket(elapsed)], 1);
+        }
+    }
+
+    InstrumentationScope(const InstrumentationScope&) = delete;
+    InstrumentationScope& operator=(const InstrumentationScope&) = delete;
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    InstrumentationCounters& counters_;
+    bool timed_;
+    uint64_t start_;
+};
+
+// Record the enclosing function as `name` (a string literal), processing `items` items
+#ifdef FINMATH_INSTRUMENTATION
+#define FINMATH_INSTRUMENT_WITH_PERIOD(name, items, period)                               \
+    static thread_local InstrumentationCounters* finmath_instrument_counters = nullptr; \
+    InstrumentationScope<period> finmath_instrument_scope(name, static_cast<uint64_t>(items), \
+                                                          finmath_instrument_counters)
+#else
+#define FINMATH_INSTRUMENT_WITH_PERIOD(name, items, period) static_cast<void>(0)
+#endif
+
+#define FINMATH_INSTRUMENT(name, items) FINMATH_INSTRUMENT_WITH_PERIOD(name, items, 1)
+#define FINMATH_INSTRUMENT_SAMPLED(name, items) \
+    FINMATH_INSTRUMENT_WITH_PERIOD(name, items, kInstrumentationSamplePeriod)
+
+#endif // INSTRUMENTATION_H
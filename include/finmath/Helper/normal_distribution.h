@@ -0,0 +1,50 @@
+#ifndef NORMAL_DISTRIBUTION_H
+#define NORMAL_DISTRIBUTION_H
+
+#include <cstddef>
+
+// Standard normal CDF and PDF at selectable accuracy. normal_cdf(x) and normal_pdf(x) in
+// helper.h, and the scalar pricers and Greeks built on them, use the global tier; the
+// functions here also take a tier per call. The implied volatility solver always uses EXACT,
+// and the SIMD pricing kernels keep their own HIGH-accuracy CDF.
+enum class NormalAccuracy {
+    EXACT,  // C library erfc / exp, the historical behaviour and the default
+    HIGH,   // branch-free erfc polynomial with a compensated exp(-x^2 / 2): CDF and PDF within
+            // 1e-15 relative of the true values down to x = -37, where they turn subnormal.
+            // EXACT itself drifts to 2e-13 relative there from rounding x / sqrt(2), which
+            // is what comparisons against it measure in the far tails.
+    FAST,   // cubic Hermite table over [-8, 8] in steps of 1/16: within 5e-8 absolute, so
+            // relative accuracy is lost in the tails. For screening, not for solvers.
+};
+
+// Tier used by normal_cdf(x), normal_pdf(x) and, by default, the batch functions. Shared by
+// all threads, like set_simd_level; EXACT until changed.
+NormalAccuracy normal_accuracy();
+void set_normal_accuracy(NormalAccuracy accuracy);
+
+const char* normal_accuracy_name(NormalAccuracy accuracy);
+
+// Function to compute the standard normal CDF / PDF at the given tier. NaN gives NaN and
+// infinities give the limits.
+double normal_cdf(double x, NormalAccuracy accuracy);
+double normal_pdf(double x, NormalAccuracy accuracy);
+
+// out[i] = Phi(x[i]) / phi(x[i]) for i < n. HIGH and FAST run on the active SIMD level
+// (where the FAST PDF is the HIGH one: a vector exp beats the table's gathers); EXACT is a
+// loop over the C library.
+void normal_cdf_batch(const double* x, double* out, size_t n, NormalAccuracy accuracy = normal_accuracy());
+void normal_pdf_batch(const double* x, double* out, size_t n, NormalAccuracy accuracy = normal_accuracy());
+
+// Largest errors of a tier against EXACT, and where they occur
+struct NormalErrorReport {
+    double max_abs_cdf, max_rel_cdf, worst_cdf_x;
+    double max_abs_pdf, max_rel_pdf, worst_pdf_x;  // worst_*_x is the argument of the largest absolute error
+};
+
+// Function to measure a tier over `samples` evenly spaced points of [lo, hi] through the
+// batch functions (so at the active SIMD level). Relative errors skip points where the
+// exact value is 0 or subnormal.
+NormalErrorReport normal_accuracy_report(NormalAccuracy accuracy, double lo = -10.0, double hi = 10.0,
+                                         size_t samples = 1000001);
+
+#endif // NORMAL_DISTRIBUTION_H
@@ -0,0 +1,47 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <cstdint>
+
+// Philox4x32-10 counter-based random number generator (Salmon et al., "Parallel
+// Random Numbers: As Easy as 1, 2, 3", SC 2011). Each call maps a 128-bit counter
+// and a 64-bit key to four independent 32-bit outputs. There is no generator
+// state, so any thread can produce the numbers for any (counter, key) directly,
+// which makes results independent of how work is split across threads.
+
+using PhiloxCounter = std::array<uint32_t, 4>;
+using PhiloxKey = std::array<uint32_t, 2>;
+
+inline PhiloxCounter philox4x32(PhiloxCounter counter, PhiloxKey key) {
+    const uint32_t kMul0 = 0xD2511F53u;
+    const uint32_t kMul1 = 0xCD9E8D57u;
+    const uint32_t kWeyl0 = 0x9E3779B9u;
+    const uint32_t kWeyl1 = 0xBB67AE85u;
+
+    for (int round = 0; round < 10; ++round) {
+        uint64_t product0 = static_cast<uint64_t>(kMul0) * counter[0];
+        uint64_t product1 = static_cast<uint64_t>(kMul1) * counter[2];
+        counter = {
+            static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+            static_cast<uint32_t>(product1),
+            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+            static_cast<uint32_t>(product0),
+        };
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+    }
+    return counter;
+}
+
+// Key for a 64-bit seed
+inline PhiloxKey philox_key(uint64_t seed) {
+    return {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+}
+
+// Map 32 random bits to the open interval (0, 1), so the result can go through an inverse CDF
+inline double philox_uniform(uint32_t bits) {
+    return (static_cast<double>(bits) + 0.5) * 2.3283064365386962890625e-10;
+}
+
+#endif // PHILOX_H
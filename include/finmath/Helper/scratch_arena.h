@@ -0,0 +1,80 @@
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Reusable scratch memory for the indicator functions' temporaries (log returns, window
+// state, per-span kernels). Allocation bumps a pointer through blocks the arena owns and
+// deallocation does nothing; a Scope hands back everything allocated since it opened. The
+// blocks are kept for the next call, so once the arena has grown to the largest call a
+// loop makes, the loop no longer touches the heap. When a pass needed more than one block,
+// rewinding to empty merges them into one block of their total size.
+//
+// It is a std::pmr::memory_resource, so std::pmr containers can draw from it. Not
+// thread-safe: use one arena per thread.
+class ScratchArena : public std::pmr::memory_resource {
+public:
+    // Bytes of the first block, allocated on first use
+    explicit ScratchArena(size_t initial_capacity = 64 * 1024);
+    ~ScratchArena() override;
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    // Uninitialized storage for n values of T, aligned to a cache line
+    template <typename T>
+    T* allocate_array(size_t n) {
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T) > kAlignment ? alignof(T) : kAlignment));
+    }
+
+    // Release everything allocated (the blocks are kept)
+    void reset();
+
+    // Bytes owned, and bytes up to the current allocation point
+    size_t capacity() const;
+    size_t used() const;
+
+    // Blocks requested from the heap since construction
+    size_t heap_allocations() const { return heap_allocations_; }
+
+    // Everything allocated from the arena while a Scope is open is released when it closes.
+    // Scopes nest like the calls that open them.
+    class Scope {
+    public:
+        explicit Scope(ScratchArena& arena) : arena_(arena), block_(arena.block_), offset_(arena.offset_) {}
+        ~Scope() { arena_.rewind(block_, offset_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ScratchArena& arena_;
+        size_t block_;
+        size_t offset_;
+    };
+
+private:
+    static constexpr size_t kAlignment = 64;
+
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void rewind(size_t block, size_t offset);
+    void add_block(size_t bytes);
+
+    std::vector<Block> blocks_;
+    size_t block_;   // block allocations come from
+    size_t offset_;  // bytes of blocks_[block_] in use
+    size_t initial_capacity_;
+    size_t heap_allocations_;
+};
+
+#endif // SCRATCH_ARENA_H
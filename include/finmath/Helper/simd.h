@@ -0,0 +1,18 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// Instruction sets the batch kernels can dispatch to, in increasing order
+enum class SimdLevel {SCALAR, AVX2, AVX512};
+
+// Best level this CPU supports
+SimdLevel detect_simd_level();
+
+// Level the batch kernels currently dispatch to: the detected level unless capped by set_simd_level
+SimdLevel active_simd_level();
+
+// Cap dispatch at `level` (e.g. SCALAR to compare against the scalar path); levels above the detected one are clamped
+void set_simd_level(SimdLevel level);
+
+const char* simd_level_name(SimdLevel level);
+
+#endif // SIMD_H
@@ -0,0 +1,35 @@
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sobol low-discrepancy sequence in up to max_dimensions() dimensions, as 32-bit
+// integers (multiply by 2^-32 for a point in [0, 1)). Dimensions 1-21 use the Joe-Kuo
+// direction numbers. Later dimensions use the next primitive polynomials in order,
+// with fixed pseudo-random initial direction numbers, which is still a valid Sobol
+// sequence but without the Joe-Kuo two-dimensional projection tuning.
+class SobolSequence {
+public:
+    // A non-zero seed applies a random digital shift (XOR) to each dimension, which keeps
+    // the equidistribution properties and makes the estimator unbiased
+    explicit SobolSequence(size_t dimensions, uint64_t seed = 0);
+
+    size_t dimensions() const { return dimensions_; }
+
+    // Point `index` (0-based, below 2^32 - 1), written to out[0..dimensions)
+    void point(uint64_t index, uint32_t* out) const;
+
+    // Turn point `index`, held in x, into point index + 1 (one XOR per dimension)
+    void next(uint64_t index, uint32_t* x) const;
+
+    static size_t max_dimensions();
+
+private:
+    size_t dimensions_;
+    std::vector<uint32_t> directions_;  // 32 direction numbers per dimension
+    std::vector<uint32_t> shift_;
+};
+
+#endif // SOBOL_H
@@ -0,0 +1,74 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Each worker owns a task deque: it pops its own tasks
+// from the back and, once empty, steals from the front of the other workers'
+// deques. The thread that calls parallel_for runs tasks too, so a pool of
+// thread_count() threads starts thread_count() - 1 workers, and nested
+// parallel_for calls from inside a task cannot deadlock.
+class ThreadPool {
+public:
+    // num_threads = 0 uses std::thread::hardware_concurrency(). With pin_threads,
+    // worker i is bound to CPU i + 1, leaving CPU 0 to the calling thread (Linux
+    // only, ignored elsewhere).
+    explicit ThreadPool(size_t num_threads = 0, bool pin_threads = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads that execute tasks, including the caller of parallel_for
+    size_t thread_count() const { return workers_.size() + 1; }
+
+    // Split [0, n) into contiguous chunks of at least `grain` indices and call
+    // body(begin, end) on each, blocking until all chunks are done. The chunk
+    // boundaries depend only on n, grain and thread_count(), never on timing.
+    // The first exception thrown by body is rethrown here.
+    void parallel_for(size_t n, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+private:
+    struct Job;
+
+    struct Task {
+        Job* job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(size_t index);
+    bool try_pop(size_t index, Task& task);
+    bool try_steal(size_t thief, Task& task);
+    void run(const Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    // Sleeping workers wait on wake_ until queued_ > 0 or the pool stops
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_;
+    bool stopping_;
+};
+
+// Process-wide pool used by the parallel_* entry points
+ThreadPool& default_thread_pool();
+
+// Replace the default pool. Must not be called while another thread is using it.
+void set_default_thread_count(size_t num_threads, bool pin_threads = false);
+
+#endif // THREAD_POOL_H
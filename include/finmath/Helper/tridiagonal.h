@@ -0,0 +1,44 @@
+#ifndef TRIDIAGONAL_H
+#define TRIDIAGONAL_H
+
+#include <cstddef>
+#include <vector>
+
+// Tridiagonal system A x = d solved by the Thomas algorithm. Row i of A is
+// lower[i] x[i - 1] + diagonal[i] x[i] + upper[i] x[i + 1] (lower[0] and upper[n - 1] are
+// unused). factorize() does the elimination once, so a matrix that stays the same across
+// time steps is solved against each new right-hand side in two O(n) sweeps. The buffers
+// are kept between factorizations and only grow, so a reused solver does not allocate.
+// The algorithm does not pivot: A should be diagonally dominant (as implicit finite
+// difference operators are).
+class TridiagonalSolver {
+public:
+    // Eliminate from the first row down and substitute from the last row up, or the
+    // reverse when reverse is true
+    void factorize(const double* lower, const double* diagonal, const double* upper, size_t n,
+                   bool reverse = false);
+
+    size_t size() const { return n_; }
+
+    // Overwrite x, holding d on entry, with the solution
+    void solve(double* x) const;
+
+    // Brennan-Schwartz: the same sweeps with x[i] raised to at least floor[i] as each value
+    // is substituted. This solves the complementarity problem x >= floor, A x >= d (one of
+    // them tight in each row) when the rows where x = floor form one block at the end the
+    // substitution starts from (the first rows with reverse, the last rows without), as the
+    // early-exercise region of an American put or call does.
+    void solve_projected(double* x, const double* floor) const;
+
+private:
+    template <bool Project>
+    void substitute(double* x, const double* floor) const;
+
+    size_t n_ = 0;
+    bool reverse_ = false;
+    std::vector<double> factor_;       // eliminated off-diagonal, divided by the pivot
+    std::vector<double> inverse_;      // 1 / pivot
+    std::vector<double> multiplier_;   // the off-diagonal eliminated against the previous row, / pivot
+};
+
+#endif // TRIDIAGONAL_H
@@ -0,0 +1,130 @@
+#ifndef CASH_FLOWS_H
+#define CASH_FLOWS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "finmath/Helper/thread_pool.h"
+
+// Annuities, amortization, NPV / IRR and scenario discounting of cash-flow schedules.
+// Rates are decimals per period (0.05 for 5%) unless stated otherwise.
+
+// Function to compute the present value of `periods` level payments. Payments fall at the
+// end of each period, or at the start when due is true. Returns NaN for negative periods
+// or a rate at or below -100%.
+double annuity_present_value(double payment, double rate, int periods, bool due = false);
+
+// Function to compute the future value, at the end of the last period, of `periods` level payments
+double annuity_future_value(double payment, double rate, int periods, bool due = false);
+
+// Function to compute the level payment that repays `principal` over `periods` periods
+double annuity_payment(double principal, double rate, int periods, bool due = false);
+
+// Period-by-period breakdown of a level-payment loan. Entry k describes period k + 1:
+// interest accrued on the opening balance, the principal repaid, and the balance left.
+// The last payment absorbs rounding so the final balance is exactly 0.
+struct AmortizationSchedule {
+    std::vector<double> payment;
+    std::vector<double> interest;
+    std::vector<double> principal;
+    std::vector<double> balance;
+};
+
+// Function to build the amortization schedule of a loan repaid by end-of-period level
+// payments; empty if periods is not positive or the rate is at or below -100%
+AmortizationSchedule amortization_schedule(double principal, double rate, int periods);
+
+// Discount factor curve through pillars (t_i, P(0, t_i)), interpolated linearly in
+// ln P, i.e. with a constant instantaneous forward rate between pillars. P(0, 0) = 1 is
+// implied, and past the last pillar the last forward rate carries on. Lookups are O(log
+// pillars), and sorted batches walk the pillars once.
+class DiscountCurve {
+public:
+    // times must be positive and strictly increasing, discount factors positive and finite.
+    // Throws std::invalid_argument otherwise.
+    DiscountCurve(std::vector<double> times, std::vector<double> discount_factors);
+
+    // Curve through continuously compounded zero rates, P(0, t_i) = exp(-r_i t_i)
+    static DiscountCurve from_zero_rates(const std::vector<double>& times, const std::vector<double>& zero_rates);
+
+    const std::vector<double>& times() const { return times_; }
+    const std::vector<double>& discount_factors() const { return discount_factors_; }
+
+    // P(0, t) for t >= 0; NaN for negative or non-finite t
+    double discount(double t) const;
+
+    // Discount factors of n times into out[0..n)
+    void discount_batch(const double* times, double* out, size_t n) const;
+
+    // Continuously compounded zero rate -ln P(0, t) / t; the first forward rate at t = 0
+    double zero_rate(double t) const;
+
+    // Continuously compounded forward rate between t1 and t2 > t1
+    double forward_rate(double t1, double t2) const;
+
+private:
+    // Pillar segment holding t: nodes_[i] <= t < nodes_[i + 1], or the last segment
+    size_t segment(double t) const;
+
+    std::vector<double> times_;
+    std::vector<double> discount_factors_;
+    std::vector<double> nodes_;       // 0 followed by the pillar times
+    std::vector<double> log_factors_; // ln P at each node
+    std::vector<double> forwards_;    // forward rate over segment i = [nodes_[i], nodes_[i + 1])
+};
+
+// Function to compute the NPV of cash_flows[k] paid at the end of period k (k = 0 is
+// undiscounted), as numpy_financial.npv does
+double net_present_value(double rate, const std::vector<double>& cash_flows);
+
+// Function to compute the NPV of n dated cash flows amounts[i] paid at times[i] >= 0
+double net_present_value(const DiscountCurve& curve, const double* times, const double* amounts, size_t n);
+
+// Outcome of an IRR solve
+enum class IrrStatus {
+    CONVERGED,      // NPV at the rate is zero to rounding
+    NO_SOLUTION,    // no rate in (-99.9%, 99900%) zeroes the NPV; rate is NaN
+    INVALID_INPUT,  // fewer than two flows, a non-finite flow, or flows without a sign change; rate is NaN
+};
+
+// Function to find the rate at which the NPV of cash_flows[0..n) (one per period, as in
+// net_present_value) is zero. Newton steps run on the polynomial in v = 1 / (1 + rate)
+// starting from guess. The default of 0 suits conventional flows (an outlay, then
+// inflows) with a positive IRR: the NPV is convex and increasing in v and the root lies
+// below v = 1, so Newton approaches it from above without overshooting. When Newton
+// fails the root is bracketed on a grid of rates and polished by safeguarded Newton,
+// taking the root nearest the guess if there are several. The outcome is written to
+// *status when status is not null.
+double internal_rate_of_return(const double* cash_flows, size_t n, IrrStatus* status = nullptr,
+                               double guess = 0.0);
+double internal_rate_of_return(const std::vector<double>& cash_flows, IrrStatus* status = nullptr,
+                               double guess = 0.0);
+
+// IRRs of num_schedules schedules of num_periods flows each, row-major (schedule s is
+// cash_flows[s * num_periods .. (s + 1) * num_periods)). Blocks of schedules are transposed
+// so one vectorized Newton iteration, started from a rate of 0, updates a whole block;
+// schedules it cannot solve go through the bracketing fallback. Writes out[0..num_schedules)
+// and, when status is not null, the outcome of each solve.
+void internal_rate_of_return_batch(const double* cash_flows, size_t num_schedules, size_t num_periods,
+                                   double* out, IrrStatus* status = nullptr);
+
+// Discount factors of num_curves scenario curves at num_times times into a
+// (num_times x num_curves) row-major matrix: out[k * num_curves + j] = P_j(0, times[k])
+void discount_factor_matrix(const DiscountCurve* curves, size_t num_curves, const double* times, size_t num_times,
+                            double* out);
+
+// Present values of num_schedules cash-flow schedules under num_scenarios scenarios, all
+// on a common grid of num_times payment times:
+//     out[s * num_scenarios + j] = sum_k cash_flows[s * num_times + k] * discount_factors[k * num_scenarios + j]
+// i.e. the matrix product of the (schedules x times) flows and the (times x scenarios)
+// discount factors, as from discount_factor_matrix. The product is blocked over times and
+// scenarios so a panel of discount factors stays in cache while every schedule streams past it.
+void present_value_matrix(const double* cash_flows, size_t num_schedules, size_t num_times,
+                          const double* discount_factors, size_t num_scenarios, double* out);
+
+// Same, with blocks of schedules spread across the pool's threads
+void parallel_present_value_matrix(const double* cash_flows, size_t num_schedules, size_t num_times,
+                                   const double* discount_factors, size_t num_scenarios, double* out,
+                                   ThreadPool& pool = default_thread_pool());
+
+#endif // CASH_FLOWS_H
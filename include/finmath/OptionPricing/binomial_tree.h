@@ -1,8 +1,40 @@
 #ifndef BINOMIAL_TREE_H
 #define BINOMIAL_TREE_H
 
+#include <vector>
+
 #include "options_pricing_types.h"
 
+// When the holder may exercise: only at expiry, at every step, or at listed dates
+enum class ExerciseStyle {EUROPEAN, AMERICAN, BERMUDAN};
+
+// Lattice variants:
+//   CRR  - plain Cox-Ross-Rubinstein tree
+//   BBS  - binomial Black-Scholes: the last step uses Black-Scholes values, which removes the
+//          odd/even oscillation of CRR
+//   BBSR - BBS with two-point Richardson extrapolation, 2 * BBS(N) - BBS(N / 2); odd N rounds down
+enum class BinomialMethod {CRR, BBS, BBSR};
+
+// European option on a CRR tree with N steps
 double binomial_option_pricing(OptionType type, double S0, double K, double T, double r, double sigma, long N);
 
+// Backward-induction lattice pricer with early exercise. Uses O(N) memory and O(N^2) time.
+// For BERMUDAN, exercise_times lists the exercise dates in years (each mapped to the nearest
+// step); they are ignored for the other styles.
+double binomial_lattice_pricing(OptionType type, ExerciseStyle style, double S0, double K, double T, double r,
+                                double sigma, long N, BinomialMethod method = BinomialMethod::CRR,
+                                const std::vector<double>& exercise_times = {});
+
+// Same with Real = float or double node values (explicitly instantiated). The tree
+// parameters are derived in double either way; float halves the memory and doubles the
+// SIMD width of the O(N^2) rollback. Arguments must all be Real; mixed or integer
+// arguments resolve to the double overloads above.
+template <typename Real>
+Real binomial_option_pricing(OptionType type, Real S0, Real K, Real T, Real r, Real sigma, long N);
+
+template <typename Real>
+Real binomial_lattice_pricing(OptionType type, ExerciseStyle style, Real S0, Real K, Real T, Real r, Real sigma,
+                              long N, BinomialMethod method = BinomialMethod::CRR,
+                              const std::vector<double>& exercise_times = {});
+
 #endif
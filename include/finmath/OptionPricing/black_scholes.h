@@ -1,8 +1,39 @@
 #ifndef BLACK_SCHOLES_H
 #define BLACK_SCHOLES_H
 
+#include <cstddef>
+
 #include "options_pricing_types.h"
 
+// Intermediate quantities shared by the price and the Greeks
+struct BlackScholesTerms {
+    double d1;
+    double d2;
+    double sqrt_time;
+    double discount;  // e^{-rate * time}
+};
+
+BlackScholesTerms black_scholes_terms(double strike, double price, double time, double rate, double volatility);
+
 double black_scholes(OptionType type, double strike, double price, double time, double rate, double volatility);
 
+// Same in Real = float or double arithmetic (explicitly instantiated). Arguments must all be
+// Real; mixed or integer arguments resolve to the double overload above.
+template <typename Real>
+Real black_scholes(OptionType type, Real strike, Real price, Real time, Real rate, Real volatility);
+
+// Price n options given as structure-of-arrays inputs, writing the prices to out[0..n).
+// Uses AVX-512 or AVX2 kernels when the CPU supports them (see active_simd_level) and
+// falls back to black_scholes() otherwise; SIMD results agree with black_scholes() to
+// about 1e-13 absolute (see OptionPricing/docs.md).
+void black_scholes_batch(const OptionType* types, const double* strikes, const double* prices,
+                         const double* times, const double* rates, const double* volatilities,
+                         double* out, size_t n);
+
+// float inputs and outputs: twice the lanes per vector (8 on AVX2, 16 on AVX-512) and half
+// the memory traffic, at about 1e-6 relative accuracy
+void black_scholes_batch(const OptionType* types, const float* strikes, const float* prices,
+                         const float* times, const float* rates, const float* volatilities,
+                         float* out, size_t n);
+
 #endif //BLACK_SCHOLES_H
@@ -0,0 +1,60 @@
+#ifndef FINITE_DIFFERENCE_H
+#define FINITE_DIFFERENCE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "finmath/OptionPricing/binomial_tree.h"
+#include "options_pricing_types.h"
+
+// How the early-exercise constraint V >= payoff is imposed at each time step
+enum class ExerciseSolver {
+    BRENNAN_SCHWARTZ,  // projected Thomas sweep: exact for puts and calls, one direct solve per step
+    PSOR,              // projected successive over-relaxation, iterated to convergence
+};
+
+struct FiniteDifferenceSettings {
+    size_t space_steps = 200;     // price grid intervals (of the fine grid when extrapolating)
+    size_t time_steps = 100;
+    size_t rannacher_steps = 2;   // first Crank-Nicolson steps replaced by two implicit half steps each
+    double concentration = 0.35;  // width of the node cluster around the strike, in units of sigma sqrt(T) in log S
+    double std_devs = 4.0;        // grid reaches this many sigma sqrt(T) in log S beyond S0 and K
+    ExerciseSolver exercise_solver = ExerciseSolver::BRENNAN_SCHWARTZ;
+    bool extrapolate = true;      // Richardson-combine this grid with one of half the steps
+};
+
+// Price and Greeks read off the grid at S0. Theta is per year of calendar time (d/dt).
+struct FiniteDifferenceResult {
+    double price;
+    double delta;
+    double gamma;
+    double theta;
+};
+
+// Function to price a European, American or Bermudan option by solving the Black-Scholes
+// PDE with Crank-Nicolson time stepping. The first steps are Rannacher-smoothed (implicit
+// half steps), which damps the oscillations the payoff kink would otherwise leave in
+// gamma. The price grid is uniform in a sinh map of log(S / K), which clusters nodes around
+// the strike, and is shifted so that S0 is a node. For AMERICAN a coarser solve first
+// locates the exercise boundary at t = 0 and a second cluster is put there; otherwise the
+// error jumps with where the boundary falls between nodes and the extrapolation below gains
+// little. Delta and gamma are the grid's difference quotients at S0 and theta follows from
+// the PDE. The tridiagonal system is factorized once per step size and its buffers are
+// reused per thread, so repeated calls do not allocate. For BERMUDAN, exercise_times lists
+// the exercise dates in years; the time steps are laid out to end on each date (dates
+// outside [0, T) are dropped), and exercise_solver is not used since exercise happens at
+// single instants. exercise_times is ignored for the other styles.
+//
+// Second order in both steps. American time steps are uniform in sqrt(T - t), which keeps
+// them second order despite the early-exercise boundary moving as sqrt(T - t) near expiry.
+// With extrapolate the problem is also solved on a grid of half the price and time steps
+// (odd counts round down) and every field is returned as (4 fine - coarse) / 3. Against
+// converged prices of American puts with K = 100, S0 in [60, 130], T in [0.1, 5], sigma in
+// [0.1, 0.9] and r in {5%, 10%}, the default grid is within 1.3e-4 (errors over 1e-4 only
+// for sigma = 0.9, T = 5) and 400 x 200 steps within 5e-5, at about four times the cost.
+FiniteDifferenceResult finite_difference_pricing(OptionType type, ExerciseStyle style, double S0, double K, double T,
+                                                 double r, double sigma,
+                                                 const FiniteDifferenceSettings& settings = FiniteDifferenceSettings(),
+                                                 const std::vector<double>& exercise_times = {});
+
+#endif // FINITE_DIFFERENCE_H
@@ -0,0 +1,33 @@
+#ifndef GREEKS_H
+#define GREEKS_H
+
+#include <cstddef>
+
+#include "options_pricing_types.h"
+
+// Black-Scholes price with its first- and second-order sensitivities. Vega, vanna and
+// volga are per unit of volatility (1.0 = 100 vol points), rho per unit of rate, and
+// theta, charm and veta per year of calendar time (d/dt = -d/dT).
+struct Greeks {
+    double price;
+    double delta;   // dV/dS
+    double gamma;   // d2V/dS2
+    double vega;    // dV/dsigma
+    double theta;   // dV/dt
+    double rho;     // dV/dr
+    double vanna;   // d2V/dS dsigma
+    double volga;   // d2V/dsigma2
+    double charm;   // d2V/dS dt
+    double veta;    // d2V/dsigma dt
+};
+
+// Price and Greeks of one option from a single d1/d2 evaluation
+Greeks black_scholes_greeks(OptionType type, double strike, double price, double time, double rate, double volatility);
+
+// Price and Greeks of n options given as structure-of-arrays inputs, writing to out[0..n).
+// Dispatches to the same SIMD kernels as black_scholes_batch.
+void black_scholes_greeks_batch(const OptionType* types, const double* strikes, const double* prices,
+                                const double* times, const double* rates, const double* volatilities,
+                                Greeks* out, size_t n);
+
+#endif // GREEKS_H
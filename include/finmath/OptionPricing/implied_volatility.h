@@ -0,0 +1,32 @@
+#ifndef IMPLIED_VOLATILITY_H
+#define IMPLIED_VOLATILITY_H
+
+#include <cstddef>
+
+#include "options_pricing_types.h"
+
+// Outcome of an implied volatility solve
+enum class ImpliedVolStatus {
+    CONVERGED,        // volatility reproduces the price to machine precision
+    MAX_ITERATIONS,   // best estimate after the iteration limit
+    BELOW_INTRINSIC,  // price below the discounted intrinsic value; volatility is NaN
+    ABOVE_MAXIMUM,    // price at or above the spot (call) or discounted strike (put); volatility is NaN
+    INVALID_INPUT,    // non-positive or non-finite strike, spot or time, or non-finite price or rate
+};
+
+// Function to find the Black-Scholes volatility that reproduces option_price. The price is
+// turned into an out-of-the-money normalised price, a rational/asymptotic initial guess
+// is taken on the side of the inflection point it falls on, and third-order Householder
+// steps (vega and its derivatives in closed form) run inside a bracket, usually 2-4 of them.
+// A price equal to the intrinsic value gives 0. Returns NaN when there is no solution;
+// the reason is written to *status when status is not null.
+double implied_volatility(OptionType type, double option_price, double strike, double price, double time,
+                          double rate, ImpliedVolStatus* status = nullptr);
+
+// Implied volatilities of n options given as structure-of-arrays inputs, writing to
+// out[0..n) and, when status is not null, the outcome of each solve to status[0..n)
+void implied_volatility_batch(const OptionType* types, const double* option_prices, const double* strikes,
+                              const double* prices, const double* times, const double* rates, double* out,
+                              ImpliedVolStatus* status, size_t n);
+
+#endif // IMPLIED_VOLATILITY_H
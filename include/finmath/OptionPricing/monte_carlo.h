@@ -0,0 +1,40 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "finmath/Helper/thread_pool.h"
+#include "options_pricing_types.h"
+
+// Source of the random inputs
+enum class RandomSource {
+    PHILOX,  // Philox4x32-10 counter-based streams keyed by (path, step)
+    SOBOL,   // Sobol points (digitally shifted by the seed) with Brownian bridge construction
+};
+
+struct MonteCarloSettings {
+    size_t paths = 100000;  // rounded up to a multiple of 64
+    size_t steps = 252;     // monitoring dates; at most 1111 with SOBOL
+    uint64_t seed = 42;
+    RandomSource source = RandomSource::PHILOX;
+    bool antithetic = false;       // pair every path with its mirror image (-z)
+    bool control_variate = false;  // regress on the European payoff, priced by black_scholes
+};
+
+struct MonteCarloResult {
+    double price;
+    double std_error;  // standard error of the estimate (of the sample spread for SOBOL)
+    size_t paths;      // number of paths simulated
+};
+
+// Function to price a path-dependent option by Monte Carlo simulation. Paths are split
+// into fixed blocks whose random numbers depend only on the seed and the path index, so
+// the result is identical for any thread count. The path kernels use AVX2/AVX-512 when
+// available. `barrier` is only read by the barrier payoffs.
+MonteCarloResult monte_carlo_price(OptionType type, PathPayoff payoff, double S0, double K, double T, double r,
+                                   double sigma, double barrier = 0.0,
+                                   const MonteCarloSettings& settings = MonteCarloSettings(),
+                                   ThreadPool& pool = default_thread_pool());
+
+#endif // MONTE_CARLO_H
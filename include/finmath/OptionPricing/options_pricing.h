@@ -7,5 +7,15 @@
 
 #include "finmath/OptionPricing/black_scholes.h"
 #include "finmath/OptionPricing/binomial_tree.h"
+#include "finmath/OptionPricing/finite_difference.h"
+#include "finmath/OptionPricing/greeks.h"
+#include "finmath/OptionPricing/implied_volatility.h"
+#include "finmath/OptionPricing/monte_carlo.h"
+#include "finmath/OptionPricing/parallel_pricing.h"
+#include "finmath/OptionPricing/pricing_cache.h"
+#include "finmath/OptionPricing/pricing_service.h"
+#include "finmath/OptionPricing/scenario_engine.h"
+#include "finmath/OptionPricing/trinomial_tree.h"
+#include "finmath/OptionPricing/vol_surface.h"
 
 #endif //OPTIONS_PRICING_H
@@ -7,4 +7,19 @@
 
 enum class OptionType {CALL, PUT};
 
+// Payoffs observed on `steps` equally spaced dates t_k = k T / steps, k = 1..steps,
+// under geometric Brownian motion. Calls and puts follow OptionType. Barriers and
+// lookback extremes also see the starting spot S0.
+enum class PathPayoff {
+    EUROPEAN,           // max(S_T - K, 0) / max(K - S_T, 0)
+    ASIAN_ARITHMETIC,   // strike K against the arithmetic mean of S(t_1..t_n)
+    ASIAN_GEOMETRIC,    // strike K against the geometric mean of S(t_1..t_n)
+    UP_AND_OUT,         // European payoff, lost if any S(t_k) >= barrier
+    UP_AND_IN,          // European payoff, paid only if some S(t_k) >= barrier
+    DOWN_AND_OUT,       // European payoff, lost if any S(t_k) <= barrier
+    DOWN_AND_IN,        // European payoff, paid only if some S(t_k) <= barrier
+    LOOKBACK_FIXED,     // max(S_max - K, 0) / max(K - S_min, 0)
+    LOOKBACK_FLOATING,  // S_T - S_min / S_max - S_T; K is ignored
+};
+
 #endif //OPTIONS_PRICING_TYPES_H
@@ -0,0 +1,32 @@
+#ifndef PARALLEL_PRICING_H
+#define PARALLEL_PRICING_H
+
+#include <cstddef>
+
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/OptionPricing/binomial_tree.h"
+#include "finmath/OptionPricing/implied_volatility.h"
+#include "options_pricing_types.h"
+
+// Multithreaded portfolio pricing. Inputs are structure-of-arrays and out[i] always
+// holds the price of contract i, so results do not depend on the thread count.
+
+// Black-Scholes prices of n options; each worker runs black_scholes_batch on its chunk
+void parallel_price(const OptionType* types, const double* strikes, const double* prices, const double* times,
+                    const double* rates, const double* volatilities, double* out, size_t n,
+                    ThreadPool& pool = default_thread_pool());
+
+// Binomial lattice prices of n options with a common exercise style, step count and method.
+// Contracts are handed out one at a time, so long-dated and short-dated names balance out.
+void parallel_binomial_price(const OptionType* types, const double* strikes, const double* prices,
+                             const double* times, const double* rates, const double* volatilities,
+                             ExerciseStyle style, long N, BinomialMethod method, double* out, size_t n,
+                             ThreadPool& pool = default_thread_pool());
+
+// Implied volatilities of n quoted prices, with the outcome of each solve in status[i]
+// when status is not null (see implied_volatility)
+void parallel_implied_volatility(const OptionType* types, const double* option_prices, const double* strikes,
+                                 const double* prices, const double* times, const double* rates, double* out,
+                                 ImpliedVolStatus* status, size_t n, ThreadPool& pool = default_thread_pool());
+
+#endif // PARALLEL_PRICING_H
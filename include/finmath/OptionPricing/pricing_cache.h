@@ -0,0 +1,101 @@
+#ifndef PRICING_CACHE_H
+#define PRICING_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "binomial_tree.h"
+#include "options_pricing_types.h"
+
+// Hit / miss counters of a PricingCache, summed over its shards
+struct PricingCacheStats {
+    uint64_t hits;
+    uint64_t misses;     // lookups that ran the pricer, including those the cache could not store
+    uint64_t evictions;  // entries dropped to make room, by resize() included
+    size_t size;         // entries held now
+    size_t capacity;
+
+    double hit_rate() const { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses); }
+};
+
+// Opt-in memo of pricer results for workloads that quote the same contracts again and again
+// (scenario sweeps, many clients on one book). Prices are keyed on the pricer, the option and
+// lattice settings (for black_scholes, the normal_accuracy() tier), and the inputs snapped to
+// a grid:
+//   tolerance = 0  inputs match bit for bit
+//   tolerance > 0  spot, strike, time and volatility are rounded to a relative grid (steps of
+//                  tolerance to 2 tolerance of the value) and the rate to multiples of
+//                  tolerance. The pricer runs on the snapped inputs, so a price depends only
+//                  on its grid cell, never on which caller filled it.
+// The cache is split into shards chosen by key hash, each an LRU list behind its own mutex,
+// so threads quoting different contracts rarely contend. A shard's lock is not held while the
+// pricer runs; two threads missing the same key at once both price it and the second result
+// is kept. NaN inputs bypass the cache. All member functions are safe to call concurrently.
+class PricingCache {
+public:
+    // Room for `capacity` prices (rounded up to a multiple of the shard count). num_shards = 0
+    // picks four per hardware thread; the count is rounded up to a power of two. capacity = 0
+    // disables storage, so every call is a miss. Throws std::invalid_argument unless
+    // 0 <= tolerance < 0.25.
+    explicit PricingCache(size_t capacity = 65536, double tolerance = 0.0, size_t num_shards = 0);
+    ~PricingCache();
+
+    PricingCache(const PricingCache&) = delete;
+    PricingCache& operator=(const PricingCache&) = delete;
+
+    // Cached forms of the pricers of the same names. A BERMUDAN lattice call with exercise
+    // times is not cached, since the key does not cover the dates.
+    double black_scholes(OptionType type, double strike, double price, double time, double rate, double volatility);
+    double binomial_option_pricing(OptionType type, double S0, double K, double T, double r, double sigma, long N);
+    double binomial_lattice_pricing(OptionType type, ExerciseStyle style, double S0, double K, double T, double r,
+                                    double sigma, long N, BinomialMethod method = BinomialMethod::CRR,
+                                    const std::vector<double>& exercise_times = {});
+
+    PricingCacheStats stats() const;
+    void reset_stats();
+
+    // Drop every entry (counters are kept)
+    void clear();
+
+    // Change the capacity, evicting least recently used entries down to the new size
+    void resize(size_t capacity);
+
+    size_t capacity() const { return capacity_.load(std::memory_order_relaxed); }
+    size_t shard_count() const { return shards_.size(); }
+    double tolerance() const { return tolerance_; }
+
+private:
+    // The pricer and its settings, the step count and the snapped inputs, with their hash
+    struct Key {
+        uint64_t words[7];
+        uint64_t hash;
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+    };
+
+    struct Shard;
+
+    // Price for key, running price() on a miss
+    template <typename Pricer>
+    double lookup(const Key& key, Pricer price);
+
+    static Key make_key(uint64_t tag, long steps, const double (&inputs)[5]);
+    double snap_relative(double x) const;
+    double snap_absolute(double x) const;
+
+    double tolerance_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    unsigned shard_bits_;
+    std::atomic<size_t> capacity_;
+};
+
+// Process-wide cache for callers that share one (65536 entries, exact keys)
+PricingCache& default_pricing_cache();
+
+#endif // PRICING_CACHE_H
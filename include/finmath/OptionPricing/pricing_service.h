@@ -0,0 +1,135 @@
+#ifndef PRICING_SERVICE_H
+#define PRICING_SERVICE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "finmath/Helper/thread_pool.h"
+#include "binomial_tree.h"
+#include "options_pricing_types.h"
+
+// Pricers a PricingService can dispatch to
+enum class PricingRequestKind {BLACK_SCHOLES, IMPLIED_VOLATILITY, BINOMIAL};
+
+// One pricing request. volatility is read by BLACK_SCHOLES and BINOMIAL, option_price by
+// IMPLIED_VOLATILITY, and style, steps and method by BINOMIAL only. There are no exercise
+// dates, so a BERMUDAN lattice request is priced as binomial_lattice_pricing prices one
+// without any.
+struct PricingRequest {
+    PricingRequestKind kind = PricingRequestKind::BLACK_SCHOLES;
+    OptionType type = OptionType::CALL;
+    double strike = 0.0;
+    double price = 0.0;  // spot
+    double time = 0.0;
+    double rate = 0.0;
+    double volatility = 0.0;
+    double option_price = 0.0;
+    ExerciseStyle style = ExerciseStyle::EUROPEAN;
+    long steps = 0;
+    BinomialMethod method = BinomialMethod::CRR;
+};
+
+struct PricingServiceSettings {
+    // A batch is dispatched once it holds this many requests ...
+    size_t max_batch_size = 256;
+    // ... or once its oldest request has waited this long
+    std::chrono::microseconds max_delay{50};
+};
+
+// Counters of a PricingService since construction
+struct PricingServiceStats {
+    uint64_t requests;          // requests priced
+    uint64_t batches;           // batches dispatched
+    uint64_t full_batches;      // batches dispatched because they reached max_batch_size
+    uint64_t deadline_batches;  // batches dispatched because the oldest request hit max_delay
+    size_t largest_batch;
+
+    double average_batch_size() const { return batches == 0 ? 0.0 : static_cast<double>(requests) / batches; }
+};
+
+// In-process asynchronous front end for many small pricing requests, e.g. from the handlers
+// of an RPC server. submit() pushes a request onto a lock-free multi-producer queue and
+// returns a future. One dispatcher thread drains the queue into a batch until the batch is
+// full or its oldest request has waited max_delay, sleeping on a condition variable while
+// the queue is empty, then prices it with the batch kernels: black_scholes_batch and
+// implied_volatility_batch on the dispatcher, lattices through parallel_binomial_price on
+// the pool, grouped by style, steps and method. A request's result does not depend on what
+// it was batched with: lattice and implied volatility results are the single-request
+// pricers', Black-Scholes prices agree with black_scholes() to about 1e-13 absolute, and
+// invalid inputs give NaN. A kernel call that throws sets its exception on the futures of
+// the rows it was pricing (one kind, or one lattice group) and the rest of the batch is
+// delivered. This trades up to max_delay of latency for the batch kernels' throughput once
+// requests arrive faster than they can be priced one by one.
+//
+// submit() may be called from any number of threads. The destructor prices everything
+// already submitted before it returns.
+class PricingService {
+public:
+    // The pool runs the lattice batches and must outlive the service. Throws
+    // std::invalid_argument for a max_batch_size of 0 or a negative max_delay.
+    explicit PricingService(const PricingServiceSettings& settings = PricingServiceSettings(),
+                            ThreadPool& pool = default_thread_pool());
+    ~PricingService();
+
+    PricingService(const PricingService&) = delete;
+    PricingService& operator=(const PricingService&) = delete;
+
+    std::future<double> submit(const PricingRequest& request);
+
+    // Shorthands building the request for the pricers of the same names
+    std::future<double> black_scholes(OptionType type, double strike, double price, double time, double rate,
+                                      double volatility);
+    std::future<double> implied_volatility(OptionType type, double option_price, double strike, double price,
+                                           double time, double rate);
+    std::future<double> binomial_lattice_pricing(OptionType type, ExerciseStyle style, double S0, double K,
+                                                 double T, double r, double sigma, long N,
+                                                 BinomialMethod method = BinomialMethod::CRR);
+
+    PricingServiceStats stats() const;
+
+    const PricingServiceSettings& settings() const { return settings_; }
+
+private:
+    struct Pending;
+    struct Node;
+    struct Batch;
+
+    // Vyukov's intrusive MPSC queue: producers swap their node in at head_, the dispatcher
+    // follows next links from tail_, which always points at an already consumed node.
+    // pop() returns false when the queue is empty or the next node is not linked yet.
+    void push(Node* node);
+    bool pop(Pending& pending);
+
+    void dispatch_loop();
+    void price(Batch& batch);
+
+    PricingServiceSettings settings_;
+    ThreadPool& pool_;
+
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) Node* tail_;
+
+    // The dispatcher sleeps on wake_ when the queue is empty, until a push or, with a batch
+    // open, its deadline; producers only take wake_mutex_ when sleeping_ is set
+    std::atomic<bool> sleeping_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> stopping_;
+
+    std::atomic<uint64_t> requests_;
+    std::atomic<uint64_t> batches_;
+    std::atomic<uint64_t> full_batches_;
+    std::atomic<uint64_t> deadline_batches_;
+    std::atomic<size_t> largest_batch_;
+
+    std::thread dispatcher_;
+};
+
+#endif // PRICING_SERVICE_H
@@ -0,0 +1,49 @@
+#ifndef SCENARIO_ENGINE_H
+#define SCENARIO_ENGINE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/OptionPricing/binomial_tree.h"
+#include "options_pricing_types.h"
+
+// Shocks spanning a stress grid. Cell (t, v, s) revalues every position at spot
+// S (1 + spot_shocks[s]), volatility sigma + vol_shocks[v] (floored at zero) and time to
+// expiry T - time_shifts[t]; positions past expiry are worth their intrinsic value.
+struct StressGrid {
+    std::vector<double> spot_shocks;   // relative, e.g. -0.2 .. 0.2
+    std::vector<double> vol_shocks;    // absolute, e.g. -0.1 .. 0.1
+    std::vector<double> time_shifts;   // years elapsed, e.g. 0, 1 / 252, ...
+
+    size_t cells() const { return spot_shocks.size() * vol_shocks.size() * time_shifts.size(); }
+};
+
+enum class ScenarioModel {BLACK_SCHOLES, BINOMIAL};
+
+// How positions are revalued. The lattice settings apply to BINOMIAL only; Bermudan
+// exercise_times are in years from today and move closer as time is shifted.
+struct ScenarioSettings {
+    ScenarioModel model = ScenarioModel::BLACK_SCHOLES;
+    ExerciseStyle style = ExerciseStyle::EUROPEAN;
+    long steps = 200;
+    BinomialMethod method = BinomialMethod::CRR;
+    std::vector<double> exercise_times;
+};
+
+// Function to compute the P&L cube of a portfolio over a stress grid, summed by book:
+//   out[((b * times + t) * vols + v) * spots + s] = sum over positions i in book b of
+//       quantities[i] * (value of i in cell (t, v, s) - value of i today)
+// books[i] < num_books gives the book of position i; books = nullptr puts every position in
+// book 0. Shock-independent terms (log-moneyness, sqrt(T), discount factors, lattice node
+// prices) are computed once per position rather than per cell: a binomial lattice is built
+// once per (time, vol) cell and rolled back for every spot shock. Blocks of cells are spread
+// over the pool and each cell sums its positions in input order, so the cube is the same for
+// any thread count. Black-Scholes values use the HIGH normal CDF of the SIMD kernels.
+// Invalid inputs print an error and fill out with NaN.
+void scenario_pnl(const OptionType* types, const double* strikes, const double* prices, const double* times,
+                  const double* rates, const double* volatilities, const double* quantities, const size_t* books,
+                  size_t n, size_t num_books, const StressGrid& grid, double* out,
+                  const ScenarioSettings& settings = ScenarioSettings(), ThreadPool& pool = default_thread_pool());
+
+#endif // SCENARIO_ENGINE_H
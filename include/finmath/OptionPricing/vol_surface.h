@@ -0,0 +1,134 @@
+#ifndef VOL_SURFACE_H
+#define VOL_SURFACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "options_pricing_types.h"
+
+// How a VolSurface fills in between its quotes
+enum class VolInterpolation {
+    BICUBIC,  // bicubic Hermite patches in total variance over (log strike, expiry)
+    SVI,      // one raw SVI smile per expiry, linear in total variance between expiries
+};
+
+// Raw SVI smile in log strike k = ln K: total variance w(k) = a + b (rho (k - m) + sqrt((k - m)^2 + sigma^2)).
+// SVI is usually written in log-moneyness ln(K / F); a fixed forward only shifts m, so each
+// expiry's slice is fitted in log strike directly.
+struct SviParameters {
+    double a;
+    double b;
+    double rho;
+    double m;
+    double sigma;
+};
+
+// A changed quote: grid position and new implied volatility
+struct VolQuote {
+    size_t strike_index;
+    size_t expiry_index;
+    double volatility;
+};
+
+// Implied volatility surface built from a strike x expiry grid of quotes. Interpolation
+// runs on total variance w = sigma^2 T, with
+//   BICUBIC  a Hermite patch per grid cell, node slopes taken from finite differences of
+//            the neighbouring quotes, so each patch depends only on nearby quotes
+//   SVI      a raw SVI fit per expiry (least squares in total variance), and linear
+//            interpolation in total variance between expiries at a fixed strike
+// Every patch or slice is reduced to a small coefficient table when the surface is built,
+// and each axis keeps a bucket index over its nodes, so a lookup finds its cell in O(1)
+// and evaluates one polynomial (BICUBIC) or two square roots (SVI).
+//
+// Outside the grid, volatility is held flat: BICUBIC clamps the strike to the quoted range
+// (SVI follows its wings), and before the first or after the last expiry w scales with T.
+// No arbitrage checks are made; negative total variance is floored at 0.
+//
+// update() changes a few quotes and rebuilds only what depends on them: the patches within
+// two cells of each quote (BICUBIC), giving bit for bit the surface a full build would, or
+// the slices of the changed expiries (SVI), refitted starting from their current parameters.
+//
+// Lookups are const and safe to run concurrently; update() must not overlap them.
+class VolSurface {
+public:
+    // strikes and expiries must be positive and strictly increasing, and volatilities hold
+    // expiries.size() rows of strikes.size() positive quotes (row j is expiry j). BICUBIC needs
+    // at least two strikes and two expiries, SVI at least five strikes and one expiry.
+    // Throws std::invalid_argument otherwise.
+    VolSurface(std::vector<double> strikes, std::vector<double> expiries, std::vector<double> volatilities,
+               VolInterpolation method = VolInterpolation::BICUBIC);
+
+    VolInterpolation method() const { return method_; }
+    const std::vector<double>& strikes() const { return strikes_; }
+    const std::vector<double>& expiries() const { return expiries_; }
+
+    // Quoted volatility at a grid point
+    double quote(size_t strike_index, size_t expiry_index) const;
+
+    // Interpolated volatility and total variance at a strike and time to expiry; NaN
+    // unless both are positive
+    double volatility(double strike, double time) const;
+    double total_variance(double strike, double time) const;
+
+    // Volatilities of n (strike, time) pairs into out[0..n), ready to pass to the pricers
+    void volatility_batch(const double* strikes, const double* times, double* out, size_t n) const;
+
+    // Replace some quotes and rebuild the parts of the surface that depend on them. Throws
+    // std::out_of_range for an index off the grid and std::invalid_argument for a volatility
+    // that is not positive and finite, in which case the surface is unchanged.
+    void update(size_t strike_index, size_t expiry_index, double volatility);
+    void update(const VolQuote* quotes, size_t n);
+
+    // Fitted smile of an expiry; throws std::logic_error unless the method is SVI
+    const SviParameters& svi_slice(size_t expiry_index) const;
+
+private:
+    // Nodes of one axis with a uniform bucket table: bucket b holds the first cell that
+    // can contain a point of the bucket, and buckets are no wider than the narrowest cell
+    // (up to a cap), so finding a cell takes at most a step or two
+    struct Axis {
+        std::vector<double> nodes;
+        std::vector<double> inverse_widths;  // 1 / (nodes[i + 1] - nodes[i])
+        std::vector<uint32_t> buckets;
+        double scale;  // buckets per unit
+
+        void build(std::vector<double> values);
+        size_t bucket(double x) const;
+        size_t cell(double x) const;  // x within [nodes.front(), nodes.back()]
+    };
+
+    void rebuild_node(size_t i, size_t j);
+    void rebuild_cell(size_t i, size_t j);
+    void fit_slice(size_t expiry_index, bool warm_start);
+    double bicubic_variance(double x, double time) const;
+    double svi_variance(double x, double time) const;
+
+    VolInterpolation method_;
+    std::vector<double> strikes_;
+    std::vector<double> expiries_;
+    std::vector<double> quotes_;    // volatilities, row j = expiry j
+    std::vector<double> variance_;  // total variance at each quote, same layout
+    Axis strike_axis_;              // over log strike
+    Axis expiry_axis_;
+
+    // BICUBIC: finite-difference weights of each node's neighbours (i - 1, i, i + 1) per axis,
+    // node slopes dw/dx, dw/dT and d2w/dxdT, and 16 coefficients per cell (cell (i, j) at
+    // 16 * (j * (strikes - 1) + i), c[4p + q] multiplying u^p v^q)
+    std::vector<double> strike_weights_;
+    std::vector<double> expiry_weights_;
+    std::vector<double> slope_x_;
+    std::vector<double> slope_t_;
+    std::vector<double> slope_xt_;
+    std::vector<double> coefficients_;
+
+    // SVI: one smile per expiry
+    std::vector<SviParameters> slices_;
+};
+
+// Function to price n options with each volatility looked up on a surface at the option's
+// strike and time, in chunks on the stack, so no volatility array is allocated
+void black_scholes_batch(const OptionType* types, const double* strikes, const double* prices,
+                         const double* times, const double* rates, const VolSurface& surface, double* out, size_t n);
+
+#endif // VOL_SURFACE_H
@@ -0,0 +1,98 @@
+#ifndef INDICATOR_PIPELINE_H
+#define INDICATOR_PIPELINE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/TimeSeries/parallel_indicators.h"
+
+// One indicator of a pipeline
+struct IndicatorSpec {
+    IndicatorType indicator;
+    size_t window_size;
+};
+
+// Receives count values of indicator k, output indices first .. first + count
+using IndicatorSink = std::function<void(size_t k, size_t first, const double* values, size_t count)>;
+
+// Set of indicators computed together over a panel of price series (one column per
+// ticker). Each column is walked once in cache-sized blocks: the prices of a block are
+// loaded once, the log returns and price changes are computed once and shared by all
+// volatility / RSI specs, and every indicator then advances its running state over the
+// block. Results are identical to calling simple_moving_average, rolling_volatility and
+// compute_rsi separately. EMA, DEMA, TEMA and WMA match the streaming RollingEMA, ...
+// classes exactly, and the moving_averages.h batch functions exactly under SCALAR and to
+// rounding with SIMD enabled. compute_rsi seeds its averages from the sum over the whole
+// series, so a pipeline containing RSI makes one extra read of each column for that sum.
+//
+// Output is columnar: for a column of n prices, column_size(n) values, in which indicator
+// k takes output_size(k, n) values starting at offset(k, n). An indicator whose window is
+// longer than the series produces no values.
+class IndicatorPipeline {
+public:
+    // Throws std::invalid_argument if indicators is empty or a window size is 0
+    explicit IndicatorPipeline(std::vector<IndicatorSpec> indicators);
+
+    const std::vector<IndicatorSpec>& indicators() const { return indicators_; }
+
+    // Values indicator k produces for a column of n prices
+    size_t output_size(size_t k, size_t n) const;
+
+    // Position of indicator k within the output of a column of n prices
+    size_t offset(size_t k, size_t n) const;
+
+    // Values all indicators produce for a column of n prices
+    size_t column_size(size_t n) const;
+
+    // Compute every indicator of prices[0..n) into out[0..column_size(n))
+    void compute(const double* prices, size_t n, double* out) const;
+
+    // Same over a panel of `columns` series of `rows` prices stored one after another
+    // (column c at panel + c * rows). Column c is written to out + c * column_size(rows),
+    // and columns are spread across the pool.
+    void compute(const double* panel, size_t rows, size_t columns, double* out,
+                 ThreadPool& pool = default_thread_pool()) const;
+
+    // One vector per indicator, in the order they were given
+    std::vector<std::vector<double>> compute(const std::vector<double>& prices) const;
+
+    // Same over prices[0..n) chunk_rows prices at a time, handing each chunk's values to sink
+    // in order, so only O(chunk_rows) outputs are held at once. The values are identical to
+    // compute() for any chunk size. Throws std::invalid_argument if chunk_rows is 0.
+    void compute_chunked(const double* prices, size_t n, size_t chunk_rows, const IndicatorSink& sink) const;
+
+private:
+    std::vector<IndicatorSpec> indicators_;
+};
+
+// Resumable run of a pipeline over prices[0..n). Each advance() continues the rolling
+// state where the previous one stopped, so a series can be processed in chunks of any
+// size with the same results as in one go. The windows read back up to window_size
+// prices before the current position, so all of prices[0..n) must stay addressable for
+// the lifetime of the cursor (a memory-mapped column qualifies; see series_store.h).
+class IndicatorCursor {
+public:
+    IndicatorCursor(const IndicatorPipeline& pipeline, const double* prices, size_t n);
+    ~IndicatorCursor();
+    IndicatorCursor(IndicatorCursor&&) noexcept;
+    IndicatorCursor& operator=(IndicatorCursor&&) noexcept;
+
+    // Prices consumed so far
+    size_t position() const;
+
+    // Values of indicator k produced so far
+    size_t produced(size_t k) const;
+
+    // Consume prices up to min(end, n). The new values of indicator k, output indices
+    // produced(k) onward, are written from outs[k][0]; at most end - position() + 1 of them.
+    void advance(size_t end, double* const* outs);
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+#endif // INDICATOR_PIPELINE_H
@@ -0,0 +1,110 @@
+#ifndef MOVING_AVERAGES_H
+#define MOVING_AVERAGES_H
+
+#include <cstddef>
+#include <vector>
+
+#include "finmath/Helper/scratch_arena.h"
+#include "finmath/TimeSeries/parallel_indicators.h"
+#include "finmath/TimeSeries/rolling_window.h"
+
+// Exponential moving averages use alpha = 2 / (span + 1) and are seeded, like Wilder's RSI,
+// with the simple mean of the first span values:
+//     EMA[span - 1] = (x[0] + ... + x[span - 1]) / span,  EMA[t] = EMA[t - 1] + alpha (x[t] - EMA[t - 1]).
+// DEMA = 2 E1 - E2 and TEMA = 3 (E1 - E2) + E3, where E1 is the EMA of the data, E2 the EMA
+// of E1 and E3 the EMA of E2, each seeded the same way; every level adds span - 1 values of
+// warm-up. WMA weights the last span values 1, 2, ..., span, the newest the most. Output i
+// of each belongs to the input at i + warm-up, so the outputs end with the last input.
+//
+// The batch EMA scan is vectorized over time: a block of SIMD-width values is computed as
+// one small matrix-vector product from the value before it, which leaves one multiply-add
+// of serial dependency per block instead of one per value. Results agree with the
+// streaming classes (RollingEMA, ...) to rounding, and exactly with set_simd_level(SCALAR).
+// WMA keeps a running sum and a running weighted sum, so each value costs O(1) whatever the
+// window; both are rebuilt from the window every rolling_resync_period(span) values.
+//
+// The pointer forms allocate their per-span kernels; each also takes a ScratchArena to draw
+// them from instead.
+
+// Number of values an EMA, DEMA, TEMA or WMA of n values produces
+inline size_t ema_output_size(size_t n, size_t span) {
+    return rolling_output_size(n, span);
+}
+
+inline size_t dema_output_size(size_t n, size_t span) {
+    return span == 0 ? 0 : rolling_output_size(n, 2 * span - 1);
+}
+
+inline size_t tema_output_size(size_t n, size_t span) {
+    return span == 0 ? 0 : rolling_output_size(n, 3 * span - 2);
+}
+
+inline size_t wma_output_size(size_t n, size_t span) {
+    return rolling_output_size(n, span);
+}
+
+// Function to compute the exponential moving average of a time series (float or double)
+template <typename Real>
+std::vector<Real> exponential_moving_average(const std::vector<Real>& data, size_t span);
+
+// Function to compute the exponential moving average of data[0..n) into out, which must hold
+// ema_output_size(n, span) values. Returns the number of values written.
+template <typename Real>
+size_t exponential_moving_average(const Real* data, size_t n, size_t span, Real* out);
+
+template <typename Real>
+size_t exponential_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena);
+
+// Function to compute the double exponential moving average of a time series
+template <typename Real>
+std::vector<Real> double_exponential_moving_average(const std::vector<Real>& data, size_t span);
+
+// Same into out, which must hold dema_output_size(n, span) values
+template <typename Real>
+size_t double_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out);
+
+template <typename Real>
+size_t double_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena);
+
+// Function to compute the triple exponential moving average of a time series
+template <typename Real>
+std::vector<Real> triple_exponential_moving_average(const std::vector<Real>& data, size_t span);
+
+// Same into out, which must hold tema_output_size(n, span) values
+template <typename Real>
+size_t triple_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out);
+
+template <typename Real>
+size_t triple_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena);
+
+// Function to compute the linearly weighted moving average of a time series
+template <typename Real>
+std::vector<Real> weighted_moving_average(const std::vector<Real>& data, size_t span);
+
+// Same into out, which must hold wma_output_size(n, span) values
+template <typename Real>
+size_t weighted_moving_average(const Real* data, size_t n, size_t span, Real* out);
+
+template <typename Real>
+size_t weighted_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena);
+
+// Function to compute one moving average (EMA, DEMA, TEMA or WMA) of data[0..n) for several
+// spans in one pass: the data is walked once in cache-sized blocks and every span advances
+// over each block while it is in cache. out[k] must hold indicator_output_size(indicator,
+// n, spans[k]) values; a span longer than the data produces none. Each result is identical
+// to the single-span function's.
+template <typename Real>
+void moving_averages(IndicatorType indicator, const Real* data, size_t n, const size_t* spans, size_t count,
+                     Real* const* out);
+
+// Same with the kernels drawn from arena
+template <typename Real>
+void moving_averages(IndicatorType indicator, const Real* data, size_t n, const size_t* spans, size_t count,
+                     Real* const* out, ScratchArena& arena);
+
+// Same, returning one vector per span
+template <typename Real>
+std::vector<std::vector<Real>> moving_averages(IndicatorType indicator, const std::vector<Real>& data,
+                                               const std::vector<size_t>& spans);
+
+#endif // MOVING_AVERAGES_H
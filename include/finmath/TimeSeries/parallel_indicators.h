@@ -0,0 +1,41 @@
+#ifndef PARALLEL_INDICATORS_H
+#define PARALLEL_INDICATORS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "finmath/Helper/scratch_arena.h"
+#include "finmath/Helper/thread_pool.h"
+
+// Indicators that parallel_indicators can compute
+enum class IndicatorType {SMA, VOLATILITY, RSI, EMA, DEMA, TEMA, WMA};
+
+// Number of values `indicator` produces for a series of n prices
+size_t indicator_output_size(IndicatorType indicator, size_t n, size_t window_size);
+
+// Function to compute one indicator of prices[0..n) into out, which must hold
+// indicator_output_size(indicator, n, window_size) values. Returns the number written.
+// Real is float or double.
+template <typename Real>
+size_t compute_indicator(IndicatorType indicator, const Real* prices, size_t n, size_t window_size, Real* out);
+
+// Same with any scratch the indicator needs drawn from arena: a loop that reuses one arena
+// over many series makes no heap allocations once the arena has grown to the longest
+template <typename Real>
+size_t compute_indicator(IndicatorType indicator, const Real* prices, size_t n, size_t window_size, Real* out,
+                         ScratchArena& arena);
+
+// Function to compute one indicator over many price series (e.g. one per ticker) across
+// the pool. result[i] is the indicator of series[i], identical to the single-threaded
+// simple_moving_average, rolling_volatility, compute_rsi, ... output.
+std::vector<std::vector<double>> parallel_indicators(const std::vector<std::vector<double>>& series,
+                                                     IndicatorType indicator, size_t window_size,
+                                                     ThreadPool& pool = default_thread_pool());
+
+// Same over caller-owned buffers: series[i] holds lengths[i] prices and out[i] must hold
+// indicator_output_size(indicator, lengths[i], window_size) values. Each worker thread draws
+// scratch from its own arena, kept between calls.
+void parallel_indicators(const double* const* series, const size_t* lengths, size_t count, IndicatorType indicator,
+                         size_t window_size, double* const* out, ThreadPool& pool = default_thread_pool());
+
+#endif // PARALLEL_INDICATORS_H
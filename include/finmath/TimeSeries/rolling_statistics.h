@@ -0,0 +1,299 @@
+#ifndef ROLLING_STATISTICS_H
+#define ROLLING_STATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "finmath/Helper/scratch_arena.h"
+#include "finmath/TimeSeries/rolling_window.h"
+
+// Rolling order statistics and higher moments, on the same windows as the other TimeSeries
+// functions: output i describes data[i .. i + window_size), so n values give
+// rolling_output_size(n, window_size) outputs. Data must not contain NaNs.
+//
+// - rolling_max / rolling_min keep a monotonic deque of the samples that can still become
+//   the extremum, O(1) amortized per value whatever the window.
+// - rolling_quantile keeps the window sorted in an indexable skip list, O(log window) per
+//   value, and interpolates linearly between order statistics (numpy.quantile's and
+//   pandas' default). rolling_quantiles serves several quantiles from one sorted window.
+// - rolling_skewness / rolling_kurtosis slide running sums of the first four powers of the
+//   samples, taken about a shift that is moved back to the window mean whenever the mean
+//   wanders from it, and apply the bias corrections of pandas' rolling().skew() and .kurt() (excess
+//   kurtosis). They need 3 and 4 samples per window; smaller windows give NaN.
+// - rolling_zscore is (x - mean) / sample standard deviation of the window ending at x.
+// A window whose variance is zero to rounding gives NaN skewness, kurtosis and z-score.
+//
+// The pointer forms of max, min and the quantiles allocate their window state; each also
+// takes a ScratchArena to draw it from instead, so a loop over many series that reuses
+// one arena stops allocating once the arena has grown. Skewness, kurtosis and z-score
+// never allocate.
+
+// Running maximum (Compare = std::greater<Real>) or minimum (std::less<Real>) of the last
+// window_size samples. Candidates are kept in a ring of window_size slots, each one beating
+// every candidate after it; a new sample evicts the candidates it ties or beats, and the
+// front leaves once it falls out of the window.
+template <typename Real, typename Compare>
+class MonotonicWindow {
+public:
+    // The candidate ring is drawn from resource (e.g. a ScratchArena)
+    explicit MonotonicWindow(size_t window_size = 0,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : values_(window_size, resource), positions_(window_size, resource), head_(0), size_(0), count_(0) {}
+
+    // Forget all samples, keeping the window size
+    void reset() {
+        head_ = 0;
+        size_ = 0;
+        count_ = 0;
+    }
+
+    void push(Real x) {
+        const size_t capacity = values_.size();
+        // Positions only grow, so at most the front can have left the window
+        if (size_ > 0 && positions_[head_] + capacity <= count_) {
+            head_ = head_ + 1 == capacity ? 0 : head_ + 1;
+            --size_;
+        }
+        while (size_ > 0 && !Compare()(values_[slot(size_ - 1)], x)) {
+            --size_;
+        }
+        size_t tail = slot(size_);
+        values_[tail] = x;
+        positions_[tail] = count_;
+        ++size_;
+        ++count_;
+    }
+
+    // Extremum of the last min(count(), window_size()) samples; needs count() > 0
+    Real value() const { return values_[head_]; }
+
+    size_t window_size() const { return values_.size(); }
+    size_t count() const { return count_; }
+    bool full() const { return count_ >= values_.size(); }
+
+private:
+    size_t slot(size_t i) const {
+        size_t index = head_ + i;
+        return index >= values_.size() ? index - values_.size() : index;
+    }
+
+    std::pmr::vector<Real> values_;
+    std::pmr::vector<size_t> positions_;
+    size_t head_;
+    size_t size_;
+    size_t count_;  // samples pushed since the last reset
+};
+
+// Multiset of at most `capacity` values kept sorted in an indexable skip list: insert(),
+// erase() and the value of a given rank take O(log capacity) expected time. Each link
+// records how many values it skips, which is what makes ranks searchable. Nodes come from a
+// pool allocated in the constructor, each with a height drawn once from a fixed-seed
+// geometric distribution, so updates never allocate and results are reproducible.
+// Instantiated for float and double.
+template <typename Real>
+class BasicOrderStatistics {
+public:
+    // Throws std::invalid_argument if capacity does not fit in 32 bits. The pool is drawn
+    // from resource (e.g. a ScratchArena).
+    explicit BasicOrderStatistics(size_t capacity = 0,
+                                  std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void clear();
+
+    // Add x; throws std::length_error if capacity() values are already held
+    void insert(Real x);
+
+    // Remove one copy of x, returning false if there is none
+    bool erase(Real x);
+
+    // The rank-th smallest value, rank < size()
+    Real operator[](size_t rank) const;
+
+    // q-quantile for q in [0, 1], interpolated linearly between the values of ranks
+    // floor(q (size - 1)) and the one after it; needs size() > 0
+    Real quantile(double q) const;
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return values_.size() - 1; }
+
+private:
+    struct Link {
+        uint32_t next;   // node the link leads to, kNil (the head) at the end of a level
+        uint32_t width;  // values passed along it
+    };
+
+    // Node holding the value of the given rank, and the links of a node
+    uint32_t node_at(size_t rank) const;
+    Link* links(uint32_t node) { return links_.data() + offsets_[node]; }
+    const Link* links(uint32_t node) const { return links_.data() + offsets_[node]; }
+
+    size_t levels_;
+    size_t size_;
+    std::pmr::vector<Real> values_;      // node values; node 0 is the head
+    std::pmr::vector<size_t> offsets_;   // first link of each node in links_
+    std::pmr::vector<uint8_t> heights_;  // levels each node takes part in
+    std::pmr::vector<Link> links_;
+    std::pmr::vector<uint32_t> free_;    // unused nodes
+    std::pmr::vector<uint32_t> chain_;   // scratch: last node before the insert / erase point per level
+    std::pmr::vector<size_t> steps_;     // scratch: values passed at each level on the way there
+};
+
+extern template class BasicOrderStatistics<float>;
+extern template class BasicOrderStatistics<double>;
+
+// Running sums of (x - shift)^k, k = 1..4, over a sliding window, from which the mean and
+// the second to fourth central moments follow. Used like BasicRollingMoments: push() while
+// the window fills, slide() once it is full, and resync() every rolling_resync_period slides
+// or as soon as drifted(), which rebuilds the sums about the current window mean. Keeping
+// the shift within a few standard deviations of the mean bounds the cancellation in the
+// central moments. Sums of floats are compensated.
+template <typename Real>
+class BasicRollingHigherMoments {
+public:
+    explicit BasicRollingHigherMoments(size_t window_size = 0);
+
+    // Forget all samples, keeping the window size
+    void reset();
+
+    // Add a sample while the window is still filling up; the first sets the shift
+    void push(Real x);
+
+    // Replace the oldest sample x_out with x_in once the window is full
+    void slide(Real x_in, Real x_out);
+
+    // Recompute exactly from the current window contents, about their mean
+    void resync(const Real* window, size_t count);
+
+    // Reinstate state captured from count(), shift() and power_sum(1..4)
+    void restore(size_t count, Real shift, Real sum1, Real sum2, Real sum3, Real sum4);
+
+    size_t window_size() const { return window_size_; }
+    size_t count() const { return count_; }
+    bool full() const { return count_ == window_size_; }
+
+    Real shift() const { return shift_; }
+
+    // Whether the window mean has moved more than two standard deviations from the shift
+    bool drifted() const;
+
+    // Sum of (x - shift)^k over the window, k = 1..4
+    Real power_sum(int k) const { return sums_[k - 1].value(); }
+
+    Real mean() const;
+
+    // Population variance of the samples in the window
+    Real variance() const;
+
+    // Adjusted Fisher-Pearson skewness, sqrt(n (n - 1)) / (n - 2) * m3 / m2^1.5
+    Real skewness() const;
+
+    // Bias-corrected excess kurtosis, ((n^2 - 1) m4 / m2^2 - 3 (n - 1)^2) / ((n - 2) (n - 3))
+    Real kurtosis() const;
+
+private:
+    // Central moments m2, m3, m4 (divided by n); false if the variance is zero to rounding
+    bool central_moments(Real& m2, Real& m3, Real& m4) const;
+
+    size_t window_size_;
+    size_t count_;
+    Real shift_;
+    CompensatedSum<Real> sums_[4];
+};
+
+extern template class BasicRollingHigherMoments<float>;
+extern template class BasicRollingHigherMoments<double>;
+
+// z-score of x, the newest sample of the window summarized by moments: (x - mean) over the
+// sample standard deviation. NaN for fewer than 2 samples or a variance zero to rounding.
+template <typename Real>
+Real window_zscore(const BasicRollingMoments<Real>& moments, Real x);
+
+// Function to compute the rolling maximum of a time series (float or double)
+template <typename Real>
+std::vector<Real> rolling_max(const std::vector<Real>& data, size_t window_size);
+
+// Function to compute the rolling maximum of data[0..n) into out, which must hold
+// rolling_output_size(n, window_size) values. Returns the number of values written.
+template <typename Real>
+size_t rolling_max(const Real* data, size_t n, size_t window_size, Real* out);
+
+// Same with the window state drawn from arena
+template <typename Real>
+size_t rolling_max(const Real* data, size_t n, size_t window_size, Real* out, ScratchArena& arena);
+
+// Function to compute the rolling minimum of a time series
+template <typename Real>
+std::vector<Real> rolling_min(const std::vector<Real>& data, size_t window_size);
+
+// Same into out, which must hold rolling_output_size(n, window_size) values
+template <typename Real>
+size_t rolling_min(const Real* data, size_t n, size_t window_size, Real* out);
+
+template <typename Real>
+size_t rolling_min(const Real* data, size_t n, size_t window_size, Real* out, ScratchArena& arena);
+
+// Function to compute the rolling q-quantile (0 <= q <= 1) of a time series
+template <typename Real>
+std::vector<Real> rolling_quantile(const std::vector<Real>& data, size_t window_size, double q);
+
+// Same into out, which must hold rolling_output_size(n, window_size) values
+template <typename Real>
+size_t rolling_quantile(const Real* data, size_t n, size_t window_size, double q, Real* out);
+
+template <typename Real>
+size_t rolling_quantile(const Real* data, size_t n, size_t window_size, double q, Real* out, ScratchArena& arena);
+
+// Function to compute the rolling median of a time series
+template <typename Real>
+std::vector<Real> rolling_median(const std::vector<Real>& data, size_t window_size);
+
+// Same into out, which must hold rolling_output_size(n, window_size) values
+template <typename Real>
+size_t rolling_median(const Real* data, size_t n, size_t window_size, Real* out);
+
+template <typename Real>
+size_t rolling_median(const Real* data, size_t n, size_t window_size, Real* out, ScratchArena& arena);
+
+// Function to compute several rolling quantiles of data[0..n) from one sorted window:
+// out[k] must hold rolling_output_size(n, window_size) values of quantile qs[k]. Returns
+// the number of values written to each.
+template <typename Real>
+size_t rolling_quantiles(const Real* data, size_t n, size_t window_size, const double* qs, size_t count,
+                         Real* const* out);
+
+template <typename Real>
+size_t rolling_quantiles(const Real* data, size_t n, size_t window_size, const double* qs, size_t count,
+                         Real* const* out, ScratchArena& arena);
+
+// Same, returning one vector per quantile
+template <typename Real>
+std::vector<std::vector<Real>> rolling_quantiles(const std::vector<Real>& data, size_t window_size,
+                                                 const std::vector<double>& qs);
+
+// Function to compute the rolling skewness of a time series
+template <typename Real>
+std::vector<Real> rolling_skewness(const std::vector<Real>& data, size_t window_size);
+
+// Same into out, which must hold rolling_output_size(n, window_size) values
+template <typename Real>
+size_t rolling_skewness(const Real* data, size_t n, size_t window_size, Real* out);
+
+// Function to compute the rolling excess kurtosis of a time series
+template <typename Real>
+std::vector<Real> rolling_kurtosis(const std::vector<Real>& data, size_t window_size);
+
+// Same into out, which must hold rolling_output_size(n, window_size) values
+template <typename Real>
+size_t rolling_kurtosis(const Real* data, size_t n, size_t window_size, Real* out);
+
+// Function to compute the rolling z-score of a time series
+template <typename Real>
+std::vector<Real> rolling_zscore(const std::vector<Real>& data, size_t window_size);
+
+// Same into out, which must hold rolling_output_size(n, window_size) values
+template <typename Real>
+size_t rolling_zscore(const Real* data, size_t n, size_t window_size, Real* out);
+
+#endif // ROLLING_STATISTICS_H
@@ -1,8 +1,12 @@
 #ifndef ROLLING_VOLATILITY_H
 #define ROLLING_VOLATILITY_H
 
+#include <cstddef>
 #include <vector>
 
+#include "finmath/Helper/scratch_arena.h"
+#include "finmath/TimeSeries/rolling_window.h"
+
 // Function to compute the logarithmic returns from prices
 std::vector<double> compute_log_returns(const std::vector<double>& prices);
 
@@ -12,4 +16,24 @@ double compute_std(const std::vector<double>& data);
 // Function to compute the rolling volatility from a time series of prices
 std::vector<double> rolling_volatility(const std::vector<double>& prices, size_t window_size);
 
+// Same for float or double prices; braced lists and other arguments that do not deduce Real
+// resolve to the double overload above
+template <typename Real>
+std::vector<Real> rolling_volatility(const std::vector<Real>& prices, size_t window_size);
+
+// Number of values rolling_volatility produces for n prices
+inline size_t rolling_volatility_output_size(size_t n, size_t window_size) {
+    return n < 2 ? 0 : rolling_output_size(n - 1, window_size);
+}
+
+// Function to compute the rolling volatility of prices[0..n) into out, which must hold
+// rolling_volatility_output_size(n, window_size) values. Returns the number of values written.
+template <typename Real>
+size_t rolling_volatility(const Real* prices, size_t n, size_t window_size, Real* out);
+
+// Same with the log returns drawn from arena, which is left as it was found; reusing one
+// arena across calls takes the heap out of a loop over many series
+template <typename Real>
+size_t rolling_volatility(const Real* prices, size_t n, size_t window_size, Real* out, ScratchArena& arena);
+
 #endif // ROLLING_VOLATILITY_H
@@ -0,0 +1,111 @@
+#ifndef ROLLING_WINDOW_H
+#define ROLLING_WINDOW_H
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// Running sum. For float each addition's rounding error is carried in a compensation
+// term (Neumaier's variant of Kahan summation), which keeps long float running sums
+// within a few ulps of the exact value; for double it is a plain sum, so the double
+// kernels keep their results bit for bit.
+template <typename Real>
+class CompensatedSum {
+public:
+    explicit CompensatedSum(Real value = 0) : sum_(value), compensation_(0) {}
+
+    void add(Real x) {
+        if constexpr (std::is_same<Real, float>::value) {
+            Real t = sum_ + x;
+            if (std::abs(sum_) >= std::abs(x)) {
+                compensation_ += (sum_ - t) + x;
+            } else {
+                compensation_ += (x - t) + sum_;
+            }
+            sum_ = t;
+        } else {
+            sum_ += x;
+        }
+    }
+
+    Real value() const {
+        if constexpr (std::is_same<Real, float>::value) {
+            return sum_ + compensation_;
+        } else {
+            return sum_;
+        }
+    }
+
+private:
+    Real sum_;
+    Real compensation_;
+};
+
+// Running mean and variance over a fixed-size sliding window (Welford update).
+// Samples enter with push() until the window is full; after that slide() swaps
+// the oldest sample for a new one. The caller keeps the samples themselves (the
+// input array or a ring buffer) and hands back the outgoing value, so the kernel
+// is just a few scalars and never allocates. Instantiated for float and double;
+// the float version accumulates the mean and M2 with CompensatedSum.
+template <typename Real>
+class BasicRollingMoments {
+public:
+    explicit BasicRollingMoments(size_t window_size = 0);
+
+    // Forget all samples, keeping the window size
+    void reset();
+
+    // Add a sample while the window is still filling up
+    void push(Real x);
+
+    // Replace the oldest sample x_out with x_in once the window is full
+    void slide(Real x_in, Real x_out);
+
+    // Recompute exactly from the current window contents to discard rounding drift
+    void resync(const Real* window, size_t count);
+
+    // Reinstate state captured from count(), mean() and m2()
+    void restore(size_t count, Real mean, Real m2);
+
+    size_t window_size() const { return window_size_; }
+    size_t count() const { return count_; }
+    bool full() const { return count_ == window_size_; }
+
+    Real mean() const { return mean_.value(); }
+    Real sum() const { return mean() * static_cast<Real>(count_); }
+    Real m2() const { return m2_.value(); }
+
+    // Population variance / standard deviation of the samples in the window
+    Real variance() const;
+    Real stddev() const;
+
+private:
+    size_t window_size_;
+    size_t count_;
+    CompensatedSum<Real> mean_;
+    CompensatedSum<Real> m2_;
+};
+
+extern template class BasicRollingMoments<float>;
+extern template class BasicRollingMoments<double>;
+
+using RollingMoments = BasicRollingMoments<double>;
+
+// Number of values a rolling computation over n samples produces
+inline size_t rolling_output_size(size_t n, size_t window_size) {
+    return (window_size == 0 || n < window_size) ? 0 : n - window_size + 1;
+}
+
+// Number of slides after which running sums should be rebuilt with resync()
+size_t rolling_resync_period(size_t window_size);
+
+// Rolling mean of data[0..n), writing rolling_output_size(n, window_size) values to out.
+// Real is float or double (explicitly instantiated); float sums are compensated.
+template <typename Real>
+void rolling_mean(const Real* data, size_t n, size_t window_size, Real* out);
+
+// Rolling population standard deviation of data[0..n), writing rolling_output_size(n, window_size) values to out
+template <typename Real>
+void rolling_stddev(const Real* data, size_t n, size_t window_size, Real* out);
+
+#endif // ROLLING_WINDOW_H
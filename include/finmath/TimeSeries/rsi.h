@@ -1,7 +1,8 @@
 #ifndef RSI_H
 #define RSI_H
 
-#include<vector>
+#include <cstddef>
+#include <vector>
 
 //function to compute the average gain over a window
 double compute_avg_gain(const std::vector<double>& price_changes, size_t window_size);
@@ -12,4 +13,19 @@ double compute_avg_loss(const std::vector<double>& price_changes, size_t window_
 // Function to compute the RSI from a time series of prices
 std::vector<double> compute_rsi(const std::vector<double>& prices, size_t window_size);
 
+// Same for float or double prices; braced lists and other arguments that do not deduce Real
+// resolve to the double overload above
+template <typename Real>
+std::vector<Real> compute_rsi(const std::vector<Real>& prices, size_t window_size);
+
+// Number of values compute_rsi produces for n prices (one seed value plus one per price change)
+inline size_t rsi_output_size(size_t n) {
+    return n == 0 ? 1 : n;
+}
+
+// Function to compute the RSI of prices[0..n) into out, which must hold rsi_output_size(n)
+// values. Returns the number of values written.
+template <typename Real>
+size_t compute_rsi(const Real* prices, size_t n, size_t window_size, Real* out);
+
 #endif // RSI_H
\ No newline at end of file
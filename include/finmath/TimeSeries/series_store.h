@@ -0,0 +1,120 @@
+#ifndef SERIES_STORE_H
+#define SERIES_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "finmath/TimeSeries/indicator_pipeline.h"
+
+// On-disk columnar time series for data sets larger than memory.
+//
+// File layout (native byte order):
+//   header       magic "FMSERIES", byte-order mark, format version, column count,
+//                capacity (rows reserved per column) and rows (rows written)
+//   descriptors  one 64-byte entry per column: name (up to 47 bytes), type, file offset
+//   columns      each starts on a 4096-byte boundary and holds capacity 8-byte values
+//
+// SeriesStoreWriter fills the columns with pwrite and SeriesStore maps the file read-only,
+// so a column reads as a plain array that the page cache fills as it is touched.
+// POSIX only; elsewhere both classes throw std::runtime_error.
+
+enum class ColumnType : uint32_t {
+    FLOAT64 = 1,    // double
+    TIMESTAMP = 2,  // int64_t, e.g. nanoseconds since the epoch
+};
+
+struct ColumnSpec {
+    std::string name;
+    ColumnType type;
+};
+
+// Writes a new store. Columns are filled independently by append() (one column at a time
+// or interleaved) and must all hold the same number of rows when the store is closed.
+class SeriesStoreWriter {
+public:
+    // Create (or truncate) path with room for capacity rows per column. Throws
+    // std::invalid_argument for an empty, duplicate or over-long column name and
+    // std::runtime_error if the file cannot be created.
+    SeriesStoreWriter(const std::string& path, std::vector<ColumnSpec> columns, size_t capacity);
+
+    // Closes the store if close() has not been called; errors are swallowed here
+    ~SeriesStoreWriter();
+
+    SeriesStoreWriter(const SeriesStoreWriter&) = delete;
+    SeriesStoreWriter& operator=(const SeriesStoreWriter&) = delete;
+
+    // Append count values to a FLOAT64 / TIMESTAMP column. Throws std::invalid_argument on a
+    // type mismatch, std::length_error past the capacity and std::runtime_error on I/O errors.
+    void append(size_t column, const double* values, size_t count);
+    void append(size_t column, const int64_t* values, size_t count);
+
+    const ColumnSpec& column(size_t c) const { return columns_.at(c); }
+
+    // Rows written so far to a column
+    size_t rows(size_t column) const;
+
+    // Record the row count in the header and close the file. Throws std::logic_error if the
+    // columns hold different numbers of rows and std::runtime_error on I/O errors.
+    void close();
+
+private:
+    void write_column(size_t column, ColumnType type, const void* values, size_t count);
+
+    int fd_;
+    std::vector<ColumnSpec> columns_;
+    std::vector<uint64_t> offsets_;
+    std::vector<size_t> rows_;
+    size_t capacity_;
+};
+
+// Read-only memory-mapped view of a store written by SeriesStoreWriter
+class SeriesStore {
+public:
+    // Throws std::runtime_error if the file cannot be mapped or is not a valid store
+    explicit SeriesStore(const std::string& path);
+    ~SeriesStore();
+
+    SeriesStore(const SeriesStore&) = delete;
+    SeriesStore& operator=(const SeriesStore&) = delete;
+
+    size_t rows() const { return rows_; }
+    size_t column_count() const { return columns_.size(); }
+    const ColumnSpec& column(size_t c) const { return columns_.at(c); }
+
+    // Index of the column called name; throws std::out_of_range if there is none
+    size_t column_index(const std::string& name) const;
+
+    // The rows() values of a column. Throws std::invalid_argument on a type mismatch.
+    const double* values(size_t c) const;
+    const int64_t* timestamps(size_t c) const;
+
+    // Page-cache hints for rows [begin, end) of column c: will_need starts reading them
+    // ahead (MADV_WILLNEED), release drops them from this process (MADV_DONTNEED; the data
+    // is read back from the file if touched again)
+    void will_need(size_t c, size_t begin, size_t end) const;
+    void release(size_t c, size_t begin, size_t end) const;
+
+private:
+    const unsigned char* column_data(size_t c, ColumnType type) const;
+    void advise(size_t c, size_t begin, size_t end, int advice) const;
+
+    void* map_;
+    size_t map_size_;
+    size_t rows_;
+    std::vector<ColumnSpec> columns_;
+    std::vector<uint64_t> offsets_;
+};
+
+// Function to run a pipeline over a FLOAT64 column of a store chunk_rows rows at a time,
+// handing each chunk's values to sink as IndicatorPipeline::compute_chunked does. The
+// rolling state carries across chunks, so the values match an in-memory run exactly.
+// The column is read front to back: the next chunk is prefetched while the current one
+// is processed, and rows the windows can no longer reach are released, so resident
+// memory stays around one chunk plus the longest window however large the file. (With RSI
+// the column is also read once up front for compute_rsi's seed; see IndicatorPipeline.)
+void compute_indicators(const SeriesStore& store, size_t column, const IndicatorPipeline& pipeline,
+                        size_t chunk_rows, const IndicatorSink& sink);
+
+#endif // SERIES_STORE_H
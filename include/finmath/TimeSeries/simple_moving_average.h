@@ -1,9 +1,24 @@
 #ifndef SIMPLE_MOVING_AVERAGE_H
 #define SIMPLE_MOVING_AVERAGE_H
 
+#include <cstddef>
 #include <vector>
 
+// The indicators are templates over the scalar type, instantiated for float and double.
+// float halves the memory traffic and doubles the SIMD width; its running sums are
+// compensated (see CompensatedSum in rolling_window.h) to limit drift.
+
 // Function to compute the moving average from a time series
 std::vector<double> simple_moving_average(const std::vector<double>& data, size_t window_size);
 
+// Same for float or double series; braced lists and other arguments that do not deduce Real
+// resolve to the double overload above
+template <typename Real>
+std::vector<Real> simple_moving_average(const std::vector<Real>& data, size_t window_size);
+
+// Function to compute the moving average of data[0..n) into out, which must hold
+// rolling_output_size(n, window_size) values. Returns the number of values written.
+template <typename Real>
+size_t simple_moving_average(const Real* data, size_t n, size_t window_size, Real* out);
+
 #endif // MOVING_AVERAGE_H
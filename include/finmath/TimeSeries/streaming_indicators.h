@@ -0,0 +1,326 @@
+#ifndef STREAMING_INDICATORS_H
+#define STREAMING_INDICATORS_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "finmath/TimeSeries/rolling_statistics.h"
+#include "finmath/TimeSeries/rolling_window.h"
+
+// Stateful indicators for live feeds: each tick is folded in with update() in
+// O(1) amortized time. All storage is sized in the constructor, so update() never
+// allocates. snapshot() flattens the state into a vector of doubles and restore()
+// loads it back, which lets a process persist its indicators across restarts.
+// Until enough ticks have arrived for a full window, update() returns NaN.
+
+// Fixed-capacity circular buffer of doubles
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity);
+
+    // Append x, overwriting the oldest value once the buffer is full
+    void push(double x);
+
+    // i-th value in arrival order, 0 being the oldest
+    double operator[](size_t i) const;
+
+    double oldest() const { return (*this)[0]; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return data_.size(); }
+    bool full() const { return size_ == data_.size(); }
+
+    // Raw storage (rotated, not in arrival order)
+    const double* data() const { return data_.data(); }
+
+    void clear();
+
+private:
+    std::vector<double> data_;
+    size_t head_;
+    size_t size_;
+};
+
+// Simple moving average over the last window_size prices
+class RollingSMA {
+public:
+    explicit RollingSMA(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    RollingMoments moments_;
+    size_t slides_since_resync_;
+};
+
+// Annualized volatility of the last window_size log returns, matching rolling_volatility
+class RollingVolatility {
+public:
+    explicit RollingVolatility(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return returns_.full(); }
+    size_t window_size() const { return returns_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer returns_;
+    RollingMoments moments_;
+    size_t slides_since_resync_;
+    double last_price_;
+    bool has_last_price_;
+};
+
+// Relative Strength Index with Wilder smoothing: the first average gain/loss is the
+// simple mean of the first `period` price changes, later ones use
+// avg = (avg * (period - 1) + change) / period
+class WilderRSI {
+public:
+    explicit WilderRSI(size_t period);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return changes_seen_ >= period_; }
+    size_t period() const { return period_; }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    size_t period_;
+    size_t changes_seen_;
+    double avg_gain_;
+    double avg_loss_;
+    double last_price_;
+    bool has_last_price_;
+};
+
+// Exponential moving average with alpha = 2 / (span + 1), seeded with the simple mean of
+// the first span prices; the same values as exponential_moving_average
+class RollingEMA {
+public:
+    explicit RollingEMA(size_t span);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return count_ == span_; }
+    size_t span() const { return span_; }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    size_t span_;
+    double alpha_;
+    size_t count_;  // prices summed for the seed, at most span
+    double sum_;
+    double value_;
+};
+
+// Double exponential moving average 2 E1 - E2, E2 being the EMA of E1; ready after
+// 2 span - 1 prices
+class RollingDEMA {
+public:
+    explicit RollingDEMA(size_t span);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return second_.ready(); }
+    size_t span() const { return first_.span(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RollingEMA first_;
+    RollingEMA second_;
+};
+
+// Triple exponential moving average 3 (E1 - E2) + E3; ready after 3 span - 2 prices
+class RollingTEMA {
+public:
+    explicit RollingTEMA(size_t span);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return third_.ready(); }
+    size_t span() const { return first_.span(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RollingEMA first_;
+    RollingEMA second_;
+    RollingEMA third_;
+};
+
+// Linearly weighted moving average of the last window_size prices (weights 1..window_size,
+// newest heaviest), updated from a running sum and weighted sum
+class RollingWMA {
+public:
+    explicit RollingWMA(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    double inv_weights_;
+    double sum_;
+    double weighted_;
+    size_t slides_since_resync_;
+};
+
+// Maximum of the last window_size prices, matching rolling_max
+class RollingMax {
+public:
+    explicit RollingMax(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    MonotonicWindow<double, std::greater<double>> extremum_;
+};
+
+// Minimum of the last window_size prices, matching rolling_min
+class RollingMin {
+public:
+    explicit RollingMin(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    MonotonicWindow<double, std::less<double>> extremum_;
+};
+
+// q-quantile of the last window_size prices, matching rolling_quantile
+class RollingQuantile {
+public:
+    // Throws std::invalid_argument unless 0 <= q <= 1
+    RollingQuantile(size_t window_size, double q);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    double q() const { return q_; }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    BasicOrderStatistics<double> sorted_;
+    double q_;
+};
+
+// Skewness of the last window_size prices, matching rolling_skewness to rounding
+class RollingSkewness {
+public:
+    explicit RollingSkewness(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    BasicRollingHigherMoments<double> moments_;
+    size_t slides_since_resync_;
+};
+
+// Excess kurtosis of the last window_size prices, matching rolling_kurtosis to rounding
+class RollingKurtosis {
+public:
+    explicit RollingKurtosis(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    BasicRollingHigherMoments<double> moments_;
+    size_t slides_since_resync_;
+};
+
+// z-score of the latest price against the last window_size prices, matching rolling_zscore
+// to rounding
+class RollingZScore {
+public:
+    explicit RollingZScore(size_t window_size);
+
+    double update(double price);
+    double value() const;
+    bool ready() const { return window_.full(); }
+    size_t window_size() const { return window_.capacity(); }
+    void reset();
+
+    std::vector<double> snapshot() const;
+    void restore(const std::vector<double>& state);
+
+private:
+    RingBuffer window_;
+    RollingMoments moments_;
+    size_t slides_since_resync_;
+};
+
+// Window size / period recorded in a snapshot (its second field), to construct the indicator
+// that restores it. Throws std::invalid_argument unless it is an integer in [1, 2^53].
+size_t snapshot_window_size(const std::vector<double>& state);
+
+// Quantile recorded in a RollingQuantile snapshot (its third field). Throws
+// std::invalid_argument unless it lies in [0, 1].
+double snapshot_quantile(const std::vector<double>& state);
+
+#endif // STREAMING_INDICATORS_H
@@ -1,12 +1,28 @@
 #ifndef FINMATH_H
 #define FINMATH_H
 
+#include "finmath/Helper/brownian_bridge.h"
 #include "finmath/Helper/helper.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/normal_distribution.h"
+#include "finmath/Helper/philox.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/Helper/sobol.h"
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/Helper/tridiagonal.h"
+#include "finmath/InterestAndAnnuities/cash_flows.h"
 #include "finmath/InterestAndAnnuities/compound_interest.h"
 #include "finmath/OptionPricing/options_pricing.h"
+#include "finmath/TimeSeries/indicator_pipeline.h"
+#include "finmath/TimeSeries/series_store.h"
+#include "finmath/TimeSeries/moving_averages.h"
+#include "finmath/TimeSeries/parallel_indicators.h"
+#include "finmath/TimeSeries/rolling_statistics.h"
 #include "finmath/TimeSeries/rolling_volatility.h"
+#include "finmath/TimeSeries/rolling_window.h"
 #include "finmath/TimeSeries/simple_moving_average.h"
 #include "finmath/TimeSeries/rsi.h"
+#include "finmath/TimeSeries/streaming_indicators.h"
 // Include other headers as needed
 
 #endif // FINMATH_H
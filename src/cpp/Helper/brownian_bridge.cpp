@@ -0,0 +1,81 @@
+#include "finmath/Helper/brownian_bridge.h"
+
+#include <cmath>
+#include <stdexcept>
+
+// Construction order after Jaeckel, "Monte Carlo Methods in Finance", section 10.8.3
+BrownianBridge::BrownianBridge(size_t steps)
+    : steps_(steps), left_index_(steps, 0), right_index_(steps, 0), bridge_index_(steps, 0),
+      left_weight_(steps, 0.0), right_weight_(steps, 0.0), std_dev_(steps, 0.0) {
+    if (steps == 0) {
+        throw std::invalid_argument("Brownian bridge needs at least one step.");
+    }
+
+    // filled[k] marks points already placed
+    std::vector<bool> filled(steps, false);
+    filled[steps - 1] = true;
+    bridge_index_[0] = steps - 1;
+    std_dev_[0] = std::sqrt(static_cast<double>(steps));
+
+    size_t j = 0;
+    for (size_t i = 1; i < steps; ++i) {
+        // Next gap: points j..k-1 are empty and k is filled
+        while (filled[j]) {
+            ++j;
+        }
+        size_t k = j;
+        while (!filled[k]) {
+            ++k;
+        }
+        size_t l = j + ((k - 1 - j) >> 1);
+        filled[l] = true;
+
+        // Times of the bracketing points: W(j - 1) is at t = j (0 for the origin), W(k) at t = k + 1
+        double t_left = static_cast<double>(j);
+        double t_mid = static_cast<double>(l + 1);
+        double t_right = static_cast<double>(k + 1);
+
+        bridge_index_[i] = l;
+        left_index_[i] = j;
+        right_index_[i] = k;
+        left_weight_[i] = (t_right - t_mid) / (t_right - t_left);
+        right_weight_[i] = (t_mid - t_left) / (t_right - t_left);
+        std_dev_[i] = std::sqrt((t_mid - t_left) * (t_right - t_mid) / (t_right - t_left));
+
+        j = k + 1;
+        if (j >= steps) {
+            j = 0;
+        }
+    }
+}
+
+void BrownianBridge::build(const double* z, double* w) const {
+    build(z, w, 1);
+}
+
+void BrownianBridge::build(const double* z, double* w, size_t lanes) const {
+    double* terminal = w + (steps_ - 1) * lanes;
+    for (size_t p = 0; p < lanes; ++p) {
+        terminal[p] = std_dev_[0] * z[p];
+    }
+
+    for (size_t i = 1; i < steps_; ++i) {
+        const double* zi = z + i * lanes;
+        const double* right = w + right_index_[i] * lanes;
+        double* mid = w + bridge_index_[i] * lanes;
+        const double rw = right_weight_[i];
+        const double sd = std_dev_[i];
+
+        if (left_index_[i] == 0) {
+            for (size_t p = 0; p < lanes; ++p) {
+                mid[p] = rw * right[p] + sd * zi[p];
+            }
+        } else {
+            const double* left = w + (left_index_[i] - 1) * lanes;
+            const double lw = left_weight_[i];
+            for (size_t p = 0; p < lanes; ++p) {
+                mid[p] = lw * left[p] + rw * right[p] + sd * zi[p];
+            }
+        }
+    }
+}
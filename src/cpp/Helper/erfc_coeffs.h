@@ -0,0 +1,27 @@
+#ifndef ERFC_COEFFS_H
+#define ERFC_COEFFS_H
+
+// Coefficients of the erfc approximation shared by the HIGH accuracy tier of
+// normal_cdf (normal_distribution.cpp) and the SIMD kernels (simd_math.h).
+
+namespace {
+
+// (1 + 2z) exp(z^2) erfc(z) as a degree-24 polynomial in y = (z - K) / (z + K), K = 3.75,
+// valid for all z >= 0 (Shepherd & Laframboise form). Converted from a Chebyshev
+// interpolant of erfcl; highest degree first.
+constexpr double kErfcK = 3.75;
+constexpr double kErfcPoly[] = {
+    4.22360812990518752486e-10, 3.10521386381878983229e-10, -5.15809617240847728681e-09,
+    -3.74090713961550136446e-09, 3.86360490267634304473e-08, 2.32560879442900159120e-08,
+    -2.58613324866097116228e-07, -5.72091096717741720568e-08, 1.75158904677785720594e-06,
+    -9.73566483680743388618e-07, -1.14441182510541250572e-05, 2.23842419001599179929e-05,
+    5.16490881997001133330e-05, -2.90154081098460345234e-04, 2.93713668299299280467e-04,
+    1.75562585289454732920e-03, -9.74657955847776545037e-03, 2.83622774189791360274e-02,
+    -5.86933985895899242241e-02, 9.23043211603735737889e-02, -1.08803930141751623014e-01,
+    8.22767384901454620102e-02, 3.58541548546449820240e-03, -1.40240598585546968690e-01,
+    1.23751263083782757899e+00,
+};
+
+} // namespace
+
+#endif // ERFC_COEFFS_H
@@ -1,15 +1,51 @@
 #include <cmath>
+#include <cstddef>
 #include "finmath/Helper/helper.h"
+#include "finmath/Helper/normal_distribution.h"
+#include "inverse_normal_coeffs.h"
 
 
-// Standard normal cumulative distribution function
+// Standard normal cumulative distribution function, at the global accuracy tier
 double normal_cdf(double x) {
-    return 0.5 * std::erfc(-x / std::sqrt(2));
+    return normal_cdf(x, normal_accuracy());
 }
 
-// Standard normal probability density function
+// Standard normal probability density function, at the global accuracy tier
 double normal_pdf(double x) {
-    return std::exp(-0.5 * x * x) / std::sqrt(2 * M_PI);
+    return normal_pdf(x, normal_accuracy());
+}
+
+// Inverse standard normal cumulative distribution function
+double inverse_normal_cdf(double p) {
+    if (!(p > 0.0 && p < 1.0)) {
+        if (p == 0.0) {
+            return -HUGE_VAL;
+        }
+        if (p == 1.0) {
+            return HUGE_VAL;
+        }
+        return NAN;
+    }
+
+    double x;
+    if (p < kAcklamLow || p > 1.0 - kAcklamLow) {
+        // Tails: rational function of sqrt(-2 log(tail probability))
+        double q = std::sqrt(-2.0 * std::log(p < 0.5 ? p : 1.0 - p));
+        x = acklam_horner(q, kAcklamC) / acklam_horner(q, kAcklamD);
+        if (p > 0.5) {
+            x = -x;
+        }
+    } else {
+        double q = p - 0.5;
+        double r = q * q;
+        x = q * acklam_horner(r, kAcklamA) / acklam_horner(r, kAcklamB);
+    }
+
+    // One Halley step on e = Phi(x) - p; above the median it is formed from the upper tail
+    // 1 - Phi(x) = erfc(x / sqrt(2)) / 2 to keep precision
+    double e = (p < 0.5) ? 0.5 * std::erfc(-x / std::sqrt(2)) - p : (1.0 - p) - 0.5 * std::erfc(x / std::sqrt(2));
+    double u = e * std::sqrt(2 * M_PI) * std::exp(0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
 }
 
 long long combinations(long n, long k) {
@@ -0,0 +1,281 @@
+#include "finmath/Helper/instrumentation.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Counts summed over threads, in plain integers
+struct Totals {
+    uint64_t calls = 0;
+    uint64_t items = 0;
+    uint64_t timed_calls = 0;
+    uint64_t total_ticks = 0;
+    std::vector<uint64_t> buckets = std::vector<uint64_t>(kInstrumentationBuckets, 0);
+
+    void add(const InstrumentationCounters& counters) {
+        calls += counters.calls.load(std::memory_order_relaxed);
+        items += counters.items.load(std::memory_order_relaxed);
+        timed_calls += counters.timed_calls.load(std::memory_order_relaxed);
+        total_ticks += counters.total_ticks.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < kInstrumentationBuckets; ++b) {
+            buckets[b] += counters.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+
+    void subtract(const Totals& other) {
+        calls -= other.calls;
+        items -= other.items;
+        timed_calls -= other.timed_calls;
+        total_ticks -= other.total_ticks;
+        for (size_t b = 0; b < kInstrumentationBuckets; ++b) {
+            buckets[b] -= other.buckets[b];
+        }
+    }
+};
+
+// One thread's counters, indexed by function id and allocated on the thread's first call
+struct ThreadBlock {
+    std::atomic<InstrumentationCounters*> slots[kMaxInstrumentedFunctions] = {};
+};
+
+void clear(InstrumentationCounters& counters) {
+    counters.calls.store(0, std::memory_order_relaxed);
+    counters.items.store(0, std::memory_order_relaxed);
+    counters.timed_calls.store(0, std::memory_order_relaxed);
+    counters.total_ticks.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint64_t>& bucket : counters.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<ThreadBlock*> live;
+    std::vector<ThreadBlock*> free;   // blocks of exited threads, cleared for reuse
+    std::vector<Totals> retired;      // counts of exited threads
+    std::vector<Totals> baseline;     // counts at the last reset
+    uint64_t start_ticks = instrumentation_ticks();
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    // Caller holds the mutex
+    std::vector<Totals> totals() const {
+        std::vector<Totals> result = retired;
+        for (const ThreadBlock* block : live) {
+            for (size_t id = 0; id < names.size(); ++id) {
+                const InstrumentationCounters* counters = block->slots[id].load(std::memory_order_acquire);
+                if (counters != nullptr) {
+                    result[id].add(*counters);
+                }
+            }
+        }
+        return result;
+    }
+};
+
+// Never destroyed: threads may exit, and retire their block, after static destructors ran
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+// The calling thread's block; trivially initialized, so reading it needs no TLS guard
+thread_local ThreadBlock* t_block = nullptr;
+
+// Folds the thread's counts into the registry when the thread exits
+struct BlockOwner {
+    ~BlockOwner() {
+        if (t_block == nullptr) {
+            return;
+        }
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (size_t id = 0; id < reg.names.size(); ++id) {
+            InstrumentationCounters* counters = t_block->slots[id].load(std::memory_order_relaxed);
+            if (counters != nullptr) {
+                reg.retired[id].add(*counters);
+                clear(*counters);
+            }
+        }
+        for (size_t i = 0; i < reg.live.size(); ++i) {
+            if (reg.live[i] == t_block) {
+                reg.live.erase(reg.live.begin() + static_cast<std::ptrdiff_t>(i));
+                break;
+            }
+        }
+        reg.free.push_back(t_block);
+        t_block = nullptr;
+    }
+};
+
+thread_local BlockOwner t_owner;
+
+// Time-stamp counter ticks per nanosecond, measured over the life of the process
+double ticks_per_ns(const Registry& reg) {
+    auto elapsed = std::chrono::steady_clock::now() - reg.start_time;
+    if (elapsed < std::chrono::milliseconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5) - elapsed);
+    }
+    uint64_t ticks = instrumentation_ticks() - reg.start_ticks;
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - reg.start_time).count();
+    return static_cast<double>(ticks) / ns;
+}
+
+// Largest latency in bucket b, in ticks
+uint64_t bucket_upper(size_t b) {
+    if (b < 8) {
+        return b;
+    }
+    size_t exponent = b / 8 + 2;
+    uint64_t next = static_cast<uint64_t>(8 + b % 8 + 1) << (exponent - 3);
+    return next - 1;
+}
+
+std::string format_ns(double ticks, double per_ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << ticks / per_ns;
+    return out.str();
+}
+
+std::string json_function(const std::string& name, const Totals& t, double per_ns) {
+    std::ostringstream out;
+    out << "\"" << name << "\": {\"calls\": " << t.calls << ", \"items\": " << t.items
+        << ", \"timed_calls\": " << t.timed_calls;
+
+    const double mean = t.timed_calls == 0 ? 0.0 : static_cast<double>(t.total_ticks) / t.timed_calls;
+    out << ", \"mean_ns\": " << format_ns(mean, per_ns);
+
+    const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    const char* labels[] = {"p50_ns", "p90_ns", "p99_ns", "p999_ns"};
+    for (size_t q = 0; q < 4; ++q) {
+        // Smallest bucket holding at least a fraction q of the timed calls
+        uint64_t rank = static_cast<uint64_t>(std::ceil(quantiles[q] * static_cast<double>(t.timed_calls)));
+        uint64_t seen = 0;
+        size_t b = 0;
+        for (; b < kInstrumentationBuckets && seen < rank; ++b) {
+            seen += t.buckets[b];
+        }
+        double value = t.timed_calls == 0 ? 0.0 : static_cast<double>(bucket_upper(b - 1));
+        out << ", \"" << labels[q] << "\": " << format_ns(value, per_ns);
+    }
+
+    size_t last = kInstrumentationBuckets;
+    while (last > 0 && t.buckets[last - 1] == 0) {
+        --last;
+    }
+    out << ", \"max_ns\": " << format_ns(last == 0 ? 0.0 : static_cast<double>(bucket_upper(last - 1)), per_ns);
+
+    out << ", \"histogram\": [";
+    bool first = true;
+    for (size_t b = 0; b < kInstrumentationBuckets; ++b) {
+        if (t.buckets[b] != 0) {
+            out << (first ? "" : ", ") << "[" << format_ns(static_cast<double>(bucket_upper(b)), per_ns) << ", "
+                << t.buckets[b] << "]";
+            first = false;
+        }
+    }
+    out << "]}";
+    return out.str();
+}
+
+} // namespace
+
+bool instrumentation_enabled() {
+#ifdef FINMATH_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+int instrumentation_register(const char* name) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t id = 0; id < reg.names.size(); ++id) {
+        if (reg.names[id] == name) {
+            return static_cast<int>(id);
+        }
+    }
+    // The last slot is shared by every function past the limit
+    const bool full = reg.names.size() + 1 >= kMaxInstrumentedFunctions;
+    if (reg.names.size() < kMaxInstrumentedFunctions) {
+        reg.names.push_back(full ? "(other)" : name);
+        reg.retired.emplace_back();
+        reg.baseline.emplace_back();
+    }
+    return static_cast<int>(reg.names.size() - 1);
+}
+
+InstrumentationCounters& instrumentation_counters(int id) {
+    ThreadBlock* block = t_block;
+    if (block != nullptr) {
+        InstrumentationCounters* counters = block->slots[id].load(std::memory_order_relaxed);
+        if (counters != nullptr) {
+            return *counters;
+        }
+    }
+
+    // First call of this function on this thread
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (block == nullptr) {
+        if (reg.free.empty()) {
+            block = new ThreadBlock();
+        } else {
+            block = reg.free.back();
+            reg.free.pop_back();
+        }
+        reg.live.push_back(block);
+        t_block = block;
+        static_cast<void>(t_owner);  // constructs the owner, whose destructor runs at thread exit
+    }
+    InstrumentationCounters* counters = block->slots[id].load(std::memory_order_relaxed);
+    if (counters == nullptr) {
+        counters = new InstrumentationCounters();
+        clear(*counters);
+        block->slots[id].store(counters, std::memory_order_release);
+    }
+    return *counters;
+}
+
+std::string instrumentation_json() {
+    std::ostringstream out;
+    out << "{\"enabled\": " << (instrumentation_enabled() ? "true" : "false") << ", \"functions\": {";
+
+    Registry& reg = registry();
+    std::vector<std::string> names;
+    std::vector<Totals> totals;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        names = reg.names;
+        totals = reg.totals();
+        for (size_t id = 0; id < totals.size(); ++id) {
+            totals[id].subtract(reg.baseline[id]);
+        }
+    }
+
+    const double per_ns = names.empty() ? 1.0 : ticks_per_ns(reg);
+    bool first = true;
+    for (size_t id = 0; id < names.size(); ++id) {
+        if (totals[id].calls == 0) {
+            continue;
+        }
+        out << (first ? "" : ", ") << json_function(names[id], totals[id], per_ns);
+        first = false;
+    }
+    out << "}}";
+    return out.str();
+}
+
+void reset_instrumentation() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.baseline = reg.totals();
+}
@@ -0,0 +1,35 @@
+#ifndef INVERSE_NORMAL_COEFFS_H
+#define INVERSE_NORMAL_COEFFS_H
+
+// Coefficients of Acklam's rational approximation to the inverse normal CDF (relative
+// error below 1.15e-9), shared by the scalar inverse_normal_cdf and the SIMD kernels.
+// Highest degree first; the denominators carry their constant term 1.
+
+namespace {
+
+// Central region |p - 0.5| <= 0.5 - kAcklamLow: x = q A(r) / B(r) with q = p - 0.5, r = q^2
+constexpr double kAcklamA[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+constexpr double kAcklamB[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01, 1.0};
+
+// Lower tail: x = C(t) / D(t) with t = sqrt(-2 log p); the upper tail follows by symmetry
+constexpr double kAcklamC[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+constexpr double kAcklamD[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00, 1.0};
+
+constexpr double kAcklamLow = 0.02425;
+
+template <size_t N>
+inline double acklam_horner(double x, const double (&coeffs)[N]) {
+    double result = coeffs[0];
+    for (size_t i = 1; i < N; ++i) {
+        result = result * x + coeffs[i];
+    }
+    return result;
+}
+
+} // namespace
+
+#endif // INVERSE_NORMAL_COEFFS_H
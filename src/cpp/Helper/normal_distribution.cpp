@@ -0,0 +1,267 @@
+#include "finmath/Helper/normal_distribution.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "finmath/Helper/simd.h"
+#include "erfc_coeffs.h"
+#include "normal_distribution_simd.h"
+
+namespace {
+
+constexpr double kInvSqrt2 = 7.07106781186547524401e-01;
+constexpr double kInvSqrt2Pi = 3.98942280401432677940e-01;
+
+std::atomic<int>& active_accuracy() {
+    static std::atomic<int> accuracy(static_cast<int>(NormalAccuracy::EXACT));
+    return accuracy;
+}
+
+// The forms normal_cdf and normal_pdf have always used, kept bit for bit
+double exact_cdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2));
+}
+
+double exact_pdf(double x) {
+    return std::exp(-0.5 * x * x) / std::sqrt(2 * M_PI);
+}
+
+// kErfcPoly at y by Estrin's scheme: adjacent terms are paired with y, pairs with y^2 and
+// so on, so the 24 dependent multiply-adds of Horner's rule become a tree of depth 5
+double erfc_poly(double y) {
+    const double* c = kErfcPoly;  // c[24 - k] multiplies y^k
+    double y2 = y * y;
+    double y4 = y2 * y2;
+    double y8 = y4 * y4;
+    auto pair = [c, y](int k) { return c[24 - k] + c[23 - k] * y; };  // y^k and y^(k + 1)
+    auto quad = [&pair, y2](int k) { return pair(k) + pair(k + 2) * y2; };
+    auto oct = [&quad, y4](int k) { return quad(k) + quad(k + 4) * y4; };
+    double low = oct(0) + oct(8) * y8;   // y^0 .. y^15
+    double high = oct(16) + c[0] * y8;   // y^16 .. y^24
+    return low + high * (y8 * y8);
+}
+
+// exp(-x^2 / 2) for |x| <= kNormalClamp, with x^2 = sq + err split exactly by Dekker's
+// product so the rounding of x^2 does not cost x^2 / 2 ulps of relative accuracy
+double gauss(double x) {
+    double split = 134217729.0 * x;  // 2^27 + 1
+    double hi = split - (split - x);
+    double lo = x - hi;
+    double sq = x * x;
+    double err = ((hi * hi - sq) + 2.0 * hi * lo) + lo * lo;
+    return std::exp(-0.5 * sq) * (1.0 - 0.5 * err);
+}
+
+// Branch-free form of vnormal_cdf in simd_math.h
+double high_cdf(double x) {
+    double a = std::fabs(x);
+    a = a > kNormalClamp ? kNormalClamp : a;  // NaN passes through
+    double z = a * kInvSqrt2;
+    double prefactor = 1.0 + 2.0 * z;
+    double inv = 1.0 / ((z + kErfcK) * prefactor);
+    double y = (z - kErfcK) * prefactor * inv;
+    double tail = 0.5 * erfc_poly(y) * gauss(a) * ((z + kErfcK) * inv);
+    return x < 0.0 ? tail : 1.0 - tail;
+}
+
+double high_pdf(double x) {
+    double a = std::fabs(x);
+    a = a > kNormalClamp ? kNormalClamp : a;
+    return gauss(a) * kInvSqrt2Pi;
+}
+
+// Cubic of the FAST table cell holding x, as vnormal_cdf_fast
+double table_value(double x, const double* table) {
+    if (std::isnan(x)) {
+        return x;
+    }
+    double u = (std::max(x, kFastNormalLo) - kFastNormalLo) * kFastNormalScale;
+    u = std::min(u, static_cast<double>(kFastNormalCells));
+    size_t cell = std::min(static_cast<size_t>(u), kFastNormalCells - 1);
+    double t = u - static_cast<double>(cell);
+    const double* a = table + 4 * cell;
+    return a[0] + t * (a[1] + t * (a[2] + t * a[3]));
+}
+
+// Cubic Hermite interpolants of Phi and phi through the cell ends, in the cell coordinate
+// t = (x - x0) * kFastNormalScale; the error is below h^4 max|f''''| / 384 = 5e-8 for h = 1/16.
+// The outermost nodes hold the limits 0 and 1 (Phi(-8) = 6e-16) so arguments past the table,
+// which take its end values, give them exactly.
+struct FastNormalTables {
+    double cdf[4 * kFastNormalCells];
+    double pdf[4 * kFastNormalCells];
+
+    FastNormalTables() {
+        const double h = 1.0 / kFastNormalScale;
+        double cdf_node[kFastNormalCells + 1], pdf_node[kFastNormalCells + 1], slope_node[kFastNormalCells + 1];
+        for (size_t c = 0; c <= kFastNormalCells; ++c) {
+            double x = kFastNormalLo + static_cast<double>(c) * h;
+            bool end = c == 0 || c == kFastNormalCells;
+            cdf_node[c] = end ? (x < 0.0 ? 0.0 : 1.0) : exact_cdf(x);
+            pdf_node[c] = end ? 0.0 : exact_pdf(x);
+            slope_node[c] = -x * pdf_node[c];
+        }
+        for (size_t c = 0; c < kFastNormalCells; ++c) {
+            hermite(cdf + 4 * c, cdf_node[c], cdf_node[c + 1], h * pdf_node[c], h * pdf_node[c + 1]);
+            hermite(pdf + 4 * c, pdf_node[c], pdf_node[c + 1], h * slope_node[c], h * slope_node[c + 1]);
+        }
+    }
+
+    // Cubic with values p0, p1 and slopes m0, m1 at t = 0 and t = 1
+    static void hermite(double* a, double p0, double p1, double m0, double m1) {
+        a[0] = p0;
+        a[1] = m0;
+        a[2] = 3.0 * (p1 - p0) - 2.0 * m0 - m1;
+        a[3] = 2.0 * (p0 - p1) + m0 + m1;
+    }
+};
+
+const FastNormalTables& fast_tables() {
+    static const FastNormalTables tables;
+    return tables;
+}
+
+// The cubics may overshoot [0, 1] by their error in the tails; NaN passes through the clamps
+double fast_cdf(double x) {
+    double value = table_value(x, fast_tables().cdf);
+    value = value < 0.0 ? 0.0 : value;
+    return value > 1.0 ? 1.0 : value;
+}
+
+double fast_pdf(double x) {
+    double value = table_value(x, fast_tables().pdf);
+    return value < 0.0 ? 0.0 : value;
+}
+
+template <typename F>
+void scalar_batch(const double* x, double* out, size_t n, F f) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = f(x[i]);
+    }
+}
+
+} // namespace
+
+const double* fast_normal_cdf_table() {
+    return fast_tables().cdf;
+}
+
+NormalAccuracy normal_accuracy() {
+    return static_cast<NormalAccuracy>(active_accuracy().load(std::memory_order_relaxed));
+}
+
+void set_normal_accuracy(NormalAccuracy accuracy) {
+    active_accuracy().store(static_cast<int>(accuracy), std::memory_order_relaxed);
+}
+
+const char* normal_accuracy_name(NormalAccuracy accuracy) {
+    switch (accuracy) {
+        case NormalAccuracy::HIGH: return "high";
+        case NormalAccuracy::FAST: return "fast";
+        default: return "exact";
+    }
+}
+
+double normal_cdf(double x, NormalAccuracy accuracy) {
+    switch (accuracy) {
+        case NormalAccuracy::HIGH: return high_cdf(x);
+        case NormalAccuracy::FAST: return fast_cdf(x);
+        default: return exact_cdf(x);
+    }
+}
+
+double normal_pdf(double x, NormalAccuracy accuracy) {
+    switch (accuracy) {
+        case NormalAccuracy::HIGH: return high_pdf(x);
+        case NormalAccuracy::FAST: return fast_pdf(x);
+        default: return exact_pdf(x);
+    }
+}
+
+void normal_cdf_batch(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+    if (accuracy != NormalAccuracy::EXACT) {
+        switch (active_simd_level()) {
+            case SimdLevel::AVX512:
+                if (normal_cdf_batch_avx512(x, out, n, accuracy)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::AVX2:
+                if (normal_cdf_batch_avx2(x, out, n, accuracy)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::SCALAR:
+                break;
+        }
+    }
+
+    switch (accuracy) {
+        case NormalAccuracy::HIGH: scalar_batch(x, out, n, high_cdf); break;
+        case NormalAccuracy::FAST: scalar_batch(x, out, n, fast_cdf); break;
+        default: scalar_batch(x, out, n, exact_cdf); break;
+    }
+}
+
+void normal_pdf_batch(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+    if (accuracy != NormalAccuracy::EXACT) {
+        switch (active_simd_level()) {
+            case SimdLevel::AVX512:
+                if (normal_pdf_batch_avx512(x, out, n, accuracy)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::AVX2:
+                if (normal_pdf_batch_avx2(x, out, n, accuracy)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::SCALAR:
+                break;
+        }
+    }
+
+    switch (accuracy) {
+        case NormalAccuracy::HIGH: scalar_batch(x, out, n, high_pdf); break;
+        case NormalAccuracy::FAST: scalar_batch(x, out, n, fast_pdf); break;
+        default: scalar_batch(x, out, n, exact_pdf); break;
+    }
+}
+
+NormalErrorReport normal_accuracy_report(NormalAccuracy accuracy, double lo, double hi, size_t samples) {
+    if (samples == 0 || !(lo <= hi)) {
+        return {NAN, NAN, NAN, NAN, NAN, NAN};
+    }
+    NormalErrorReport report = {0.0, 0.0, lo, 0.0, 0.0, lo};
+
+    std::vector<double> x(samples);
+    double step = samples > 1 ? (hi - lo) / static_cast<double>(samples - 1) : 0.0;
+    for (size_t i = 0; i < samples; ++i) {
+        x[i] = lo + step * static_cast<double>(i);
+    }
+
+    std::vector<double> exact(samples), approx(samples);
+    auto measure = [&](double& max_abs, double& max_rel, double& worst_x) {
+        for (size_t i = 0; i < samples; ++i) {
+            double error = std::fabs(approx[i] - exact[i]);
+            if (error > max_abs) {
+                max_abs = error;
+                worst_x = x[i];
+            }
+            if (std::isnormal(exact[i])) {
+                max_rel = std::max(max_rel, error / std::fabs(exact[i]));
+            }
+        }
+    };
+
+    normal_cdf_batch(x.data(), exact.data(), samples, NormalAccuracy::EXACT);
+    normal_cdf_batch(x.data(), approx.data(), samples, accuracy);
+    measure(report.max_abs_cdf, report.max_rel_cdf, report.worst_cdf_x);
+
+    normal_pdf_batch(x.data(), exact.data(), samples, NormalAccuracy::EXACT);
+    normal_pdf_batch(x.data(), approx.data(), samples, accuracy);
+    measure(report.max_abs_pdf, report.max_rel_pdf, report.worst_pdf_x);
+    return report;
+}
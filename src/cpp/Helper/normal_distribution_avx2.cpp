@@ -0,0 +1,23 @@
+// Compiled with -mavx2 -mfma (see CMakeLists.txt); only called after runtime CPU detection
+#define NORMAL_DISTRIBUTION_SIMD_KERNEL
+#include "normal_distribution_simd.h"
+
+bool normal_cdf_batch_avx2(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+#if defined(__AVX2__) && defined(__FMA__)
+    normal_cdf_batch_kernel<VecAVX2>(x, out, n, accuracy);
+    return true;
+#else
+    (void)x, (void)out, (void)n, (void)accuracy;
+    return false;
+#endif
+}
+
+bool normal_pdf_batch_avx2(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+#if defined(__AVX2__) && defined(__FMA__)
+    normal_pdf_batch_kernel<VecAVX2>(x, out, n, accuracy);
+    return true;
+#else
+    (void)x, (void)out, (void)n, (void)accuracy;
+    return false;
+#endif
+}
@@ -0,0 +1,23 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime CPU detection
+#define NORMAL_DISTRIBUTION_SIMD_KERNEL
+#include "normal_distribution_simd.h"
+
+bool normal_cdf_batch_avx512(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+#if defined(__AVX512F__)
+    normal_cdf_batch_kernel<VecAVX512>(x, out, n, accuracy);
+    return true;
+#else
+    (void)x, (void)out, (void)n, (void)accuracy;
+    return false;
+#endif
+}
+
+bool normal_pdf_batch_avx512(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+#if defined(__AVX512F__)
+    normal_pdf_batch_kernel<VecAVX512>(x, out, n, accuracy);
+    return true;
+#else
+    (void)x, (void)out, (void)n, (void)accuracy;
+    return false;
+#endif
+}
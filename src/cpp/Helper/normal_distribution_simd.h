@@ -0,0 +1,107 @@
+#ifndef NORMAL_DISTRIBUTION_SIMD_H
+#define NORMAL_DISTRIBUTION_SIMD_H
+
+#include <cstddef>
+
+#include "finmath/Helper/normal_distribution.h"
+
+// FAST tier CDF table: cell c covers x in [kFastNormalLo + c / kFastNormalScale, ... + 1 / kFastNormalScale)
+// and holds the cubic a0 + a1 t + a2 t^2 + a3 t^3 in the cell coordinate t in [0, 1] at
+// table[4c .. 4c + 4). Built once by normal_distribution.cpp, which keeps a PDF table of the
+// same layout for the scalar path.
+constexpr double kFastNormalLo = -8.0;
+constexpr double kFastNormalScale = 16.0;
+constexpr size_t kFastNormalCells = 256;
+
+// Past |x| = 40 both tails are 0 in double precision; the HIGH tier clamps there to keep x^2 finite
+constexpr double kNormalClamp = 40.0;
+
+const double* fast_normal_cdf_table();
+
+// Instruction-set specific kernels of normal_cdf_batch / normal_pdf_batch for the HIGH and
+// FAST tiers. Each returns false when its translation unit was built without the matching
+// compiler flags.
+bool normal_cdf_batch_avx2(const double* x, double* out, size_t n, NormalAccuracy accuracy);
+bool normal_cdf_batch_avx512(const double* x, double* out, size_t n, NormalAccuracy accuracy);
+bool normal_pdf_batch_avx2(const double* x, double* out, size_t n, NormalAccuracy accuracy);
+bool normal_pdf_batch_avx512(const double* x, double* out, size_t n, NormalAccuracy accuracy);
+
+#ifdef NORMAL_DISTRIBUTION_SIMD_KERNEL
+
+#include "simd_math.h"
+
+namespace {
+
+template <typename V>
+inline V vnormal_cdf_high(V x) {
+    x = vmin(V::set1(kNormalClamp), vmax(V::set1(-kNormalClamp), x));
+    return vnormal_cdf(x);
+}
+
+template <typename V>
+inline V vnormal_pdf_high(V x) {
+    x = vmin(V::set1(kNormalClamp), vmax(V::set1(-kNormalClamp), x));
+    return vnormal_pdf(x);
+}
+
+// Cubic of the table cell holding x. Arguments outside the table take its end values.
+template <typename V>
+inline V vnormal_cdf_fast(V x, const double* table) {
+    // vmax(x, lo) maps NaN to lo so the gather index stays in range; NaN is restored below
+    V u = (vmax(x, V::set1(kFastNormalLo)) - V::set1(kFastNormalLo)) * V::set1(kFastNormalScale);
+    u = vmin(u, V::set1(static_cast<double>(kFastNormalCells)));
+    V cell = vmin(vround(u - V::set1(0.5)), V::set1(static_cast<double>(kFastNormalCells - 1)));
+    V t = u - cell;
+    V index = cell * V::set1(4.0);
+    V result = vgather(table + 3, index);
+    result = vfma(result, t, vgather(table + 2, index));
+    result = vfma(result, t, vgather(table + 1, index));
+    result = vfma(result, t, vgather(table, index));
+    // The cubic may overshoot [0, 1] by its error in the tails
+    result = vmin(V::set1(1.0), vmax(V::set1(0.0), result));
+    return vselect(visnan(x), x, result);
+}
+
+// out[i] = f(x[i]); the last partial vector goes through a padded buffer
+template <typename V, typename F>
+void normal_batch_kernel(const double* x, double* out, size_t n, F f) {
+    constexpr size_t w = V::width;
+    size_t i = 0;
+    for (; i + w <= n; i += w) {
+        V::store(out + i, f(V::load(x + i)));
+    }
+    if (i == n) {
+        return;
+    }
+    double tail[w] = {};
+    for (size_t j = 0; i + j < n; ++j) {
+        tail[j] = x[i + j];
+    }
+    V::store(tail, f(V::load(tail)));
+    for (size_t j = 0; i + j < n; ++j) {
+        out[i + j] = tail[j];
+    }
+}
+
+template <typename V>
+void normal_cdf_batch_kernel(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+    if (accuracy == NormalAccuracy::FAST) {
+        const double* table = fast_normal_cdf_table();
+        normal_batch_kernel<V>(x, out, n, [table](V v) { return vnormal_cdf_fast(v, table); });
+    } else {
+        normal_batch_kernel<V>(x, out, n, [](V v) { return vnormal_cdf_high(v); });
+    }
+}
+
+// The vectorized exp outruns the four gathers of a table lookup, so FAST shares the HIGH kernel
+template <typename V>
+void normal_pdf_batch_kernel(const double* x, double* out, size_t n, NormalAccuracy accuracy) {
+    (void)accuracy;
+    normal_batch_kernel<V>(x, out, n, [](V v) { return vnormal_pdf_high(v); });
+}
+
+} // namespace
+
+#endif // NORMAL_DISTRIBUTION_SIMD_KERNEL
+
+#endif // NORMAL_DISTRIBUTION_SIMD_H
@@ -0,0 +1,76 @@
+#include "finmath/Helper/scratch_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+ScratchArena::ScratchArena(size_t initial_capacity)
+    : block_(0), offset_(0), initial_capacity_(std::max<size_t>(initial_capacity, kAlignment)), heap_allocations_(0) {}
+
+ScratchArena::~ScratchArena() {
+    for (const Block& block : blocks_) {
+        ::operator delete(block.data, std::align_val_t(kAlignment));
+    }
+}
+
+void ScratchArena::add_block(size_t bytes) {
+    Block block{static_cast<char*>(::operator new(bytes, std::align_val_t(kAlignment))), bytes};
+    ++heap_allocations_;
+    blocks_.push_back(block);
+}
+
+void* ScratchArena::do_allocate(size_t bytes, size_t alignment) {
+    if (blocks_.empty()) {
+        add_block(initial_capacity_);
+    }
+    alignment = std::max<size_t>(alignment, 1);
+    for (;;) {
+        const Block& block = blocks_[block_];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        const size_t start = (base + offset_ + alignment - 1) / alignment * alignment - base;
+        if (start + bytes <= block.size) {
+            offset_ = start + bytes;
+            return block.data + start;
+        }
+        if (block_ + 1 == blocks_.size()) {
+            // Grow geometrically, so a loop settles after a few passes
+            add_block(std::max(bytes + alignment, 2 * blocks_.back().size));
+        }
+        ++block_;
+        offset_ = 0;
+    }
+}
+
+void ScratchArena::rewind(size_t block, size_t offset) {
+    block_ = block;
+    offset_ = offset;
+    if (block == 0 && offset == 0 && blocks_.size() > 1) {
+        // A pass outgrew the first block: replace the chain with one block of its size
+        size_t total = capacity();
+        for (const Block& b : blocks_) {
+            ::operator delete(b.data, std::align_val_t(kAlignment));
+        }
+        blocks_.clear();
+        add_block(total);
+    }
+}
+
+void ScratchArena::reset() {
+    rewind(0, 0);
+}
+
+size_t ScratchArena::capacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+size_t ScratchArena::used() const {
+    size_t total = offset_;
+    for (size_t b = 0; b < block_ && b < blocks_.size(); ++b) {
+        total += blocks_[b].size;
+    }
+    return total;
+}
@@ -0,0 +1,48 @@
+#include "finmath/Helper/simd.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+SimdLevel query_cpu() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+std::atomic<int>& active_level() {
+    static std::atomic<int> level(static_cast<int>(detect_simd_level()));
+    return level;
+}
+
+} // namespace
+
+SimdLevel detect_simd_level() {
+    static const SimdLevel detected = query_cpu();
+    return detected;
+}
+
+SimdLevel active_simd_level() {
+    return static_cast<SimdLevel>(active_level().load(std::memory_order_relaxed));
+}
+
+void set_simd_level(SimdLevel level) {
+    int capped = std::min(static_cast<int>(level), static_cast<int>(detect_simd_level()));
+    active_level().store(capped, std::memory_order_relaxed);
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "avx512";
+        case SimdLevel::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,172 @@
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+// Vectorized exp/log/erfc and the standard normal CDF/PDF, written once against the
+// wrappers in simd_vec.h. Each kernel translation unit instantiates these for its own
+// vector type. Accuracy (relative, against the C library) for double vectors:
+//   vexp, vlog           ~1 ulp; vexp returns 0 below x = -708 and inf above x = 709
+//   verfc, vnormal_cdf   < 1e-15 for arguments up to ~26 (erfc(z) underflows past that)
+//   vinverse_normal_cdf  < 1.2e-9 (Acklam's approximation without refinement)
+// Float vectors evaluate the same polynomials in single precision and are good to a few
+// float ulps (~1e-6 relative); vexp's range shrinks to [-87, 88].
+// Inputs are expected to be finite; vlog expects positive normal numbers.
+
+#include <cstddef>
+
+#include "erfc_coeffs.h"
+#include "inverse_normal_coeffs.h"
+#include "simd_vec.h"
+
+namespace {
+
+constexpr double kLog2e = 1.44269504088896338700e+00;
+constexpr double kSqrt2 = 1.41421356237309504880e+00;
+constexpr double kInvSqrt2 = 7.07106781186547524401e-01;
+constexpr double kInvSqrt2Pi = 3.98942280401432677940e-01;
+
+// Taylor coefficients 1/k! for exp(r), |r| <= ln(2)/2, highest degree first
+constexpr double kExpCoeffs[] = {
+    1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0,
+    1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0,
+};
+
+// log(m) = 2 atanh(f) = 2f * sum s^k / (2k + 1) with f = (m - 1) / (m + 1), s = f^2, highest degree first
+constexpr double kLogCoeffs[] = {
+    1.0 / 21.0, 1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0, 1.0 / 11.0,
+    1.0 / 9.0, 1.0 / 7.0, 1.0 / 5.0, 1.0 / 3.0, 1.0,
+};
+
+// Range of vexp and the two-part split of ln2 (the high part has enough trailing zero
+// bits that n * hi is exact for every n the range allows)
+template <typename Scalar>
+struct ExpConstants;
+
+template <>
+struct ExpConstants<double> {
+    static constexpr double lo = -708.0;
+    static constexpr double hi = 709.0;
+    static constexpr double ln2_hi = 6.93147180369123816490e-01;
+    static constexpr double ln2_lo = 1.90821492927058770002e-10;
+};
+
+template <>
+struct ExpConstants<float> {
+    static constexpr float lo = -87.0f;
+    static constexpr float hi = 88.0f;
+    static constexpr float ln2_hi = 0.693359375f;
+    static constexpr float ln2_lo = -2.12194440e-4f;
+};
+
+template <typename V, size_t N>
+inline V vhorner(V x, const double (&coeffs)[N]) {
+    V result = V::set1(coeffs[0]);
+    for (size_t i = 1; i < N; ++i) {
+        result = vfma(result, x, V::set1(coeffs[i]));
+    }
+    return result;
+}
+
+template <typename V>
+inline V vexp(V x) {
+    using Constants = ExpConstants<typename V::Scalar>;
+
+    // Keep 2^n representable; results outside the range are patched afterwards
+    const V lo = V::set1(Constants::lo);
+    const V hi = V::set1(Constants::hi);
+    V clamped = vmin(hi, vmax(lo, x));
+
+    // x = n ln2 + r with |r| <= ln2 / 2 (Cody-Waite split of ln2)
+    V n = vround(clamped * V::set1(kLog2e));
+    V r = vfma(n, V::set1(-Constants::ln2_hi), clamped);
+    r = vfma(n, V::set1(-Constants::ln2_lo), r);
+
+    V result = vhorner(r, kExpCoeffs) * vpow2i(n);
+    result = vselect(vless(x, lo), V::set1(0.0), result);
+    return vselect(vless(hi, x), V::set1(__builtin_huge_val()), result);
+}
+
+template <typename V>
+inline V vlog(V x) {
+    V mantissa, exponent;
+    vsplit_exponent(x, mantissa, exponent);
+
+    // Move the mantissa into [sqrt(2)/2, sqrt(2)) so f stays below 0.172
+    auto high = vless(V::set1(kSqrt2), mantissa);
+    mantissa = vselect(high, mantissa * V::set1(0.5), mantissa);
+    exponent = vselect(high, exponent + V::set1(1.0), exponent);
+
+    const V one = V::set1(1.0);
+    V f = (mantissa - one) / (mantissa + one);
+    V two_f = f + f;
+    V log_mantissa = two_f * vhorner(f * f, kLogCoeffs);
+
+    using Constants = ExpConstants<typename V::Scalar>;
+    return vfma(exponent, V::set1(Constants::ln2_hi), vfma(exponent, V::set1(Constants::ln2_lo), log_mantissa));
+}
+
+// erfc(z) for z >= 0, given exp(-z^2) computed by the caller
+template <typename V>
+inline V verfc_scaled(V z, V exp_minus_z2) {
+    // One division serves both y = (z - K) / (z + K) and the 1 / (1 + 2z) prefactor
+    const V k = V::set1(kErfcK);
+    V prefactor = vfma(V::set1(2.0), z, V::set1(1.0));
+    V inv = V::set1(1.0) / ((z + k) * prefactor);
+    V y = (z - k) * prefactor * inv;
+    V series = vhorner(y, kErfcPoly);
+
+    return series * exp_minus_z2 * ((z + k) * inv);
+}
+
+// Phi(x) given exp(-x^2 / 2), for callers that already have it (e.g. from the PDF)
+template <typename V>
+inline V vnormal_cdf_scaled(V x, V exp_minus_half_x2) {
+    // Phi(x) = erfc(-x / sqrt(2)) / 2; evaluate the tail for |x| and reflect
+    V z = vabs(x) * V::set1(kInvSqrt2);
+    V tail = V::set1(0.5) * verfc_scaled(z, exp_minus_half_x2);
+    return vselect(vless(x, V::set1(0.0)), tail, V::set1(1.0) - tail);
+}
+
+// exp(-x^2 / 2) without the rounding error of x^2: with x^2 = sq + err exactly,
+// exp(-x^2 / 2) = exp(-sq / 2) (1 - err / 2) to within err^2. The plain form loses
+// x^2 / 2 ulps of relative accuracy, about 30 ulps at x = 8.
+template <typename V>
+inline V vgauss(V x) {
+    V sq = x * x;
+    V err = vfma(x, x, -sq);
+    return vexp(V::set1(-0.5) * sq) * vfma(V::set1(-0.5), err, V::set1(1.0));
+}
+
+template <typename V>
+inline V vnormal_cdf(V x) {
+    return vnormal_cdf_scaled(x, vgauss(x));
+}
+
+template <typename V>
+inline V vnormal_pdf(V x) {
+    return vgauss(x) * V::set1(kInvSqrt2Pi);
+}
+
+// Inverse normal CDF for p in (0, 1): both Acklam branches are evaluated and blended
+template <typename V>
+inline V vinverse_normal_cdf(V p) {
+    const V half = V::set1(0.5);
+    V q = p - half;
+    V r = q * q;
+    V central = q * vhorner(r, kAcklamA) / vhorner(r, kAcklamB);
+    typename V::Mask in_central = vless(vabs(q), V::set1(0.5 - kAcklamLow));
+    // About 95% of uniform inputs are central, so skip the log and sqrt when no lane needs them
+    if (vall(in_central)) {
+        return central;
+    }
+
+    V tail_p = vmin(p, V::set1(1.0) - p);
+    V t = vsqrt(V::set1(-2.0) * vlog(tail_p));
+    V tail = vhorner(t, kAcklamC) / vhorner(t, kAcklamD);
+    tail = vselect(vless(half, p), -tail, tail);
+
+    return vselect(in_central, central, tail);
+}
+
+} // namespace
+
+#endif // SIMD_MATH_H
@@ -0,0 +1,219 @@
+#ifndef SIMD_VEC_H
+#define SIMD_VEC_H
+
+// Thin wrappers over AVX2 / AVX-512 double and float vectors used by the generic kernels
+// in simd_math.h. Each wrapper names its element type as Scalar. Only include this from translation units compiled with the matching
+// instruction-set flags (see CMakeLists.txt); everything lives in an anonymous
+// namespace so no code built for a wider ISA can leak into the rest of the library.
+
+#if (defined(__AVX512F__) || defined(__AVX2__)) && defined(__GNUC__) && !defined(__clang__)
+// GCC 12 flags the undefined-vector placeholders (__Y) inside its own AVX-512 and AVX2
+// intrinsics, the gathers and the vexp / vlog / vsqrt helpers, as (maybe) uninitialized
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+#include <immintrin.h>
+
+namespace {
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+struct VecAVX2 {
+    static constexpr int width = 4;
+    using Scalar = double;
+    using Mask = __m256d;
+
+    __m256d v;
+
+    static VecAVX2 set1(double x) { return {_mm256_set1_pd(x)}; }
+    static VecAVX2 load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static void store(double* p, VecAVX2 a) { _mm256_storeu_pd(p, a.v); }
+};
+
+inline VecAVX2 operator+(VecAVX2 a, VecAVX2 b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline VecAVX2 operator-(VecAVX2 a, VecAVX2 b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline VecAVX2 operator*(VecAVX2 a, VecAVX2 b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline VecAVX2 operator/(VecAVX2 a, VecAVX2 b) { return {_mm256_div_pd(a.v, b.v)}; }
+inline VecAVX2 operator-(VecAVX2 a) { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+
+// a * b + c with a single rounding
+inline VecAVX2 vfma(VecAVX2 a, VecAVX2 b, VecAVX2 c) { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+inline VecAVX2 vsqrt(VecAVX2 a) { return {_mm256_sqrt_pd(a.v)}; }
+inline VecAVX2 vabs(VecAVX2 a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+// NaN in b propagates, so clamp as vmin(hi, vmax(lo, x))
+inline VecAVX2 vmin(VecAVX2 a, VecAVX2 b) { return {_mm256_min_pd(a.v, b.v)}; }
+inline VecAVX2 vmax(VecAVX2 a, VecAVX2 b) { return {_mm256_max_pd(a.v, b.v)}; }
+inline VecAVX2 vround(VecAVX2 a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+inline VecAVX2::Mask vless(VecAVX2 a, VecAVX2 b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+// Lanes of a where mask is set, lanes of b elsewhere
+inline VecAVX2 vselect(VecAVX2::Mask mask, VecAVX2 a, VecAVX2 b) { return {_mm256_blendv_pd(b.v, a.v, mask)}; }
+// True when every lane of mask is set
+inline bool vall(VecAVX2::Mask mask) { return _mm256_movemask_pd(mask) == 0xF; }
+inline VecAVX2::Mask visnan(VecAVX2 a) { return _mm256_cmp_pd(a.v, a.v, _CMP_UNORD_Q); }
+
+// base[index] per lane for integer-valued index in [0, 2^31)
+inline VecAVX2 vgather(const double* base, VecAVX2 index) {
+    return {_mm256_i32gather_pd(base, _mm256_cvtpd_epi32(index.v), 8)};
+}
+
+// 2^n for integer-valued n in [-1022, 1023]
+inline VecAVX2 vpow2i(VecAVX2 n) {
+    // Adding 1.5 * 2^52 moves the integer into the low mantissa bits
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+    __m256i bits = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(n.v, magic)), _mm256_castpd_si256(magic));
+    bits = _mm256_slli_epi64(_mm256_add_epi64(bits, _mm256_set1_epi64x(1023)), 52);
+    return {_mm256_castsi256_pd(bits)};
+}
+
+// Split a positive normal x into mantissa in [1, 2) and integer-valued exponent
+inline void vsplit_exponent(VecAVX2 x, VecAVX2& mantissa, VecAVX2& exponent) {
+    const __m256i bits = _mm256_castpd_si256(x.v);
+    const __m256i mantissa_mask = _mm256_set1_epi64x(0x000fffffffffffffLL);
+    const __m256i one_bits = _mm256_set1_epi64x(0x3ff0000000000000LL);
+    mantissa.v = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, mantissa_mask), one_bits));
+
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+    __m256i e = _mm256_sub_epi64(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(1023));
+    exponent.v = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(e, _mm256_castpd_si256(magic))), magic);
+}
+
+// Eight floats; same operations as VecAVX2
+struct VecAVX2f {
+    static constexpr int width = 8;
+    using Scalar = float;
+    using Mask = __m256;
+
+    __m256 v;
+
+    static VecAVX2f set1(float x) { return {_mm256_set1_ps(x)}; }
+    static VecAVX2f load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    static void store(float* p, VecAVX2f a) { _mm256_storeu_ps(p, a.v); }
+};
+
+inline VecAVX2f operator+(VecAVX2f a, VecAVX2f b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline VecAVX2f operator-(VecAVX2f a, VecAVX2f b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline VecAVX2f operator*(VecAVX2f a, VecAVX2f b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline VecAVX2f operator/(VecAVX2f a, VecAVX2f b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline VecAVX2f operator-(VecAVX2f a) { return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+
+inline VecAVX2f vfma(VecAVX2f a, VecAVX2f b, VecAVX2f c) { return {_mm256_fmadd_ps(a.v, b.v, c.v)}; }
+inline VecAVX2f vsqrt(VecAVX2f a) { return {_mm256_sqrt_ps(a.v)}; }
+inline VecAVX2f vabs(VecAVX2f a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+inline VecAVX2f vmin(VecAVX2f a, VecAVX2f b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline VecAVX2f vmax(VecAVX2f a, VecAVX2f b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline VecAVX2f vround(VecAVX2f a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+inline VecAVX2f::Mask vless(VecAVX2f a, VecAVX2f b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+inline VecAVX2f vselect(VecAVX2f::Mask mask, VecAVX2f a, VecAVX2f b) { return {_mm256_blendv_ps(b.v, a.v, mask)}; }
+inline bool vall(VecAVX2f::Mask mask) { return _mm256_movemask_ps(mask) == 0xFF; }
+inline VecAVX2f::Mask visnan(VecAVX2f a) { return _mm256_cmp_ps(a.v, a.v, _CMP_UNORD_Q); }
+inline VecAVX2f vgather(const float* base, VecAVX2f index) {
+    return {_mm256_i32gather_ps(base, _mm256_cvtps_epi32(index.v), 4)};
+}
+
+// 2^n for integer-valued n in [-126, 127]
+inline VecAVX2f vpow2i(VecAVX2f n) {
+    __m256i bits = _mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127));
+    return {_mm256_castsi256_ps(_mm256_slli_epi32(bits, 23))};
+}
+
+inline void vsplit_exponent(VecAVX2f x, VecAVX2f& mantissa, VecAVX2f& exponent) {
+    const __m256i bits = _mm256_castps_si256(x.v);
+    const __m256i mantissa_mask = _mm256_set1_epi32(0x007fffff);
+    const __m256i one_bits = _mm256_set1_epi32(0x3f800000);
+    mantissa.v = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantissa_mask), one_bits));
+    exponent.v = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+}
+
+#endif // __AVX2__ && __FMA__
+
+#if defined(__AVX512F__)
+
+struct VecAVX512 {
+    static constexpr int width = 8;
+    using Scalar = double;
+    using Mask = __mmask8;
+
+    __m512d v;
+
+    static VecAVX512 set1(double x) { return {_mm512_set1_pd(x)}; }
+    static VecAVX512 load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    static void store(double* p, VecAVX512 a) { _mm512_storeu_pd(p, a.v); }
+};
+
+inline VecAVX512 operator+(VecAVX512 a, VecAVX512 b) { return {_mm512_add_pd(a.v, b.v)}; }
+inline VecAVX512 operator-(VecAVX512 a, VecAVX512 b) { return {_mm512_sub_pd(a.v, b.v)}; }
+inline VecAVX512 operator*(VecAVX512 a, VecAVX512 b) { return {_mm512_mul_pd(a.v, b.v)}; }
+inline VecAVX512 operator/(VecAVX512 a, VecAVX512 b) { return {_mm512_div_pd(a.v, b.v)}; }
+inline VecAVX512 operator-(VecAVX512 a) { return {_mm512_sub_pd(_mm512_setzero_pd(), a.v)}; }
+
+inline VecAVX512 vfma(VecAVX512 a, VecAVX512 b, VecAVX512 c) { return {_mm512_fmadd_pd(a.v, b.v, c.v)}; }
+inline VecAVX512 vsqrt(VecAVX512 a) { return {_mm512_sqrt_pd(a.v)}; }
+inline VecAVX512 vabs(VecAVX512 a) { return {_mm512_abs_pd(a.v)}; }
+inline VecAVX512 vmin(VecAVX512 a, VecAVX512 b) { return {_mm512_min_pd(a.v, b.v)}; }
+inline VecAVX512 vmax(VecAVX512 a, VecAVX512 b) { return {_mm512_max_pd(a.v, b.v)}; }
+inline VecAVX512 vround(VecAVX512 a) { return {_mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+inline VecAVX512::Mask vless(VecAVX512 a, VecAVX512 b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+inline VecAVX512 vselect(VecAVX512::Mask mask, VecAVX512 a, VecAVX512 b) { return {_mm512_mask_blend_pd(mask, b.v, a.v)}; }
+inline bool vall(VecAVX512::Mask mask) { return mask == 0xFF; }
+inline VecAVX512::Mask visnan(VecAVX512 a) { return _mm512_cmp_pd_mask(a.v, a.v, _CMP_UNORD_Q); }
+inline VecAVX512 vgather(const double* base, VecAVX512 index) {
+    return {_mm512_i32gather_pd(_mm512_cvtpd_epi32(index.v), base, 8)};
+}
+
+inline VecAVX512 vpow2i(VecAVX512 n) { return {_mm512_scalef_pd(_mm512_set1_pd(1.0), n.v)}; }
+
+inline void vsplit_exponent(VecAVX512 x, VecAVX512& mantissa, VecAVX512& exponent) {
+    mantissa.v = _mm512_getmant_pd(x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+    exponent.v = _mm512_getexp_pd(x.v);
+}
+
+// Sixteen floats; same operations as VecAVX512
+struct VecAVX512f {
+    static constexpr int width = 16;
+    using Scalar = float;
+    using Mask = __mmask16;
+
+    __m512 v;
+
+    static VecAVX512f set1(float x) { return {_mm512_set1_ps(x)}; }
+    static VecAVX512f load(const float* p) { return {_mm512_loadu_ps(p)}; }
+    static void store(float* p, VecAVX512f a) { _mm512_storeu_ps(p, a.v); }
+};
+
+inline VecAVX512f operator+(VecAVX512f a, VecAVX512f b) { return {_mm512_add_ps(a.v, b.v)}; }
+inline VecAVX512f operator-(VecAVX512f a, VecAVX512f b) { return {_mm512_sub_ps(a.v, b.v)}; }
+inline VecAVX512f operator*(VecAVX512f a, VecAVX512f b) { return {_mm512_mul_ps(a.v, b.v)}; }
+inline VecAVX512f operator/(VecAVX512f a, VecAVX512f b) { return {_mm512_div_ps(a.v, b.v)}; }
+inline VecAVX512f operator-(VecAVX512f a) { return {_mm512_sub_ps(_mm512_setzero_ps(), a.v)}; }
+
+inline VecAVX512f vfma(VecAVX512f a, VecAVX512f b, VecAVX512f c) { return {_mm512_fmadd_ps(a.v, b.v, c.v)}; }
+inline VecAVX512f vsqrt(VecAVX512f a) { return {_mm512_sqrt_ps(a.v)}; }
+inline VecAVX512f vabs(VecAVX512f a) { return {_mm512_abs_ps(a.v)}; }
+inline VecAVX512f vmin(VecAVX512f a, VecAVX512f b) { return {_mm512_min_ps(a.v, b.v)}; }
+inline VecAVX512f vmax(VecAVX512f a, VecAVX512f b) { return {_mm512_max_ps(a.v, b.v)}; }
+inline VecAVX512f vround(VecAVX512f a) { return {_mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+inline VecAVX512f::Mask vless(VecAVX512f a, VecAVX512f b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ); }
+inline VecAVX512f vselect(VecAVX512f::Mask mask, VecAVX512f a, VecAVX512f b) { return {_mm512_mask_blend_ps(mask, b.v, a.v)}; }
+inline bool vall(VecAVX512f::Mask mask) { return mask == 0xFFFF; }
+inline VecAVX512f::Mask visnan(VecAVX512f a) { return _mm512_cmp_ps_mask(a.v, a.v, _CMP_UNORD_Q); }
+inline VecAVX512f vgather(const float* base, VecAVX512f index) {
+    return {_mm512_i32gather_ps(_mm512_cvtps_epi32(index.v), base, 4)};
+}
+
+inline VecAVX512f vpow2i(VecAVX512f n) { return {_mm512_scalef_ps(_mm512_set1_ps(1.0f), n.v)}; }
+
+inline void vsplit_exponent(VecAVX512f x, VecAVX512f& mantissa, VecAVX512f& exponent) {
+    mantissa.v = _mm512_getmant_ps(x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+    exponent.v = _mm512_getexp_ps(x.v);
+}
+
+#endif // __AVX512F__
+
+} // namespace
+
+#endif // SIMD_VEC_H
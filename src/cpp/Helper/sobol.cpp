@@ -0,0 +1,184 @@
+#include "finmath/Helper/sobol.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "finmath/Helper/philox.h"
+
+namespace {
+
+constexpr int kBits = 32;
+
+// Primitive polynomials up to this degree give 1111 dimensions
+constexpr int kMaxDegree = 13;
+
+struct Polynomial {
+    int degree;
+    uint32_t coefficients;  // middle coefficients a_1..a_{s-1}, a_1 in the highest bit
+};
+
+// Initial direction numbers m_1..m_s from Joe and Kuo (new-joe-kuo-6.21201) for dimensions 2-21
+const std::vector<std::vector<uint32_t>> kJoeKuoInitial = {
+    {1}, {1, 3}, {1, 3, 1}, {1, 1, 1}, {1, 1, 3, 3}, {1, 3, 5, 13}, {1, 1, 5, 5, 17}, {1, 1, 5, 5, 5},
+    {1, 1, 7, 11, 19}, {1, 1, 5, 1, 1}, {1, 1, 1, 3, 11}, {1, 3, 5, 5, 31}, {1, 3, 3, 9, 7, 49},
+    {1, 1, 1, 15, 21, 21}, {1, 3, 1, 13, 27, 49}, {1, 1, 1, 15, 7, 5}, {1, 3, 1, 15, 13, 25},
+    {1, 1, 5, 5, 19, 61}, {1, 3, 7, 11, 23, 15, 103}, {1, 3, 7, 13, 13, 15, 69},
+};
+
+// Product of two polynomials over GF(2) modulo p, which has degree `degree`
+uint32_t multiply_mod(uint32_t a, uint32_t b, uint32_t p, int degree) {
+    uint32_t result = 0;
+    while (b != 0) {
+        if (b & 1u) {
+            result ^= a;
+        }
+        b >>= 1;
+        a <<= 1;
+        if ((a >> degree) & 1u) {
+            a ^= p;
+        }
+    }
+    return result;
+}
+
+// x^e modulo p
+uint32_t power_of_x_mod(uint64_t e, uint32_t p, int degree) {
+    uint32_t result = 1;
+    uint32_t base = 2;
+    while (e != 0) {
+        if (e & 1u) {
+            result = multiply_mod(result, base, p, degree);
+        }
+        base = multiply_mod(base, base, p, degree);
+        e >>= 1;
+    }
+    return result;
+}
+
+// p is primitive when x has multiplicative order exactly 2^degree - 1 modulo p
+bool is_primitive(uint32_t p, int degree) {
+    uint64_t order = (uint64_t(1) << degree) - 1;
+    if (power_of_x_mod(order, p, degree) != 1) {
+        return false;
+    }
+    // The order is below 2^13, so trial division finds its prime factors quickly
+    uint64_t rest = order;
+    for (uint64_t q = 2; q <= rest; ++q) {
+        if (rest % q != 0) {
+            continue;
+        }
+        if (power_of_x_mod(order / q, p, degree) == 1) {
+            return false;
+        }
+        while (rest % q == 0) {
+            rest /= q;
+        }
+    }
+    return true;
+}
+
+// Primitive polynomials ordered by degree, then by coefficients (the Joe-Kuo order)
+const std::vector<Polynomial>& primitive_polynomials() {
+    static const std::vector<Polynomial> polynomials = [] {
+        std::vector<Polynomial> result = {{1, 0}};
+        for (int degree = 2; degree <= kMaxDegree; ++degree) {
+            for (uint32_t a = 0; a < (1u << (degree - 1)); ++a) {
+                uint32_t p = (1u << degree) | (a << 1) | 1u;
+                if (is_primitive(p, degree)) {
+                    result.push_back({degree, a});
+                }
+            }
+        }
+        return result;
+    }();
+    return polynomials;
+}
+
+// Direction numbers v_1..v_32 of one dimension (index 0 is the van der Corput dimension)
+void fill_directions(size_t dimension, uint32_t* v) {
+    if (dimension == 0) {
+        for (int k = 0; k < kBits; ++k) {
+            v[k] = 1u << (kBits - 1 - k);
+        }
+        return;
+    }
+
+    const Polynomial& poly = primitive_polynomials()[dimension - 1];
+    const int s = poly.degree;
+
+    // Initial numbers: odd m_k < 2^k
+    for (int k = 0; k < s; ++k) {
+        uint32_t m;
+        if (dimension - 1 < kJoeKuoInitial.size()) {
+            m = kJoeKuoInitial[dimension - 1][k];
+        } else {
+            PhiloxCounter bits = philox4x32({static_cast<uint32_t>(dimension), static_cast<uint32_t>(k), 0, 0},
+                                            philox_key(0x50B01));
+            m = (bits[0] & ((2u << k) - 1)) | 1u;
+        }
+        v[k] = m << (kBits - 1 - k);
+    }
+
+    // v_k = a_1 v_{k-1} ^ ... ^ a_{s-1} v_{k-s+1} ^ v_{k-s} ^ (v_{k-s} >> s)
+    for (int k = s; k < kBits; ++k) {
+        uint32_t value = v[k - s] ^ (v[k - s] >> s);
+        for (int j = 1; j < s; ++j) {
+            if ((poly.coefficients >> (s - 1 - j)) & 1u) {
+                value ^= v[k - j];
+            }
+        }
+        v[k] = value;
+    }
+}
+
+int lowest_zero_bit(uint64_t x) {
+    int bit = 0;
+    while (x & 1u) {
+        x >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+} // namespace
+
+SobolSequence::SobolSequence(size_t dimensions, uint64_t seed)
+    : dimensions_(dimensions), directions_(dimensions * kBits), shift_(dimensions, 0) {
+    if (dimensions == 0 || dimensions > max_dimensions()) {
+        throw std::invalid_argument("Sobol dimension must be between 1 and " + std::to_string(max_dimensions()) + ".");
+    }
+    for (size_t d = 0; d < dimensions; ++d) {
+        fill_directions(d, &directions_[d * kBits]);
+    }
+    if (seed != 0) {
+        for (size_t d = 0; d < dimensions; ++d) {
+            shift_[d] = philox4x32({static_cast<uint32_t>(d), 0, 0, 0}, philox_key(seed))[0];
+        }
+    }
+}
+
+void SobolSequence::point(uint64_t index, uint32_t* out) const {
+    uint64_t gray = index ^ (index >> 1);
+    for (size_t d = 0; d < dimensions_; ++d) {
+        const uint32_t* v = &directions_[d * kBits];
+        uint32_t x = shift_[d];
+        for (int k = 0; k < kBits && (gray >> k) != 0; ++k) {
+            if ((gray >> k) & 1u) {
+                x ^= v[k];
+            }
+        }
+        out[d] = x;
+    }
+}
+
+void SobolSequence::next(uint64_t index, uint32_t* x) const {
+    // Consecutive Gray codes differ in the lowest zero bit of the index
+    int bit = lowest_zero_bit(index);
+    for (size_t d = 0; d < dimensions_; ++d) {
+        x[d] ^= directions_[d * kBits + bit];
+    }
+}
+
+size_t SobolSequence::max_dimensions() {
+    return primitive_polynomials().size() + 1;
+}
@@ -0,0 +1,217 @@
+#include "finmath/Helper/thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Work shared by the chunks of one parallel_for call; lives on the caller's stack
+struct ThreadPool::Job {
+    const std::function<void(size_t, size_t)>* body;
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t pending;
+    std::exception_ptr error;
+};
+
+namespace {
+
+// Chunks per thread: enough slack for stealing to even out uneven task costs
+constexpr size_t kChunksPerThread = 8;
+
+// Pool and queue index of the current thread when it is a worker
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_index = 0;
+
+size_t resolve_thread_count(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    return std::max<size_t>(num_threads, 1);
+}
+
+void pin_to_cpu(std::thread& thread, size_t cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(cpu), &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+std::mutex& default_pool_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unique_ptr<ThreadPool>& default_pool() {
+    static std::unique_ptr<ThreadPool> pool;
+    return pool;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_threads, bool pin_threads) : queued_(0), stopping_(false) {
+    size_t worker_count = resolve_thread_count(num_threads) - 1;
+    size_t cpu_count = resolve_thread_count(0);
+
+    queues_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+        if (pin_threads) {
+            // CPU 0 is left to the thread that drives the pool
+            pin_to_cpu(workers_.back(), (i + 1) % cpu_count);
+        }
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallel_for(size_t n, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (n == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = std::min((n + grain - 1) / grain, thread_count() * kChunksPerThread);
+    if (chunks <= 1 || queues_.empty()) {
+        body(0, n);
+        return;
+    }
+
+    Job job;
+    job.body = &body;
+    job.pending = chunks;
+
+    // Deal the chunks round-robin so every worker starts on its own queue
+    for (size_t i = 0; i < chunks; ++i) {
+        Task task = {&job, n * i / chunks, n * (i + 1) / chunks};
+        WorkerQueue& queue = *queues_[i % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_.notify_all();
+
+    // Help until nothing is left to take, then wait for the chunks still running
+    size_t self = current_pool == this ? current_index : queues_.size();
+    Task task;
+    while (try_pop(self, task) || try_steal(self, task)) {
+        run(task);
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (job.pending == 0) {
+            break;
+        }
+    }
+    {
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.done.wait(lock, [&job] { return job.pending == 0; });
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    Task task;
+    for (;;) {
+        if (try_pop(index, task) || try_steal(index, task)) {
+            run(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this] { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::try_pop(size_t index, Task& task) {
+    if (index >= queues_.size()) {
+        return false;
+    }
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ThreadPool::try_steal(size_t thief, Task& task) {
+    // External threads use thief == queues_.size() and visit every queue
+    size_t count = queues_.size();
+    for (size_t k = 1; k <= count; ++k) {
+        WorkerQueue& queue = *queues_[(thief + k) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(const Task& task) {
+    Job& job = *task.job;
+    std::exception_ptr error;
+    try {
+        (*job.body)(task.begin, task.end);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // The caller may destroy the job as soon as pending reaches 0, so finish under the lock
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (error && !job.error) {
+        job.error = error;
+    }
+    if (--job.pending == 0) {
+        job.done.notify_all();
+    }
+}
+
+ThreadPool& default_thread_pool() {
+    std::lock_guard<std::mutex> lock(default_pool_mutex());
+    std::unique_ptr<ThreadPool>& pool = default_pool();
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>();
+    }
+    return *pool;
+}
+
+void set_default_thread_count(size_t num_threads, bool pin_threads) {
+    std::lock_guard<std::mutex> lock(default_pool_mutex());
+    default_pool() = std::make_unique<ThreadPool>(num_threads, pin_threads);
+}
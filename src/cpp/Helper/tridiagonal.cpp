@@ -0,0 +1,66 @@
+#include "finmath/Helper/tridiagonal.h"
+
+#include <algorithm>
+
+// Forward order (reverse_ false) for rows k = 0..n-1:
+//   pivot_k = diagonal_k - lower_k factor_{k-1},  factor_k = upper_k / pivot_k
+//   y_k = (d_k - lower_k y_{k-1}) / pivot_k,      x_k = y_k - factor_k x_{k+1}
+// Reverse order runs the same recurrences over the rows n-1..0 with lower and upper swapped.
+// y_k is computed as d_k / pivot_k - (lower_k / pivot_k) y_{k-1}, so each step of both
+// sweeps is one multiply-add on the serial dependency chain.
+
+void TridiagonalSolver::factorize(const double* lower, const double* diagonal, const double* upper, size_t n,
+                                  bool reverse) {
+    n_ = n;
+    reverse_ = reverse;
+    factor_.resize(n);
+    inverse_.resize(n);
+    multiplier_.resize(n);
+    // Position k of the sweep is row k, or row n - 1 - k in reverse
+    double previous = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        size_t row = reverse ? n - 1 - k : k;
+        double towards_previous = k == 0 ? 0.0 : (reverse ? upper[row] : lower[row]);
+        double towards_next = k + 1 == n ? 0.0 : (reverse ? lower[row] : upper[row]);
+        double inverse = 1.0 / (diagonal[row] - towards_previous * previous);
+        multiplier_[k] = towards_previous * inverse;
+        inverse_[k] = inverse;
+        factor_[k] = towards_next * inverse;
+        previous = factor_[k];
+    }
+}
+
+template <bool Project>
+void TridiagonalSolver::substitute(double* x, const double* floor) const {
+    const size_t n = n_;
+    if (n == 0) {
+        return;
+    }
+    // Row of sweep position k
+    auto row = [&](size_t k) { return reverse_ ? n - 1 - k : k; };
+
+    double previous = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        size_t r = row(k);
+        previous = x[r] * inverse_[k] - multiplier_[k] * previous;
+        x[r] = previous;
+    }
+    double next = 0.0;
+    for (size_t k = n; k-- > 0;) {
+        size_t r = row(k);
+        double value = x[r] - factor_[k] * next;
+        if (Project) {
+            value = std::max(value, floor[r]);
+        }
+        x[r] = value;
+        next = value;
+    }
+}
+
+void TridiagonalSolver::solve(double* x) const {
+    substitute<false>(x, nullptr);
+}
+
+void TridiagonalSolver::solve_projected(double* x, const double* floor) const {
+    substitute<true>(x, floor);
+}
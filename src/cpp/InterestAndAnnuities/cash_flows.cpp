@@ -0,0 +1,561 @@
+#include "finmath/InterestAndAnnuities/cash_flows.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "finmath/Helper/aligned_allocator.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/simd.h"
+#include "cash_flows_simd.h"
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// IRR search range in v = 1 / (1 + rate): rates from 99900% down to -99.9%
+constexpr double kMinFactor = 1e-3;
+constexpr double kMaxFactor = 1e3;
+constexpr size_t kBracketGridPoints = 241;
+constexpr int kNewtonIterations = 50;
+constexpr int kBracketIterations = 200;
+// Newton stops once a step moves v by less than this fraction of v; the step after
+// would be of the order of its square
+constexpr double kFactorTolerance = 1e-13;
+
+// Discount factor panels of present_value_matrix, 256 KB, sized for L2
+constexpr size_t kTimeBlock = 256;
+constexpr size_t kScenarioBlock = 128;
+// Schedules per parallel_present_value_matrix task
+constexpr size_t kScheduleGrain = 256;
+
+bool check_annuity(double rate, int periods) {
+    if (periods < 0) {
+        std::cerr << "Number of periods must be non-negative." << std::endl;
+        return false;
+    }
+    if (!(rate > -1.0)) {
+        std::cerr << "Rate must be greater than -100%." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 1 - (1 + rate)^-periods, without cancellation for small rates
+double discount_complement(double rate, int periods) {
+    return -std::expm1(-periods * std::log1p(rate));
+}
+
+// Finite flows with at least one positive and one negative, so the NPV can change sign
+bool valid_flows(const double* cash_flows, size_t n) {
+    bool positive = false;
+    bool negative = false;
+    for (size_t k = 0; k < n; ++k) {
+        if (!std::isfinite(cash_flows[k])) {
+            return false;
+        }
+        positive = positive || cash_flows[k] > 0.0;
+        negative = negative || cash_flows[k] < 0.0;
+    }
+    return n >= 2 && positive && negative;
+}
+
+// NPV as a polynomial in v, p = sum_k c_k v^k, and its derivative dp/dv
+void horner(const double* cash_flows, size_t n, double v, double& p, double& dp) {
+    p = cash_flows[n - 1];
+    dp = 0.0;
+    for (size_t k = n - 1; k > 0; --k) {
+        dp = dp * v + p;
+        p = p * v + cash_flows[k - 1];
+    }
+}
+
+// Plain Newton on the NPV polynomial from v; true with the root in v once a step is
+// small enough, false if an iterate leaves the search range or the slope vanishes
+bool newton_factor(const double* cash_flows, size_t n, double& v) {
+    for (int iteration = 0; iteration < kNewtonIterations; ++iteration) {
+        double p, dp;
+        horner(cash_flows, n, v, p, dp);
+        const double step = p / dp;
+        const double next = v - step;
+        if (!std::isfinite(step) || !(next > kMinFactor && next < kMaxFactor)) {
+            return false;
+        }
+        v = next;
+        if (std::abs(step) <= kFactorTolerance * v) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fallback: bracket a sign change on a geometric grid of v, taking the bracket nearest
+// target (in log v), then Newton steps that fall back to bisection when they would leave
+// the bracket
+bool bracketed_factor(const double* cash_flows, size_t n, double target, double& v) {
+    const double ratio = std::pow(kMaxFactor / kMinFactor, 1.0 / (kBracketGridPoints - 1));
+    double lo = 0.0, hi = 0.0, best = std::numeric_limits<double>::infinity();
+    double x_prev = kMinFactor, p_prev, dp;
+    horner(cash_flows, n, x_prev, p_prev, dp);
+    for (size_t i = 1; i < kBracketGridPoints; ++i) {
+        const double x = kMinFactor * std::pow(ratio, static_cast<double>(i));
+        double p;
+        horner(cash_flows, n, x, p, dp);
+        if (std::isfinite(p) && std::isfinite(p_prev) && (p_prev <= 0.0) != (p <= 0.0)) {
+            const double distance = std::abs(std::log(std::sqrt(x_prev * x) / target));
+            if (distance < best) {
+                best = distance;
+                lo = x_prev;
+                hi = x;
+            }
+        }
+        x_prev = x;
+        p_prev = p;
+    }
+    if (!(best < std::numeric_limits<double>::infinity())) {
+        return false;
+    }
+
+    double p_lo;
+    horner(cash_flows, n, lo, p_lo, dp);
+    double x = 0.5 * (lo + hi);
+    for (int iteration = 0; iteration < kBracketIterations; ++iteration) {
+        double p;
+        horner(cash_flows, n, x, p, dp);
+        if (p == 0.0) {
+            break;
+        }
+        // Keep the sign change inside [lo, hi]
+        if ((p < 0.0) == (p_lo < 0.0)) {
+            lo = x;
+            p_lo = p;
+        } else {
+            hi = x;
+        }
+        double next = x - p / dp;
+        if (!(next > lo && next < hi)) {
+            next = 0.5 * (lo + hi);
+        }
+        const double step = next - x;
+        x = next;
+        if (std::abs(step) <= kFactorTolerance * x || hi - lo <= kFactorTolerance * x) {
+            break;
+        }
+    }
+    v = x;
+    return true;
+}
+
+double factor_guess(double guess) {
+    return guess > -1.0 && std::isfinite(guess) ? 1.0 / (1.0 + guess) : 1.0;
+}
+
+// Scalar IRR for flows that passed valid_flows
+double solve_irr(const double* cash_flows, size_t n, double guess, IrrStatus& status) {
+    double v = factor_guess(guess);
+    if (newton_factor(cash_flows, n, v) || bracketed_factor(cash_flows, n, factor_guess(guess), v)) {
+        status = IrrStatus::CONVERGED;
+        return (1.0 - v) / v;
+    }
+    status = IrrStatus::NO_SOLUTION;
+    return kNaN;
+}
+
+void irr_horner(SimdLevel level, const double* block, size_t periods, const double* v, double* value,
+                double* slope) {
+    switch (level) {
+        case SimdLevel::AVX512:
+            if (irr_horner_avx512(block, periods, v, value, slope)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (irr_horner_avx2(block, periods, v, value, slope)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+
+    for (size_t l = 0; l < kIrrLanes; ++l) {
+        value[l] = block[(periods - 1) * kIrrLanes + l];
+        slope[l] = 0.0;
+    }
+    for (size_t k = periods - 1; k > 0; --k) {
+        const double* row = block + (k - 1) * kIrrLanes;
+        for (size_t l = 0; l < kIrrLanes; ++l) {
+            slope[l] = slope[l] * v[l] + value[l];
+            value[l] = value[l] * v[l] + row[l];
+        }
+    }
+}
+
+void discount_panel(SimdLevel level, const double* flows, size_t flow_stride, size_t rows, const double* panel,
+                    size_t depth, size_t width, double* out, size_t out_stride) {
+    switch (level) {
+        case SimdLevel::AVX512:
+            if (discount_panel_avx512(flows, flow_stride, rows, panel, depth, width, out, out_stride)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (discount_panel_avx2(flows, flow_stride, rows, panel, depth, width, out, out_stride)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+
+    for (size_t r = 0; r < rows; ++r) {
+        const double* row = flows + r * flow_stride;
+        double* result = out + r * out_stride;
+        for (size_t k = 0; k < depth; ++k) {
+            const double amount = row[k];
+            const double* factors = panel + k * width;
+            for (size_t c = 0; c < width; ++c) {
+                result[c] += amount * factors[c];
+            }
+        }
+    }
+}
+
+} // namespace
+
+double annuity_present_value(double payment, double rate, int periods, bool due) {
+    if (!check_annuity(rate, periods)) {
+        return kNaN;
+    }
+    if (rate == 0.0) {
+        return payment * periods;
+    }
+    double value = payment * discount_complement(rate, periods) / rate;
+    return due ? value * (1.0 + rate) : value;
+}
+
+double annuity_future_value(double payment, double rate, int periods, bool due) {
+    if (!check_annuity(rate, periods)) {
+        return kNaN;
+    }
+    if (rate == 0.0) {
+        return payment * periods;
+    }
+    double value = payment * std::expm1(periods * std::log1p(rate)) / rate;
+    return due ? value * (1.0 + rate) : value;
+}
+
+double annuity_payment(double principal, double rate, int periods, bool due) {
+    if (!check_annuity(rate, periods)) {
+        return kNaN;
+    }
+    if (periods == 0) {
+        std::cerr << "Number of periods must be greater than 0." << std::endl;
+        return kNaN;
+    }
+    if (rate == 0.0) {
+        return principal / periods;
+    }
+    double payment = principal * rate / discount_complement(rate, periods);
+    return due ? payment / (1.0 + rate) : payment;
+}
+
+AmortizationSchedule amortization_schedule(double principal, double rate, int periods) {
+    AmortizationSchedule schedule;
+    if (!check_annuity(rate, periods)) {
+        return schedule;
+    }
+    if (periods == 0) {
+        std::cerr << "Number of periods must be greater than 0." << std::endl;
+        return schedule;
+    }
+
+    const double level_payment = annuity_payment(principal, rate, periods);
+    const size_t count = static_cast<size_t>(periods);
+    schedule.payment.resize(count);
+    schedule.interest.resize(count);
+    schedule.principal.resize(count);
+    schedule.balance.resize(count);
+
+    double balance = principal;
+    for (size_t k = 0; k < count; ++k) {
+        const double interest = balance * rate;
+        const double repaid = k + 1 == count ? balance : level_payment - interest;
+        balance = k + 1 == count ? 0.0 : balance - repaid;
+        schedule.payment[k] = interest + repaid;
+        schedule.interest[k] = interest;
+        schedule.principal[k] = repaid;
+        schedule.balance[k] = balance;
+    }
+    return schedule;
+}
+
+DiscountCurve::DiscountCurve(std::vector<double> times, std::vector<double> discount_factors)
+    : times_(std::move(times)), discount_factors_(std::move(discount_factors)) {
+    if (times_.empty() || times_.size() != discount_factors_.size()) {
+        throw std::invalid_argument("DiscountCurve needs one discount factor per pillar time.");
+    }
+    for (size_t i = 0; i < times_.size(); ++i) {
+        if (!(times_[i] > (i == 0 ? 0.0 : times_[i - 1])) || !std::isfinite(times_[i])) {
+            throw std::invalid_argument("DiscountCurve pillar times must be positive and strictly increasing.");
+        }
+        if (!(discount_factors_[i] > 0.0) || !std::isfinite(discount_factors_[i])) {
+            throw std::invalid_argument("DiscountCurve discount factors must be positive and finite.");
+        }
+    }
+
+    nodes_.reserve(times_.size() + 1);
+    log_factors_.reserve(times_.size() + 1);
+    nodes_.push_back(0.0);
+    log_factors_.push_back(0.0);
+    for (size_t i = 0; i < times_.size(); ++i) {
+        nodes_.push_back(times_[i]);
+        log_factors_.push_back(std::log(discount_factors_[i]));
+    }
+    forwards_.resize(times_.size());
+    for (size_t i = 0; i < forwards_.size(); ++i) {
+        forwards_[i] = (log_factors_[i] - log_factors_[i + 1]) / (nodes_[i + 1] - nodes_[i]);
+    }
+}
+
+DiscountCurve DiscountCurve::from_zero_rates(const std::vector<double>& times, const std::vector<double>& zero_rates) {
+    if (times.size() != zero_rates.size()) {
+        throw std::invalid_argument("DiscountCurve needs one zero rate per pillar time.");
+    }
+    std::vector<double> discount_factors(times.size());
+    for (size_t i = 0; i < times.size(); ++i) {
+        discount_factors[i] = std::exp(-zero_rates[i] * times[i]);
+    }
+    return DiscountCurve(times, std::move(discount_factors));
+}
+
+size_t DiscountCurve::segment(double t) const {
+    size_t i = static_cast<size_t>(std::upper_bound(nodes_.begin(), nodes_.end(), t) - nodes_.begin());
+    return std::min(i == 0 ? 0 : i - 1, forwards_.size() - 1);
+}
+
+double DiscountCurve::discount(double t) const {
+    if (!(t >= 0.0) || !std::isfinite(t)) {
+        return kNaN;
+    }
+    size_t i = segment(t);
+    return std::exp(log_factors_[i] - forwards_[i] * (t - nodes_[i]));
+}
+
+void DiscountCurve::discount_batch(const double* times, double* out, size_t n) const {
+    FINMATH_INSTRUMENT_SAMPLED("DiscountCurve::discount_batch", n);
+    const size_t last = forwards_.size() - 1;
+    size_t i = 0;
+    for (size_t j = 0; j < n; ++j) {
+        const double t = times[j];
+        if (!(t >= 0.0) || !std::isfinite(t)) {
+            out[j] = kNaN;
+            continue;
+        }
+        // Sorted times only ever move a segment or two forward
+        if (t < nodes_[i]) {
+            i = segment(t);
+        } else {
+            int steps = 0;
+            while (i < last && t >= nodes_[i + 1] && steps < 4) {
+                ++i;
+                ++steps;
+            }
+            if (i < last && t >= nodes_[i + 1]) {
+                i = segment(t);
+            }
+        }
+        out[j] = std::exp(log_factors_[i] - forwards_[i] * (t - nodes_[i]));
+    }
+}
+
+double DiscountCurve::zero_rate(double t) const {
+    if (t == 0.0) {
+        return forwards_[0];
+    }
+    if (!(t > 0.0) || !std::isfinite(t)) {
+        return kNaN;
+    }
+    size_t i = segment(t);
+    return -(log_factors_[i] - forwards_[i] * (t - nodes_[i])) / t;
+}
+
+double DiscountCurve::forward_rate(double t1, double t2) const {
+    if (!(t1 >= 0.0) || !(t2 > t1) || !std::isfinite(t2)) {
+        return kNaN;
+    }
+    size_t i1 = segment(t1);
+    size_t i2 = segment(t2);
+    double log1 = log_factors_[i1] - forwards_[i1] * (t1 - nodes_[i1]);
+    double log2 = log_factors_[i2] - forwards_[i2] * (t2 - nodes_[i2]);
+    return (log1 - log2) / (t2 - t1);
+}
+
+double net_present_value(double rate, const std::vector<double>& cash_flows) {
+    if (!(rate > -1.0)) {
+        std::cerr << "Rate must be greater than -100%." << std::endl;
+        return kNaN;
+    }
+    if (cash_flows.empty()) {
+        return 0.0;
+    }
+    double p, dp;
+    horner(cash_flows.data(), cash_flows.size(), 1.0 / (1.0 + rate), p, dp);
+    return p;
+}
+
+double net_present_value(const DiscountCurve& curve, const double* times, const double* amounts, size_t n) {
+    constexpr size_t kChunk = 256;
+    double factors[kChunk];
+    double sum = 0.0;
+    for (size_t begin = 0; begin < n; begin += kChunk) {
+        const size_t count = std::min(kChunk, n - begin);
+        curve.discount_batch(times + begin, factors, count);
+        for (size_t i = 0; i < count; ++i) {
+            sum += amounts[begin + i] * factors[i];
+        }
+    }
+    return sum;
+}
+
+double internal_rate_of_return(const double* cash_flows, size_t n, IrrStatus* status, double guess) {
+    FINMATH_INSTRUMENT_SAMPLED("internal_rate_of_return", n);
+    IrrStatus outcome = IrrStatus::INVALID_INPUT;
+    double rate = valid_flows(cash_flows, n) ? solve_irr(cash_flows, n, guess, outcome) : kNaN;
+    if (status != nullptr) {
+        *status = outcome;
+    }
+    return rate;
+}
+
+double internal_rate_of_return(const std::vector<double>& cash_flows, IrrStatus* status, double guess) {
+    return internal_rate_of_return(cash_flows.data(), cash_flows.size(), status, guess);
+}
+
+void internal_rate_of_return_batch(const double* cash_flows, size_t num_schedules, size_t num_periods,
+                                   double* out, IrrStatus* status) {
+    FINMATH_INSTRUMENT("internal_rate_of_return_batch", num_schedules);
+    enum Lane { ACTIVE, SOLVED, FALLBACK, INVALID };
+
+    const SimdLevel level = active_simd_level();
+    AlignedVector block(std::max<size_t>(num_periods, 1) * kIrrLanes);
+    alignas(64) double v[kIrrLanes];
+    alignas(64) double value[kIrrLanes];
+    alignas(64) double slope[kIrrLanes];
+    Lane lanes[kIrrLanes];
+
+    for (size_t begin = 0; begin < num_schedules; begin += kIrrLanes) {
+        const size_t count = std::min(kIrrLanes, num_schedules - begin);
+        const double* rows = cash_flows + begin * num_periods;
+
+        // Transpose to period-major; padding lanes repeat the first schedule
+        size_t active = 0;
+        for (size_t l = 0; l < kIrrLanes; ++l) {
+            const double* row = rows + (l < count ? l : 0) * num_periods;
+            lanes[l] = l >= count ? SOLVED : valid_flows(row, num_periods) ? ACTIVE : INVALID;
+            active += lanes[l] == ACTIVE;
+            v[l] = 1.0;
+        }
+        if (active > 0) {
+            for (size_t k = 0; k < num_periods; ++k) {
+                double* column = block.data() + k * kIrrLanes;
+                for (size_t l = 0; l < kIrrLanes; ++l) {
+                    column[l] = rows[(l < count ? l : 0) * num_periods + k];
+                }
+            }
+        }
+
+        // Newton on every lane at once; converged lanes stop moving
+        for (int iteration = 0; iteration < kNewtonIterations && active > 0; ++iteration) {
+            irr_horner(level, block.data(), num_periods, v, value, slope);
+            for (size_t l = 0; l < kIrrLanes; ++l) {
+                if (lanes[l] != ACTIVE) {
+                    continue;
+                }
+                const double step = value[l] / slope[l];
+                const double next = v[l] - step;
+                if (!std::isfinite(step) || !(next > kMinFactor && next < kMaxFactor)) {
+                    lanes[l] = FALLBACK;
+                    --active;
+                    continue;
+                }
+                v[l] = next;
+                if (std::abs(step) <= kFactorTolerance * next) {
+                    lanes[l] = SOLVED;
+                    --active;
+                }
+            }
+        }
+
+        for (size_t l = 0; l < count; ++l) {
+            IrrStatus outcome = IrrStatus::CONVERGED;
+            if (lanes[l] == SOLVED) {
+                out[begin + l] = (1.0 - v[l]) / v[l];
+            } else if (lanes[l] == INVALID) {
+                out[begin + l] = kNaN;
+                outcome = IrrStatus::INVALID_INPUT;
+            } else {
+                double root;
+                const double* row = rows + l * num_periods;
+                if (bracketed_factor(row, num_periods, 1.0, root)) {
+                    out[begin + l] = (1.0 - root) / root;
+                } else {
+                    out[begin + l] = kNaN;
+                    outcome = IrrStatus::NO_SOLUTION;
+                }
+            }
+            if (status != nullptr) {
+                status[begin + l] = outcome;
+            }
+        }
+    }
+}
+
+void discount_factor_matrix(const DiscountCurve* curves, size_t num_curves, const double* times, size_t num_times,
+                            double* out) {
+    FINMATH_INSTRUMENT("discount_factor_matrix", num_curves * num_times);
+    std::vector<double> factors(num_times);
+    for (size_t j = 0; j < num_curves; ++j) {
+        curves[j].discount_batch(times, factors.data(), num_times);
+        for (size_t k = 0; k < num_times; ++k) {
+            out[k * num_curves + j] = factors[k];
+        }
+    }
+}
+
+void present_value_matrix(const double* cash_flows, size_t num_schedules, size_t num_times,
+                          const double* discount_factors, size_t num_scenarios, double* out) {
+    FINMATH_INSTRUMENT_SAMPLED("present_value_matrix", num_schedules * num_scenarios);
+    std::fill(out, out + num_schedules * num_scenarios, 0.0);
+    if (num_schedules == 0 || num_times == 0) {
+        return;
+    }
+
+    const SimdLevel level = active_simd_level();
+    AlignedVector panel(std::min(num_times, kTimeBlock) * std::min(num_scenarios, kScenarioBlock));
+    for (size_t j0 = 0; j0 < num_scenarios; j0 += kScenarioBlock) {
+        const size_t width = std::min(kScenarioBlock, num_scenarios - j0);
+        for (size_t k0 = 0; k0 < num_times; k0 += kTimeBlock) {
+            const size_t depth = std::min(kTimeBlock, num_times - k0);
+            // Pack the panel contiguously so the kernel walks it with unit stride
+            for (size_t k = 0; k < depth; ++k) {
+                const double* row = discount_factors + (k0 + k) * num_scenarios + j0;
+                std::copy(row, row + width, panel.data() + k * width);
+            }
+            discount_panel(level, cash_flows + k0, num_times, num_schedules, panel.data(), depth, width, out + j0,
+                           num_scenarios);
+        }
+    }
+}
+
+void parallel_present_value_matrix(const double* cash_flows, size_t num_schedules, size_t num_times,
+                                   const double* discount_factors, size_t num_scenarios, double* out,
+                                   ThreadPool& pool) {
+    FINMATH_INSTRUMENT("parallel_present_value_matrix", num_schedules * num_scenarios);
+    pool.parallel_for(num_schedules, kScheduleGrain, [&](size_t begin, size_t end) {
+        present_value_matrix(cash_flows + begin * num_times, end - begin, num_times, discount_factors, num_scenarios,
+                             out + begin * num_scenarios);
+    });
+}
@@ -0,0 +1,24 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime CPU detection
+#define CASH_FLOWS_SIMD_KERNEL
+#include "cash_flows_simd.h"
+
+bool discount_panel_avx512(const double* flows, size_t flow_stride, size_t rows, const double* panel, size_t depth,
+                           size_t width, double* out, size_t out_stride) {
+#if defined(__AVX512F__)
+    discount_panel_kernel<VecAVX512>(flows, flow_stride, rows, panel, depth, width, out, out_stride);
+    return true;
+#else
+    (void)flows, (void)flow_stride, (void)rows, (void)panel, (void)depth, (void)width, (void)out, (void)out_stride;
+    return false;
+#endif
+}
+
+bool irr_horner_avx512(const double* flows, size_t periods, const double* v, double* value, double* slope) {
+#if defined(__AVX512F__)
+    irr_horner_kernel<VecAVX512>(flows, periods, v, value, slope);
+    return true;
+#else
+    (void)flows, (void)periods, (void)v, (void)value, (void)slope;
+    return false;
+#endif
+}
@@ -0,0 +1,122 @@
+#ifndef CASH_FLOWS_SIMD_H
+#define CASH_FLOWS_SIMD_H
+
+#include <cstddef>
+
+// Instruction-set specific kernels of the cash-flow engine. Each returns false when its
+// translation unit was built without the matching compiler flags.
+
+// Schedules solved together by one batched IRR Newton iteration
+constexpr size_t kIrrLanes = 16;
+
+// Multiply-accumulate of a block of flows against a packed panel of discount factors:
+//     out[r * out_stride + c] += sum_{k < depth} flows[r * flow_stride + k] * panel[k * width + c]
+// for r < rows and c < width
+bool discount_panel_avx2(const double* flows, size_t flow_stride, size_t rows, const double* panel, size_t depth,
+                         size_t width, double* out, size_t out_stride);
+bool discount_panel_avx512(const double* flows, size_t flow_stride, size_t rows, const double* panel,
+                           size_t depth, size_t width, double* out, size_t out_stride);
+
+// Value and derivative of the polynomials sum_k flows[k * kIrrLanes + l] v[l]^k, k < periods
+// (periods >= 1), for the kIrrLanes lanes l of a transposed block, by Horner's rule
+bool irr_horner_avx2(const double* flows, size_t periods, const double* v, double* value, double* slope);
+bool irr_horner_avx512(const double* flows, size_t periods, const double* v, double* value, double* slope);
+
+#ifdef CASH_FLOWS_SIMD_KERNEL
+
+#include "../Helper/simd_vec.h"
+
+namespace {
+
+// Rows rows (1 or 4) of the panel product over columns [c, c + 2 width) of out. The row
+// count is a template parameter so the accumulators stay in registers: 4 rows against
+// two vectors of discount factors keep 8 independent FMA chains in flight per time step.
+template <typename V, size_t Rows>
+void discount_tile(const double* flows, size_t flow_stride, const double* panel, size_t depth, size_t width,
+                   size_t c, double* out, size_t out_stride) {
+    constexpr size_t w = V::width;
+    V acc[Rows][2];
+    for (size_t i = 0; i < Rows; ++i) {
+        acc[i][0] = V::load(out + i * out_stride + c);
+        acc[i][1] = V::load(out + i * out_stride + c + w);
+    }
+    for (size_t k = 0; k < depth; ++k) {
+        const V b0 = V::load(panel + k * width + c);
+        const V b1 = V::load(panel + k * width + c + w);
+        for (size_t i = 0; i < Rows; ++i) {
+            const V a = V::set1(flows[i * flow_stride + k]);
+            acc[i][0] = vfma(a, b0, acc[i][0]);
+            acc[i][1] = vfma(a, b1, acc[i][1]);
+        }
+    }
+    for (size_t i = 0; i < Rows; ++i) {
+        V::store(out + i * out_stride + c, acc[i][0]);
+        V::store(out + i * out_stride + c + w, acc[i][1]);
+    }
+}
+
+template <typename V, size_t Rows>
+void discount_rows(const double* flows, size_t flow_stride, const double* panel, size_t depth, size_t width,
+                   double* out, size_t out_stride) {
+    constexpr size_t w = V::width;
+    size_t c = 0;
+    for (; c + 2 * w <= width; c += 2 * w) {
+        discount_tile<V, Rows>(flows, flow_stride, panel, depth, width, c, out, out_stride);
+    }
+    // Columns left over at the right edge of the panel
+    for (; c < width; ++c) {
+        for (size_t i = 0; i < Rows; ++i) {
+            double sum = out[i * out_stride + c];
+            for (size_t k = 0; k < depth; ++k) {
+                sum += flows[i * flow_stride + k] * panel[k * width + c];
+            }
+            out[i * out_stride + c] = sum;
+        }
+    }
+}
+
+template <typename V>
+void discount_panel_kernel(const double* flows, size_t flow_stride, size_t rows, const double* panel, size_t depth,
+                           size_t width, double* out, size_t out_stride) {
+    size_t r = 0;
+    for (; r + 4 <= rows; r += 4) {
+        discount_rows<V, 4>(flows + r * flow_stride, flow_stride, panel, depth, width, out + r * out_stride,
+                            out_stride);
+    }
+    for (; r < rows; ++r) {
+        discount_rows<V, 1>(flows + r * flow_stride, flow_stride, panel, depth, width, out + r * out_stride,
+                            out_stride);
+    }
+}
+
+// Horner's rule runs one dependent chain per lane; kIrrLanes / width vectors of lanes,
+// each with a value and a derivative chain, hide the FMA latency
+template <typename V>
+void irr_horner_kernel(const double* flows, size_t periods, const double* v, double* value, double* slope) {
+    constexpr size_t w = V::width;
+    constexpr size_t vectors = kIrrLanes / w;
+    V x[vectors], p[vectors], dp[vectors];
+    const double* last = flows + (periods - 1) * kIrrLanes;
+    for (size_t i = 0; i < vectors; ++i) {
+        x[i] = V::load(v + i * w);
+        p[i] = V::load(last + i * w);
+        dp[i] = V::set1(0.0);
+    }
+    for (size_t k = periods - 1; k > 0; --k) {
+        const double* row = flows + (k - 1) * kIrrLanes;
+        for (size_t i = 0; i < vectors; ++i) {
+            dp[i] = vfma(dp[i], x[i], p[i]);
+            p[i] = vfma(p[i], x[i], V::load(row + i * w));
+        }
+    }
+    for (size_t i = 0; i < vectors; ++i) {
+        V::store(value + i * w, p[i]);
+        V::store(slope + i * w, dp[i]);
+    }
+}
+
+} // namespace
+
+#endif // CASH_FLOWS_SIMD_KERNEL
+
+#endif // CASH_FLOWS_SIMD_H
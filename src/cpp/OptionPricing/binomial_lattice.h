@@ -0,0 +1,36 @@
+#ifndef BINOMIAL_LATTICE_H
+#define BINOMIAL_LATTICE_H
+
+#include <memory>
+#include <vector>
+
+#include "finmath/OptionPricing/binomial_tree.h"
+
+// The lattice binomial_lattice_pricing rolls back, for one spot, expiry, rate, volatility,
+// step count and exercise schedule. Probabilities, node prices and the schedule are built
+// once; price() then rolls back any option type and strike on them, giving what
+// binomial_lattice_pricing gives for the same arguments bit for bit. Since payoffs and
+// exercise values are homogeneous in (spot, strike), a spot shocked by a factor c prices as
+// c * price(type, K / c) on the unshocked lattice. Used by the scenario engine to reuse one
+// lattice across a row of spot shocks.
+template <typename Real>
+class BinomialLattice {
+public:
+    // N must be at least 1 (2 for BBSR); binomial_lattice_pricing checks it
+    BinomialLattice(ExerciseStyle style, double S0, double T, double r, double sigma, long N,
+                    BinomialMethod method = BinomialMethod::CRR, const std::vector<double>& exercise_times = {});
+    ~BinomialLattice();
+
+    BinomialLattice(const BinomialLattice&) = delete;
+    BinomialLattice& operator=(const BinomialLattice&) = delete;
+
+    Real price(OptionType type, double K) const;
+
+private:
+    struct Tree;
+
+    std::unique_ptr<Tree> fine_;
+    std::unique_ptr<Tree> coarse_;  // N / 2 steps, BBSR only
+};
+
+#endif // BINOMIAL_LATTICE_H
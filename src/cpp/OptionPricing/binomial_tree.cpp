@@ -1,34 +1,167 @@
 #include <cmath>
 #include <algorithm>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <array>
 #include <vector>
 #include "finmath/OptionPricing/binomial_tree.h"
-#include "finmath/Helper/helper.h"
+#include "finmath/OptionPricing/black_scholes.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/simd.h"
+#include "binomial_lattice.h"
+#include "lattice_core.h"
 
-double binomial_option_pricing(OptionType type, double S0, double K, double T, double r, double sigma, long N) {
-    double dt = T / N;
-    double u = std::exp(sigma * std::sqrt(dt));
-    double d = std::exp(-sigma * std::sqrt(dt));
-    double p = (std::exp(r * dt) - d) / (u - d);
-    double value = 0.0;
-
-    // Start with the initial binomial coefficient C(N, 0) = 1
-    double binomial_coeff = 1.0;
-
-    for (long i = 0; i <= N; ++i) {
-        double node_prob = binomial_coeff * std::pow(p, i) * std::pow(1 - p, N - i);
-        double ST = S0 * std::pow(u, i) * std::pow(d, N - i);
-
-        if (type == OptionType::CALL) {
-            value += std::max(ST - K, 0.0) * node_prob;
-        } else if (type == OptionType::PUT) {
-            value += std::max(K - ST, 0.0) * node_prob;
+namespace {
+
+// Lattice policy of a vanilla call or put: the payoff at expiry or, for BBS, Black-Scholes
+// values one step before it, and exercise wherever the schedule allows
+template <typename Real>
+struct VanillaPolicy {
+    OptionType type;
+    Real K;
+    const std::vector<char>& schedule;
+    bool black_scholes_last_step;
+    double dt, r, sigma;
+
+    void initialize(long n, const Real* S, Real* v, long count) const {
+        if (!black_scholes_last_step) {
+            for (long i = 0; i < count; ++i) {
+                v[i] = payoff(type, S[i], K);
+            }
+            return;
         }
+        // BBS: values one step before expiry are European prices over the final dt
+        std::vector<OptionType> types(count, type);
+        std::vector<Real> strikes(count, K), times(count, static_cast<Real>(dt)), rates(count, static_cast<Real>(r)),
+            vols(count, static_cast<Real>(sigma));
+        black_scholes_batch(types.data(), strikes.data(), S, times.data(), rates.data(), vols.data(), v, count);
+        if (schedule[n]) {
+            for (long i = 0; i < count; ++i) {
+                v[i] = std::max(v[i], payoff(type, S[i], K));
+            }
+        }
+    }
+
+    RollbackExercise exercise(long n) const {
+        if (!schedule[n]) {
+            return RollbackExercise::NONE;
+        }
+        return (type == OptionType::CALL) ? RollbackExercise::CALL : RollbackExercise::PUT;
+    }
+
+    Real strike() const { return K; }
+
+    void adjust(long, const Real*, Real*, long) const {}
+};
+
+// Discounted down / up probabilities of a CRR step; the lattice parameters are always
+// derived in double (p is a small difference of exponentials)
+template <typename Real>
+std::array<Real, 2> crr_probabilities(double dt, double log_u, double r) {
+    const double u = std::exp(log_u);
+    const double d = 1.0 / u;
+    const double p = (std::exp(r * dt) - d) / (u - d);
+    const double discount = std::exp(-r * dt);
+    return {static_cast<Real>(discount * (1 - p)), static_cast<Real>(discount * p)};
+}
+
+} // namespace
+
+// A binomial LatticeCore with its exercise schedule. Real is the type of the node values and
+// prices rolled back over O(N^2) nodes.
+template <typename Real>
+struct BinomialLattice<Real>::Tree {
+    long N;
+    double dt;
+    double r;
+    double sigma;
+    bool black_scholes_last_step;
+    std::vector<char> exercise;
+    LatticeCore<2, Real> core;
+
+    Tree(ExerciseStyle style, double S0, double T, double r, double sigma, long N, bool black_scholes_last_step,
+         const std::vector<double>& exercise_times)
+        : N(N), dt(T / N), r(r), sigma(sigma), black_scholes_last_step(black_scholes_last_step),
+          exercise(exercise_schedule(style, N, dt, exercise_times)),
+          core(S0, sigma * std::sqrt(dt), N, crr_probabilities<Real>(dt, sigma * std::sqrt(dt), r)) {}
+
+    Real price(OptionType type, Real strike) const {
+        VanillaPolicy<Real> policy{type, strike, exercise, black_scholes_last_step, dt, r, sigma};
+        return core.roll(policy, black_scholes_last_step ? N - 1 : N);
+    }
+};
 
-        // Update binomial coefficient for next iteration: C(N, i+1)
-        if (i < N) {
-            binomial_coeff *= (N - i) / double(i + 1);
+template <typename Real>
+BinomialLattice<Real>::BinomialLattice(ExerciseStyle style, double S0, double T, double r, double sigma, long N,
+                                       BinomialMethod method, const std::vector<double>& exercise_times) {
+    switch (method) {
+        case BinomialMethod::CRR:
+            fine_ = std::make_unique<Tree>(style, S0, T, r, sigma, N, false, exercise_times);
+            break;
+        case BinomialMethod::BBS:
+            fine_ = std::make_unique<Tree>(style, S0, T, r, sigma, N, true, exercise_times);
+            break;
+        case BinomialMethod::BBSR: {
+            // Extrapolate from an even step count and its half; an odd N rounds down
+            long half = N / 2;
+            fine_ = std::make_unique<Tree>(style, S0, T, r, sigma, 2 * half, true, exercise_times);
+            coarse_ = std::make_unique<Tree>(style, S0, T, r, sigma, half, true, exercise_times);
+            break;
         }
     }
+}
+
+template <typename Real>
+BinomialLattice<Real>::~BinomialLattice() = default;
 
-    return value * std::exp(-r * T);
+template <typename Real>
+Real BinomialLattice<Real>::price(OptionType type, double K) const {
+    const Real strike = static_cast<Real>(K);
+    if (!fine_) {
+        return std::numeric_limits<Real>::quiet_NaN();
+    }
+    Real fine = fine_->price(type, strike);
+    if (!coarse_) {
+        return fine;
+    }
+    Real coarse = coarse_->price(type, strike);
+    return 2 * fine - coarse;
 }
+
+template class BinomialLattice<float>;
+template class BinomialLattice<double>;
+
+double binomial_option_pricing(OptionType type, double S0, double K, double T, double r, double sigma, long N) {
+    return binomial_lattice_pricing<double>(type, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, N);
+}
+
+template <typename Real>
+Real binomial_option_pricing(OptionType type, Real S0, Real K, Real T, Real r, Real sigma, long N) {
+    return binomial_lattice_pricing<Real>(type, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, N);
+}
+
+double binomial_lattice_pricing(OptionType type, ExerciseStyle style, double S0, double K, double T, double r,
+                                double sigma, long N, BinomialMethod method, const std::vector<double>& exercise_times) {
+    return binomial_lattice_pricing<double>(type, style, S0, K, T, r, sigma, N, method, exercise_times);
+}
+
+template <typename Real>
+Real binomial_lattice_pricing(OptionType type, ExerciseStyle style, Real S0, Real K, Real T, Real r, Real sigma,
+                              long N, BinomialMethod method, const std::vector<double>& exercise_times) {
+    FINMATH_INSTRUMENT("binomial_lattice_pricing", 1);
+    const long min_steps = (method == BinomialMethod::BBSR) ? 2 : 1;
+    if (N < min_steps) {
+        std::cerr << "Number of steps must be at least " << min_steps << "." << std::endl;
+        return std::numeric_limits<Real>::quiet_NaN();
+    }
+
+    return BinomialLattice<Real>(style, S0, T, r, sigma, N, method, exercise_times).price(type, K);
+}
+
+template float binomial_option_pricing<float>(OptionType, float, float, float, float, float, long);
+template double binomial_option_pricing<double>(OptionType, double, double, double, double, double, long);
+template float binomial_lattice_pricing<float>(OptionType, ExerciseStyle, float, float, float, float, float, long,
+                                               BinomialMethod, const std::vector<double>&);
+template double binomial_lattice_pricing<double>(OptionType, ExerciseStyle, double, double, double, double, double,
+                                                 long, BinomialMethod, const std::vector<double>&);
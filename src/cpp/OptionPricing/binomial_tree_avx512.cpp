@@ -0,0 +1,25 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime CPU detection
+#define BINOMIAL_TREE_SIMD_KERNEL
+#include "binomial_tree_simd.h"
+
+bool binomial_rollback_avx512(double* v, long n, double p_up, double p_down, const double* S, double K,
+                              RollbackExercise exercise) {
+#if defined(__AVX512F__)
+    binomial_rollback_kernel<VecAVX512>(v, n, p_up, p_down, S, K, exercise);
+    return true;
+#else
+    (void)v, (void)n, (void)p_up, (void)p_down, (void)S, (void)K, (void)exercise;
+    return false;
+#endif
+}
+
+bool binomial_rollback_avx512(float* v, long n, float p_up, float p_down, const float* S, float K,
+                              RollbackExercise exercise) {
+#if defined(__AVX512F__)
+    binomial_rollback_kernel<VecAVX512f>(v, n, p_up, p_down, S, K, exercise);
+    return true;
+#else
+    (void)v, (void)n, (void)p_up, (void)p_down, (void)S, (void)K, (void)exercise;
+    return false;
+#endif
+}
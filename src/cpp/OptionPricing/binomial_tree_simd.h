@@ -0,0 +1,64 @@
+#ifndef BINOMIAL_TREE_SIMD_H
+#define BINOMIAL_TREE_SIMD_H
+
+// Instruction-set specific kernels for one backward-induction step of the binomial
+// lattice: v[i] = p_up v[i + 1] + p_down v[i] for i = 0..n, then (when exercise is
+// allowed) the max against the call or put payoff of S[i]. Each returns false when its
+// translation unit was built without the matching compiler flags.
+
+enum class RollbackExercise {NONE, CALL, PUT};
+
+bool binomial_rollback_avx2(double* v, long n, double p_up, double p_down, const double* S, double K,
+                            RollbackExercise exercise);
+bool binomial_rollback_avx512(double* v, long n, double p_up, double p_down, const double* S, double K,
+                              RollbackExercise exercise);
+bool binomial_rollback_avx2(float* v, long n, float p_up, float p_down, const float* S, float K,
+                            RollbackExercise exercise);
+bool binomial_rollback_avx512(float* v, long n, float p_up, float p_down, const float* S, float K,
+                              RollbackExercise exercise);
+
+#ifdef BINOMIAL_TREE_SIMD_KERNEL
+
+#include "../Helper/simd_vec.h"
+
+namespace {
+
+template <typename V, typename Real = typename V::Scalar>
+void binomial_rollback_kernel(Real* v, long n, Real p_up, Real p_down, const Real* S, Real K,
+                              RollbackExercise exercise) {
+    constexpr long width = V::width;
+    const V up = V::set1(p_up);
+    const V down = V::set1(p_down);
+    const V strike = V::set1(K);
+
+    // Loads of v[i + 1 .. i + width] happen before the store to v[i .. i + width - 1],
+    // so each block still sees the previous step's values
+    long i = 0;
+    for (; i + width <= n + 1; i += width) {
+        V value = vfma(up, V::load(v + i + 1), down * V::load(v + i));
+        if (exercise == RollbackExercise::CALL) {
+            value = vmax(value, V::load(S + i) - strike);
+        } else if (exercise == RollbackExercise::PUT) {
+            value = vmax(value, strike - V::load(S + i));
+        }
+        V::store(v + i, value);
+    }
+
+    for (; i <= n; ++i) {
+        Real value = p_up * v[i + 1] + p_down * v[i];
+        if (exercise == RollbackExercise::CALL) {
+            Real intrinsic = S[i] - K;
+            value = value > intrinsic ? value : intrinsic;
+        } else if (exercise == RollbackExercise::PUT) {
+            Real intrinsic = K - S[i];
+            value = value > intrinsic ? value : intrinsic;
+        }
+        v[i] = value;
+    }
+}
+
+} // namespace
+
+#endif // BINOMIAL_TREE_SIMD_KERNEL
+
+#endif // BINOMIAL_TREE_SIMD_H
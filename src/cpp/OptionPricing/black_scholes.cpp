@@ -1,14 +1,81 @@
-#include <cmath> 
+#include <cmath>
 #include "finmath/OptionPricing/black_scholes.h"
 #include "finmath/Helper/helper.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/simd.h"
+#include "black_scholes_simd.h"
+
+BlackScholesTerms black_scholes_terms(double strike, double price, double time, double rate, double volatility) {
+    BlackScholesTerms terms;
+    terms.sqrt_time = std::sqrt(time);
+    terms.d1 = (std::log(price / strike) + ((rate + volatility*volatility/2) * time)) / (volatility * terms.sqrt_time);
+    terms.d2 = terms.d1 - (volatility * terms.sqrt_time);
+    terms.discount = std::exp(-rate * time);
+    return terms;
+}
 
 double black_scholes(OptionType type, double strike, double price, double time, double rate, double volatility){
-    double d1 = (std::log(price / strike) + ((rate + volatility*volatility/2) * time)) / (volatility * std::sqrt(time));
-    double d2 = d1 - (volatility * std::sqrt(time));
+    FINMATH_INSTRUMENT_SAMPLED("black_scholes", 1);
+    return black_scholes<double>(type, strike, price, time, rate, volatility);
+}
+
+template <typename Real>
+Real black_scholes(OptionType type, Real strike, Real price, Real time, Real rate, Real volatility) {
+    // Same steps as black_scholes_terms in Real arithmetic; the normal CDF is evaluated in double
+    Real sqrt_time = std::sqrt(time);
+    Real d1 = (std::log(price / strike) + ((rate + volatility*volatility/2) * time)) / (volatility * sqrt_time);
+    Real d2 = d1 - (volatility * sqrt_time);
+    Real discount = std::exp(-rate * time);
 
     if (type == OptionType::CALL) {
-        return price * normal_cdf(d1) - std::exp(-rate * time) * strike * normal_cdf(d2);
+        return price * static_cast<Real>(normal_cdf(d1)) - discount * strike * static_cast<Real>(normal_cdf(d2));
     } else {
-        return strike * std::exp(-rate * time) * normal_cdf(-d2) - price * normal_cdf(-d1);
+        return strike * discount * static_cast<Real>(normal_cdf(-d2)) - price * static_cast<Real>(normal_cdf(-d1));
+    }
+}
+
+template float black_scholes<float>(OptionType, float, float, float, float, float);
+template double black_scholes<double>(OptionType, double, double, double, double, double);
+
+namespace {
+
+// Dispatch to the widest compiled-in kernel; Real is float or double
+template <typename Real>
+void black_scholes_batch_impl(const OptionType* types, const Real* strikes, const Real* prices,
+                              const Real* times, const Real* rates, const Real* volatilities,
+                              Real* out, size_t n) {
+    FINMATH_INSTRUMENT("black_scholes_batch", n);
+    // Each SIMD kernel reports false when it was not compiled in, dropping to the next level
+    switch (active_simd_level()) {
+        case SimdLevel::AVX512:
+            if (black_scholes_batch_avx512(types, strikes, prices, times, rates, volatilities, out, n)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (black_scholes_batch_avx2(types, strikes, prices, times, rates, volatilities, out, n)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = black_scholes<Real>(types[i], strikes[i], prices[i], times[i], rates[i], volatilities[i]);
     }
 }
+
+} // namespace
+
+void black_scholes_batch(const OptionType* types, const double* strikes, const double* prices,
+                         const double* times, const double* rates, const double* volatilities,
+                         double* out, size_t n) {
+    black_scholes_batch_impl(types, strikes, prices, times, rates, volatilities, out, n);
+}
+
+void black_scholes_batch(const OptionType* types, const float* strikes, const float* prices,
+                         const float* times, const float* rates, const float* volatilities,
+                         float* out, size_t n) {
+    black_scholes_batch_impl(types, strikes, prices, times, rates, volatilities, out, n);
+}
@@ -0,0 +1,39 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime CPU detection
+#define BLACK_SCHOLES_SIMD_KERNEL
+#include "black_scholes_simd.h"
+
+bool black_scholes_batch_avx512(const OptionType* types, const double* strikes, const double* prices,
+                                const double* times, const double* rates, const double* volatilities,
+                                double* out, size_t n) {
+#if defined(__AVX512F__)
+    black_scholes_batch_kernel<VecAVX512>(types, strikes, prices, times, rates, volatilities, out, n);
+    return true;
+#else
+    (void)types, (void)strikes, (void)prices, (void)times, (void)rates, (void)volatilities, (void)out, (void)n;
+    return false;
+#endif
+}
+
+bool black_scholes_batch_avx512(const OptionType* types, const float* strikes, const float* prices,
+                                const float* times, const float* rates, const float* volatilities,
+                                float* out, size_t n) {
+#if defined(__AVX512F__)
+    black_scholes_batch_kernel<VecAVX512f>(types, strikes, prices, times, rates, volatilities, out, n);
+    return true;
+#else
+    (void)types, (void)strikes, (void)prices, (void)times, (void)rates, (void)volatilities, (void)out, (void)n;
+    return false;
+#endif
+}
+
+bool black_scholes_greeks_batch_avx512(const OptionType* types, const double* strikes, const double* prices,
+                                       const double* times, const double* rates, const double* volatilities,
+                                       Greeks* out, size_t n) {
+#if defined(__AVX512F__)
+    black_scholes_greeks_batch_kernel<VecAVX512>(types, strikes, prices, times, rates, volatilities, out, n);
+    return true;
+#else
+    (void)types, (void)strikes, (void)prices, (void)times, (void)rates, (void)volatilities, (void)out, (void)n;
+    return false;
+#endif
+}
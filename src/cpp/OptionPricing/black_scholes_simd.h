@@ -0,0 +1,179 @@
+#ifndef BLACK_SCHOLES_SIMD_H
+#define BLACK_SCHOLES_SIMD_H
+
+#include <cstddef>
+
+#include "finmath/OptionPricing/greeks.h"
+#include "finmath/OptionPricing/options_pricing_types.h"
+
+// Instruction-set specific batch kernels behind black_scholes_batch. Each one returns
+// false without touching `out` when its translation unit was built without the
+// matching compiler flags, so the caller can fall back to the next level.
+bool black_scholes_batch_avx2(const OptionType* types, const double* strikes, const double* prices,
+                              const double* times, const double* rates, const double* volatilities,
+                              double* out, size_t n);
+bool black_scholes_batch_avx512(const OptionType* types, const double* strikes, const double* prices,
+                                const double* times, const double* rates, const double* volatilities,
+                                double* out, size_t n);
+bool black_scholes_batch_avx2(const OptionType* types, const float* strikes, const float* prices,
+                              const float* times, const float* rates, const float* volatilities,
+                              float* out, size_t n);
+bool black_scholes_batch_avx512(const OptionType* types, const float* strikes, const float* prices,
+                                const float* times, const float* rates, const float* volatilities,
+                                float* out, size_t n);
+bool black_scholes_greeks_batch_avx2(const OptionType* types, const double* strikes, const double* prices,
+                                     const double* times, const double* rates, const double* volatilities,
+                                     Greeks* out, size_t n);
+bool black_scholes_greeks_batch_avx512(const OptionType* types, const double* strikes, const double* prices,
+                                       const double* times, const double* rates, const double* volatilities,
+                                       Greeks* out, size_t n);
+
+#ifdef BLACK_SCHOLES_SIMD_KERNEL
+
+#include "../Helper/simd_math.h"
+
+namespace {
+
+// One vector's worth of contracts. sign is +1 for calls and -1 for puts, so
+// price = sign * (S N(sign d1) - K e^{-rT} N(sign d2)) covers both without
+// evaluating N() on both tails.
+template <typename V>
+struct ContractLanes {
+    V sign, strike, price, time, rate, volatility;
+};
+
+// Shared per-lane work: d1, d2, discounting and the two normal CDFs
+template <typename V>
+struct LaneTerms {
+    V sqrt_time, vol_sqrt_time, d1, d2, discounted_strike, gauss_d1, cdf_d1, cdf_d2;
+};
+
+template <typename V>
+inline LaneTerms<V> lane_terms(const ContractLanes<V>& c) {
+    LaneTerms<V> t;
+    t.sqrt_time = vsqrt(c.time);
+    t.vol_sqrt_time = c.volatility * t.sqrt_time;
+    V drift = vfma(V::set1(0.5) * c.volatility, c.volatility, c.rate);
+    t.d1 = vfma(drift, c.time, vlog(c.price / c.strike)) / t.vol_sqrt_time;
+    t.d2 = t.d1 - t.vol_sqrt_time;
+    t.discounted_strike = c.strike * vexp(-(c.rate * c.time));
+
+    // S phi(d1) = K e^{-rT} phi(d2), so one exp serves both tails
+    t.gauss_d1 = vexp(V::set1(-0.5) * t.d1 * t.d1);
+    V gauss_d2 = t.gauss_d1 * (c.price / t.discounted_strike);
+    t.cdf_d1 = vnormal_cdf_scaled(c.sign * t.d1, t.gauss_d1);
+    t.cdf_d2 = vnormal_cdf_scaled(c.sign * t.d2, gauss_d2);
+    return t;
+}
+
+// Walk the inputs one vector at a time, calling body(lanes, offset, count). The last
+// block pads unused lanes with a harmless at-the-money contract; count tells the body
+// how many lanes are real.
+template <typename V, typename Body>
+void for_each_contract_block(const OptionType* types, const typename V::Scalar* strikes,
+                             const typename V::Scalar* prices, const typename V::Scalar* times,
+                             const typename V::Scalar* rates, const typename V::Scalar* volatilities,
+                             size_t n, Body body) {
+    using Real = typename V::Scalar;
+    constexpr size_t width = V::width;
+    Real signs[width];
+
+    size_t i = 0;
+    for (; i + width <= n; i += width) {
+        for (size_t j = 0; j < width; ++j) {
+            signs[j] = types[i + j] == OptionType::CALL ? 1.0 : -1.0;
+        }
+        ContractLanes<V> lanes = {V::load(signs), V::load(strikes + i), V::load(prices + i),
+                                  V::load(times + i), V::load(rates + i), V::load(volatilities + i)};
+        body(lanes, i, width);
+    }
+
+    if (i == n) {
+        return;
+    }
+
+    Real strike_tail[width], price_tail[width], time_tail[width], rate_tail[width], vol_tail[width];
+    for (size_t j = 0; j < width; ++j) {
+        bool valid = i + j < n;
+        signs[j] = (valid && types[i + j] == OptionType::PUT) ? -1.0 : 1.0;
+        strike_tail[j] = valid ? strikes[i + j] : 1.0;
+        price_tail[j] = valid ? prices[i + j] : 1.0;
+        time_tail[j] = valid ? times[i + j] : 1.0;
+        rate_tail[j] = valid ? rates[i + j] : 0.0;
+        vol_tail[j] = valid ? volatilities[i + j] : 0.2;
+    }
+    ContractLanes<V> lanes = {V::load(signs), V::load(strike_tail), V::load(price_tail),
+                              V::load(time_tail), V::load(rate_tail), V::load(vol_tail)};
+    body(lanes, i, n - i);
+}
+
+template <typename V>
+void black_scholes_batch_kernel(const OptionType* types, const typename V::Scalar* strikes,
+                                const typename V::Scalar* prices, const typename V::Scalar* times,
+                                const typename V::Scalar* rates, const typename V::Scalar* volatilities,
+                                typename V::Scalar* out, size_t n) {
+    for_each_contract_block<V>(types, strikes, prices, times, rates, volatilities, n,
+        [out](const ContractLanes<V>& c, size_t offset, size_t count) {
+            LaneTerms<V> t = lane_terms(c);
+            V result = c.sign * (c.price * t.cdf_d1 - t.discounted_strike * t.cdf_d2);
+            if (count == static_cast<size_t>(V::width)) {
+                V::store(out + offset, result);
+                return;
+            }
+            typename V::Scalar tail[V::width];
+            V::store(tail, result);
+            for (size_t j = 0; j < count; ++j) {
+                out[offset + j] = tail[j];
+            }
+        });
+}
+
+template <typename V>
+void black_scholes_greeks_batch_kernel(const OptionType* types, const double* strikes, const double* prices,
+                                       const double* times, const double* rates, const double* volatilities,
+                                       Greeks* out, size_t n) {
+    for_each_contract_block<V>(types, strikes, prices, times, rates, volatilities, n,
+        [out](const ContractLanes<V>& c, size_t offset, size_t count) {
+            LaneTerms<V> t = lane_terms(c);
+            const V two = V::set1(2.0);
+            V pdf_d1 = t.gauss_d1 * V::set1(kInvSqrt2Pi);
+            V d1_d2 = t.d1 * t.d2;
+            V strike_leg = t.discounted_strike * t.cdf_d2;
+
+            // Two divisions give every reciprocal the Greeks need
+            V inv_vol_sqrt_time = V::set1(1.0) / t.vol_sqrt_time;
+            V inv_price = V::set1(1.0) / c.price;
+            V inv_vol = t.sqrt_time * inv_vol_sqrt_time;
+            V inv_sqrt_time = c.volatility * inv_vol_sqrt_time;
+            V half_inv_time = V::set1(0.5) * inv_sqrt_time * inv_sqrt_time;
+
+            V vega = c.price * pdf_d1 * t.sqrt_time;
+            V fields[10] = {
+                c.sign * (c.price * t.cdf_d1 - strike_leg),
+                c.sign * t.cdf_d1,
+                pdf_d1 * inv_price * inv_vol_sqrt_time,
+                vega,
+                -(V::set1(0.5) * c.price * pdf_d1 * c.volatility * inv_sqrt_time) - c.sign * c.rate * strike_leg,
+                c.sign * strike_leg * c.time,
+                -(pdf_d1 * t.d2 * inv_vol),
+                vega * d1_d2 * inv_vol,
+                -(pdf_d1 * (two * c.rate * c.time - t.d2 * t.vol_sqrt_time) * half_inv_time * inv_vol_sqrt_time),
+                vega * (c.rate * t.d1 * inv_vol_sqrt_time - (V::set1(1.0) + d1_d2) * half_inv_time),
+            };
+
+            double lanes[10][V::width];
+            for (size_t k = 0; k < 10; ++k) {
+                V::store(lanes[k], fields[k]);
+            }
+            for (size_t j = 0; j < count; ++j) {
+                out[offset + j] = {lanes[0][j], lanes[1][j], lanes[2][j], lanes[3][j], lanes[4][j],
+                                   lanes[5][j], lanes[6][j], lanes[7][j], lanes[8][j], lanes[9][j]};
+            }
+        });
+}
+
+} // namespace
+
+#endif // BLACK_SCHOLES_SIMD_KERNEL
+
+#endif // BLACK_SCHOLES_SIMD_H
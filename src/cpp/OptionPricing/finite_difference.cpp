@@ -0,0 +1,445 @@
+#include "finmath/OptionPricing/finite_difference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/tridiagonal.h"
+
+// The PDE is solved in time to expiry tau = T - t on a price grid 0 < S_0 < S_1 < ... < S_M:
+//     V_tau = L V = 1/2 sigma^2 S^2 V_SS + r S V_S - r V,
+// with L discretized by three-point differences on the non-uniform grid. A Crank-Nicolson
+// step solves (I - dt/2 L) V^{n+1} = (I + dt/2 L) V^n; a Rannacher half step solves
+// (I - dt/2 L) V^{n+1/2} = V^n, the same matrix, so one factorization serves both.
+// V(S_0) and V(S_M) follow the linear asymptotes of the payoff (Dirichlet conditions).
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// PSOR relaxation factor and stopping rule (largest change in a sweep, relative to K)
+constexpr double kPsorOmega = 1.5;
+constexpr double kPsorTolerance = 1e-12;
+constexpr int kPsorMaxSweeps = 10000;
+
+// One step of the march in tau: its size, whether it is taken as two implicit half steps
+// (Rannacher smoothing after the payoff or an exercise date) and whether exercise is allowed
+// at its end
+struct TimeStep {
+    double size;
+    bool smoothed;
+    bool exercise;
+};
+
+// Buffers of one pricing. Kept per thread and only ever grown, so repeated calls reuse them.
+struct Workspace {
+    std::vector<double> spots;
+    std::vector<double> payoff;
+    std::vector<double> values;
+    std::vector<double> rhs;
+    std::vector<double> op_lower;  // L row i: op_lower V_{i-1} + op_diagonal V_i + op_upper V_{i+1}
+    std::vector<double> op_diagonal;
+    std::vector<double> op_upper;
+    std::vector<double> lower;     // I - dt/2 L on the interior nodes
+    std::vector<double> diagonal;
+    std::vector<double> upper;
+    std::vector<TimeStep> steps;
+    std::vector<double> dates;
+    TridiagonalSolver solver;
+};
+
+Workspace& thread_workspace() {
+    thread_local Workspace workspace;
+    return workspace;
+}
+
+// Projected SOR for x >= floor, A x >= d with A tridiagonal, starting from x
+void psor(const double* lower, const double* diagonal, const double* upper, const double* d, const double* floor,
+          double* x, size_t n, double scale) {
+    const double tolerance = kPsorTolerance * scale;
+    for (int sweep = 0; sweep < kPsorMaxSweeps; ++sweep) {
+        double change = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double residual = d[i];
+            if (i > 0) {
+                residual -= lower[i] * x[i - 1];
+            }
+            if (i + 1 < n) {
+                residual -= upper[i] * x[i + 1];
+            }
+            double updated = std::max(floor[i], x[i] + kPsorOmega * (residual / diagonal[i] - x[i]));
+            change = std::max(change, std::fabs(updated - x[i]));
+            x[i] = updated;
+        }
+        if (change <= tolerance) {
+            return;
+        }
+    }
+}
+
+// Node cluster at the exercise boundary: its weight relative to the strike cluster and its
+// width as a fraction of the strike cluster's
+constexpr double kBoundaryWeight = 0.5;
+constexpr double kBoundaryWidth = 0.1;
+
+// Problem and grid map shared by the fine and coarse grids of one pricing. Nodes are uniform
+// in xi = asinh(x / c) + w asinh((x - x_b) / c_b) of the log-moneyness x = log(S / K), which
+// clusters them around the strike and, for American options, around the exercise boundary
+// x_b at tau = T (w = 0 otherwise). The step in xi is chosen so that node j0 is S0; grids
+// with j0 and 2 j0 nodes below S0 (and M and 2 M steps) are therefore nested.
+struct Problem {
+    OptionType type;
+    ExerciseStyle style;
+    double S0;
+    double K;
+    double T;
+    double r;
+    double sigma;
+    double c;
+    double boundary;
+    double boundary_weight;
+    double boundary_width;
+    double x_lo;
+    double x_spot;
+    double x_hi;
+    double xi_lo;
+    double xi_spot;
+};
+
+double grid_map(const Problem& p, double x) {
+    return std::asinh(x / p.c) + p.boundary_weight * std::asinh((x - p.boundary) / p.boundary_width);
+}
+
+double grid_map_slope(const Problem& p, double x) {
+    double y = x - p.boundary;
+    return 1.0 / std::sqrt(p.c * p.c + x * x) +
+           p.boundary_weight / std::sqrt(p.boundary_width * p.boundary_width + y * y);
+}
+
+// x > lo with grid_map(x) = xi. Without the boundary cluster the map inverts directly;
+// otherwise Newton steps from guess, falling back to bisection.
+double grid_inverse(const Problem& p, double xi, double lo, double guess) {
+    if (p.boundary_weight == 0.0) {
+        return p.c * std::sinh(xi);
+    }
+    double hi = lo + 1.0;
+    while (grid_map(p, hi) < xi) {
+        hi += 2.0 * (hi - lo);
+    }
+    double x = guess > lo && guess < hi ? guess : lo;
+    for (int k = 0; k < 100; ++k) {
+        double f = grid_map(p, x) - xi;
+        if (f > 0) {
+            hi = x;
+        } else {
+            lo = x;
+        }
+        double next = x - f / grid_map_slope(p, x);
+        if (std::fabs(next - x) <= 1e-12 * (1.0 + std::fabs(x))) {
+            return next;
+        }
+        x = next > lo && next < hi ? next : 0.5 * (lo + hi);
+    }
+    return x;
+}
+
+// Fix the map's range and return the node of S0 on a grid of M price steps
+size_t place_spot(Problem& problem, size_t M) {
+    problem.xi_lo = grid_map(problem, problem.x_lo);
+    problem.xi_spot = grid_map(problem, problem.x_spot);
+    const double xi_hi = grid_map(problem, problem.x_hi);
+    long nearest = std::lround((problem.xi_spot - problem.xi_lo) / (xi_hi - problem.xi_lo) * static_cast<double>(M));
+    return static_cast<size_t>(std::min(std::max(nearest, 1L), static_cast<long>(M) - 1));
+}
+
+// Solve on a grid of M price steps (node j0 at S0) and N time steps
+FiniteDifferenceResult solve_on_grid(const Problem& problem, size_t M, size_t N, size_t j0,
+                                     const FiniteDifferenceSettings& settings,
+                                     const std::vector<double>& exercise_times) {
+    const ExerciseStyle style = problem.style;
+    const double K = problem.K;
+    const double T = problem.T;
+    const double r = problem.r;
+    const double sigma = problem.sigma;
+    const double dt = T / static_cast<double>(N);
+    const bool put = problem.type == OptionType::PUT;
+    Workspace& w = thread_workspace();
+
+    w.spots.resize(M + 1);
+    const double dxi = (problem.xi_spot - problem.xi_lo) / static_cast<double>(j0);
+    double x = problem.x_lo - 1.0;
+    double dx = 0.0;
+    for (size_t i = 0; i <= M; ++i) {
+        double next = grid_inverse(problem, problem.xi_lo + static_cast<double>(i) * dxi, x, x + dx);
+        dx = i > 0 ? next - x : 0.0;
+        x = next;
+        w.spots[i] = K * std::exp(x);
+    }
+    w.spots[j0] = problem.S0;
+    const double* S = w.spots.data();
+
+    w.payoff.resize(M + 1);
+    w.values.resize(M + 1);
+    for (size_t i = 0; i <= M; ++i) {
+        w.payoff[i] = put ? std::max(K - S[i], 0.0) : std::max(S[i] - K, 0.0);
+        w.values[i] = w.payoff[i];
+    }
+    // Start from the payoff averaged over the cell of the node nearest the strike. Without
+    // this the error depends on where K falls between nodes, which changes from grid to grid
+    // and defeats the extrapolation; the exercise floor keeps the exact payoff.
+    for (size_t i = 1; i < M; ++i) {
+        double a = 0.5 * (S[i - 1] + S[i]);
+        double b = 0.5 * (S[i] + S[i + 1]);
+        if (a < K && K <= b) {
+            w.values[i] = (put ? (K - a) * (K - a) : (b - K) * (b - K)) / (2.0 * (b - a));
+        }
+    }
+
+    // Operator L; interior node i is row i - 1 of the system
+    const size_t interior = M - 1;
+    w.op_lower.resize(M + 1);
+    w.op_diagonal.resize(M + 1);
+    w.op_upper.resize(M + 1);
+    for (size_t i = 1; i < M; ++i) {
+        double hm = S[i] - S[i - 1];
+        double hp = S[i + 1] - S[i];
+        double diffusion = sigma * sigma * S[i] * S[i];  // twice the coefficient of V_SS
+        double drift = r * S[i];
+        w.op_lower[i] = (diffusion - drift * hp) / (hm * (hm + hp));
+        w.op_diagonal[i] = (-diffusion + drift * (hp - hm)) / (hm * hp) - r;
+        w.op_upper[i] = (diffusion + drift * hm) / (hp * (hm + hp));
+    }
+
+    // Time steps. AMERICAN steps are uniform in sqrt(tau): the exercise boundary moves like
+    // sqrt(tau) near expiry, and steps that shrink towards expiry keep the scheme close to
+    // second order there (with uniform steps it drops to about first order). BERMUDAN steps
+    // are uniform between exercise dates, which fall exactly on step ends, and each date
+    // restarts the Rannacher smoothing since exercise puts a new kink into V.
+    w.steps.clear();
+    if (style == ExerciseStyle::AMERICAN) {
+        for (size_t n = 1; n <= N; ++n) {
+            double u1 = static_cast<double>(n) / static_cast<double>(N);
+            double u0 = static_cast<double>(n - 1) / static_cast<double>(N);
+            w.steps.push_back({T * (u1 * u1 - u0 * u0), n <= settings.rannacher_steps, true});
+        }
+    } else {
+        // Exercise dates as times to expiry, in increasing order
+        std::vector<double>& dates = w.dates;
+        dates.clear();
+        if (style == ExerciseStyle::BERMUDAN) {
+            for (double t : exercise_times) {
+                if (t >= 0.0 && t < T) {
+                    dates.push_back(T - t);
+                }
+            }
+            std::sort(dates.begin(), dates.end());
+            dates.erase(std::unique(dates.begin(), dates.end()), dates.end());
+        }
+        double start = 0.0;
+        for (size_t d = 0; d <= dates.size(); ++d) {
+            double end = d < dates.size() ? dates[d] : T;
+            bool exercise = d < dates.size();
+            if (end <= start) {
+                // Nothing is left to step after a date at t = 0
+                continue;
+            }
+            long count = std::max(1L, std::lround((end - start) / dt));
+            double size = (end - start) / static_cast<double>(count);
+            for (long n = 0; n < count; ++n) {
+                w.steps.push_back({size, static_cast<size_t>(n) < settings.rannacher_steps, exercise && n + 1 == count});
+            }
+            start = end;
+        }
+    }
+
+    // Matrix I - dt/2 L for a step of size dt. Brennan-Schwartz substitutes from the exercise
+    // region inward, from S = 0 for puts, so their elimination runs from the top.
+    w.lower.resize(interior);
+    w.diagonal.resize(interior);
+    w.upper.resize(interior);
+    double factorized_step = 0.0;
+    auto factorize = [&](double step) {
+        if (step == factorized_step) {
+            return;
+        }
+        for (size_t i = 1; i < M; ++i) {
+            w.lower[i - 1] = -0.5 * step * w.op_lower[i];
+            w.diagonal[i - 1] = 1.0 - 0.5 * step * w.op_diagonal[i];
+            w.upper[i - 1] = -0.5 * step * w.op_upper[i];
+        }
+        w.solver.factorize(w.lower.data(), w.diagonal.data(), w.upper.data(), interior, put);
+        factorized_step = step;
+    };
+
+    // Boundary values are K B - S_0 (put at S_0) and S_M - K B (call at S_M), where B is the
+    // discount factor since the last exercise opportunity
+    double bond = 1.0;
+    const bool american = style == ExerciseStyle::AMERICAN;
+    const bool brennan_schwartz = settings.exercise_solver == ExerciseSolver::BRENNAN_SCHWARTZ;
+    w.rhs.resize(interior);
+    double* V = w.values.data();
+    double* rhs = w.rhs.data();
+    const double* floor = w.payoff.data() + 1;
+    const double* op_lower = w.op_lower.data();
+    const double* op_diagonal = w.op_diagonal.data();
+    const double* op_upper = w.op_upper.data();
+
+    // Advance by an implicit half step or a full Crank-Nicolson step of size step
+    auto advance = [&](double step, bool crank_nicolson, bool exercise) {
+        const double half = 0.5 * step;
+        if (crank_nicolson) {
+            for (size_t i = 1; i < M; ++i) {
+                rhs[i - 1] = V[i] + half * (op_lower[i] * V[i - 1] + op_diagonal[i] * V[i] + op_upper[i] * V[i + 1]);
+            }
+        } else {
+            std::copy(V + 1, V + M, rhs);
+        }
+        bond *= std::exp(-r * (crank_nicolson ? step : half));
+        if (exercise) {
+            bond = put ? std::max(bond, 1.0) : std::min(bond, 1.0);
+        }
+        V[0] = put ? K * bond - S[0] : 0.0;
+        V[M] = put ? 0.0 : S[M] - K * bond;
+        rhs[0] += half * op_lower[1] * V[0];
+        rhs[interior - 1] += half * op_upper[M - 1] * V[M];
+
+        if (!exercise || !american) {
+            // A discrete exercise date takes the larger of holding and exercising at that instant
+            w.solver.solve(rhs);
+            for (size_t i = 0; i < interior; ++i) {
+                V[i + 1] = exercise ? std::max(rhs[i], floor[i]) : rhs[i];
+            }
+        } else if (brennan_schwartz) {
+            w.solver.solve_projected(rhs, floor);
+            std::copy(rhs, rhs + interior, V + 1);
+        } else {
+            psor(w.lower.data(), w.diagonal.data(), w.upper.data(), rhs, floor, V + 1, interior, K);
+        }
+    };
+
+    for (const TimeStep& step : w.steps) {
+        factorize(step.size);
+        if (step.smoothed) {
+            // Exercise between the half steps only where it is continuous
+            advance(step.size, false, american);
+            advance(step.size, false, step.exercise);
+        } else {
+            advance(step.size, true, step.exercise);
+        }
+    }
+
+    double hm = S[j0] - S[j0 - 1];
+    double hp = S[j0 + 1] - S[j0];
+    FiniteDifferenceResult result;
+    result.price = V[j0];
+    result.delta = (-hp / (hm * (hm + hp))) * V[j0 - 1] + ((hp - hm) / (hm * hp)) * V[j0] +
+                   (hm / (hp * (hm + hp))) * V[j0 + 1];
+    result.gamma = 2.0 * (V[j0 - 1] / (hm * (hm + hp)) - V[j0] / (hm * hp) + V[j0 + 1] / (hp * (hm + hp)));
+    // Theta from the PDE itself, dV/dt = -L V, which is zero where the option is exercised
+    bool exercised = w.steps.back().exercise && V[j0] <= w.payoff[j0];
+    result.theta = exercised ? 0.0 : -(op_lower[j0] * V[j0 - 1] + op_diagonal[j0] * V[j0] + op_upper[j0] * V[j0 + 1]);
+    return result;
+}
+
+// Log-moneyness of the exercise boundary at tau = T from a solve on a grid of M price steps,
+// or NaN if the option is not exercised anywhere inside the grid. Off the boundary V - payoff
+// grows like (S - S*)^2, so S* is extrapolated from the square roots at the first two nodes
+// that are held.
+double exercise_boundary(const Problem& problem, size_t M, size_t N, size_t j0,
+                         const FiniteDifferenceSettings& settings) {
+    solve_on_grid(problem, M, N, j0, settings, {});
+    const Workspace& w = thread_workspace();
+    const bool put = problem.type == OptionType::PUT;
+    const double* V = w.values.data();
+    const double* payoff = w.payoff.data();
+    // Walk in from the deep in-the-money end to the first node that is held
+    for (size_t k = 1; k + 2 <= M; ++k) {
+        const size_t held = put ? k : M - k;
+        if (V[held] <= payoff[held]) {
+            continue;
+        }
+        if (k == 1) {
+            break;
+        }
+        const size_t exercised = put ? held - 1 : held + 1;
+        const size_t next = put ? held + 1 : held - 1;
+        const double x_exercised = std::log(w.spots[exercised] / problem.K);
+        const double x_held = std::log(w.spots[held] / problem.K);
+        const double x_next = std::log(w.spots[next] / problem.K);
+        const double e_held = std::sqrt(V[held] - payoff[held]);
+        const double e_next = std::sqrt(std::max(V[next] - payoff[next], 0.0));
+        double x = e_next > e_held ? x_held - e_held * (x_next - x_held) / (e_next - e_held) : x_held;
+        return put ? std::min(std::max(x, x_exercised), x_held) : std::max(std::min(x, x_exercised), x_held);
+    }
+    return kNaN;
+}
+
+} // namespace
+
+FiniteDifferenceResult finite_difference_pricing(OptionType type, ExerciseStyle style, double S0, double K, double T,
+                                                 double r, double sigma, const FiniteDifferenceSettings& settings,
+                                                 const std::vector<double>& exercise_times) {
+    FINMATH_INSTRUMENT("finite_difference_pricing", 1);
+    const FiniteDifferenceResult invalid = {kNaN, kNaN, kNaN, kNaN};
+    const size_t min_scale = settings.extrapolate ? 2 : 1;
+    if (settings.space_steps < 3 * min_scale || settings.time_steps < min_scale) {
+        std::cerr << "Finite difference grid needs at least " << 3 * min_scale << " price steps and " << min_scale
+                  << " time steps." << std::endl;
+        return invalid;
+    }
+    if (!(S0 > 0) || !(K > 0) || !(T > 0) || !(sigma > 0) || !std::isfinite(r)) {
+        std::cerr << "Invalid option parameters." << std::endl;
+        return invalid;
+    }
+    if (!(settings.concentration > 0) || !(settings.std_devs > 0)) {
+        std::cerr << "Grid concentration and width must be positive." << std::endl;
+        return invalid;
+    }
+
+    // Place S0 on the (coarse) grid, then double it for the fine grid when extrapolating
+    Problem problem;
+    problem.type = type;
+    problem.style = style;
+    problem.S0 = S0;
+    problem.K = K;
+    problem.T = T;
+    problem.r = r;
+    problem.sigma = sigma;
+    problem.c = settings.concentration * sigma * std::sqrt(T);
+    problem.boundary = 0.0;
+    problem.boundary_weight = 0.0;
+    problem.boundary_width = kBoundaryWidth * problem.c;
+    problem.x_lo = std::log(std::min(S0, K) / K) - settings.std_devs * sigma * std::sqrt(T);
+    problem.x_spot = std::log(S0 / K);
+    problem.x_hi = std::log(std::max(S0, K) / K) + settings.std_devs * sigma * std::sqrt(T);
+    const size_t M = settings.space_steps / min_scale;
+    const size_t N = settings.time_steps / min_scale;
+    if (style == ExerciseStyle::AMERICAN) {
+        // Where the exercise boundary ends up relative to the nodes changes from grid to grid
+        // and makes the error jump between them; nodes packed around it keep it smooth. A
+        // solve with half the steps locates it well enough.
+        const size_t pilot_steps = std::max<size_t>(M / 2, 3);
+        double boundary = exercise_boundary(problem, pilot_steps, std::max<size_t>(N / 2, 1),
+                                            place_spot(problem, pilot_steps), settings);
+        if (std::isfinite(boundary)) {
+            problem.boundary = boundary;
+            problem.boundary_weight = kBoundaryWeight;
+        }
+    }
+    const size_t j0 = place_spot(problem, M);
+
+    if (!settings.extrapolate) {
+        return solve_on_grid(problem, M, N, j0, settings, exercise_times);
+    }
+    // Richardson: the error is c2 (h^2 + dt^2) + ..., so (4 fine - coarse) / 3 cancels the leading term
+    FiniteDifferenceResult fine = solve_on_grid(problem, 2 * M, 2 * N, 2 * j0, settings, exercise_times);
+    FiniteDifferenceResult coarse = solve_on_grid(problem, M, N, j0, settings, exercise_times);
+    FiniteDifferenceResult result;
+    result.price = (4.0 * fine.price - coarse.price) / 3.0;
+    result.delta = (4.0 * fine.delta - coarse.delta) / 3.0;
+    result.gamma = (4.0 * fine.gamma - coarse.gamma) / 3.0;
+    result.theta = (4.0 * fine.theta - coarse.theta) / 3.0;
+    return result;
+}
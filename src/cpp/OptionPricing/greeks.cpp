@@ -0,0 +1,71 @@
+#include "finmath/OptionPricing/greeks.h"
+
+#include <cmath>
+
+#include "finmath/Helper/helper.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/OptionPricing/black_scholes.h"
+#include "black_scholes_simd.h"
+
+namespace {
+
+// Body of black_scholes_greeks, which the batch calls without recording every option
+Greeks greeks_of(OptionType type, double strike, double price, double time, double rate, double volatility) {
+    BlackScholesTerms terms = black_scholes_terms(strike, price, time, rate, volatility);
+    const double d1 = terms.d1;
+    const double d2 = terms.d2;
+    const double vol_sqrt_time = volatility * terms.sqrt_time;
+    const double discounted_strike = strike * terms.discount;
+
+    // sign = +1 for calls, -1 for puts: N(sign d) picks the tail each leg needs
+    const double sign = (type == OptionType::CALL) ? 1.0 : -1.0;
+    const double cdf_d1 = normal_cdf(sign * d1);
+    const double cdf_d2 = normal_cdf(sign * d2);
+    const double pdf_d1 = normal_pdf(d1);
+
+    Greeks g;
+    g.price = sign * (price * cdf_d1 - discounted_strike * cdf_d2);
+    g.delta = sign * cdf_d1;
+    g.gamma = pdf_d1 / (price * vol_sqrt_time);
+    g.vega = price * pdf_d1 * terms.sqrt_time;
+    g.theta = -price * pdf_d1 * volatility / (2 * terms.sqrt_time) - sign * rate * discounted_strike * cdf_d2;
+    g.rho = sign * discounted_strike * time * cdf_d2;
+    g.vanna = -pdf_d1 * d2 / volatility;
+    g.volga = g.vega * d1 * d2 / volatility;
+    g.charm = -pdf_d1 * (2 * rate * time - d2 * vol_sqrt_time) / (2 * time * vol_sqrt_time);
+    g.veta = g.vega * (rate * d1 / vol_sqrt_time - (1 + d1 * d2) / (2 * time));
+    return g;
+}
+
+} // namespace
+
+Greeks black_scholes_greeks(OptionType type, double strike, double price, double time, double rate, double volatility) {
+    FINMATH_INSTRUMENT_SAMPLED("black_scholes_greeks", 1);
+    return greeks_of(type, strike, price, time, rate, volatility);
+}
+
+void black_scholes_greeks_batch(const OptionType* types, const double* strikes, const double* prices,
+                                const double* times, const double* rates, const double* volatilities,
+                                Greeks* out, size_t n) {
+    FINMATH_INSTRUMENT("black_scholes_greeks_batch", n);
+    // Each SIMD kernel reports false when it was not compiled in, dropping to the next level
+    switch (active_simd_level()) {
+        case SimdLevel::AVX512:
+            if (black_scholes_greeks_batch_avx512(types, strikes, prices, times, rates, volatilities, out, n)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (black_scholes_greeks_batch_avx2(types, strikes, prices, times, rates, volatilities, out, n)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = greeks_of(types[i], strikes[i], prices[i], times[i], rates[i], volatilities[i]);
+    }
+}
@@ -0,0 +1,191 @@
+#include "finmath/OptionPricing/implied_volatility.h"
+
+#include <cmath>
+#include <limits>
+
+#include "finmath/Helper/helper.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/normal_distribution.h"
+
+// The solver works on the normalised Black call with log-moneyness x = ln(F / K) <= 0
+// and total volatility s = sigma sqrt(T):
+//     b(x, s) = e^{x/2} N(x/s + s/2) - e^{-x/2} N(x/s - s/2),
+// which increases from 0 to e^{x/2} and has its single inflection point at s_c = sqrt(-2x).
+// Any call or put maps onto it: subtracting the intrinsic value gives the out-of-the-money
+// option (put-call parity), and an out-of-the-money put at x is the call at -x.
+
+namespace {
+
+constexpr int kMaxIterations = 32;
+// Relative step in s below which the solve has converged. The error after a Householder
+// step shrinks like the cube of the step, so the returned value is at machine precision.
+constexpr double kTolerance = 1e-8;
+constexpr double kInvSqrt2Pi = 0.39894228040143267794;
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+const double kInf = std::numeric_limits<double>::infinity();
+
+// Log-moneyness x <= 0 with the weights e^{x/2} and e^{-x/2}, computed once per solve
+struct Moneyness {
+    double x;
+    double forward_weight;
+    double strike_weight;
+};
+
+// b(x, s) and a bound on its rounding error. N is evaluated at x/s +- s/2; its relative
+// error grows like (x/s)^2 times the rounding of the argument, and the subtraction of the
+// two terms turns that into an absolute error of the size of the larger term. N stays on
+// the EXACT tier whatever set_normal_accuracy says, since the bound assumes it.
+double normalised_call(const Moneyness& m, double s, double& error) {
+    double h = m.x / s;
+    double t = 0.5 * s;
+    double leading = m.forward_weight * normal_cdf(h + t, NormalAccuracy::EXACT);
+    error = 4.0 * std::numeric_limits<double>::epsilon() * (1.0 + h * h) * leading;
+    return leading - m.strike_weight * normal_cdf(h - t, NormalAccuracy::EXACT);
+}
+
+// Guess below the inflection point. There ln b is close to linear in 1/s^2, so take the
+// line through ln b_c at the inflection point with the slope of ln b there,
+// d ln b / ds = b' / b, where b'(s_c) = e^{x/2} / sqrt(2 pi).
+double lower_guess(const Moneyness& m, double beta, double s_c, double b_c) {
+    double slope = kInvSqrt2Pi * m.forward_weight / b_c;
+    double inverse_square = 1.0 / (s_c * s_c) + 2.0 * std::log(b_c / beta) / (slope * s_c * s_c * s_c);
+    return 1.0 / std::sqrt(inverse_square);
+}
+
+// Guess above the inflection point from b ~ e^{x/2} - (e^{x/2} + e^{-x/2}) N(-s/2) as s -> inf,
+// exact at x = 0
+double upper_guess(const Moneyness& m, double beta, double s_c) {
+    double tail = (m.forward_weight - beta) / (m.forward_weight + m.strike_weight);
+    return std::fmax(-2.0 * inverse_normal_cdf(tail), s_c);
+}
+
+// Solve b(x, s) = beta for 0 < beta < e^{x/2}. Below the inflection point b falls off like
+// exp(-x^2 / 2s^2), so there the iteration runs on ln b, which is close to linear in 1/s^2.
+double solve_total_volatility(const Moneyness& m, double beta, ImpliedVolStatus& status) {
+    const double x = m.x;
+    const double s_c = std::sqrt(-2.0 * x);
+    double error;
+    const double b_c = s_c > 0.0 ? normalised_call(m, s_c, error) : 0.0;
+    const bool lower = beta < b_c;
+
+    double lo = lower ? 0.0 : s_c;
+    double hi = lower ? s_c : kInf;
+    double s = lower ? lower_guess(m, beta, s_c, b_c) : upper_guess(m, beta, s_c);
+    if (!(s > lo && s < hi)) {
+        s = lower ? 0.5 * s_c : s_c + 1.0;
+    }
+
+    const double log_beta = std::log(beta);
+    for (int iteration = 0; iteration < kMaxIterations; ++iteration) {
+        double b = normalised_call(m, s, error);
+        if (std::fabs(b - beta) <= error) {
+            // Deep in the wings b is only known to within error, so s cannot be pinned down further
+            status = ImpliedVolStatus::CONVERGED;
+            return s;
+        }
+        if (b > beta) {
+            hi = s;
+        } else {
+            lo = s;
+        }
+
+        // Derivatives in s: b' = exp(-(x^2/s^2 + s^2/4) / 2) / sqrt(2 pi), b''/b' = a, b'''/b' = a^2 + a'
+        double x2 = x * x;
+        double vega = kInvSqrt2Pi * std::exp(-0.5 * (x2 / (s * s) + 0.25 * s * s));
+        double a = x2 / (s * s * s) - 0.25 * s;
+        double da = -3.0 * x2 / (s * s * s * s) - 0.25;
+
+        double newton;
+        double h2;
+        double h3;
+        if (lower) {
+            // f = ln b - ln beta, with g = b'/b
+            double g = vega / b;
+            newton = -(std::log(b) - log_beta) / g;
+            h2 = a - g;
+            h3 = a * a + da - 3.0 * a * g + 2.0 * g * g;
+        } else {
+            newton = -(b - beta) / vega;
+            h2 = a;
+            h3 = a * a + da;
+        }
+        // Third-order Householder step
+        double next = s + newton * (1.0 + 0.5 * h2 * newton) / (1.0 + newton * (h2 + h3 * newton / 6.0));
+
+        if (std::fabs(next - s) <= kTolerance * s) {
+            status = ImpliedVolStatus::CONVERGED;
+            return next;
+        }
+        // Fall back to bisection when the step leaves the bracket (or b underflowed)
+        if (!(next > lo && next < hi)) {
+            next = std::isinf(hi) ? 2.0 * s : 0.5 * (lo + hi);
+        }
+        s = next;
+    }
+    status = ImpliedVolStatus::MAX_ITERATIONS;
+    return s;
+}
+
+// Body of implied_volatility, which the batch calls without recording every quote
+double solve_quote(OptionType type, double option_price, double strike, double price, double time, double rate,
+                   ImpliedVolStatus* status) {
+    ImpliedVolStatus outcome;
+    double volatility = kNaN;
+
+    if (!(strike > 0.0 && price > 0.0 && time > 0.0) || !std::isfinite(strike) || !std::isfinite(price) ||
+        !std::isfinite(time) || !std::isfinite(rate) || !std::isfinite(option_price)) {
+        outcome = ImpliedVolStatus::INVALID_INPUT;
+    } else {
+        // Work with undiscounted (forward) values
+        double growth = std::exp(rate * time);
+        double forward = price * growth;
+        double value = option_price * growth;
+        bool call = type == OptionType::CALL;
+        double intrinsic = call ? std::fmax(forward - strike, 0.0) : std::fmax(strike - forward, 0.0);
+        double maximum = call ? forward : strike;
+
+        if (value < intrinsic) {
+            outcome = ImpliedVolStatus::BELOW_INTRINSIC;
+        } else if (value >= maximum) {
+            outcome = ImpliedVolStatus::ABOVE_MAXIMUM;
+        } else if (value == intrinsic) {
+            outcome = ImpliedVolStatus::CONVERGED;
+            volatility = 0.0;
+        } else {
+            Moneyness m;
+            m.x = -std::fabs(std::log(forward / strike));
+            m.forward_weight = std::exp(0.5 * m.x);
+            m.strike_weight = 1.0 / m.forward_weight;
+            double beta = (value - intrinsic) / std::sqrt(forward * strike);
+            if (beta >= m.forward_weight) {
+                // Only reachable through rounding right at the upper bound
+                outcome = ImpliedVolStatus::ABOVE_MAXIMUM;
+            } else {
+                volatility = solve_total_volatility(m, beta, outcome) / std::sqrt(time);
+            }
+        }
+    }
+
+    if (status) {
+        *status = outcome;
+    }
+    return volatility;
+}
+
+} // namespace
+
+double implied_volatility(OptionType type, double option_price, double strike, double price, double time,
+                          double rate, ImpliedVolStatus* status) {
+    FINMATH_INSTRUMENT_SAMPLED("implied_volatility", 1);
+    return solve_quote(type, option_price, strike, price, time, rate, status);
+}
+
+void implied_volatility_batch(const OptionType* types, const double* option_prices, const double* strikes,
+                              const double* prices, const double* times, const double* rates, double* out,
+                              ImpliedVolStatus* status, size_t n) {
+    FINMATH_INSTRUMENT("implied_volatility_batch", n);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = solve_quote(types[i], option_prices[i], strikes[i], prices[i], times[i], rates[i],
+                             status ? status + i : nullptr);
+    }
+}
@@ -0,0 +1,226 @@
+#ifndef LATTICE_CORE_H
+#define LATTICE_CORE_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+#include "finmath/Helper/aligned_allocator.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/OptionPricing/binomial_tree.h"
+#include "finmath/OptionPricing/options_pricing_types.h"
+#include "binomial_tree_simd.h"
+#include "trinomial_tree_simd.h"
+
+// Recombining lattice shared by the binomial and trinomial pricers. Branches = 2 or 3 is
+// the number of successors of a node: step n has (Branches - 1) n + 1 nodes, node i of a
+// binomial step sits at S0 u^(2i - n) and of a trinomial step at S0 u^(i - n). Node values
+// live in one rolling array that each backward step overwrites in place.
+//
+// What is priced comes from a policy type, whose member functions inline into the rollback:
+//   void initialize(long n, const Real* S, Real* v, long count) const  values at the last step
+//   RollbackExercise exercise(long n) const  early exercise fused into the step to n
+//   Real strike() const                      strike of that exercise
+//   void adjust(long n, const Real* S, Real* v, long count) const  anything else after the
+//                                            step to n (barriers, mesh refinement)
+
+template <typename Real>
+using LatticeVector = std::vector<Real, AlignedAllocator<Real>>;
+
+template <typename Real>
+inline Real payoff(OptionType type, Real S, Real K) {
+    return type == OptionType::CALL ? std::max(S - K, Real(0)) : std::max(K - S, Real(0));
+}
+
+// Far out-of-the-money node values shrink geometrically as they are rolled back and
+// reach float's subnormal range within a few hundred steps, where every operation on
+// them is microcoded. While a float lattice runs, this thread's SSE control register
+// flushes subnormals to zero (values below 1e-38 do not move a price); the previous
+// mode is restored afterwards.
+class FlushSubnormals {
+public:
+#if defined(__SSE__) || defined(_M_X64)
+    explicit FlushSubnormals(bool enable) : saved_(_mm_getcsr()), enabled_(enable) {
+        if (enabled_) {
+            _mm_setcsr(saved_ | kFlushToZero | kDenormalsAreZero);
+        }
+    }
+    ~FlushSubnormals() {
+        if (enabled_) {
+            _mm_setcsr(saved_);
+        }
+    }
+
+private:
+    static constexpr unsigned int kFlushToZero = 0x8000;
+    static constexpr unsigned int kDenormalsAreZero = 0x0040;
+    unsigned int saved_;
+    bool enabled_;
+#else
+    explicit FlushSubnormals(bool) {}
+#endif
+};
+
+// Stock prices on the lattice. A binomial step's exponents 2i - n share the parity of n,
+// so the powers are split into even and odd tables and every step reads a contiguous
+// slice; a trinomial step's exponents i - n are a contiguous run of one table.
+template <int Branches, typename Real>
+struct PriceTable {
+    static_assert(Branches == 2 || Branches == 3, "lattices have two or three branches");
+
+    LatticeVector<Real> even;  // binomial S0 u^(2j - N); trinomial S0 u^(j - N), j = 0..2N
+    LatticeVector<Real> odd;   // binomial S0 u^(2j + 1 - N)
+    long N;
+
+    PriceTable(double S0, double log_u, long N) : N(N) {
+        // Each power is an independent exp, so no rounding error compounds across the table
+        if (Branches == 2) {
+            even.resize(N + 1);
+            odd.resize(N);
+            for (long j = 0; j <= N; ++j) {
+                even[j] = static_cast<Real>(S0 * std::exp(log_u * static_cast<double>(2 * j - N)));
+            }
+            for (long j = 0; j < N; ++j) {
+                odd[j] = static_cast<Real>(S0 * std::exp(log_u * static_cast<double>(2 * j + 1 - N)));
+            }
+        } else {
+            even.resize(2 * N + 1);
+            for (long j = 0; j <= 2 * N; ++j) {
+                even[j] = static_cast<Real>(S0 * std::exp(log_u * static_cast<double>(j - N)));
+            }
+        }
+    }
+
+    // Prices of the nodes of step n
+    const Real* step(long n) const {
+        long offset = N - n;
+        if (Branches == 3) {
+            return even.data() + offset;
+        }
+        return (offset % 2 == 0) ? even.data() + offset / 2 : odd.data() + (offset - 1) / 2;
+    }
+};
+
+// One backward-induction step onto nodes 0..n, on the widest kernel available.
+// p holds the discounted branch probabilities from the lowest branch to the highest.
+template <int Branches, typename Real>
+void lattice_rollback(SimdLevel level, Real* v, long n, const std::array<Real, Branches>& p, const Real* S, Real K,
+                      RollbackExercise exercise) {
+    if constexpr (Branches == 2) {
+        switch (level) {
+            case SimdLevel::AVX512:
+                if (binomial_rollback_avx512(v, n, p[1], p[0], S, K, exercise)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::AVX2:
+                if (binomial_rollback_avx2(v, n, p[1], p[0], S, K, exercise)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::SCALAR:
+                break;
+        }
+    } else if constexpr (std::is_same<Real, double>::value) {
+        switch (level) {
+            case SimdLevel::AVX512:
+                if (trinomial_rollback_avx512(v, n, p[2], p[1], p[0], S, K, exercise)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::AVX2:
+                if (trinomial_rollback_avx2(v, n, p[2], p[1], p[0], S, K, exercise)) {
+                    return;
+                }
+                [[fallthrough]];
+            case SimdLevel::SCALAR:
+                break;
+        }
+    }
+
+    // v[i] reads v[i + 1 ..] before later iterations overwrite them, so the update is in place
+    auto continuation = [&](long i) {
+        if constexpr (Branches == 2) {
+            return p[1] * v[i + 1] + p[0] * v[i];
+        } else {
+            return p[2] * v[i + 2] + p[1] * v[i + 1] + p[0] * v[i];
+        }
+    };
+    if (exercise == RollbackExercise::NONE) {
+        for (long i = 0; i <= n; ++i) {
+            v[i] = continuation(i);
+        }
+    } else if (exercise == RollbackExercise::CALL) {
+        for (long i = 0; i <= n; ++i) {
+            v[i] = std::max(continuation(i), S[i] - K);
+        }
+    } else {
+        for (long i = 0; i <= n; ++i) {
+            v[i] = std::max(continuation(i), K - S[i]);
+        }
+    }
+}
+
+// Which steps allow exercise (index 0..N)
+inline std::vector<char> exercise_schedule(ExerciseStyle style, long N, double dt,
+                                           const std::vector<double>& exercise_times) {
+    std::vector<char> allowed(N + 1, 0);
+    if (style == ExerciseStyle::AMERICAN) {
+        std::fill(allowed.begin(), allowed.end(), 1);
+    } else if (style == ExerciseStyle::BERMUDAN) {
+        for (double t : exercise_times) {
+            long step = std::lround(t / dt);
+            if (step >= 0 && step <= N) {
+                allowed[step] = 1;
+            }
+        }
+    }
+    return allowed;
+}
+
+template <int Branches, typename Real>
+class LatticeCore {
+public:
+    // probabilities are discounted and ordered from the lowest branch to the highest
+    LatticeCore(double S0, double log_u, long N, const std::array<Real, Branches>& probabilities)
+        : prices_(price_table(S0, log_u, N)), probabilities_(probabilities) {}
+
+    static long nodes(long n) { return (Branches - 1) * n + 1; }
+    long steps() const { return prices_.N; }
+    const Real* prices(long n) const { return prices_.step(n); }
+
+    // Roll the values policy.initialize puts on step `last` back to the root
+    template <typename Policy>
+    Real roll(const Policy& policy, long last) const {
+        const FlushSubnormals flush(std::is_same<Real, float>::value);
+
+        LatticeVector<Real> values(nodes(last));
+        Real* v = values.data();
+        policy.initialize(last, prices(last), v, nodes(last));
+
+        const SimdLevel level = active_simd_level();
+        for (long n = last - 1; n >= 0; --n) {
+            lattice_rollback<Branches>(level, v, nodes(n) - 1, probabilities_, prices(n), policy.strike(),
+                                       policy.exercise(n));
+            policy.adjust(n, prices(n), v, nodes(n));
+        }
+        return v[0];
+    }
+
+private:
+    // Built with subnormals flushed as the rollback runs them
+    static PriceTable<Branches, Real> price_table(double S0, double log_u, long N) {
+        const FlushSubnormals flush(std::is_same<Real, float>::value);
+        return PriceTable<Branches, Real>(S0, log_u, N);
+    }
+
+    PriceTable<Branches, Real> prices_;
+    std::array<Real, Branches> probabilities_;
+};
+
+#endif // LATTICE_CORE_H
@@ -0,0 +1,375 @@
+#include "finmath/OptionPricing/monte_carlo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "finmath/Helper/brownian_bridge.h"
+#include "finmath/Helper/helper.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/philox.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/Helper/sobol.h"
+#include "finmath/OptionPricing/black_scholes.h"
+#include "monte_carlo_simd.h"
+
+namespace {
+
+// Paths simulated together in structure-of-arrays layout
+constexpr size_t kLanes = 64;
+
+// Batches per task. Tasks are the unit of work handed to the pool and of the reduction,
+// so their boundaries must not depend on the thread count.
+constexpr size_t kBatchesPerTask = 16;
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Running means and co-moments of the payoff y and the control x, merged pairwise
+// (Chan et al.) so blocks can be combined in a fixed order
+struct SampleMoments {
+    double count = 0.0;
+    double mean_y = 0.0;
+    double mean_x = 0.0;
+    double m2_y = 0.0;
+    double m2_x = 0.0;
+    double c_xy = 0.0;
+
+    void add(double y, double x) {
+        count += 1.0;
+        double dy = y - mean_y;
+        double dx = x - mean_x;
+        mean_y += dy / count;
+        mean_x += dx / count;
+        m2_y += dy * (y - mean_y);
+        m2_x += dx * (x - mean_x);
+        c_xy += dx * (y - mean_y);
+    }
+
+    void merge(const SampleMoments& other) {
+        if (other.count == 0.0) {
+            return;
+        }
+        double total = count + other.count;
+        double dy = other.mean_y - mean_y;
+        double dx = other.mean_x - mean_x;
+        double weight = count * other.count / total;
+        m2_y += other.m2_y + dy * dy * weight;
+        m2_x += other.m2_x + dx * dx * weight;
+        c_xy += other.c_xy + dx * dy * weight;
+        mean_y += dy * other.count / total;
+        mean_x += dx * other.count / total;
+        count = total;
+    }
+};
+
+void normals_from_uniforms(const double* u, double* z, size_t n) {
+    switch (active_simd_level()) {
+        case SimdLevel::AVX512:
+            if (monte_carlo_normals_avx512(u, z, n)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (monte_carlo_normals_avx2(u, z, n)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        z[i] = inverse_normal_cdf(u[i]);
+    }
+}
+
+double vanilla_payoff(double underlying, double strike, bool call) {
+    return std::max(call ? underlying - strike : strike - underlying, 0.0);
+}
+
+void simulate_paths_scalar(const PathKernelArgs& a) {
+    const bool call = a.type == OptionType::CALL;
+    const double inv_steps = 1.0 / static_cast<double>(a.steps);
+
+    for (size_t lane = 0; lane < a.lanes; ++lane) {
+        double log_s = a.log_spot;
+        double log_max = log_s;
+        double log_min = log_s;
+        double log_sum = 0.0;
+        double sum = 0.0;
+
+        for (size_t k = 0; k < a.steps; ++k) {
+            log_s = std::fma(a.diffusion, a.z[k * a.lanes + lane], log_s + a.drift);
+            log_sum += log_s;
+            log_max = std::max(log_max, log_s);
+            log_min = std::min(log_min, log_s);
+            if (a.payoff == PathPayoff::ASIAN_ARITHMETIC) {
+                sum += std::exp(log_s);
+            }
+        }
+
+        double terminal = std::exp(log_s);
+        double european = vanilla_payoff(terminal, a.strike, call);
+        double payoff = 0.0;
+        switch (a.payoff) {
+            case PathPayoff::EUROPEAN:
+                payoff = european;
+                break;
+            case PathPayoff::ASIAN_ARITHMETIC:
+                payoff = vanilla_payoff(sum * inv_steps, a.strike, call);
+                break;
+            case PathPayoff::ASIAN_GEOMETRIC:
+                payoff = vanilla_payoff(std::exp(log_sum * inv_steps), a.strike, call);
+                break;
+            case PathPayoff::UP_AND_OUT:
+                payoff = log_max < a.log_barrier ? european : 0.0;
+                break;
+            case PathPayoff::UP_AND_IN:
+                payoff = log_max < a.log_barrier ? 0.0 : european;
+                break;
+            case PathPayoff::DOWN_AND_OUT:
+                payoff = a.log_barrier < log_min ? european : 0.0;
+                break;
+            case PathPayoff::DOWN_AND_IN:
+                payoff = a.log_barrier < log_min ? 0.0 : european;
+                break;
+            case PathPayoff::LOOKBACK_FIXED:
+                payoff = call ? vanilla_payoff(std::exp(log_max), a.strike, true)
+                              : vanilla_payoff(std::exp(log_min), a.strike, false);
+                break;
+            case PathPayoff::LOOKBACK_FLOATING:
+                payoff = call ? terminal - std::exp(log_min) : std::exp(log_max) - terminal;
+                break;
+        }
+
+        a.payoffs[lane] = payoff * a.discount;
+        a.controls[lane] = european * a.discount;
+    }
+}
+
+void simulate_paths(const PathKernelArgs& args) {
+    switch (active_simd_level()) {
+        case SimdLevel::AVX512:
+            if (monte_carlo_paths_avx512(args)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (monte_carlo_paths_avx2(args)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+    simulate_paths_scalar(args);
+}
+
+bool is_barrier(PathPayoff payoff) {
+    return payoff == PathPayoff::UP_AND_OUT || payoff == PathPayoff::UP_AND_IN ||
+           payoff == PathPayoff::DOWN_AND_OUT || payoff == PathPayoff::DOWN_AND_IN;
+}
+
+// Everything a task needs to simulate its batches
+struct Simulation {
+    const MonteCarloSettings* settings;
+    const SobolSequence* sobol;
+    const BrownianBridge* bridge;
+    PathKernelArgs kernel;    // shared parameters; buffers are filled in per batch
+    size_t draws_per_batch;   // independent draws per batch (half the lanes with antithetic)
+};
+
+// Uniforms for draws first_draw.. of one batch, in u[k * kLanes + lane]. Philox fills
+// whole groups of four steps, so u has room for steps rounded up to a multiple of 4.
+void fill_uniforms(const Simulation& sim, uint64_t first_draw, double* u, std::vector<uint32_t>& point) {
+    const size_t steps = sim.settings->steps;
+    const size_t draws = sim.draws_per_batch;
+
+    if (sim.settings->source == RandomSource::SOBOL) {
+        // Point 0 is the origin, which maps to -infinity without a shift, so start at 1
+        uint64_t index = first_draw + 1;
+        sim.sobol->point(index, point.data());
+        for (size_t lane = 0; lane < draws; ++lane) {
+            if (lane > 0) {
+                sim.sobol->next(index++, point.data());
+            }
+            for (size_t k = 0; k < steps; ++k) {
+                u[k * kLanes + lane] = philox_uniform(point[k]);
+            }
+        }
+        return;
+    }
+
+    // One Philox call yields the uniforms for four consecutive steps of one draw
+    const PhiloxKey key = philox_key(sim.settings->seed);
+    switch (active_simd_level()) {
+        case SimdLevel::AVX512:
+            if (monte_carlo_philox_avx512(first_draw, draws, steps, key[0], key[1], u, kLanes)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (monte_carlo_philox_avx2(first_draw, draws, steps, key[0], key[1], u, kLanes)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+
+    for (size_t lane = 0; lane < draws; ++lane) {
+        uint64_t draw = first_draw + lane;
+        for (size_t k = 0; k < steps; k += 4) {
+            PhiloxCounter bits = philox4x32(
+                {static_cast<uint32_t>(k / 4), 0, static_cast<uint32_t>(draw), static_cast<uint32_t>(draw >> 32)}, key);
+            for (size_t t = 0; t < 4 && k + t < steps; ++t) {
+                u[(k + t) * kLanes + lane] = philox_uniform(bits[t]);
+            }
+        }
+    }
+}
+
+// Simulate one task's batches and accumulate its samples
+SampleMoments run_task(const Simulation& sim, size_t first_batch, size_t batches) {
+    const size_t steps = sim.settings->steps;
+    const size_t draws = sim.draws_per_batch;
+    const bool antithetic = sim.settings->antithetic;
+
+    std::vector<double> u((steps + 3) / 4 * 4 * kLanes);
+    std::vector<double> z(steps * kLanes);
+    std::vector<double> w(sim.bridge ? steps * kLanes : 0);
+    std::vector<double> payoffs(kLanes);
+    std::vector<double> controls(kLanes);
+    std::vector<uint32_t> point(sim.sobol ? steps : 0);
+
+    PathKernelArgs args = sim.kernel;
+    args.z = z.data();
+    args.lanes = kLanes;
+    args.payoffs = payoffs.data();
+    args.controls = controls.data();
+
+    SampleMoments moments;
+    for (size_t b = first_batch; b < first_batch + batches; ++b) {
+        fill_uniforms(sim, static_cast<uint64_t>(b) * draws, u.data(), point);
+        for (size_t k = 0; k < steps; ++k) {
+            normals_from_uniforms(&u[k * kLanes], &z[k * kLanes], draws);
+        }
+
+        if (sim.bridge) {
+            // Bridge values W(1..n) back to unit increments W(k) - W(k - 1)
+            sim.bridge->build(z.data(), w.data(), kLanes);
+            for (size_t lane = 0; lane < draws; ++lane) {
+                z[lane] = w[lane];
+            }
+            for (size_t k = 1; k < steps; ++k) {
+                for (size_t lane = 0; lane < draws; ++lane) {
+                    z[k * kLanes + lane] = w[k * kLanes + lane] - w[(k - 1) * kLanes + lane];
+                }
+            }
+        }
+
+        if (antithetic) {
+            for (size_t k = 0; k < steps; ++k) {
+                for (size_t lane = 0; lane < draws; ++lane) {
+                    z[k * kLanes + draws + lane] = -z[k * kLanes + lane];
+                }
+            }
+        }
+
+        simulate_paths(args);
+
+        for (size_t lane = 0; lane < draws; ++lane) {
+            if (antithetic) {
+                moments.add(0.5 * (payoffs[lane] + payoffs[lane + draws]),
+                            0.5 * (controls[lane] + controls[lane + draws]));
+            } else {
+                moments.add(payoffs[lane], controls[lane]);
+            }
+        }
+    }
+    return moments;
+}
+
+} // namespace
+
+MonteCarloResult monte_carlo_price(OptionType type, PathPayoff payoff, double S0, double K, double T, double r,
+                                   double sigma, double barrier, const MonteCarloSettings& settings,
+                                   ThreadPool& pool) {
+    FINMATH_INSTRUMENT("monte_carlo_price", settings.paths);
+    const MonteCarloResult invalid = {kNaN, kNaN, 0};
+    if (settings.paths == 0 || settings.steps == 0) {
+        std::cerr << "Monte Carlo needs at least one path and one step." << std::endl;
+        return invalid;
+    }
+    if (!(S0 > 0) || !(K >= 0) || !(T > 0) || !(sigma > 0)) {
+        std::cerr << "Invalid option parameters." << std::endl;
+        return invalid;
+    }
+    if (is_barrier(payoff) && !(barrier > 0)) {
+        std::cerr << "Barrier level must be positive." << std::endl;
+        return invalid;
+    }
+    if (settings.source == RandomSource::SOBOL && settings.steps > SobolSequence::max_dimensions()) {
+        std::cerr << "Sobol sampling supports at most " << SobolSequence::max_dimensions() << " steps." << std::endl;
+        return invalid;
+    }
+
+    const double dt = T / static_cast<double>(settings.steps);
+
+    Simulation sim;
+    sim.settings = &settings;
+    sim.draws_per_batch = settings.antithetic ? kLanes / 2 : kLanes;
+
+    sim.kernel = PathKernelArgs();
+    sim.kernel.steps = settings.steps;
+    sim.kernel.log_spot = std::log(S0);
+    sim.kernel.drift = (r - 0.5 * sigma * sigma) * dt;
+    sim.kernel.diffusion = sigma * std::sqrt(dt);
+    sim.kernel.strike = K;
+    sim.kernel.log_barrier = is_barrier(payoff) ? std::log(barrier) : 0.0;
+    sim.kernel.discount = std::exp(-r * T);
+    sim.kernel.payoff = payoff;
+    sim.kernel.type = type;
+
+    std::unique_ptr<SobolSequence> sobol;
+    std::unique_ptr<BrownianBridge> bridge;
+    if (settings.source == RandomSource::SOBOL) {
+        sobol = std::make_unique<SobolSequence>(settings.steps, settings.seed);
+        bridge = std::make_unique<BrownianBridge>(settings.steps);
+    }
+    sim.sobol = sobol.get();
+    sim.bridge = bridge.get();
+
+    const size_t batches = (settings.paths + kLanes - 1) / kLanes;
+    const size_t tasks = (batches + kBatchesPerTask - 1) / kBatchesPerTask;
+    std::vector<SampleMoments> task_moments(tasks);
+    pool.parallel_for(tasks, 1, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            size_t first = t * kBatchesPerTask;
+            task_moments[t] = run_task(sim, first, std::min(kBatchesPerTask, batches - first));
+        }
+    });
+
+    // Combine in task order so the result does not depend on scheduling
+    SampleMoments total;
+    for (const SampleMoments& m : task_moments) {
+        total.merge(m);
+    }
+
+    const double n = total.count;
+    double price = total.mean_y;
+    double residual_m2 = total.m2_y;
+    if (settings.control_variate && total.m2_x > 0) {
+        // Optimal coefficient b = cov(y, x) / var(x); the control's exact mean is the Black-Scholes price
+        double b = total.c_xy / total.m2_x;
+        double expected_control = black_scholes(type, K, S0, T, r, sigma);
+        price -= b * (total.mean_x - expected_control);
+        residual_m2 = std::max(total.m2_y - b * total.c_xy, 0.0);
+    }
+    double std_error = n > 1 ? std::sqrt(residual_m2 / (n - 1) / n) : kNaN;
+
+    return {price, std_error, batches * kLanes};
+}
@@ -0,0 +1,34 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime CPU detection
+#define MONTE_CARLO_SIMD_KERNEL
+#include "monte_carlo_simd.h"
+
+bool monte_carlo_philox_avx512(uint64_t first_draw, size_t draws, size_t steps, uint32_t key0, uint32_t key1,
+                               double* u, size_t stride) {
+#if defined(__AVX512F__)
+    monte_carlo_philox_kernel(first_draw, draws, steps, key0, key1, u, stride);
+    return true;
+#else
+    (void)first_draw, (void)draws, (void)steps, (void)key0, (void)key1, (void)u, (void)stride;
+    return false;
+#endif
+}
+
+bool monte_carlo_normals_avx512(const double* u, double* z, size_t n) {
+#if defined(__AVX512F__)
+    monte_carlo_normals_kernel<VecAVX512>(u, z, n);
+    return true;
+#else
+    (void)u, (void)z, (void)n;
+    return false;
+#endif
+}
+
+bool monte_carlo_paths_avx512(const PathKernelArgs& args) {
+#if defined(__AVX512F__)
+    monte_carlo_paths_kernel<VecAVX512>(args);
+    return true;
+#else
+    (void)args;
+    return false;
+#endif
+}
@@ -0,0 +1,191 @@
+#ifndef MONTE_CARLO_SIMD_H
+#define MONTE_CARLO_SIMD_H
+
+// Instruction-set specific Monte Carlo kernels. Paths are simulated in blocks stored as
+// structure-of-arrays: the normal for step k of path j is z[k * lanes + j], so one
+// vector register advances `width` paths by one step. Each kernel returns false when
+// its translation unit was built without the matching compiler flags.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "finmath/OptionPricing/options_pricing_types.h"
+
+struct PathKernelArgs {
+    const double* z;      // steps x lanes standard normals
+    size_t steps;
+    size_t lanes;         // multiple of 8
+    double log_spot;
+    double drift;         // (r - sigma^2 / 2) dt
+    double diffusion;     // sigma sqrt(dt)
+    double strike;
+    double log_barrier;
+    double discount;      // exp(-r T)
+    PathPayoff payoff;
+    OptionType type;
+    double* payoffs;      // discounted payoff of each path
+    double* controls;     // discounted European payoff on the same path (the control variate)
+};
+
+// Uniforms in (0, 1) from Philox4x32-10 for `draws` consecutive draws starting at
+// first_draw: u[k * stride + j] is step k of draw first_draw + j. Steps are produced four
+// at a time, so u needs room for `steps` rounded up to a multiple of 4 rows.
+bool monte_carlo_philox_avx2(uint64_t first_draw, size_t draws, size_t steps, uint32_t key0, uint32_t key1,
+                             double* u, size_t stride);
+bool monte_carlo_philox_avx512(uint64_t first_draw, size_t draws, size_t steps, uint32_t key0, uint32_t key1,
+                               double* u, size_t stride);
+
+bool monte_carlo_normals_avx2(const double* u, double* z, size_t n);
+bool monte_carlo_normals_avx512(const double* u, double* z, size_t n);
+
+bool monte_carlo_paths_avx2(const PathKernelArgs& args);
+bool monte_carlo_paths_avx512(const PathKernelArgs& args);
+
+#ifdef MONTE_CARLO_SIMD_KERNEL
+
+#include "../Helper/simd_math.h"
+
+namespace {
+
+// Same rounds as philox4x32 in finmath/Helper/philox.h, written on plain integers so the
+// lane loop vectorizes (no std templates are instantiated with the wider instruction set)
+inline void monte_carlo_philox_kernel(uint64_t first_draw, size_t draws, size_t steps, uint32_t key0, uint32_t key1,
+                                      double* u, size_t stride) {
+    const double scale = 2.3283064365386962890625e-10;
+    for (size_t k = 0; k < steps; k += 4) {
+        const uint32_t block = static_cast<uint32_t>(k / 4);
+        double* row = u + k * stride;
+
+        for (size_t lane = 0; lane < draws; ++lane) {
+            uint64_t draw = first_draw + lane;
+            uint32_t c0 = block;
+            uint32_t c1 = 0;
+            uint32_t c2 = static_cast<uint32_t>(draw);
+            uint32_t c3 = static_cast<uint32_t>(draw >> 32);
+            uint32_t k0 = key0;
+            uint32_t k1 = key1;
+            for (int round = 0; round < 10; ++round) {
+                uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+                uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+                c0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+                c1 = static_cast<uint32_t>(product1);
+                c2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+                c3 = static_cast<uint32_t>(product0);
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            row[lane] = (static_cast<double>(c0) + 0.5) * scale;
+            row[stride + lane] = (static_cast<double>(c1) + 0.5) * scale;
+            row[2 * stride + lane] = (static_cast<double>(c2) + 0.5) * scale;
+            row[3 * stride + lane] = (static_cast<double>(c3) + 0.5) * scale;
+        }
+    }
+}
+
+template <typename V>
+void monte_carlo_normals_kernel(const double* u, double* z, size_t n) {
+    size_t i = 0;
+    for (; i + V::width <= n; i += V::width) {
+        V::store(z + i, vinverse_normal_cdf(V::load(u + i)));
+    }
+    if (i < n) {
+        // Pad the tail with 0.5, whose image is 0
+        double in[V::width];
+        double out[V::width];
+        for (size_t k = 0; k < V::width; ++k) {
+            in[k] = i + k < n ? u[i + k] : 0.5;
+        }
+        V::store(out, vinverse_normal_cdf(V::load(in)));
+        for (size_t k = 0; i + k < n; ++k) {
+            z[i + k] = out[k];
+        }
+    }
+}
+
+template <typename V>
+inline V vanilla_payoff(V underlying, V strike, bool call) {
+    return call ? vmax(underlying - strike, V::set1(0.0)) : vmax(strike - underlying, V::set1(0.0));
+}
+
+template <typename V>
+void monte_carlo_paths_kernel(const PathKernelArgs& a) {
+    const V drift = V::set1(a.drift);
+    const V diffusion = V::set1(a.diffusion);
+    const V strike = V::set1(a.strike);
+    const V log_barrier = V::set1(a.log_barrier);
+    const V discount = V::set1(a.discount);
+    const V zero = V::set1(0.0);
+    const V inv_steps = V::set1(1.0 / static_cast<double>(a.steps));
+    const bool call = a.type == OptionType::CALL;
+    const bool arithmetic = a.payoff == PathPayoff::ASIAN_ARITHMETIC;
+
+    for (size_t lane = 0; lane < a.lanes; lane += V::width) {
+        V log_s = V::set1(a.log_spot);
+        V log_max = log_s;
+        V log_min = log_s;
+        V log_sum = zero;
+        V sum = zero;
+
+        const double* z = a.z + lane;
+        if (arithmetic) {
+            for (size_t k = 0; k < a.steps; ++k, z += a.lanes) {
+                log_s = vfma(diffusion, V::load(z), log_s + drift);
+                sum = sum + vexp(log_s);
+            }
+        } else {
+            // Extremes and the geometric mean only need log prices: no exp inside the loop
+            for (size_t k = 0; k < a.steps; ++k, z += a.lanes) {
+                log_s = vfma(diffusion, V::load(z), log_s + drift);
+                log_sum = log_sum + log_s;
+                log_max = vmax(log_max, log_s);
+                log_min = vmin(log_min, log_s);
+            }
+        }
+
+        V terminal = vexp(log_s);
+        V european = vanilla_payoff(terminal, strike, call);
+        V payoff;
+        switch (a.payoff) {
+            case PathPayoff::EUROPEAN:
+                payoff = european;
+                break;
+            case PathPayoff::ASIAN_ARITHMETIC:
+                payoff = vanilla_payoff(sum * inv_steps, strike, call);
+                break;
+            case PathPayoff::ASIAN_GEOMETRIC:
+                payoff = vanilla_payoff(vexp(log_sum * inv_steps), strike, call);
+                break;
+            case PathPayoff::UP_AND_OUT:
+                payoff = vselect(vless(log_max, log_barrier), european, zero);
+                break;
+            case PathPayoff::UP_AND_IN:
+                payoff = vselect(vless(log_max, log_barrier), zero, european);
+                break;
+            case PathPayoff::DOWN_AND_OUT:
+                payoff = vselect(vless(log_barrier, log_min), european, zero);
+                break;
+            case PathPayoff::DOWN_AND_IN:
+                payoff = vselect(vless(log_barrier, log_min), zero, european);
+                break;
+            case PathPayoff::LOOKBACK_FIXED:
+                payoff = call ? vanilla_payoff(vexp(log_max), strike, true)
+                              : vanilla_payoff(vexp(log_min), strike, false);
+                break;
+            case PathPayoff::LOOKBACK_FLOATING:
+                payoff = call ? terminal - vexp(log_min) : vexp(log_max) - terminal;
+                break;
+            default:
+                payoff = zero;
+                break;
+        }
+
+        V::store(a.payoffs + lane, payoff * discount);
+        V::store(a.controls + lane, european * discount);
+    }
+}
+
+} // namespace
+
+#endif // MONTE_CARLO_SIMD_KERNEL
+
+#endif // MONTE_CARLO_SIMD_H
@@ -0,0 +1,244 @@
+#include "finmath/OptionPricing/pricing_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "finmath/Helper/normal_distribution.h"
+#include "finmath/OptionPricing/black_scholes.h"
+
+namespace {
+
+// Pricer identifiers in the low byte of a key's tag
+constexpr uint64_t kBlackScholes = 0;
+constexpr uint64_t kBinomialEuropean = 1;
+constexpr uint64_t kBinomialLattice = 2;
+
+// Tolerances must stay below this: snapping rounds mantissas in [0.5, 1) to multiples of the
+// tolerance, which from 0.5 up can give zero
+constexpr double kMaxTolerance = 0.25;
+
+// Automatic sharding: shards per hardware thread, and the fewest entries a shard should hold
+constexpr size_t kShardsPerThread = 4;
+constexpr size_t kMinShardCapacity = 64;
+
+// Black-Scholes prices also depend on the normal CDF tier, kept above the lattice settings
+uint64_t tag(uint64_t pricer, OptionType type, ExerciseStyle style = ExerciseStyle::EUROPEAN,
+             BinomialMethod method = BinomialMethod::CRR, NormalAccuracy accuracy = NormalAccuracy::EXACT) {
+    return pricer | static_cast<uint64_t>(type) << 8 | static_cast<uint64_t>(style) << 16 |
+           static_cast<uint64_t>(method) << 24 | static_cast<uint64_t>(accuracy) << 32;
+}
+
+size_t shard_capacity(size_t capacity, size_t shards) {
+    return (capacity + shards - 1) / shards;
+}
+
+} // namespace
+
+struct PricingCache::Shard {
+    std::mutex mutex;
+    std::list<std::pair<Key, double>> entries;  // most recently used first
+    std::unordered_map<Key, std::list<std::pair<Key, double>>::iterator, KeyHash> index;
+    size_t capacity = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+
+    void evict_to(size_t size) {
+        while (entries.size() > size) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+            ++evictions;
+        }
+    }
+};
+
+bool PricingCache::Key::operator==(const Key& other) const {
+    return std::memcmp(words, other.words, sizeof(words)) == 0;
+}
+
+PricingCache::PricingCache(size_t capacity, double tolerance, size_t num_shards)
+    : tolerance_(tolerance), shard_bits_(0), capacity_(0) {
+    if (!(tolerance >= 0.0 && tolerance < kMaxTolerance)) {
+        throw std::invalid_argument("PricingCache tolerance must lie in [0, 0.25).");
+    }
+
+    bool automatic = num_shards == 0;
+    if (automatic) {
+        num_shards = kShardsPerThread * std::max(1u, std::thread::hardware_concurrency());
+    }
+    while ((size_t(1) << shard_bits_) < num_shards) {
+        ++shard_bits_;
+    }
+    // Small automatic caches get fewer shards, so each still holds a useful LRU list
+    while (automatic && shard_bits_ > 0 && (size_t(1) << shard_bits_) * kMinShardCapacity > capacity) {
+        --shard_bits_;
+    }
+
+    size_t shards = size_t(1) << shard_bits_;
+    for (size_t i = 0; i < shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->capacity = shard_capacity(capacity, shards);
+    }
+    capacity_.store(shards * shard_capacity(capacity, shards), std::memory_order_relaxed);
+}
+
+PricingCache::~PricingCache() = default;
+
+PricingCache::Key PricingCache::make_key(uint64_t tag, long steps, const double (&inputs)[5]) {
+    Key key;
+    key.words[0] = tag;
+    key.words[1] = static_cast<uint64_t>(steps);
+    std::memcpy(key.words + 2, inputs, sizeof(inputs));
+
+    // Multiply-xorshift mixing of every word; the top bits pick the shard
+    uint64_t hash = 0x9e3779b97f4a7c15ULL;
+    for (uint64_t word : key.words) {
+        hash = (hash ^ word) * 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 31;
+    }
+    key.hash = hash;
+    return key;
+}
+
+double PricingCache::snap_relative(double x) const {
+    if (tolerance_ == 0.0 || x == 0.0 || !std::isfinite(x)) {
+        return x;
+    }
+    // x = m 2^e with 0.5 <= |m| < 1; rounding m to a multiple of tolerance is exact in binary
+    // for power-of-two tolerances and within an ulp otherwise
+    int exponent;
+    double mantissa = std::frexp(x, &exponent);
+    return std::ldexp(std::nearbyint(mantissa / tolerance_) * tolerance_, exponent);
+}
+
+double PricingCache::snap_absolute(double x) const {
+    if (tolerance_ == 0.0 || !std::isfinite(x)) {
+        return x;
+    }
+    // + 0.0 folds -0.0 into 0.0 so rates just either side of zero share a key
+    return std::nearbyint(x / tolerance_) * tolerance_ + 0.0;
+}
+
+template <typename Pricer>
+double PricingCache::lookup(const Key& key, Pricer price) {
+    Shard& shard = *shards_[shard_bits_ == 0 ? 0 : key.hash >> (64 - shard_bits_)];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            ++shard.hits;
+            return found->second->second;
+        }
+        ++shard.misses;
+    }
+
+    // Price without the lock so other contracts in this shard are not held up
+    double value = price();
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.capacity == 0) {
+        return value;
+    }
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        // Another thread priced it meanwhile
+        found->second->second = value;
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return value;
+    }
+    shard.evict_to(shard.capacity - 1);
+    shard.entries.emplace_front(key, value);
+    shard.index.emplace(key, shard.entries.begin());
+    return value;
+}
+
+double PricingCache::black_scholes(OptionType type, double strike, double price, double time, double rate,
+                                   double volatility) {
+    double inputs[5] = {snap_relative(price), snap_relative(strike), snap_relative(time), snap_absolute(rate),
+                        snap_relative(volatility)};
+    auto pricer = [&]() { return ::black_scholes(type, inputs[1], inputs[0], inputs[2], inputs[3], inputs[4]); };
+    if (std::any_of(inputs, inputs + 5, [](double x) { return std::isnan(x); })) {
+        return pricer();
+    }
+    uint64_t key_tag = tag(kBlackScholes, type, ExerciseStyle::EUROPEAN, BinomialMethod::CRR, normal_accuracy());
+    return lookup(make_key(key_tag, 0, inputs), pricer);
+}
+
+double PricingCache::binomial_option_pricing(OptionType type, double S0, double K, double T, double r,
+                                             double sigma, long N) {
+    double inputs[5] = {snap_relative(S0), snap_relative(K), snap_relative(T), snap_absolute(r),
+                        snap_relative(sigma)};
+    auto pricer = [&]() {
+        return ::binomial_option_pricing(type, inputs[0], inputs[1], inputs[2], inputs[3], inputs[4], N);
+    };
+    if (std::any_of(inputs, inputs + 5, [](double x) { return std::isnan(x); })) {
+        return pricer();
+    }
+    return lookup(make_key(tag(kBinomialEuropean, type), N, inputs), pricer);
+}
+
+double PricingCache::binomial_lattice_pricing(OptionType type, ExerciseStyle style, double S0, double K, double T,
+                                              double r, double sigma, long N, BinomialMethod method,
+                                              const std::vector<double>& exercise_times) {
+    double inputs[5] = {snap_relative(S0), snap_relative(K), snap_relative(T), snap_absolute(r),
+                        snap_relative(sigma)};
+    auto pricer = [&]() {
+        return ::binomial_lattice_pricing(type, style, inputs[0], inputs[1], inputs[2], inputs[3], inputs[4], N,
+                                          method, exercise_times);
+    };
+    bool dated = style == ExerciseStyle::BERMUDAN && !exercise_times.empty();
+    if (dated || std::any_of(inputs, inputs + 5, [](double x) { return std::isnan(x); })) {
+        return pricer();
+    }
+    return lookup(make_key(tag(kBinomialLattice, type, style, method), N, inputs), pricer);
+}
+
+PricingCacheStats PricingCache::stats() const {
+    PricingCacheStats total = {0, 0, 0, 0, capacity()};
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total.hits += shard->hits;
+        total.misses += shard->misses;
+        total.evictions += shard->evictions;
+        total.size += shard->entries.size();
+    }
+    return total;
+}
+
+void PricingCache::reset_stats() {
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->hits = shard->misses = shard->evictions = 0;
+    }
+}
+
+void PricingCache::clear() {
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->entries.clear();
+    }
+}
+
+void PricingCache::resize(size_t capacity) {
+    size_t per_shard = shard_capacity(capacity, shards_.size());
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->capacity = per_shard;
+        shard->evict_to(per_shard);
+    }
+    capacity_.store(per_shard * shards_.size(), std::memory_order_relaxed);
+}
+
+PricingCache& default_pricing_cache() {
+    static PricingCache cache;
+    return cache;
+}
@@ -0,0 +1,340 @@
+#include "finmath/OptionPricing/pricing_service.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/OptionPricing/black_scholes.h"
+#include "finmath/OptionPricing/implied_volatility.h"
+#include "finmath/OptionPricing/parallel_pricing.h"
+
+namespace {
+
+// Structure-of-arrays inputs of one pricer's share of a batch, kept between batches so a
+// steady stream of requests reuses the same buffers
+struct Columns {
+    std::vector<size_t> index;  // position of each row in the batch
+    std::vector<OptionType> types;
+    std::vector<double> strikes;
+    std::vector<double> prices;
+    std::vector<double> times;
+    std::vector<double> rates;
+    std::vector<double> volatilities;
+    std::vector<double> option_prices;
+    std::vector<double> out;
+
+    void clear() {
+        index.clear();
+        types.clear();
+        strikes.clear();
+        prices.clear();
+        times.clear();
+        rates.clear();
+        volatilities.clear();
+        option_prices.clear();
+    }
+
+    void add(size_t i, const PricingRequest& request) {
+        index.push_back(i);
+        types.push_back(request.type);
+        strikes.push_back(request.strike);
+        prices.push_back(request.price);
+        times.push_back(request.time);
+        rates.push_back(request.rate);
+        volatilities.push_back(request.volatility);
+        option_prices.push_back(request.option_price);
+    }
+
+    size_t size() const { return index.size(); }
+};
+
+// Lattice requests are priced in groups sharing these settings
+std::tuple<int, long, int> lattice_group(const PricingRequest& request) {
+    return {static_cast<int>(request.style), request.steps, static_cast<int>(request.method)};
+}
+
+} // namespace
+
+struct PricingService::Pending {
+    PricingRequest request;
+    std::promise<double> promise;
+    std::chrono::steady_clock::time_point submitted;
+};
+
+struct PricingService::Node {
+    std::atomic<Node*> next{nullptr};
+    Pending pending;
+};
+
+struct PricingService::Batch {
+    std::vector<Pending> pending;
+    std::vector<double> results;
+    std::vector<std::exception_ptr> failures;  // set for the rows of a kernel call that threw
+    std::vector<size_t> lattice_order;
+    Columns black_scholes;
+    Columns implied_volatility;
+    Columns lattice;
+};
+
+PricingService::PricingService(const PricingServiceSettings& settings, ThreadPool& pool)
+    : settings_(settings), pool_(pool), head_(nullptr), tail_(nullptr), sleeping_(false), stopping_(false),
+      requests_(0), batches_(0), full_batches_(0), deadline_batches_(0), largest_batch_(0) {
+    if (settings.max_batch_size == 0) {
+        throw std::invalid_argument("PricingService batch size must be at least 1.");
+    }
+    if (settings.max_delay.count() < 0) {
+        throw std::invalid_argument("PricingService delay must not be negative.");
+    }
+    Node* stub = new Node();
+    head_.store(stub);
+    tail_ = stub;
+    dispatcher_ = std::thread(&PricingService::dispatch_loop, this);
+}
+
+PricingService::~PricingService() {
+    stopping_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_one();
+    }
+    dispatcher_.join();
+    delete tail_;
+}
+
+void PricingService::push(Node* node) {
+    Node* previous = head_.exchange(node);
+    // Until this store the dispatcher sees the queue end at previous and waits for the link
+    previous->next.store(node, std::memory_order_release);
+    if (sleeping_.load()) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_one();
+    }
+}
+
+bool PricingService::pop(Pending& pending) {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+        return false;
+    }
+    // next becomes the consumed node at the tail; its payload moves out
+    pending = std::move(next->pending);
+    tail_ = next;
+    delete tail;
+    return true;
+}
+
+std::future<double> PricingService::submit(const PricingRequest& request) {
+    Node* node = new Node();
+    node->pending.request = request;
+    node->pending.submitted = std::chrono::steady_clock::now();
+    std::future<double> result = node->pending.promise.get_future();
+    push(node);
+    return result;
+}
+
+std::future<double> PricingService::black_scholes(OptionType type, double strike, double price, double time,
+                                                  double rate, double volatility) {
+    PricingRequest request;
+    request.kind = PricingRequestKind::BLACK_SCHOLES;
+    request.type = type;
+    request.strike = strike;
+    request.price = price;
+    request.time = time;
+    request.rate = rate;
+    request.volatility = volatility;
+    return submit(request);
+}
+
+std::future<double> PricingService::implied_volatility(OptionType type, double option_price, double strike,
+                                                       double price, double time, double rate) {
+    PricingRequest request;
+    request.kind = PricingRequestKind::IMPLIED_VOLATILITY;
+    request.type = type;
+    request.option_price = option_price;
+    request.strike = strike;
+    request.price = price;
+    request.time = time;
+    request.rate = rate;
+    return submit(request);
+}
+
+std::future<double> PricingService::binomial_lattice_pricing(OptionType type, ExerciseStyle style, double S0,
+                                                             double K, double T, double r, double sigma, long N,
+                                                             BinomialMethod method) {
+    PricingRequest request;
+    request.kind = PricingRequestKind::BINOMIAL;
+    request.type = type;
+    request.price = S0;
+    request.strike = K;
+    request.time = T;
+    request.rate = r;
+    request.volatility = sigma;
+    request.style = style;
+    request.steps = N;
+    request.method = method;
+    return submit(request);
+}
+
+PricingServiceStats PricingService::stats() const {
+    return {requests_.load(), batches_.load(), full_batches_.load(), deadline_batches_.load(), largest_batch_.load()};
+}
+
+void PricingService::dispatch_loop() {
+    Batch batch;
+    Pending pending;
+    for (;;) {
+        if (!pop(pending)) {
+            if (head_.load() != tail_) {
+                // A producer has swapped in but not linked its node yet
+                std::this_thread::yield();
+                continue;
+            }
+            if (stopping_.load()) {
+                return;
+            }
+            // Announce the sleep before the last look at the queue, so a producer either
+            // sees sleeping_ or its node is seen here
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            sleeping_.store(true);
+            wake_.wait(lock, [this] { return head_.load() != tail_ || stopping_.load(); });
+            sleeping_.store(false);
+            continue;
+        }
+
+        const auto deadline = pending.submitted + settings_.max_delay;
+        batch.pending.push_back(std::move(pending));
+        bool deadline_hit = false;
+        while (batch.pending.size() < settings_.max_batch_size) {
+            if (pop(pending)) {
+                batch.pending.push_back(std::move(pending));
+            } else if (stopping_.load() && head_.load() == tail_) {
+                break;
+            } else if (std::chrono::steady_clock::now() >= deadline) {
+                deadline_hit = true;
+                break;
+            } else if (head_.load() != tail_) {
+                // Linking is a store away, too short to sleep on
+                std::this_thread::yield();
+            } else {
+                // Sleep until the next push or the deadline, announced as in the idle case
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                sleeping_.store(true);
+                wake_.wait_until(lock, deadline, [this] { return head_.load() != tail_ || stopping_.load(); });
+                sleeping_.store(false);
+            }
+        }
+
+        // Counted before the futures are set, so a caller holding a result sees its batch
+        const size_t size = batch.pending.size();
+        requests_.fetch_add(size, std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        if (size == settings_.max_batch_size) {
+            full_batches_.fetch_add(1, std::memory_order_relaxed);
+        } else if (deadline_hit) {
+            deadline_batches_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (size > largest_batch_.load(std::memory_order_relaxed)) {
+            largest_batch_.store(size, std::memory_order_relaxed);
+        }
+        price(batch);
+        batch.pending.clear();
+    }
+}
+
+void PricingService::price(Batch& batch) {
+    const size_t n = batch.pending.size();
+    FINMATH_INSTRUMENT("PricingService::price", n);
+    batch.black_scholes.clear();
+    batch.implied_volatility.clear();
+    batch.lattice.clear();
+    batch.lattice_order.clear();
+    for (size_t i = 0; i < n; ++i) {
+        const PricingRequest& request = batch.pending[i].request;
+        switch (request.kind) {
+            case PricingRequestKind::BLACK_SCHOLES:
+                batch.black_scholes.add(i, request);
+                break;
+            case PricingRequestKind::IMPLIED_VOLATILITY:
+                batch.implied_volatility.add(i, request);
+                break;
+            case PricingRequestKind::BINOMIAL:
+                batch.lattice_order.push_back(i);
+                break;
+        }
+    }
+    // Lattice requests with the same settings side by side, in arrival order within a group
+    std::stable_sort(batch.lattice_order.begin(), batch.lattice_order.end(), [&](size_t a, size_t b) {
+        return lattice_group(batch.pending[a].request) < lattice_group(batch.pending[b].request);
+    });
+    for (size_t i : batch.lattice_order) {
+        batch.lattice.add(i, batch.pending[i].request);
+    }
+
+    batch.results.assign(n, 0.0);
+    batch.failures.assign(n, nullptr);
+    // A kernel call that throws fails only the rows it was pricing
+    auto fail = [&](const Columns& columns, size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            batch.failures[columns.index[k]] = std::current_exception();
+        }
+    };
+
+    Columns& bs = batch.black_scholes;
+    try {
+        bs.out.resize(bs.size());
+        black_scholes_batch(bs.types.data(), bs.strikes.data(), bs.prices.data(), bs.times.data(), bs.rates.data(),
+                            bs.volatilities.data(), bs.out.data(), bs.size());
+        for (size_t k = 0; k < bs.size(); ++k) {
+            batch.results[bs.index[k]] = bs.out[k];
+        }
+    } catch (...) {
+        fail(bs, 0, bs.size());
+    }
+
+    Columns& iv = batch.implied_volatility;
+    try {
+        iv.out.resize(iv.size());
+        implied_volatility_batch(iv.types.data(), iv.option_prices.data(), iv.strikes.data(), iv.prices.data(),
+                                 iv.times.data(), iv.rates.data(), iv.out.data(), nullptr, iv.size());
+        for (size_t k = 0; k < iv.size(); ++k) {
+            batch.results[iv.index[k]] = iv.out[k];
+        }
+    } catch (...) {
+        fail(iv, 0, iv.size());
+    }
+
+    Columns& lattice = batch.lattice;
+    lattice.out.resize(lattice.size());
+    for (size_t begin = 0; begin < lattice.size();) {
+        const PricingRequest& first = batch.pending[lattice.index[begin]].request;
+        size_t end = begin + 1;
+        while (end < lattice.size() &&
+               lattice_group(batch.pending[lattice.index[end]].request) == lattice_group(first)) {
+            ++end;
+        }
+        try {
+            parallel_binomial_price(lattice.types.data() + begin, lattice.strikes.data() + begin,
+                                    lattice.prices.data() + begin, lattice.times.data() + begin,
+                                    lattice.rates.data() + begin, lattice.volatilities.data() + begin, first.style,
+                                    first.steps, first.method, lattice.out.data() + begin, end - begin, pool_);
+            for (size_t k = begin; k < end; ++k) {
+                batch.results[lattice.index[k]] = lattice.out[k];
+            }
+        } catch (...) {
+            fail(lattice, begin, end);
+        }
+        begin = end;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (batch.failures[i]) {
+            batch.pending[i].promise.set_exception(batch.failures[i]);
+        } else {
+            batch.pending[i].promise.set_value(batch.results[i]);
+        }
+    }
+}
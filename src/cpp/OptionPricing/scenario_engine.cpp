@@ -0,0 +1,269 @@
+#include "finmath/OptionPricing/scenario_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/normal_distribution.h"
+#include "binomial_lattice.h"
+
+namespace {
+
+// Cell blocks per pool thread: enough to balance, few enough that shared terms are reused
+constexpr size_t kBlocksPerThread = 4;
+
+// One time shift, a range of vol shocks and a range of spot shocks
+struct CellBlock {
+    size_t t;
+    size_t v_begin, v_end;
+    size_t s_begin, s_end;
+};
+
+// Terms of a position that depend on the time shift only
+struct TimeSlice {
+    double time;       // remaining time to expiry, at least 0
+    double sqrt_time;
+    double discount;   // e^{-rate * time}
+};
+
+// Terms shared by every cell of a grid
+struct ScenarioInputs {
+    const OptionType* types;
+    const double* strikes;
+    const double* prices;
+    const double* rates;
+    const double* volatilities;
+    size_t slice_count;                    // time shifts, plus today
+    std::vector<double> spot_factors;      // 1 + spot shock
+    std::vector<double> log_spot_factors;  // log(1 + spot shock)
+    std::vector<double> log_moneyness;     // log(S / K) per position
+    std::vector<TimeSlice> slices;         // position i, shift t at [i * slice_count + t]
+};
+
+double intrinsic(OptionType type, double S, double K) {
+    return type == OptionType::CALL ? std::max(S - K, 0.0) : std::max(K - S, 0.0);
+}
+
+// Black-Scholes values of position i at one time shift, vol shocks [v_begin, v_end) and spot
+// shocks [s_begin, s_end), written row by row to values. All d1 / d2 of the block go through
+// one batch CDF call each; puts store -d1 / -d2 so the same call gives N(-d1) / N(-d2).
+// Zero volatility or time takes the deterministic limit max(S - K e^{-rT}, 0).
+void black_scholes_block(const ScenarioInputs& in, size_t i, size_t t, size_t v_begin, size_t v_end,
+                         const double* vol_shocks, size_t s_begin, size_t s_end, std::vector<double>& scratch,
+                         double* values) {
+    const size_t spots = s_end - s_begin;
+    const size_t m = (v_end - v_begin) * spots;
+    scratch.resize(4 * m + (v_end - v_begin));
+    double* d1 = scratch.data();
+    double* d2 = d1 + m;
+    double* n1 = d2 + m;
+    double* n2 = n1 + m;
+    double* deviations = n2 + m;
+
+    const TimeSlice& slice = in.slices[i * in.slice_count + t];
+    const double sign = in.types[i] == OptionType::CALL ? 1.0 : -1.0;
+    for (size_t v = v_begin; v < v_end; ++v) {
+        double volatility = std::max(in.volatilities[i] + vol_shocks[v], 0.0);
+        double deviation = volatility * slice.sqrt_time;
+        double drift = (in.rates[i] + volatility * volatility / 2) * slice.time;
+        deviations[v - v_begin] = deviation;
+        double* row1 = d1 + (v - v_begin) * spots;
+        double* row2 = d2 + (v - v_begin) * spots;
+        for (size_t s = 0; s < spots; ++s) {
+            double d = (in.log_moneyness[i] + in.log_spot_factors[s_begin + s] + drift) / deviation;
+            row1[s] = sign * d;
+            row2[s] = sign * (d - deviation);
+        }
+    }
+    normal_cdf_batch(d1, n1, m, NormalAccuracy::HIGH);
+    normal_cdf_batch(d2, n2, m, NormalAccuracy::HIGH);
+
+    const double strike = in.strikes[i];
+    const double forward_strike = strike * slice.discount;
+    for (size_t v = v_begin; v < v_end; ++v) {
+        bool deterministic = !(deviations[v - v_begin] > 0.0);
+        size_t row = (v - v_begin) * spots;
+        for (size_t s = 0; s < spots; ++s) {
+            double S = in.prices[i] * in.spot_factors[s_begin + s];
+            double value;
+            if (deterministic) {
+                value = intrinsic(in.types[i], S, forward_strike);
+            } else if (in.types[i] == OptionType::CALL) {
+                value = S * n1[row + s] - forward_strike * n2[row + s];
+            } else {
+                value = forward_strike * n2[row + s] - S * n1[row + s];
+            }
+            values[row + s] = value;
+        }
+    }
+}
+
+// Binomial values of position i for a block, one lattice per vol shock: a spot scaled by
+// c = 1 + shock prices as c * price(K / c) on the unshocked lattice
+void binomial_block(const ScenarioInputs& in, size_t i, size_t t, size_t v_begin, size_t v_end,
+                    const double* vol_shocks, size_t s_begin, size_t s_end, const ScenarioSettings& settings,
+                    const std::vector<double>& exercise_times, double* values) {
+    const size_t spots = s_end - s_begin;
+    const TimeSlice& slice = in.slices[i * in.slice_count + t];
+    const OptionType type = in.types[i];
+    const double strike = in.strikes[i];
+
+    for (size_t v = v_begin; v < v_end; ++v) {
+        double* row = values + (v - v_begin) * spots;
+        if (!(slice.time > 0.0)) {
+            for (size_t s = 0; s < spots; ++s) {
+                row[s] = intrinsic(type, in.prices[i] * in.spot_factors[s_begin + s], strike);
+            }
+            continue;
+        }
+        double volatility = std::max(in.volatilities[i] + vol_shocks[v], 0.0);
+        const BinomialLattice<double> lattice(settings.style, in.prices[i], slice.time, in.rates[i], volatility,
+                                              settings.steps, settings.method, exercise_times);
+        for (size_t s = 0; s < spots; ++s) {
+            double factor = in.spot_factors[s_begin + s];
+            row[s] = factor * lattice.price(type, strike / factor);
+        }
+    }
+}
+
+bool valid_inputs(const size_t* books, size_t n, size_t num_books, const StressGrid& grid,
+                  const ScenarioSettings& settings) {
+    if (n > 0 && num_books == 0) {
+        std::cerr << "Number of books must be at least 1." << std::endl;
+        return false;
+    }
+    for (size_t i = 0; books && i < n; ++i) {
+        if (books[i] >= num_books) {
+            std::cerr << "Book indices must be less than the number of books." << std::endl;
+            return false;
+        }
+    }
+    for (double shock : grid.spot_shocks) {
+        if (!(shock > -1.0) || !std::isfinite(shock)) {
+            std::cerr << "Spot shocks must be finite and greater than -1." << std::endl;
+            return false;
+        }
+    }
+    const long min_steps = (settings.method == BinomialMethod::BBSR) ? 2 : 1;
+    if (settings.model == ScenarioModel::BINOMIAL && settings.steps < min_steps) {
+        std::cerr << "Number of steps must be at least " << min_steps << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void scenario_pnl(const OptionType* types, const double* strikes, const double* prices, const double* times,
+                  const double* rates, const double* volatilities, const double* quantities, const size_t* books,
+                  size_t n, size_t num_books, const StressGrid& grid, double* out, const ScenarioSettings& settings,
+                  ThreadPool& pool) {
+    FINMATH_INSTRUMENT("scenario_pnl", n * grid.cells());
+    const size_t spots = grid.spot_shocks.size();
+    const size_t vols = grid.vol_shocks.size();
+    const size_t shifts = grid.time_shifts.size();
+    const size_t cells = grid.cells();
+    if (!valid_inputs(books, n, num_books, grid, settings)) {
+        std::fill(out, out + num_books * cells, std::numeric_limits<double>::quiet_NaN());
+        return;
+    }
+    std::fill(out, out + num_books * cells, 0.0);
+    if (n == 0 || cells == 0) {
+        return;
+    }
+
+    // Shock-independent terms, once per grid and once per position. One more time slice and
+    // spot factor than the grid has hold today's (unshocked) inputs.
+    std::vector<double> time_shifts = grid.time_shifts;
+    time_shifts.push_back(0.0);
+    ScenarioInputs in{types, strikes, prices, rates, volatilities, time_shifts.size(), {}, {}, {}, {}};
+    for (double shock : grid.spot_shocks) {
+        in.spot_factors.push_back(1.0 + shock);
+        in.log_spot_factors.push_back(std::log1p(shock));
+    }
+    in.spot_factors.push_back(1.0);
+    in.log_spot_factors.push_back(0.0);
+    in.log_moneyness.resize(n);
+    in.slices.resize(n * in.slice_count);
+    for (size_t i = 0; i < n; ++i) {
+        in.log_moneyness[i] = std::log(prices[i] / strikes[i]);
+        for (size_t t = 0; t < in.slice_count; ++t) {
+            double remaining = std::max(times[i] - time_shifts[t], 0.0);
+            in.slices[i * in.slice_count + t] = {remaining, std::sqrt(remaining), std::exp(-rates[i] * remaining)};
+        }
+    }
+
+    const bool binomial = settings.model == ScenarioModel::BINOMIAL;
+    std::vector<std::vector<double>> exercise_times(in.slice_count);
+    for (size_t t = 0; binomial && t < in.slice_count; ++t) {
+        for (double date : settings.exercise_times) {
+            exercise_times[t].push_back(date - time_shifts[t]);
+        }
+    }
+
+    // Today's values go through the same code as the cells, so unshocked cells give exactly 0
+    const double zero_shock = 0.0;
+    std::vector<double> base(n);
+    pool.parallel_for(n, binomial ? 1 : 256, [&](size_t begin, size_t end) {
+        std::vector<double> scratch;
+        for (size_t i = begin; i < end; ++i) {
+            if (binomial) {
+                binomial_block(in, i, shifts, 0, 1, &zero_shock, spots, spots + 1, settings, exercise_times[shifts],
+                               &base[i]);
+            } else {
+                black_scholes_block(in, i, shifts, 0, 1, &zero_shock, spots, spots + 1, scratch, &base[i]);
+            }
+        }
+    });
+
+    // Split the cube into blocks: by time shift, then vol shocks, then spot shocks, until the
+    // pool has several blocks per thread. Every cell is computed the same way whatever the split.
+    const size_t target = kBlocksPerThread * pool.thread_count();
+    const size_t vol_blocks = std::min(vols, (target + shifts - 1) / shifts);
+    const size_t spot_blocks = std::min(spots, (target + shifts * vol_blocks - 1) / (shifts * vol_blocks));
+    std::vector<CellBlock> blocks;
+    for (size_t t = 0; t < shifts; ++t) {
+        for (size_t vb = 0; vb < vol_blocks; ++vb) {
+            for (size_t sb = 0; sb < spot_blocks; ++sb) {
+                blocks.push_back({t, vb * vols / vol_blocks, (vb + 1) * vols / vol_blocks, sb * spots / spot_blocks,
+                                  (sb + 1) * spots / spot_blocks});
+            }
+        }
+    }
+
+    pool.parallel_for(blocks.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<double> scratch, values, totals;
+        for (size_t k = begin; k < end; ++k) {
+            const CellBlock& block = blocks[k];
+            const size_t block_spots = block.s_end - block.s_begin;
+            const size_t block_cells = (block.v_end - block.v_begin) * block_spots;
+            values.resize(block_cells);
+            totals.assign(num_books * block_cells, 0.0);
+
+            // Positions in input order, so each cell's sum does not depend on the blocking
+            for (size_t i = 0; i < n; ++i) {
+                if (binomial) {
+                    binomial_block(in, i, block.t, block.v_begin, block.v_end, grid.vol_shocks.data(), block.s_begin,
+                                   block.s_end, settings, exercise_times[block.t], values.data());
+                } else {
+                    black_scholes_block(in, i, block.t, block.v_begin, block.v_end, grid.vol_shocks.data(),
+                                        block.s_begin, block.s_end, scratch, values.data());
+                }
+                double* total = totals.data() + (books ? books[i] : 0) * block_cells;
+                for (size_t c = 0; c < block_cells; ++c) {
+                    total[c] += quantities[i] * (values[c] - base[i]);
+                }
+            }
+
+            for (size_t b = 0; b < num_books; ++b) {
+                for (size_t v = block.v_begin; v < block.v_end; ++v) {
+                    double* cube_row = out + ((b * shifts + block.t) * vols + v) * spots + block.s_begin;
+                    const double* row = totals.data() + b * block_cells + (v - block.v_begin) * block_spots;
+                    std::copy(row, row + block_spots, cube_row);
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,265 @@
+#include "finmath/OptionPricing/trinomial_tree.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "finmath/Helper/instrumentation.h"
+#include "lattice_core.h"
+
+namespace {
+
+// Nodes refined on each side of the node nearest the strike or the barrier
+constexpr long kRefinedHalfWidth = 2;
+
+// A node within this fraction of a step of the barrier counts as on it
+constexpr double kBarrierTolerance = 1e-9;
+
+// Discounted down / middle / up probabilities of a step of length dt with log-price spacing
+// stretch * sigma * sqrt(dt). Boyle's choice: they match the mean e^{r dt} and the variance of
+// the price ratio exactly, so the lattice is a martingale under discounting.
+std::array<double, 3> trinomial_probabilities(double stretch, double r, double sigma, double dt) {
+    const double u = std::exp(stretch * sigma * std::sqrt(dt));
+    const double mean = std::exp(r * dt);
+    const double second_moment = mean * mean * std::exp(sigma * sigma * dt);
+    const double denominator = (u - 1) * (u * u - 1);
+    const double up = ((second_moment - mean) * u - (mean - 1)) / denominator;
+    const double down = ((second_moment - mean) * u * u - (mean - 1) * u * u * u) / denominator;
+    const double discount = 1 / mean;
+    return {discount * down, discount * (1 - up - down), discount * up};
+}
+
+bool valid_probabilities(const std::array<double, 3>& p) {
+    return p[0] >= 0 && p[1] >= 0 && p[2] >= 0;
+}
+
+// What every node of the coarse and refined lattices shares: the payoff, the knock-out
+// barrier and where to refine. Log-prices x are relative to S0.
+struct LatticeTerms {
+    OptionType type;
+    double S0;
+    double K;
+    double r;
+    double sigma;
+    double stretch;
+    double log_strike;   // log(K / S0)
+    bool knock_out;
+    bool up;
+    double log_barrier;  // log(barrier / S0)
+    bool american;
+
+    double intrinsic(double x) const { return payoff(type, S0 * std::exp(x), K); }
+
+    bool knocked(double x, double spacing) const {
+        if (!knock_out) {
+            return false;
+        }
+        const double tolerance = kBarrierTolerance * spacing;
+        return up ? x >= log_barrier - tolerance : x <= log_barrier + tolerance;
+    }
+
+    void apply_barrier(double first, double spacing, double* v, long count) const {
+        for (long i = 0; knock_out && i < count; ++i) {
+            if (knocked(first + i * spacing, spacing)) {
+                v[i] = 0.0;
+            }
+        }
+    }
+
+    // Overwrite the nodes of a row (log-prices first + i * spacing, the start of a period of
+    // length h) around the strike and the barrier with values from a finer mesh
+    void refine(double first, double spacing, double h, long count, int depth, bool exercise_at_start,
+                double* v) const {
+        std::array<long, 2> lo{}, hi{};
+        int windows = 0;
+        const double targets[2] = {log_strike, log_barrier};
+        for (int w = 0; w < (knock_out ? 2 : 1); ++w) {
+            long centre = std::lround((targets[w] - first) / spacing);
+            long begin = std::max(centre - kRefinedHalfWidth, 0L);
+            long end = std::min(centre + kRefinedHalfWidth, count - 1);
+            if (begin > end) {
+                continue;
+            }
+            if (windows > 0 && begin <= hi[0] + 1 && end >= lo[0] - 1) {
+                lo[0] = std::min(lo[0], begin);
+                hi[0] = std::max(hi[0], end);
+            } else {
+                lo[windows] = begin;
+                hi[windows] = end;
+                ++windows;
+            }
+        }
+        for (int w = 0; w < windows; ++w) {
+            period_values(first + lo[w] * spacing, spacing, h, hi[w] - lo[w] + 1, depth, exercise_at_start,
+                          v + lo[w]);
+        }
+    }
+
+    // Values at the start of the final period of length h of m nodes first + j * spacing, from a
+    // mesh of half the spacing and a quarter of the step (the stretch, and so the probabilities'
+    // shape, is unchanged). Each fine step narrows the window by one fine node per side, so
+    // four steps from expiry need four extra nodes per side there. With depth > 0 the first
+    // fine step is itself refined around the strike and the barrier.
+    void period_values(double first, double spacing, double h, long m, int depth, bool exercise_at_start,
+                       double* out) const {
+        const double fine = spacing / 2;
+        const double dt = h / 4;
+        const std::array<double, 3> p = trinomial_probabilities(stretch, r, sigma, dt);
+
+        long count = 2 * m - 1 + 8;
+        double row_first = first - 4 * fine;
+        std::vector<double> w(count);
+        for (long i = 0; i < count; ++i) {
+            w[i] = intrinsic(row_first + i * fine);
+        }
+        apply_barrier(row_first, fine, w.data(), count);
+
+        for (int s = 1; s <= 4; ++s) {
+            count -= 2;
+            row_first += fine;
+            for (long i = 0; i < count; ++i) {
+                w[i] = p[2] * w[i + 2] + p[1] * w[i + 1] + p[0] * w[i];
+            }
+            if (s == 1 && depth > 0) {
+                refine(row_first, fine, dt, count, depth - 1, american, w.data());
+            }
+            if (american || (s == 4 && exercise_at_start)) {
+                for (long i = 0; i < count; ++i) {
+                    w[i] = std::max(w[i], intrinsic(row_first + i * fine));
+                }
+            }
+            apply_barrier(row_first, fine, w.data(), count);
+        }
+
+        for (long j = 0; j < m; ++j) {
+            out[j] = w[2 * j];
+        }
+    }
+};
+
+// Lattice policy of a vanilla or knock-out option: payoff at expiry, exercise on the schedule,
+// knock-out after every step and, at the step before expiry, the adaptive mesh
+struct TrinomialPolicy {
+    const LatticeTerms& terms;
+    const std::vector<char>& schedule;
+    long N;
+    double k;   // log-price spacing of the coarse lattice
+    double dt;
+    int refinement_levels;
+
+    void initialize(long n, const double* S, double* v, long count) const {
+        for (long i = 0; i < count; ++i) {
+            v[i] = payoff(terms.type, S[i], terms.K);
+        }
+        terms.apply_barrier(-n * k, k, v, count);
+    }
+
+    RollbackExercise exercise(long n) const {
+        if (!schedule[n]) {
+            return RollbackExercise::NONE;
+        }
+        return (terms.type == OptionType::CALL) ? RollbackExercise::CALL : RollbackExercise::PUT;
+    }
+
+    double strike() const { return terms.K; }
+
+    void adjust(long n, const double*, double* v, long count) const {
+        if (n == N - 1 && refinement_levels > 0) {
+            terms.refine(-n * k, k, dt, count, refinement_levels - 1, schedule[n] != 0, v);
+        }
+        terms.apply_barrier(-n * k, k, v, count);
+    }
+};
+
+bool is_barrier(PathPayoff payoff) {
+    return payoff == PathPayoff::UP_AND_OUT || payoff == PathPayoff::UP_AND_IN || payoff == PathPayoff::DOWN_AND_OUT ||
+           payoff == PathPayoff::DOWN_AND_IN;
+}
+
+bool is_knock_in(PathPayoff payoff) {
+    return payoff == PathPayoff::UP_AND_IN || payoff == PathPayoff::DOWN_AND_IN;
+}
+
+bool is_up(PathPayoff payoff) {
+    return payoff == PathPayoff::UP_AND_OUT || payoff == PathPayoff::UP_AND_IN;
+}
+
+// Ritchken's fit: the stretch nearest the requested one (and at least 1) for which the
+// barrier lies a whole number of steps from S0. Returns the requested stretch when the
+// barrier is less than a step away.
+double fitted_stretch(double stretch, double log_barrier, double sigma, double dt) {
+    const double distance = std::abs(log_barrier);
+    const double unit = sigma * std::sqrt(dt);
+    long steps = std::lround(distance / (stretch * unit));
+    if (steps >= 1 && distance / (steps * unit) < 1.0) {
+        --steps;
+    }
+    if (steps < 1) {
+        return stretch;
+    }
+    return distance / (steps * unit);
+}
+
+} // namespace
+
+double trinomial_lattice_pricing(OptionType type, ExerciseStyle style, double S0, double K, double T, double r,
+                                 double sigma, long N, PathPayoff payoff, double barrier,
+                                 const TrinomialSettings& settings, const std::vector<double>& exercise_times) {
+    FINMATH_INSTRUMENT("trinomial_lattice_pricing", 1);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if (N < 1) {
+        std::cerr << "Number of steps must be at least 1." << std::endl;
+        return nan;
+    }
+    if (payoff != PathPayoff::EUROPEAN && !is_barrier(payoff)) {
+        std::cerr << "Trinomial lattices price EUROPEAN and barrier payoffs only." << std::endl;
+        return nan;
+    }
+    if (is_barrier(payoff) && !(barrier > 0)) {
+        std::cerr << "Barrier level must be positive." << std::endl;
+        return nan;
+    }
+    if (is_knock_in(payoff) && style != ExerciseStyle::EUROPEAN) {
+        std::cerr << "Knock-in options must be European." << std::endl;
+        return nan;
+    }
+    if (!(settings.stretch >= 1.0) || settings.refinement_levels < 0) {
+        std::cerr << "Stretch must be at least 1 and refinement levels non-negative." << std::endl;
+        return nan;
+    }
+
+    if (is_barrier(payoff)) {
+        const bool breached = is_up(payoff) ? S0 >= barrier : S0 <= barrier;
+        double vanilla = trinomial_lattice_pricing(type, style, S0, K, T, r, sigma, N, PathPayoff::EUROPEAN, 0.0,
+                                                   settings, exercise_times);
+        if (breached) {
+            return is_knock_in(payoff) ? vanilla : 0.0;
+        }
+        if (is_knock_in(payoff)) {
+            PathPayoff out = is_up(payoff) ? PathPayoff::UP_AND_OUT : PathPayoff::DOWN_AND_OUT;
+            return vanilla - trinomial_lattice_pricing(type, style, S0, K, T, r, sigma, N, out, barrier, settings,
+                                                       exercise_times);
+        }
+    }
+
+    const double dt = T / N;
+    const double log_barrier = is_barrier(payoff) ? std::log(barrier / S0) : 0.0;
+    const double stretch = (is_barrier(payoff) && settings.fit_barrier)
+                               ? fitted_stretch(settings.stretch, log_barrier, sigma, dt)
+                               : settings.stretch;
+    const std::array<double, 3> p = trinomial_probabilities(stretch, r, sigma, dt);
+    if (!valid_probabilities(p)) {
+        std::cerr << "Trinomial probabilities are negative; use more steps." << std::endl;
+        return nan;
+    }
+
+    const double k = stretch * sigma * std::sqrt(dt);
+    const LatticeTerms terms{type, S0, K, r, sigma, stretch, std::log(K / S0), is_barrier(payoff), is_up(payoff),
+                             log_barrier, style == ExerciseStyle::AMERICAN};
+    const std::vector<char> schedule = exercise_schedule(style, N, dt, exercise_times);
+    const LatticeCore<3, double> core(S0, k, N, p);
+    return core.roll(TrinomialPolicy{terms, schedule, N, k, dt, settings.refinement_levels}, N);
+}
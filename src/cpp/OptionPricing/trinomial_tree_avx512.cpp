@@ -0,0 +1,14 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime CPU detection
+#define TRINOMIAL_TREE_SIMD_KERNEL
+#include "trinomial_tree_simd.h"
+
+bool trinomial_rollback_avx512(double* v, long n, double p_up, double p_mid, double p_down, const double* S,
+                               double K, RollbackExercise exercise) {
+#if defined(__AVX512F__)
+    trinomial_rollback_kernel<VecAVX512>(v, n, p_up, p_mid, p_down, S, K, exercise);
+    return true;
+#else
+    (void)v, (void)n, (void)p_up, (void)p_mid, (void)p_down, (void)S, (void)K, (void)exercise;
+    return false;
+#endif
+}
@@ -0,0 +1,61 @@
+#ifndef TRINOMIAL_TREE_SIMD_H
+#define TRINOMIAL_TREE_SIMD_H
+
+#include "binomial_tree_simd.h"
+
+// Instruction-set specific kernels for one backward-induction step of a trinomial
+// lattice: v[i] = p_up v[i + 2] + p_mid v[i + 1] + p_down v[i] for i = 0..n, then (when
+// exercise is allowed) the max against the call or put payoff of S[i]. Each returns false
+// when its translation unit was built without the matching compiler flags.
+
+bool trinomial_rollback_avx2(double* v, long n, double p_up, double p_mid, double p_down, const double* S, double K,
+                             RollbackExercise exercise);
+bool trinomial_rollback_avx512(double* v, long n, double p_up, double p_mid, double p_down, const double* S,
+                               double K, RollbackExercise exercise);
+
+#ifdef TRINOMIAL_TREE_SIMD_KERNEL
+
+#include "../Helper/simd_vec.h"
+
+namespace {
+
+template <typename V, typename Real = typename V::Scalar>
+void trinomial_rollback_kernel(Real* v, long n, Real p_up, Real p_mid, Real p_down, const Real* S, Real K,
+                               RollbackExercise exercise) {
+    constexpr long width = V::width;
+    const V up = V::set1(p_up);
+    const V mid = V::set1(p_mid);
+    const V down = V::set1(p_down);
+    const V strike = V::set1(K);
+
+    // As in the binomial kernel, a block loads v[i + 1 ..] and v[i + 2 ..] before it stores
+    // v[i ..], and later blocks only read past what has been stored
+    long i = 0;
+    for (; i + width <= n + 1; i += width) {
+        V value = vfma(up, V::load(v + i + 2), vfma(mid, V::load(v + i + 1), down * V::load(v + i)));
+        if (exercise == RollbackExercise::CALL) {
+            value = vmax(value, V::load(S + i) - strike);
+        } else if (exercise == RollbackExercise::PUT) {
+            value = vmax(value, strike - V::load(S + i));
+        }
+        V::store(v + i, value);
+    }
+
+    for (; i <= n; ++i) {
+        Real value = p_up * v[i + 2] + p_mid * v[i + 1] + p_down * v[i];
+        if (exercise == RollbackExercise::CALL) {
+            Real intrinsic = S[i] - K;
+            value = value > intrinsic ? value : intrinsic;
+        } else if (exercise == RollbackExercise::PUT) {
+            Real intrinsic = K - S[i];
+            value = value > intrinsic ? value : intrinsic;
+        }
+        v[i] = value;
+    }
+}
+
+} // namespace
+
+#endif // TRINOMIAL_TREE_SIMD_KERNEL
+
+#endif // TRINOMIAL_TREE_SIMD_H
@@ -0,0 +1,639 @@
+#include "finmath/OptionPricing/vol_surface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/OptionPricing/black_scholes.h"
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+const double kInf = std::numeric_limits<double>::infinity();
+
+// Most buckets per cell an axis index uses, however uneven its nodes
+constexpr size_t kMaxBucketsPerCell = 64;
+
+// Options priced per volatility lookup chunk in the surface black_scholes_batch
+constexpr size_t kSurfaceChunk = 256;
+
+// Nelder-Mead over the SVI (m, ln sigma) plane
+constexpr int kMaxSimplexIterations = 400;
+constexpr double kSimplexTolerance = 1e-10;
+
+bool positive_finite(double x) {
+    return x > 0.0 && std::isfinite(x);
+}
+
+void check_axis(const std::vector<double>& nodes, const char* name) {
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (!positive_finite(nodes[i]) || (i > 0 && !(nodes[i] > nodes[i - 1]))) {
+            throw std::invalid_argument(std::string("VolSurface ") + name +
+                                        " must be positive, finite and strictly increasing");
+        }
+    }
+}
+
+// Weights of nodes i - 1, i, i + 1 in the slope at node i: the derivative of the parabola
+// through the three nodes inside the axis, one-sided differences at its ends
+std::vector<double> slope_weights(const std::vector<double>& nodes) {
+    size_t count = nodes.size();
+    std::vector<double> weights(3 * count, 0.0);
+    if (count < 2) {
+        return weights;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        double* w = &weights[3 * i];
+        if (i == 0) {
+            double h = nodes[1] - nodes[0];
+            w[1] = -1.0 / h;
+            w[2] = 1.0 / h;
+        } else if (i + 1 == count) {
+            double h = nodes[i] - nodes[i - 1];
+            w[0] = -1.0 / h;
+            w[1] = 1.0 / h;
+        } else {
+            double h0 = nodes[i] - nodes[i - 1];
+            double h1 = nodes[i + 1] - nodes[i];
+            w[0] = -h1 / (h0 * (h0 + h1));
+            w[1] = (h1 - h0) / (h0 * h1);
+            w[2] = h0 / (h1 * (h0 + h1));
+        }
+    }
+    return weights;
+}
+
+double svi_variance_at(const SviParameters& p, double k) {
+    double y = k - p.m;
+    return p.a + p.b * (p.rho * y + std::sqrt(y * y + p.sigma * p.sigma));
+}
+
+// Solve the n x n system a x = b (row-major, n <= 3) by Gaussian elimination with partial
+// pivoting; false if it is singular to working precision
+bool solve_small(double* a, double* b, size_t n) {
+    for (size_t col = 0; col < n; ++col) {
+        size_t pivot = col;
+        for (size_t row = col + 1; row < n; ++row) {
+            if (std::fabs(a[row * n + col]) > std::fabs(a[pivot * n + col])) {
+                pivot = row;
+            }
+        }
+        if (!(std::fabs(a[pivot * n + col]) > 1e-300)) {
+            return false;
+        }
+        if (pivot != col) {
+            for (size_t k = 0; k < n; ++k) {
+                std::swap(a[col * n + k], a[pivot * n + k]);
+            }
+            std::swap(b[col], b[pivot]);
+        }
+        for (size_t row = col + 1; row < n; ++row) {
+            double factor = a[row * n + col] / a[col * n + col];
+            for (size_t k = col; k < n; ++k) {
+                a[row * n + k] -= factor * a[col * n + k];
+            }
+            b[row] -= factor * b[col];
+        }
+    }
+    for (size_t col = n; col-- > 0;) {
+        for (size_t k = col + 1; k < n; ++k) {
+            b[col] -= a[col * n + k] * b[k];
+        }
+        b[col] /= a[col * n + col];
+    }
+    return std::isfinite(b[0]);
+}
+
+// Quotes of one expiry in log strike and total variance, for fitting
+struct SliceData {
+    const double* k;
+    const double* w;
+    size_t count;
+};
+
+// With m and sigma fixed, SVI is linear in the rest: w = a + d y + c z with y = k - m,
+// z = sqrt(y^2 + sigma^2), b = c and rho = d / c. Least-squares fit of (a, d, c) subject to
+// c >= |d|: the unconstrained solution if it qualifies, otherwise the best fit on the faces
+// d = c, d = -c (rho = +-1) and c = 0. Returns the sum of squared residuals.
+double fit_linear(const SliceData& data, double m, double sigma, SviParameters& out) {
+    double s1 = static_cast<double>(data.count);
+    double sy = 0.0, sz = 0.0, syy = 0.0, syz = 0.0, szz = 0.0, sw = 0.0, syw = 0.0, szw = 0.0;
+    for (size_t i = 0; i < data.count; ++i) {
+        double y = data.k[i] - m;
+        double z = std::sqrt(y * y + sigma * sigma);
+        double w = data.w[i];
+        sy += y;
+        sz += z;
+        syy += y * y;
+        syz += y * z;
+        szz += z * z;
+        sw += w;
+        syw += y * w;
+        szw += z * w;
+    }
+
+    auto residual = [&](double a, double d, double c) {
+        double sum = 0.0;
+        for (size_t i = 0; i < data.count; ++i) {
+            double y = data.k[i] - m;
+            double r = a + d * y + c * std::sqrt(y * y + sigma * sigma) - data.w[i];
+            sum += r * r;
+        }
+        return sum;
+    };
+
+    double best = kInf;
+    double best_a = sw / s1;
+    double best_d = 0.0;
+    double best_c = 0.0;
+    auto consider = [&](double a, double d, double c) {
+        double error = residual(a, d, c);
+        if (error < best) {
+            best = error;
+            best_a = a;
+            best_d = d;
+            best_c = c;
+        }
+    };
+
+    double normal[9] = {s1, sy, sz, sy, syy, syz, sz, syz, szz};
+    double rhs[3] = {sw, syw, szw};
+    if (solve_small(normal, rhs, 3) && rhs[2] >= std::fabs(rhs[1])) {
+        consider(rhs[0], rhs[1], rhs[2]);
+    } else {
+        // Faces d = sign * c: w = a + c (z + sign y)
+        for (double sign : {1.0, -1.0}) {
+            double su = sz + sign * sy;
+            double suu = szz + 2.0 * sign * syz + syy;
+            double suw = szw + sign * syw;
+            double face[4] = {s1, su, su, suu};
+            double face_rhs[2] = {sw, suw};
+            if (solve_small(face, face_rhs, 2) && face_rhs[1] >= 0.0) {
+                consider(face_rhs[0], sign * face_rhs[1], face_rhs[1]);
+            }
+        }
+        consider(sw / s1, 0.0, 0.0);
+    }
+
+    out.a = best_a;
+    out.b = best_c;
+    out.rho = best_c > 0.0 ? best_d / best_c : 0.0;
+    out.m = m;
+    out.sigma = sigma;
+    return best;
+}
+
+// Best-fit SVI parameters over the (m, ln sigma) plane by Nelder-Mead, from start with
+// initial steps dm and dlog_sigma; m and sigma are kept inside the given bounds
+SviParameters fit_svi(const SliceData& data, double start_m, double start_sigma, double dm, double dlog_sigma,
+                      double m_lo, double m_hi) {
+    const double log_sigma_lo = std::log(1e-4);
+    const double log_sigma_hi = std::log(10.0);
+
+    struct Vertex {
+        double m;
+        double log_sigma;
+        double error;
+    };
+    SviParameters fitted{};
+    auto evaluate = [&](double m, double log_sigma) {
+        if (!(m >= m_lo && m <= m_hi && log_sigma >= log_sigma_lo && log_sigma <= log_sigma_hi)) {
+            return Vertex{m, log_sigma, kInf};
+        }
+        return Vertex{m, log_sigma, fit_linear(data, m, std::exp(log_sigma), fitted)};
+    };
+
+    double log_sigma = std::log(std::min(std::max(start_sigma, 1e-4), 10.0));
+    Vertex simplex[3];
+    // Two passes: the second restarts from the first's optimum with a fresh simplex, which
+    // undoes any collapse of the first one
+    for (int pass = 0; pass < 2; ++pass) {
+        double m = pass == 0 ? start_m : simplex[0].m;
+        double ls = pass == 0 ? log_sigma : simplex[0].log_sigma;
+        double step_m = pass == 0 ? dm : 0.1 * dm;
+        double step_s = pass == 0 ? dlog_sigma : 0.1 * dlog_sigma;
+        simplex[0] = evaluate(m, ls);
+        simplex[1] = evaluate(m + step_m, ls);
+        if (std::isinf(simplex[1].error)) {
+            simplex[1] = evaluate(m - step_m, ls);
+        }
+        simplex[2] = evaluate(m, ls + step_s);
+        if (std::isinf(simplex[2].error)) {
+            simplex[2] = evaluate(m, ls - step_s);
+        }
+
+        for (int iteration = 0; iteration < kMaxSimplexIterations; ++iteration) {
+            std::sort(simplex, simplex + 3, [](const Vertex& l, const Vertex& r) { return l.error < r.error; });
+            double size = 0.0;
+            for (int v = 1; v < 3; ++v) {
+                size = std::max(size, std::max(std::fabs(simplex[v].m - simplex[0].m),
+                                               std::fabs(simplex[v].log_sigma - simplex[0].log_sigma)));
+            }
+            if (size < kSimplexTolerance) {
+                break;
+            }
+
+            double cm = 0.5 * (simplex[0].m + simplex[1].m);
+            double cs = 0.5 * (simplex[0].log_sigma + simplex[1].log_sigma);
+            const Vertex& worst = simplex[2];
+            Vertex reflected = evaluate(2.0 * cm - worst.m, 2.0 * cs - worst.log_sigma);
+            if (reflected.error < simplex[0].error) {
+                Vertex expanded = evaluate(3.0 * cm - 2.0 * worst.m, 3.0 * cs - 2.0 * worst.log_sigma);
+                simplex[2] = expanded.error < reflected.error ? expanded : reflected;
+            } else if (reflected.error < simplex[1].error) {
+                simplex[2] = reflected;
+            } else {
+                bool outside = reflected.error < worst.error;
+                const Vertex& from = outside ? reflected : worst;
+                Vertex contracted = evaluate(0.5 * (cm + from.m), 0.5 * (cs + from.log_sigma));
+                if (contracted.error < std::min(reflected.error, worst.error)) {
+                    simplex[2] = contracted;
+                } else {
+                    for (int v = 1; v < 3; ++v) {
+                        simplex[v] = evaluate(0.5 * (simplex[0].m + simplex[v].m),
+                                              0.5 * (simplex[0].log_sigma + simplex[v].log_sigma));
+                    }
+                }
+            }
+        }
+        std::sort(simplex, simplex + 3, [](const Vertex& l, const Vertex& r) { return l.error < r.error; });
+    }
+
+    fit_linear(data, simplex[0].m, std::exp(simplex[0].log_sigma), fitted);
+    return fitted;
+}
+
+} // namespace
+
+void VolSurface::Axis::build(std::vector<double> values) {
+    nodes = std::move(values);
+    size_t cells = nodes.size() - 1;
+    inverse_widths.assign(cells, 0.0);
+    buckets.clear();
+    scale = 0.0;
+    if (cells == 0) {
+        return;
+    }
+
+    double min_width = kInf;
+    for (size_t i = 0; i < cells; ++i) {
+        double width = nodes[i + 1] - nodes[i];
+        inverse_widths[i] = 1.0 / width;
+        min_width = std::min(min_width, width);
+    }
+    double span = nodes.back() - nodes.front();
+    double wanted = std::ceil(span / min_width);
+    size_t count = wanted >= static_cast<double>(kMaxBucketsPerCell * cells)
+                       ? kMaxBucketsPerCell * cells
+                       : std::max(static_cast<size_t>(wanted), cells);
+    scale = static_cast<double>(count) / span;
+    buckets.resize(count);
+
+    // Bucket b starts at the first cell whose upper node falls in bucket b or later; bucket()
+    // is monotone, so no point of the bucket lies in an earlier cell
+    size_t i = 0;
+    for (size_t b = 0; b < count; ++b) {
+        while (i + 1 < cells && bucket(nodes[i + 1]) < b) {
+            ++i;
+        }
+        buckets[b] = static_cast<uint32_t>(i);
+    }
+}
+
+size_t VolSurface::Axis::bucket(double x) const {
+    size_t b = static_cast<size_t>((x - nodes.front()) * scale);
+    return std::min(b, buckets.size() - 1);
+}
+
+size_t VolSurface::Axis::cell(double x) const {
+    size_t cells = nodes.size() - 1;
+    size_t i = buckets[bucket(x)];
+    // A bucket no wider than the narrowest cell holds at most one node: take that step
+    // without a branch (lookups land in random cells, so a branch would mispredict)
+    i += static_cast<size_t>((x >= nodes[i + 1]) & (i + 1 < cells));
+    while (i + 1 < cells && x >= nodes[i + 1]) {
+        ++i;
+    }
+    return i;
+}
+
+VolSurface::VolSurface(std::vector<double> strikes, std::vector<double> expiries, std::vector<double> volatilities,
+                       VolInterpolation method)
+    : method_(method), strikes_(std::move(strikes)), expiries_(std::move(expiries)),
+      quotes_(std::move(volatilities)) {
+    size_t min_strikes = method_ == VolInterpolation::SVI ? 5 : 2;
+    size_t min_expiries = method_ == VolInterpolation::SVI ? 1 : 2;
+    if (strikes_.size() < min_strikes || expiries_.size() < min_expiries) {
+        throw std::invalid_argument(method_ == VolInterpolation::SVI
+                                        ? "SVI VolSurface needs at least 5 strikes and 1 expiry"
+                                        : "Bicubic VolSurface needs at least 2 strikes and 2 expiries");
+    }
+    check_axis(strikes_, "strikes");
+    check_axis(expiries_, "expiries");
+    if (quotes_.size() != strikes_.size() * expiries_.size()) {
+        throw std::invalid_argument("VolSurface needs one volatility per strike and expiry");
+    }
+
+    size_t m = strikes_.size();
+    variance_.resize(quotes_.size());
+    for (size_t j = 0; j < expiries_.size(); ++j) {
+        for (size_t i = 0; i < m; ++i) {
+            double vol = quotes_[j * m + i];
+            if (!positive_finite(vol)) {
+                throw std::invalid_argument("VolSurface volatilities must be positive and finite");
+            }
+            variance_[j * m + i] = vol * vol * expiries_[j];
+        }
+    }
+
+    std::vector<double> log_strikes(m);
+    for (size_t i = 0; i < m; ++i) {
+        log_strikes[i] = std::log(strikes_[i]);
+    }
+    strike_axis_.build(std::move(log_strikes));
+    expiry_axis_.build(expiries_);
+
+    if (method_ == VolInterpolation::BICUBIC) {
+        size_t n = expiries_.size();
+        strike_weights_ = slope_weights(strike_axis_.nodes);
+        expiry_weights_ = slope_weights(expiries_);
+        slope_x_.resize(m * n);
+        slope_t_.resize(m * n);
+        slope_xt_.resize(m * n);
+        coefficients_.resize(16 * (m - 1) * (n - 1));
+        for (size_t j = 0; j < n; ++j) {
+            for (size_t i = 0; i < m; ++i) {
+                rebuild_node(i, j);
+            }
+        }
+        for (size_t j = 0; j + 1 < n; ++j) {
+            for (size_t i = 0; i + 1 < m; ++i) {
+                rebuild_cell(i, j);
+            }
+        }
+    } else {
+        slices_.resize(expiries_.size());
+        for (size_t j = 0; j < expiries_.size(); ++j) {
+            fit_slice(j, false);
+        }
+    }
+}
+
+double VolSurface::quote(size_t strike_index, size_t expiry_index) const {
+    if (strike_index >= strikes_.size() || expiry_index >= expiries_.size()) {
+        throw std::out_of_range("VolSurface quote index off the grid");
+    }
+    return quotes_[expiry_index * strikes_.size() + strike_index];
+}
+
+double VolSurface::total_variance(double strike, double time) const {
+    if (!(strike > 0.0) || !(time > 0.0)) {
+        return kNaN;
+    }
+    double x = std::log(strike);
+    double t = std::min(std::max(time, expiries_.front()), expiries_.back());
+    double w = method_ == VolInterpolation::BICUBIC ? bicubic_variance(x, t) : svi_variance(x, t);
+    if (t != time) {
+        // Flat volatility before the first and after the last expiry
+        w *= time / t;
+    }
+    return std::max(w, 0.0);
+}
+
+double VolSurface::volatility(double strike, double time) const {
+    return std::sqrt(total_variance(strike, time) / time);
+}
+
+void VolSurface::volatility_batch(const double* strikes, const double* times, double* out, size_t n) const {
+    FINMATH_INSTRUMENT_SAMPLED("VolSurface::volatility_batch", n);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = volatility(strikes[i], times[i]);
+    }
+}
+
+void VolSurface::update(size_t strike_index, size_t expiry_index, double volatility) {
+    VolQuote quote{strike_index, expiry_index, volatility};
+    update(&quote, 1);
+}
+
+void VolSurface::update(const VolQuote* quotes, size_t n) {
+    FINMATH_INSTRUMENT("VolSurface::update", n);
+    size_t m = strikes_.size();
+    size_t e = expiries_.size();
+    for (size_t q = 0; q < n; ++q) {
+        if (quotes[q].strike_index >= m || quotes[q].expiry_index >= e) {
+            throw std::out_of_range("VolSurface quote index off the grid");
+        }
+        if (!positive_finite(quotes[q].volatility)) {
+            throw std::invalid_argument("VolSurface volatilities must be positive and finite");
+        }
+    }
+
+    for (size_t q = 0; q < n; ++q) {
+        size_t k = quotes[q].expiry_index * m + quotes[q].strike_index;
+        double vol = quotes[q].volatility;
+        quotes_[k] = vol;
+        variance_[k] = vol * vol * expiries_[quotes[q].expiry_index];
+    }
+
+    if (method_ == VolInterpolation::SVI) {
+        std::vector<bool> dirty(e, false);
+        for (size_t q = 0; q < n; ++q) {
+            dirty[quotes[q].expiry_index] = true;
+        }
+        for (size_t j = 0; j < e; ++j) {
+            if (dirty[j]) {
+                fit_slice(j, true);
+            }
+        }
+        return;
+    }
+
+    // A quote enters the slopes of the nodes next to it, and a node's slopes enter the
+    // cells on either side of it: mark nodes within one and cells within two of each quote
+    std::vector<bool> dirty_nodes(m * e, false);
+    std::vector<bool> dirty_cells((m - 1) * (e - 1), false);
+    for (size_t q = 0; q < n; ++q) {
+        size_t i = quotes[q].strike_index;
+        size_t j = quotes[q].expiry_index;
+        for (size_t jj = j > 0 ? j - 1 : 0; jj <= std::min(j + 1, e - 1); ++jj) {
+            for (size_t ii = i > 0 ? i - 1 : 0; ii <= std::min(i + 1, m - 1); ++ii) {
+                dirty_nodes[jj * m + ii] = true;
+            }
+        }
+        for (size_t jj = j > 1 ? j - 2 : 0; jj <= std::min(j + 1, e - 2); ++jj) {
+            for (size_t ii = i > 1 ? i - 2 : 0; ii <= std::min(i + 1, m - 2); ++ii) {
+                dirty_cells[jj * (m - 1) + ii] = true;
+            }
+        }
+    }
+    for (size_t j = 0; j < e; ++j) {
+        for (size_t i = 0; i < m; ++i) {
+            if (dirty_nodes[j * m + i]) {
+                rebuild_node(i, j);
+            }
+        }
+    }
+    for (size_t j = 0; j + 1 < e; ++j) {
+        for (size_t i = 0; i + 1 < m; ++i) {
+            if (dirty_cells[j * (m - 1) + i]) {
+                rebuild_cell(i, j);
+            }
+        }
+    }
+}
+
+const SviParameters& VolSurface::svi_slice(size_t expiry_index) const {
+    if (method_ != VolInterpolation::SVI) {
+        throw std::logic_error("svi_slice needs an SVI VolSurface");
+    }
+    return slices_.at(expiry_index);
+}
+
+// Slopes of node (i, j) from the total variance of its neighbours
+void VolSurface::rebuild_node(size_t i, size_t j) {
+    size_t m = strikes_.size();
+    const double* wx = &strike_weights_[3 * i];
+    const double* wt = &expiry_weights_[3 * j];
+    double sx = 0.0;
+    double st = 0.0;
+    double sxt = 0.0;
+    // A zero weight marks a neighbour past the end of the axis, so it is skipped before indexing
+    for (size_t a = 0; a < 3; ++a) {
+        if (wx[a] != 0.0) {
+            sx += wx[a] * variance_[j * m + i + a - 1];
+        }
+        if (wt[a] != 0.0) {
+            st += wt[a] * variance_[(j + a - 1) * m + i];
+        }
+    }
+    for (size_t b = 0; b < 3; ++b) {
+        if (wt[b] == 0.0) {
+            continue;
+        }
+        for (size_t a = 0; a < 3; ++a) {
+            if (wx[a] != 0.0) {
+                sxt += wt[b] * wx[a] * variance_[(j + b - 1) * m + i + a - 1];
+            }
+        }
+    }
+    slope_x_[j * m + i] = sx;
+    slope_t_[j * m + i] = st;
+    slope_xt_[j * m + i] = sxt;
+}
+
+// Coefficients of the Hermite patch on cell (i, j) in unit coordinates u, v: C = A F A^T
+// with F the corner values and slopes scaled to the cell
+void VolSurface::rebuild_cell(size_t i, size_t j) {
+    static const double A[4][4] = {{1, 0, 0, 0}, {0, 0, 1, 0}, {-3, 3, -2, -1}, {2, -2, 1, 1}};
+    size_t m = strikes_.size();
+    double hx = strike_axis_.nodes[i + 1] - strike_axis_.nodes[i];
+    double ht = expiries_[j + 1] - expiries_[j];
+
+    double F[4][4];
+    for (size_t a = 0; a < 2; ++a) {
+        for (size_t b = 0; b < 2; ++b) {
+            size_t k = (j + b) * m + i + a;
+            F[a][b] = variance_[k];
+            F[a][2 + b] = ht * slope_t_[k];
+            F[2 + a][b] = hx * slope_x_[k];
+            F[2 + a][2 + b] = hx * ht * slope_xt_[k];
+        }
+    }
+
+    double AF[4][4];
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            double sum = 0.0;
+            for (size_t k = 0; k < 4; ++k) {
+                sum += A[r][k] * F[k][c];
+            }
+            AF[r][c] = sum;
+        }
+    }
+    double* out = &coefficients_[16 * (j * (m - 1) + i)];
+    for (size_t r = 0; r < 4; ++r) {
+        for (size_t c = 0; c < 4; ++c) {
+            double sum = 0.0;
+            for (size_t k = 0; k < 4; ++k) {
+                sum += AF[r][k] * A[c][k];
+            }
+            out[4 * r + c] = sum;
+        }
+    }
+}
+
+void VolSurface::fit_slice(size_t expiry_index, bool warm_start) {
+    const std::vector<double>& k = strike_axis_.nodes;
+    size_t m = strikes_.size();
+    SliceData data{k.data(), &variance_[expiry_index * m], m};
+    double span = k.back() - k.front();
+    double m_lo = k.front() - 2.0 * span;
+    double m_hi = k.back() + 2.0 * span;
+
+    double start_m;
+    double start_sigma;
+    if (warm_start) {
+        start_m = slices_[expiry_index].m;
+        start_sigma = slices_[expiry_index].sigma;
+    } else {
+        // Coarse scan for a starting point: the quoted strikes for m and a few widths for sigma
+        double best = kInf;
+        start_m = k.front();
+        start_sigma = span;
+        SviParameters scratch;
+        for (size_t i = 0; i < m; ++i) {
+            for (double fraction : {0.03, 0.1, 0.3, 1.0}) {
+                double error = fit_linear(data, k[i], fraction * span, scratch);
+                if (error < best) {
+                    best = error;
+                    start_m = k[i];
+                    start_sigma = fraction * span;
+                }
+            }
+        }
+    }
+    slices_[expiry_index] = fit_svi(data, start_m, start_sigma, 0.1 * span, 0.5, m_lo, m_hi);
+}
+
+double VolSurface::bicubic_variance(double x, double time) const {
+    x = std::min(std::max(x, strike_axis_.nodes.front()), strike_axis_.nodes.back());
+    size_t i = strike_axis_.cell(x);
+    size_t j = expiry_axis_.cell(time);
+    double u = (x - strike_axis_.nodes[i]) * strike_axis_.inverse_widths[i];
+    double v = (time - expiries_[j]) * expiry_axis_.inverse_widths[j];
+
+    const double* c = &coefficients_[16 * (j * (strikes_.size() - 1) + i)];
+    double w = 0.0;
+    for (size_t p = 4; p-- > 0;) {
+        const double* row = c + 4 * p;
+        w = w * u + (((row[3] * v + row[2]) * v + row[1]) * v + row[0]);
+    }
+    return w;
+}
+
+double VolSurface::svi_variance(double x, double time) const {
+    if (slices_.size() == 1) {
+        return svi_variance_at(slices_[0], x);
+    }
+    size_t j = expiry_axis_.cell(time);
+    double v = (time - expiries_[j]) * expiry_axis_.inverse_widths[j];
+    double w0 = svi_variance_at(slices_[j], x);
+    double w1 = svi_variance_at(slices_[j + 1], x);
+    return w0 + v * (w1 - w0);
+}
+
+void black_scholes_batch(const OptionType* types, const double* strikes, const double* prices,
+                         const double* times, const double* rates, const VolSurface& surface, double* out, size_t n) {
+    double volatilities[kSurfaceChunk];
+    for (size_t begin = 0; begin < n; begin += kSurfaceChunk) {
+        size_t count = std::min(kSurfaceChunk, n - begin);
+        surface.volatility_batch(strikes + begin, times + begin, volatilities, count);
+        black_scholes_batch(types + begin, strikes + begin, prices + begin, times + begin, rates + begin,
+                            volatilities, out + begin, count);
+    }
+}
@@ -0,0 +1,412 @@
+#include "finmath/TimeSeries/indicator_pipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/TimeSeries/rolling_window.h"
+#include "moving_average_kernel.h"
+
+// Each kernel below repeats the arithmetic of its standalone counterpart (rolling_mean,
+// rolling_stddev plus annualization, compute_rsi) operation for operation, so the fused
+// results match those functions bit for bit. They differ only in where the inputs come
+// from: the price column, or the block of shared returns / changes. The EMA family and WMA
+// run MovingAverageKernel on its scalar path, which is what the streaming classes compute.
+
+namespace {
+
+// Prices per block: the block and its returns and changes stay in L1/L2 while every
+// indicator walks over them
+constexpr size_t kBlockSize = 2048;
+
+// until_resync counts down the outputs left before the next rebuild, which falls on
+// output indices that are multiples of the period (i % period == 0 in the originals)
+
+struct SmaState {
+    size_t window_size;
+    size_t period;
+    size_t until_resync;
+    double inv_window;
+    double sum;
+    double* out;  // output index i goes to out[i - out_base]
+    size_t out_base;
+};
+
+struct VolatilityState {
+    size_t window_size;
+    size_t period;
+    size_t until_resync;
+    RollingMoments moments;
+    double* out;
+    size_t out_base;
+};
+
+struct RsiState {
+    size_t window_size;
+    double avg_gain;
+    double avg_loss;
+    double* out;
+    size_t out_base;
+};
+
+// The kernels copy their running state into locals for the loop: out may alias any double,
+// so writes through it would otherwise force the state to be reloaded every step.
+
+// Prices t in [begin, end)
+void advance_sma(SmaState& s, const double* prices, size_t begin, size_t end) {
+    const size_t w = s.window_size;
+    const double inv_window = s.inv_window;
+    double* out = s.out;
+    const size_t out_base = s.out_base;
+    double sum = s.sum;
+    size_t until_resync = s.until_resync;
+
+    size_t t = begin;
+    for (; t < end && t < w; ++t) {
+        sum += prices[t];
+        if (t + 1 == w) {
+            // Output 0, so this is the cursor's first output of the indicator and out_base is 0
+            out[0] = sum * inv_window;
+        }
+    }
+    for (; t < end; ++t) {
+        size_t i = t + 1 - w;
+        if (until_resync == 0) {
+            sum = 0.0;
+            for (size_t j = i; j <= t; ++j) {
+                sum += prices[j];
+            }
+            until_resync = s.period;
+        } else {
+            sum += prices[t] - prices[i - 1];
+        }
+        --until_resync;
+        out[i - out_base] = sum * inv_window;
+    }
+
+    s.sum = sum;
+    s.until_resync = until_resync;
+}
+
+// Returns j in [begin, end), with return j at returns[j - base]
+void advance_volatility(VolatilityState& s, const double* returns, size_t base, size_t begin, size_t end) {
+    static const double annualization = std::sqrt(252);
+    const size_t w = s.window_size;
+    double* out = s.out;
+    const size_t out_base = s.out_base;
+    RollingMoments moments = s.moments;
+    size_t until_resync = s.until_resync;
+
+    for (size_t j = std::max(begin, w - 1); j < end; ++j) {
+        size_t i = j + 1 - w;
+        if (until_resync == 0) {
+            moments.resync(returns + (i - base), w);
+            until_resync = s.period;
+        } else {
+            moments.slide(returns[j - base], returns[i - 1 - base]);
+        }
+        --until_resync;
+        out[i - out_base] = moments.stddev() * annualization;
+    }
+
+    s.moments = moments;
+    s.until_resync = until_resync;
+}
+
+// Prices t in [begin, end), t >= 1, with the change into price t at changes[t - offset]
+void advance_rsi(RsiState& s, const double* changes, size_t offset, size_t begin, size_t end) {
+    // Converted once instead of every step; both are exact, so the products match compute_rsi
+    const double w = static_cast<double>(s.window_size);
+    const double w_minus_1 = static_cast<double>(s.window_size - 1);
+    double* out = s.out;
+    const size_t out_base = s.out_base;
+    double avg_gain = s.avg_gain;
+    double avg_loss = s.avg_loss;
+
+    for (size_t t = begin; t < end; ++t) {
+        double change = changes[t - offset];
+        avg_gain = (avg_gain * w_minus_1) + (change > 0 ? change : 0) / w;
+        avg_loss = (avg_loss * w_minus_1) + (change < 0 ? std::abs(change) : 0) / w;
+
+        double rs = (avg_loss == 0) ? 0 : avg_gain / avg_loss;
+        out[t - out_base] = (avg_loss == 0) ? 100.0 : 100.0 - (100.0 / (1.0 + rs));
+    }
+
+    s.avg_gain = avg_gain;
+    s.avg_loss = avg_loss;
+}
+
+} // namespace
+
+IndicatorPipeline::IndicatorPipeline(std::vector<IndicatorSpec> indicators)
+    : indicators_(std::move(indicators)) {
+    if (indicators_.empty()) {
+        throw std::invalid_argument("IndicatorPipeline needs at least one indicator");
+    }
+    for (const IndicatorSpec& spec : indicators_) {
+        if (spec.window_size == 0) {
+            throw std::invalid_argument("IndicatorPipeline window sizes must be greater than 0");
+        }
+    }
+}
+
+size_t IndicatorPipeline::output_size(size_t k, size_t n) const {
+    const IndicatorSpec& spec = indicators_.at(k);
+    return indicator_output_size(spec.indicator, n, spec.window_size);
+}
+
+size_t IndicatorPipeline::offset(size_t k, size_t n) const {
+    size_t position = 0;
+    for (size_t i = 0; i < k; ++i) {
+        position += output_size(i, n);
+    }
+    return position;
+}
+
+size_t IndicatorPipeline::column_size(size_t n) const {
+    return offset(indicators_.size(), n);
+}
+
+void IndicatorPipeline::compute(const double* prices, size_t n, double* out) const {
+    std::vector<double*> outs(indicators_.size());
+    for (size_t k = 0; k < indicators_.size(); ++k) {
+        outs[k] = out + offset(k, n);
+    }
+    IndicatorCursor(*this, prices, n).advance(n, outs.data());
+}
+
+void IndicatorPipeline::compute(const double* panel, size_t rows, size_t columns, double* out,
+                                ThreadPool& pool) const {
+    const size_t stride = column_size(rows);
+    std::vector<size_t> offsets(indicators_.size());
+    for (size_t k = 0; k < indicators_.size(); ++k) {
+        offsets[k] = offset(k, rows);
+    }
+
+    // Every column writes only its own slice of out
+    pool.parallel_for(columns, 1, [&](size_t begin, size_t end) {
+        std::vector<double*> outs(indicators_.size());
+        for (size_t c = begin; c < end; ++c) {
+            for (size_t k = 0; k < outs.size(); ++k) {
+                outs[k] = out + c * stride + offsets[k];
+            }
+            IndicatorCursor(*this, panel + c * rows, rows).advance(rows, outs.data());
+        }
+    });
+}
+
+std::vector<std::vector<double>> IndicatorPipeline::compute(const std::vector<double>& prices) const {
+    std::vector<std::vector<double>> result(indicators_.size());
+    std::vector<double*> outs(indicators_.size());
+    for (size_t k = 0; k < indicators_.size(); ++k) {
+        result[k].resize(output_size(k, prices.size()));
+        outs[k] = result[k].data();
+    }
+    IndicatorCursor(*this, prices.data(), prices.size()).advance(prices.size(), outs.data());
+    return result;
+}
+
+void IndicatorPipeline::compute_chunked(const double* prices, size_t n, size_t chunk_rows,
+                                        const IndicatorSink& sink) const {
+    if (chunk_rows == 0) {
+        throw std::invalid_argument("compute_chunked needs chunk_rows > 0");
+    }
+    // A chunk of prices yields at most one value per price per indicator, plus the RSI seed
+    std::vector<std::vector<double>> buffers(indicators_.size(), std::vector<double>(chunk_rows + 1));
+    std::vector<double*> outs(indicators_.size());
+    for (size_t k = 0; k < indicators_.size(); ++k) {
+        outs[k] = buffers[k].data();
+    }
+
+    IndicatorCursor cursor(*this, prices, n);
+    std::vector<size_t> first(indicators_.size());
+    do {
+        for (size_t k = 0; k < indicators_.size(); ++k) {
+            first[k] = cursor.produced(k);
+        }
+        cursor.advance(std::min(n, cursor.position() + chunk_rows), outs.data());
+        for (size_t k = 0; k < indicators_.size(); ++k) {
+            if (cursor.produced(k) > first[k]) {
+                sink(k, first[k], outs[k], cursor.produced(k) - first[k]);
+            }
+        }
+    } while (cursor.position() < n);
+}
+
+struct IndicatorCursor::State {
+    const double* prices;
+    size_t n;
+    size_t position;
+    std::vector<IndicatorSpec> indicators;
+    std::vector<size_t> produced;
+
+    // Scratch holds the log returns of the current block preceded by the last `history`
+    // returns before it (which the rolling windows reach back to), then the price changes
+    // of the current block. Return j is at returns[j - base].
+    size_t history;
+    size_t base;
+    std::vector<double> scratch;
+
+    // Per-indicator states in pipeline order within each kind, with the pipeline index of each
+    std::vector<SmaState> smas;
+    std::vector<VolatilityState> volatilities;
+    std::vector<RsiState> rsis;
+    std::vector<MovingAverageKernel<double>> averages;
+    std::vector<size_t> sma_index;
+    std::vector<size_t> volatility_index;
+    std::vector<size_t> rsi_index;
+    std::vector<size_t> average_index;
+    std::vector<size_t> average_written;  // values of each average written during the current advance()
+};
+
+IndicatorCursor::IndicatorCursor(const IndicatorPipeline& pipeline, const double* prices, size_t n)
+    : state_(new State()) {
+    State& st = *state_;
+    st.prices = prices;
+    st.n = n;
+    st.position = 0;
+    st.indicators = pipeline.indicators();
+    st.produced.assign(st.indicators.size(), 0);
+    st.history = 0;
+    st.base = 0;
+
+    bool has_rsi = false;
+    for (const IndicatorSpec& spec : st.indicators) {
+        if (spec.indicator == IndicatorType::VOLATILITY) {
+            st.history = std::max(st.history, spec.window_size);
+        } else if (spec.indicator == IndicatorType::RSI) {
+            has_rsi = true;
+        }
+    }
+    st.scratch.resize(st.history + 2 * kBlockSize);
+
+    // compute_rsi seeds both averages from the total gain and loss over the whole series
+    double total_gain = 0.0;
+    double total_loss = 0.0;
+    if (has_rsi) {
+        for (size_t t = 1; t < n; ++t) {
+            double change = prices[t] - prices[t - 1];
+            if (change > 0) {
+                total_gain += change;
+            } else if (change < 0) {
+                total_loss += std::abs(change);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < st.indicators.size(); ++k) {
+        const size_t w = st.indicators[k].window_size;
+        switch (st.indicators[k].indicator) {
+            case IndicatorType::SMA:
+                // Output 0 comes from the initial fill, so the first rebuild is period - 1 outputs later
+                st.smas.push_back({w, rolling_resync_period(w), rolling_resync_period(w) - 1,
+                                   1.0 / static_cast<double>(w), 0.0, nullptr, 0});
+                st.sma_index.push_back(k);
+                break;
+            case IndicatorType::VOLATILITY:
+                st.volatilities.push_back({w, rolling_resync_period(w), 0, RollingMoments(w), nullptr, 0});
+                st.volatility_index.push_back(k);
+                break;
+            case IndicatorType::RSI:
+                st.rsis.push_back({w, total_gain / w, total_loss / w, nullptr, 0});
+                st.rsi_index.push_back(k);
+                break;
+            case IndicatorType::EMA:
+            case IndicatorType::DEMA:
+            case IndicatorType::TEMA:
+            case IndicatorType::WMA:
+                st.averages.emplace_back(st.indicators[k].indicator, w);
+                st.average_index.push_back(k);
+                break;
+        }
+    }
+}
+
+IndicatorCursor::~IndicatorCursor() = default;
+IndicatorCursor::IndicatorCursor(IndicatorCursor&&) noexcept = default;
+IndicatorCursor& IndicatorCursor::operator=(IndicatorCursor&&) noexcept = default;
+
+size_t IndicatorCursor::position() const {
+    return state_->position;
+}
+
+size_t IndicatorCursor::produced(size_t k) const {
+    return state_->produced.at(k);
+}
+
+void IndicatorCursor::advance(size_t end, double* const* outs) {
+    State& st = *state_;
+    end = std::min(end, st.n);
+    FINMATH_INSTRUMENT_SAMPLED("IndicatorCursor::advance", std::max(end, st.position) - st.position);
+    const double* prices = st.prices;
+    double* returns = st.scratch.data();
+    double* changes = st.scratch.data() + st.history + kBlockSize;
+
+    // New values of indicator k start at output index produced(k), which lands at outs[k][0]
+    for (size_t r = 0; r < st.smas.size(); ++r) {
+        st.smas[r].out = outs[st.sma_index[r]];
+        st.smas[r].out_base = st.produced[st.sma_index[r]];
+    }
+    for (size_t r = 0; r < st.volatilities.size(); ++r) {
+        st.volatilities[r].out = outs[st.volatility_index[r]];
+        st.volatilities[r].out_base = st.produced[st.volatility_index[r]];
+    }
+    for (size_t r = 0; r < st.rsis.size(); ++r) {
+        RsiState& s = st.rsis[r];
+        s.out = outs[st.rsi_index[r]];
+        s.out_base = st.produced[st.rsi_index[r]];
+        if (s.out_base == 0) {
+            double rs = (s.avg_loss == 0) ? 0 : s.avg_gain / s.avg_loss;
+            s.out[0] = 100.0 - (100.0 / (1.0 + rs));
+        }
+    }
+    st.average_written.assign(st.averages.size(), 0);
+
+    for (size_t begin = st.position; begin < end; begin += kBlockSize) {
+        const size_t block_end = std::min(end, begin + kBlockSize);
+        // Return j and change j + 1 are both taken between prices j and j + 1
+        const size_t first = std::max<size_t>(begin, 1);
+
+        if (!st.volatilities.empty() && block_end > first) {
+            const size_t j0 = first - 1;
+            const size_t j1 = block_end - 1;
+            if (j1 - st.base > st.history + kBlockSize) {
+                std::memmove(returns, returns + (j0 - st.history - st.base), st.history * sizeof(double));
+                st.base = j0 - st.history;
+            }
+            for (size_t j = j0; j < j1; ++j) {
+                returns[j - st.base] = std::log(prices[j + 1] / prices[j]);
+            }
+            for (VolatilityState& s : st.volatilities) {
+                advance_volatility(s, returns, st.base, j0, j1);
+            }
+        }
+
+        if (!st.rsis.empty() && block_end > first) {
+            for (size_t t = first; t < block_end; ++t) {
+                changes[t - begin] = prices[t] - prices[t - 1];
+            }
+            for (RsiState& s : st.rsis) {
+                advance_rsi(s, changes, begin, first, block_end);
+            }
+        }
+
+        for (SmaState& s : st.smas) {
+            advance_sma(s, prices, begin, block_end);
+        }
+
+        // The scalar scan gives the same values however the series is split into calls
+        for (size_t r = 0; r < st.averages.size(); ++r) {
+            double* out = outs[st.average_index[r]] + st.average_written[r];
+            st.average_written[r] += st.averages[r].advance(prices, begin, block_end, out, SimdLevel::SCALAR);
+        }
+    }
+
+    st.position = std::max(st.position, end);
+    for (size_t k = 0; k < st.indicators.size(); ++k) {
+        const IndicatorSpec& spec = st.indicators[k];
+        st.produced[k] = indicator_output_size(spec.indicator, st.position, spec.window_size);
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef MOVING_AVERAGE_KERNEL_H
+#define MOVING_AVERAGE_KERNEL_H
+
+#include <cstddef>
+
+#include "finmath/Helper/simd.h"
+#include "finmath/TimeSeries/parallel_indicators.h"
+#include "finmath/TimeSeries/rolling_window.h"
+
+// Resumable EMA / DEMA / TEMA / WMA state shared by the batch functions in
+// moving_averages.h and IndicatorPipeline. Each advance() consumes the next prices of a
+// series and writes the values they complete, continuing from where the last call
+// stopped. The EMA scan runs on the SIMD kernels at `level`; with SCALAR the results do not
+// depend on how the series is split between calls.
+template <typename Real>
+class MovingAverageKernel {
+public:
+    // indicator must be EMA, DEMA, TEMA or WMA and span at least 1
+    MovingAverageKernel(IndicatorType indicator, size_t span);
+
+    // Consume data[begin..end), where data[0] is the first price of the series and begin is
+    // where the previous call ended. The new values go to out[0..); returns how many. WMA
+    // reads back up to span - 1 prices before begin.
+    size_t advance(const Real* data, size_t begin, size_t end, Real* out, SimdLevel level);
+
+private:
+    // One EMA level: a simple sum until span values have arrived, then the recurrence
+    struct EmaLevel {
+        size_t seen;
+        CompensatedSum<Real> sum;
+        Real value;
+    };
+
+    // Feed n values of one level, writing one value per input once seeded
+    size_t advance_level(EmaLevel& level, const Real* x, size_t n, Real* out, SimdLevel simd);
+    size_t advance_wma(const Real* data, size_t begin, size_t end, Real* out);
+
+    size_t span_;
+    Real alpha_;
+    int depth_;  // EMA levels: 1, 2 or 3 (0 for WMA)
+    EmaLevel levels_[3];
+
+    // WMA: window sum and weighted sum, rebuilt every period outputs
+    size_t period_;
+    size_t until_resync_;
+    Real inv_weights_;
+    CompensatedSum<Real> sum_;
+    CompensatedSum<Real> weighted_;
+};
+
+extern template class MovingAverageKernel<float>;
+extern template class MovingAverageKernel<double>;
+
+#endif // MOVING_AVERAGE_KERNEL_H
@@ -0,0 +1,384 @@
+#include "finmath/TimeSeries/moving_averages.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/simd.h"
+#include "moving_average_kernel.h"
+#include "moving_averages_simd.h"
+
+namespace {
+
+// Prices per block of moving_averages: the block stays in L1/L2 while every span walks it
+constexpr size_t kBlockSize = 2048;
+
+// DEMA / TEMA levels are run over chunks of this many prices, buffered on the stack
+constexpr size_t kLevelChunk = 256;
+
+// EMA recurrence over x[0..n) on the widest kernel available
+template <typename Real>
+void ema_scan(SimdLevel level, const Real* x, size_t n, Real alpha, Real& y, Real* out) {
+    switch (level) {
+        case SimdLevel::AVX512:
+            if (ema_scan_avx512(x, n, alpha, y, out)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::AVX2:
+            if (ema_scan_avx2(x, n, alpha, y, out)) {
+                return;
+            }
+            [[fallthrough]];
+        case SimdLevel::SCALAR:
+            break;
+    }
+
+    Real value = y;
+    for (size_t t = 0; t < n; ++t) {
+        value += alpha * (x[t] - value);
+        out[t] = value;
+    }
+    y = value;
+}
+
+int ema_depth(IndicatorType indicator) {
+    switch (indicator) {
+        case IndicatorType::EMA:
+            return 1;
+        case IndicatorType::DEMA:
+            return 2;
+        case IndicatorType::TEMA:
+            return 3;
+        case IndicatorType::WMA:
+            return 0;
+        default:
+            throw std::invalid_argument("Not a moving average indicator.");
+    }
+}
+
+bool is_moving_average(IndicatorType indicator) {
+    return indicator == IndicatorType::EMA || indicator == IndicatorType::DEMA || indicator == IndicatorType::TEMA ||
+           indicator == IndicatorType::WMA;
+}
+
+// Body of the pointer form of moving_averages, with the kernels drawn from resource
+template <typename Real>
+void run_moving_averages(IndicatorType indicator, const Real* data, size_t n, const size_t* spans, size_t count,
+                         Real* const* out, std::pmr::memory_resource* resource);
+
+// One span of one moving average, with the same error reporting as simple_moving_average
+template <typename Real>
+size_t single_moving_average(IndicatorType indicator, const Real* data, size_t n, size_t span, Real* out,
+                             std::pmr::memory_resource* resource) {
+    if (span == 0) {
+        std::cerr << "Window size must be greater than 0." << std::endl;
+        return 0;
+    }
+    size_t outputs = indicator_output_size(indicator, n, span);
+    if (outputs == 0) {
+        std::cerr << "Data size is smaller than the window size." << std::endl;
+        return 0;
+    }
+    run_moving_averages(indicator, data, n, &span, 1, &out, resource);
+    return outputs;
+}
+
+} // namespace
+
+// MovingAverageKernel
+
+template <typename Real>
+MovingAverageKernel<Real>::MovingAverageKernel(IndicatorType indicator, size_t span)
+    : span_(span), alpha_(static_cast<Real>(2) / static_cast<Real>(span + 1)),
+      depth_(ema_depth(indicator)), levels_(), period_(rolling_resync_period(span)),
+      until_resync_(rolling_resync_period(span) - 1),
+      inv_weights_(static_cast<Real>(2) / (static_cast<Real>(span) * static_cast<Real>(span + 1))), sum_(),
+      weighted_() {
+    for (EmaLevel& level : levels_) {
+        level = {0, CompensatedSum<Real>(), Real(0)};
+    }
+}
+
+template <typename Real>
+size_t MovingAverageKernel<Real>::advance_level(EmaLevel& level, const Real* x, size_t n, Real* out,
+                                                SimdLevel simd) {
+    size_t written = 0;
+    size_t i = 0;
+    for (; i < n && level.seen < span_; ++i) {
+        level.sum.add(x[i]);
+        if (++level.seen == span_) {
+            level.value = level.sum.value() / static_cast<Real>(span_);
+            out[written++] = level.value;
+        }
+    }
+    if (i < n) {
+        ema_scan(simd, x + i, n - i, alpha_, level.value, out + written);
+        written += n - i;
+    }
+    return written;
+}
+
+template <typename Real>
+size_t MovingAverageKernel<Real>::advance(const Real* data, size_t begin, size_t end, Real* out, SimdLevel level) {
+    if (depth_ == 0) {
+        return advance_wma(data, begin, end, out);
+    }
+    if (depth_ == 1) {
+        return advance_level(levels_[0], data + begin, end - begin, out, level);
+    }
+
+    // Each level's values for a chunk are the last ones of the level below, so the levels
+    // line up at the end of the chunk
+    Real e1[kLevelChunk];
+    Real e2[kLevelChunk];
+    Real e3[kLevelChunk];
+    size_t written = 0;
+    for (size_t t = begin; t < end; t += kLevelChunk) {
+        size_t c1 = advance_level(levels_[0], data + t, std::min(kLevelChunk, end - t), e1, level);
+        size_t c2 = advance_level(levels_[1], e1, c1, e2, level);
+        const Real* first = e1 + (c1 - c2);
+        if (depth_ == 2) {
+            for (size_t i = 0; i < c2; ++i) {
+                out[written + i] = static_cast<Real>(2) * first[i] - e2[i];
+            }
+            written += c2;
+        } else {
+            size_t c3 = advance_level(levels_[2], e2, c2, e3, level);
+            first += c2 - c3;
+            const Real* second = e2 + (c2 - c3);
+            for (size_t i = 0; i < c3; ++i) {
+                out[written + i] = static_cast<Real>(3) * (first[i] - second[i]) + e3[i];
+            }
+            written += c3;
+        }
+    }
+    return written;
+}
+
+template <typename Real>
+size_t MovingAverageKernel<Real>::advance_wma(const Real* data, size_t begin, size_t end, Real* out) {
+    // Running state in locals: out may alias the members' type, which would force reloads
+    const size_t w = span_;
+    const Real inv_weights = inv_weights_;
+    CompensatedSum<Real> sum = sum_;
+    CompensatedSum<Real> weighted = weighted_;
+    size_t until_resync = until_resync_;
+    size_t written = 0;
+
+    size_t t = begin;
+    for (; t < end && t < w; ++t) {
+        sum.add(data[t]);
+        weighted.add(static_cast<Real>(t + 1) * data[t]);
+        if (t + 1 == w) {
+            out[written++] = weighted.value() * inv_weights;
+        }
+    }
+    for (; t < end; ++t) {
+        size_t i = t + 1 - w;
+        if (until_resync == 0) {
+            sum = CompensatedSum<Real>();
+            weighted = CompensatedSum<Real>();
+            for (size_t j = i; j <= t; ++j) {
+                sum.add(data[j]);
+                weighted.add(static_cast<Real>(j - i + 1) * data[j]);
+            }
+            until_resync = period_;
+        } else {
+            // Every weight drops by one as the window slides: subtract the old window sum
+            weighted.add(static_cast<Real>(w) * data[t] - sum.value());
+            sum.add(data[t] - data[i - 1]);
+        }
+        --until_resync;
+        out[written++] = weighted.value() * inv_weights;
+    }
+
+    sum_ = sum;
+    weighted_ = weighted;
+    until_resync_ = until_resync;
+    return written;
+}
+
+template class MovingAverageKernel<float>;
+template class MovingAverageKernel<double>;
+
+// Batch functions
+
+namespace {
+
+template <typename Real>
+void run_moving_averages(IndicatorType indicator, const Real* data, size_t n, const size_t* spans, size_t count,
+                         Real* const* out, std::pmr::memory_resource* resource) {
+    if (!is_moving_average(indicator)) {
+        std::cerr << "moving_averages computes EMA, DEMA, TEMA or WMA." << std::endl;
+        return;
+    }
+    for (size_t k = 0; k < count; ++k) {
+        if (spans[k] == 0) {
+            std::cerr << "Window size must be greater than 0." << std::endl;
+            return;
+        }
+    }
+
+    std::pmr::vector<MovingAverageKernel<Real>> kernels(resource);
+    kernels.reserve(count);
+    for (size_t k = 0; k < count; ++k) {
+        kernels.emplace_back(indicator, spans[k]);
+    }
+    std::pmr::vector<size_t> written(count, 0, resource);
+    const SimdLevel level = active_simd_level();
+    for (size_t begin = 0; begin < n; begin += kBlockSize) {
+        const size_t end = std::min(n, begin + kBlockSize);
+        for (size_t k = 0; k < count; ++k) {
+            written[k] += kernels[k].advance(data, begin, end, out[k] + written[k], level);
+        }
+    }
+}
+
+} // namespace
+
+template <typename Real>
+void moving_averages(IndicatorType indicator, const Real* data, size_t n, const size_t* spans, size_t count,
+                     Real* const* out) {
+    FINMATH_INSTRUMENT_SAMPLED("moving_averages", n * count);
+    run_moving_averages(indicator, data, n, spans, count, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+void moving_averages(IndicatorType indicator, const Real* data, size_t n, const size_t* spans, size_t count,
+                     Real* const* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("moving_averages", n * count);
+    ScratchArena::Scope scope(arena);
+    run_moving_averages(indicator, data, n, spans, count, out, &arena);
+}
+
+template <typename Real>
+std::vector<std::vector<Real>> moving_averages(IndicatorType indicator, const std::vector<Real>& data,
+                                               const std::vector<size_t>& spans) {
+    std::vector<std::vector<Real>> result(spans.size());
+    std::vector<Real*> outs(spans.size());
+    for (size_t k = 0; k < spans.size(); ++k) {
+        result[k].resize(indicator_output_size(indicator, data.size(), spans[k]));
+        outs[k] = result[k].data();
+    }
+    moving_averages(indicator, data.data(), data.size(), spans.data(), spans.size(), outs.data());
+    return result;
+}
+
+template <typename Real>
+std::vector<Real> exponential_moving_average(const std::vector<Real>& data, size_t span) {
+    std::vector<Real> values(ema_output_size(data.size(), span));
+    exponential_moving_average(data.data(), data.size(), span, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t exponential_moving_average(const Real* data, size_t n, size_t span, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("exponential_moving_average", n);
+    return single_moving_average(IndicatorType::EMA, data, n, span, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t exponential_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("exponential_moving_average", n);
+    ScratchArena::Scope scope(arena);
+    return single_moving_average(IndicatorType::EMA, data, n, span, out, &arena);
+}
+
+template <typename Real>
+std::vector<Real> double_exponential_moving_average(const std::vector<Real>& data, size_t span) {
+    std::vector<Real> values(dema_output_size(data.size(), span));
+    double_exponential_moving_average(data.data(), data.size(), span, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t double_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("double_exponential_moving_average", n);
+    return single_moving_average(IndicatorType::DEMA, data, n, span, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t double_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("double_exponential_moving_average", n);
+    ScratchArena::Scope scope(arena);
+    return single_moving_average(IndicatorType::DEMA, data, n, span, out, &arena);
+}
+
+template <typename Real>
+std::vector<Real> triple_exponential_moving_average(const std::vector<Real>& data, size_t span) {
+    std::vector<Real> values(tema_output_size(data.size(), span));
+    triple_exponential_moving_average(data.data(), data.size(), span, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t triple_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("triple_exponential_moving_average", n);
+    return single_moving_average(IndicatorType::TEMA, data, n, span, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t triple_exponential_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("triple_exponential_moving_average", n);
+    ScratchArena::Scope scope(arena);
+    return single_moving_average(IndicatorType::TEMA, data, n, span, out, &arena);
+}
+
+template <typename Real>
+std::vector<Real> weighted_moving_average(const std::vector<Real>& data, size_t span) {
+    std::vector<Real> values(wma_output_size(data.size(), span));
+    weighted_moving_average(data.data(), data.size(), span, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t weighted_moving_average(const Real* data, size_t n, size_t span, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("weighted_moving_average", n);
+    return single_moving_average(IndicatorType::WMA, data, n, span, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t weighted_moving_average(const Real* data, size_t n, size_t span, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("weighted_moving_average", n);
+    ScratchArena::Scope scope(arena);
+    return single_moving_average(IndicatorType::WMA, data, n, span, out, &arena);
+}
+
+template void moving_averages<float>(IndicatorType, const float*, size_t, const size_t*, size_t, float* const*);
+template void moving_averages<double>(IndicatorType, const double*, size_t, const size_t*, size_t, double* const*);
+template void moving_averages<float>(IndicatorType, const float*, size_t, const size_t*, size_t, float* const*,
+                                    ScratchArena&);
+template void moving_averages<double>(IndicatorType, const double*, size_t, const size_t*, size_t, double* const*,
+                                     ScratchArena&);
+template std::vector<std::vector<float>> moving_averages<float>(IndicatorType, const std::vector<float>&,
+                                                                const std::vector<size_t>&);
+template std::vector<std::vector<double>> moving_averages<double>(IndicatorType, const std::vector<double>&,
+                                                                  const std::vector<size_t>&);
+template std::vector<float> exponential_moving_average<float>(const std::vector<float>&, size_t);
+template std::vector<double> exponential_moving_average<double>(const std::vector<double>&, size_t);
+template size_t exponential_moving_average<float>(const float*, size_t, size_t, float*);
+template size_t exponential_moving_average<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t exponential_moving_average<double>(const double*, size_t, size_t, double*);
+template size_t exponential_moving_average<double>(const double*, size_t, size_t, double*, ScratchArena&);
+template std::vector<float> double_exponential_moving_average<float>(const std::vector<float>&, size_t);
+template std::vector<double> double_exponential_moving_average<double>(const std::vector<double>&, size_t);
+template size_t double_exponential_moving_average<float>(const float*, size_t, size_t, float*);
+template size_t double_exponential_moving_average<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t double_exponential_moving_average<double>(const double*, size_t, size_t, double*);
+template size_t double_exponential_moving_average<double>(const double*, size_t, size_t, double*, ScratchArena&);
+template std::vector<float> triple_exponential_moving_average<float>(const std::vector<float>&, size_t);
+template std::vector<double> triple_exponential_moving_average<double>(const std::vector<double>&, size_t);
+template size_t triple_exponential_moving_average<float>(const float*, size_t, size_t, float*);
+template size_t triple_exponential_moving_average<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t triple_exponential_moving_average<double>(const double*, size_t, size_t, double*);
+template size_t triple_exponential_moving_average<double>(const double*, size_t, size_t, double*, ScratchArena&);
+template std::vector<float> weighted_moving_average<float>(const std::vector<float>&, size_t);
+template std::vector<double> weighted_moving_average<double>(const std::vector<double>&, size_t);
+template size_t weighted_moving_average<float>(const float*, size_t, size_t, float*);
+template size_t weighted_moving_average<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t weighted_moving_average<double>(const double*, size_t, size_t, double*);
+template size_t weighted_moving_average<double>(const double*, size_t, size_t, double*, ScratchArena&);
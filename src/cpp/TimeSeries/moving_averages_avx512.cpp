@@ -0,0 +1,23 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime CPU detection
+#define MOVING_AVERAGES_SIMD_KERNEL
+#include "moving_averages_simd.h"
+
+bool ema_scan_avx512(const double* x, size_t n, double alpha, double& y, double* out) {
+#if defined(__AVX512F__)
+    ema_scan_kernel<VecAVX512>(x, n, alpha, y, out);
+    return true;
+#else
+    (void)x, (void)n, (void)alpha, (void)y, (void)out;
+    return false;
+#endif
+}
+
+bool ema_scan_avx512(const float* x, size_t n, float alpha, float& y, float* out) {
+#if defined(__AVX512F__)
+    ema_scan_kernel<VecAVX512f>(x, n, alpha, y, out);
+    return true;
+#else
+    (void)x, (void)n, (void)alpha, (void)y, (void)out;
+    return false;
+#endif
+}
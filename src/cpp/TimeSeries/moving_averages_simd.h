@@ -0,0 +1,75 @@
+#ifndef MOVING_AVERAGES_SIMD_H
+#define MOVING_AVERAGES_SIMD_H
+
+#include <cstddef>
+
+// Instruction-set specific kernels for the EMA recurrence
+//     y[t] = y[t - 1] + alpha (x[t] - y[t - 1]),  t = 0..n-1,
+// starting from y[-1] = y. The values go to out and the last one is left in y. Each
+// returns false when its translation unit was built without the matching compiler flags.
+
+bool ema_scan_avx2(const double* x, size_t n, double alpha, double& y, double* out);
+bool ema_scan_avx512(const double* x, size_t n, double alpha, double& y, double* out);
+bool ema_scan_avx2(const float* x, size_t n, float alpha, float& y, float* out);
+bool ema_scan_avx512(const float* x, size_t n, float alpha, float& y, float* out);
+
+#ifdef MOVING_AVERAGES_SIMD_KERNEL
+
+#include "../Helper/simd_vec.h"
+
+namespace {
+
+// Unrolled, the recurrence over a block of width values is a matrix-vector product:
+//     y[j] = beta^(j+1) y[-1] + sum_{i <= j} alpha beta^(j-i) x[i],  beta = 1 - alpha.
+// The sum does not depend on earlier blocks, so only the final multiply-add with the
+// previous block's last value is serial, instead of one dependent step per value.
+template <typename V, typename Real = typename V::Scalar>
+void ema_scan_kernel(const Real* x, size_t n, Real alpha, Real& y, Real* out) {
+    constexpr size_t width = V::width;
+
+    // Weights of x[i] (column i) and of y[-1] (carry); the powers are taken in double
+    const double beta = 1.0 - static_cast<double>(alpha);
+    double powers[width + 1];
+    powers[0] = 1.0;
+    for (size_t k = 1; k <= width; ++k) {
+        powers[k] = powers[k - 1] * beta;
+    }
+    alignas(64) Real lane[width];
+    V column[width];
+    for (size_t i = 0; i < width; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            lane[j] = j >= i ? static_cast<Real>(static_cast<double>(alpha) * powers[j - i]) : Real(0);
+        }
+        column[i] = V::load(lane);
+    }
+    for (size_t j = 0; j < width; ++j) {
+        lane[j] = static_cast<Real>(powers[j + 1]);
+    }
+    const V carry = V::load(lane);
+
+    Real value = y;
+    size_t t = 0;
+    for (; t + width <= n; t += width) {
+        // Two partial sums halve the length of the block's own chain
+        V even = column[0] * V::set1(x[t]);
+        V odd = column[1] * V::set1(x[t + 1]);
+        for (size_t i = 2; i < width; i += 2) {
+            even = vfma(column[i], V::set1(x[t + i]), even);
+            odd = vfma(column[i + 1], V::set1(x[t + i + 1]), odd);
+        }
+        V::store(out + t, vfma(carry, V::set1(value), even + odd));
+        value = out[t + width - 1];
+    }
+
+    for (; t < n; ++t) {
+        value += alpha * (x[t] - value);
+        out[t] = value;
+    }
+    y = value;
+}
+
+} // namespace
+
+#endif // MOVING_AVERAGES_SIMD_KERNEL
+
+#endif // MOVING_AVERAGES_SIMD_H
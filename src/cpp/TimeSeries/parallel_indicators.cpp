@@ -0,0 +1,107 @@
+#include "finmath/TimeSeries/parallel_indicators.h"
+
+#include <numeric>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/TimeSeries/moving_averages.h"
+#include "finmath/TimeSeries/rolling_volatility.h"
+#include "finmath/TimeSeries/rolling_window.h"
+#include "finmath/TimeSeries/rsi.h"
+#include "finmath/TimeSeries/simple_moving_average.h"
+
+size_t indicator_output_size(IndicatorType indicator, size_t n, size_t window_size) {
+    switch (indicator) {
+        case IndicatorType::SMA:
+            return rolling_output_size(n, window_size);
+        case IndicatorType::VOLATILITY:
+            return rolling_volatility_output_size(n, window_size);
+        case IndicatorType::RSI:
+            return rsi_output_size(n);
+        case IndicatorType::EMA:
+            return ema_output_size(n, window_size);
+        case IndicatorType::DEMA:
+            return dema_output_size(n, window_size);
+        case IndicatorType::TEMA:
+            return tema_output_size(n, window_size);
+        case IndicatorType::WMA:
+            return wma_output_size(n, window_size);
+    }
+    return 0;
+}
+
+template <typename Real>
+size_t compute_indicator(IndicatorType indicator, const Real* prices, size_t n, size_t window_size, Real* out) {
+    switch (indicator) {
+        case IndicatorType::SMA:
+            return simple_moving_average(prices, n, window_size, out);
+        case IndicatorType::VOLATILITY:
+            return rolling_volatility(prices, n, window_size, out);
+        case IndicatorType::RSI:
+            return compute_rsi(prices, n, window_size, out);
+        case IndicatorType::EMA:
+            return exponential_moving_average(prices, n, window_size, out);
+        case IndicatorType::DEMA:
+            return double_exponential_moving_average(prices, n, window_size, out);
+        case IndicatorType::TEMA:
+            return triple_exponential_moving_average(prices, n, window_size, out);
+        case IndicatorType::WMA:
+            return weighted_moving_average(prices, n, window_size, out);
+    }
+    return 0;
+}
+
+template <typename Real>
+size_t compute_indicator(IndicatorType indicator, const Real* prices, size_t n, size_t window_size, Real* out,
+                         ScratchArena& arena) {
+    switch (indicator) {
+        case IndicatorType::SMA:
+            return simple_moving_average(prices, n, window_size, out);
+        case IndicatorType::VOLATILITY:
+            return rolling_volatility(prices, n, window_size, out, arena);
+        case IndicatorType::RSI:
+            return compute_rsi(prices, n, window_size, out);
+        case IndicatorType::EMA:
+            return exponential_moving_average(prices, n, window_size, out, arena);
+        case IndicatorType::DEMA:
+            return double_exponential_moving_average(prices, n, window_size, out, arena);
+        case IndicatorType::TEMA:
+            return triple_exponential_moving_average(prices, n, window_size, out, arena);
+        case IndicatorType::WMA:
+            return weighted_moving_average(prices, n, window_size, out, arena);
+    }
+    return 0;
+}
+
+template size_t compute_indicator<float>(IndicatorType, const float*, size_t, size_t, float*);
+template size_t compute_indicator<double>(IndicatorType, const double*, size_t, size_t, double*);
+template size_t compute_indicator<float>(IndicatorType, const float*, size_t, size_t, float*, ScratchArena&);
+template size_t compute_indicator<double>(IndicatorType, const double*, size_t, size_t, double*, ScratchArena&);
+
+std::vector<std::vector<double>> parallel_indicators(const std::vector<std::vector<double>>& series,
+                                                     IndicatorType indicator, size_t window_size,
+                                                     ThreadPool& pool) {
+    FINMATH_INSTRUMENT("parallel_indicators", std::accumulate(series.begin(), series.end(), size_t(0),
+                                                              [](size_t total, const std::vector<double>& s) {
+                                                                  return total + s.size();
+                                                              }));
+    // Every worker writes only its own slots, so no synchronization is needed on the output
+    std::vector<std::vector<double>> result(series.size());
+    pool.parallel_for(series.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            result[i].resize(indicator_output_size(indicator, series[i].size(), window_size));
+            compute_indicator(indicator, series[i].data(), series[i].size(), window_size, result[i].data());
+        }
+    });
+    return result;
+}
+
+void parallel_indicators(const double* const* series, const size_t* lengths, size_t count, IndicatorType indicator,
+                         size_t window_size, double* const* out, ThreadPool& pool) {
+    FINMATH_INSTRUMENT("parallel_indicators", std::accumulate(lengths, lengths + count, size_t(0)));
+    pool.parallel_for(count, 1, [&](size_t begin, size_t end) {
+        thread_local ScratchArena arena;
+        for (size_t i = begin; i < end; ++i) {
+            compute_indicator(indicator, series[i], lengths[i], window_size, out[i], arena);
+        }
+    });
+}
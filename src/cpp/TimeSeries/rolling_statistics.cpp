@@ -0,0 +1,682 @@
+#include "finmath/TimeSeries/rolling_statistics.h"
+#include "finmath/Helper/instrumentation.h"
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// The head node; a link to it marks the end of a level
+constexpr uint32_t kNil = 0;
+
+// Levels of the skip list: enough for 2^32 values at one level per power of two
+constexpr size_t kMaxLevels = 32;
+
+constexpr uint64_t kSkipListSeed = 0x9E3779B97F4A7C15ULL;
+
+// Variances below (kZeroVarianceUlps * epsilon * |mean|)^2 are rounding noise
+constexpr int kZeroVarianceUlps = 16;
+
+// splitmix64: a cheap, well-mixed generator for the node heights
+uint64_t next_random(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+bool check_window(size_t n, size_t window_size) {
+    if (window_size == 0) {
+        std::cerr << "Window size must be greater than 0." << std::endl;
+        return false;
+    }
+
+    if (n < window_size) {
+        std::cerr << "Data size is smaller than the window size." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename Compare, typename Real>
+size_t rolling_extremum(const Real* data, size_t n, size_t window_size, Real* out,
+                        std::pmr::memory_resource* resource) {
+    if (!check_window(n, window_size)) {
+        return 0;
+    }
+
+    MonotonicWindow<Real, Compare> window(window_size, resource);
+    for (size_t i = 0; i + 1 < window_size; ++i) {
+        window.push(data[i]);
+    }
+    for (size_t i = window_size - 1; i < n; ++i) {
+        window.push(data[i]);
+        out[i + 1 - window_size] = window.value();
+    }
+    return rolling_output_size(n, window_size);
+}
+
+template <typename Real>
+size_t run_quantiles(const Real* data, size_t n, size_t window_size, const double* qs, size_t count,
+                     Real* const* out, std::pmr::memory_resource* resource) {
+    if (!check_window(n, window_size)) {
+        return 0;
+    }
+
+    for (size_t k = 0; k < count; ++k) {
+        if (!(qs[k] >= 0.0 && qs[k] <= 1.0)) {
+            std::cerr << "Quantiles must lie between 0 and 1." << std::endl;
+            return 0;
+        }
+    }
+
+    BasicOrderStatistics<Real> sorted(window_size, resource);
+    for (size_t i = 0; i < window_size; ++i) {
+        sorted.insert(data[i]);
+    }
+
+    size_t outputs = rolling_output_size(n, window_size);
+    for (size_t i = 0;; ++i) {
+        for (size_t k = 0; k < count; ++k) {
+            out[k][i] = sorted.quantile(qs[k]);
+        }
+        if (i + 1 == outputs) {
+            break;
+        }
+        if (data[i] != data[i + window_size]) {
+            sorted.erase(data[i]);
+            sorted.insert(data[i + window_size]);
+        }
+    }
+    return outputs;
+}
+
+// Slide higher moments over data[0..n), writing statistic(moments) for every window
+template <typename Real, typename Statistic>
+size_t rolling_higher_moment(const Real* data, size_t n, size_t window_size, Real* out, Statistic statistic) {
+    if (!check_window(n, window_size)) {
+        return 0;
+    }
+
+    size_t outputs = rolling_output_size(n, window_size);
+    const size_t period = rolling_resync_period(window_size);
+
+    BasicRollingHigherMoments<Real> moments(window_size);
+    moments.resync(data, window_size);
+    out[0] = statistic(moments);
+
+    size_t until_resync = period - 1;
+    for (size_t i = 1; i < outputs; ++i) {
+        if (until_resync == 0) {
+            moments.resync(data + i, window_size);
+            until_resync = period;
+        } else {
+            moments.slide(data[i + window_size - 1], data[i - 1]);
+            if (moments.drifted()) {
+                moments.resync(data + i, window_size);
+                until_resync = period;
+            }
+        }
+        --until_resync;
+        out[i] = statistic(moments);
+    }
+    return outputs;
+}
+
+} // namespace
+
+// BasicOrderStatistics
+
+template <typename Real>
+BasicOrderStatistics<Real>::BasicOrderStatistics(size_t capacity, std::pmr::memory_resource* resource)
+    : levels_(1), size_(0), values_(resource), offsets_(resource), heights_(resource), links_(resource),
+      free_(resource), chain_(resource), steps_(resource) {
+    if (capacity >= std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Order statistics capacity must fit in 32 bits.");
+    }
+
+    // One level per power of two of the capacity
+    while (levels_ < kMaxLevels && (size_t(1) << levels_) <= capacity) {
+        ++levels_;
+    }
+
+    values_.resize(capacity + 1);
+    offsets_.resize(capacity + 1);
+    heights_.resize(capacity + 1);
+    uint64_t state = kSkipListSeed;
+    size_t total = 0;
+    for (size_t node = 0; node <= capacity; ++node) {
+        // Each level above the first is kept with probability 1/2; the head has them all
+        size_t height = 1;
+        if (node == kNil) {
+            height = levels_;
+        } else {
+            for (uint64_t bits = next_random(state); (bits & 1) != 0 && height < levels_; bits >>= 1) {
+                ++height;
+            }
+        }
+        heights_[node] = static_cast<uint8_t>(height);
+        offsets_[node] = total;
+        total += height;
+    }
+    links_.resize(total);
+    chain_.resize(levels_);
+    steps_.resize(levels_);
+    free_.reserve(capacity);
+    clear();
+}
+
+template <typename Real>
+void BasicOrderStatistics<Real>::clear() {
+    size_ = 0;
+    Link* head = links(kNil);
+    for (size_t level = 0; level < levels_; ++level) {
+        head[level] = {kNil, 1};
+    }
+    free_.clear();
+    for (size_t node = capacity(); node > 0; --node) {
+        free_.push_back(static_cast<uint32_t>(node));
+    }
+}
+
+template <typename Real>
+void BasicOrderStatistics<Real>::insert(Real x) {
+    if (free_.empty()) {
+        throw std::length_error("Order statistics are full.");
+    }
+    uint32_t node = free_.back();
+    free_.pop_back();
+    values_[node] = x;
+
+    // Find the last node at or below x on every level, counting the values passed
+    uint32_t current = kNil;
+    for (size_t level = levels_; level-- > 0;) {
+        steps_[level] = 0;
+        for (;;) {
+            const Link& link = links(current)[level];
+            if (link.next == kNil || values_[link.next] > x) {
+                break;
+            }
+            steps_[level] += link.width;
+            current = link.next;
+        }
+        chain_[level] = current;
+    }
+
+    // Splice the node in on its own levels; links passing over it get one wider
+    const size_t height = heights_[node];
+    Link* own = links(node);
+    size_t steps = 0;
+    for (size_t level = 0; level < height; ++level) {
+        Link& previous = links(chain_[level])[level];
+        own[level] = {previous.next, static_cast<uint32_t>(previous.width - steps)};
+        previous = {node, static_cast<uint32_t>(steps + 1)};
+        steps += steps_[level];
+    }
+    for (size_t level = height; level < levels_; ++level) {
+        ++links(chain_[level])[level].width;
+    }
+    ++size_;
+}
+
+template <typename Real>
+bool BasicOrderStatistics<Real>::erase(Real x) {
+    // Find the last node below x on every level
+    uint32_t current = kNil;
+    for (size_t level = levels_; level-- > 0;) {
+        for (;;) {
+            uint32_t next = links(current)[level].next;
+            if (next == kNil || !(values_[next] < x)) {
+                break;
+            }
+            current = next;
+        }
+        chain_[level] = current;
+    }
+
+    // The first copy of x follows on the bottom level, and on every level it takes part in
+    uint32_t node = links(chain_[0])[0].next;
+    if (node == kNil || values_[node] != x) {
+        return false;
+    }
+
+    const size_t height = heights_[node];
+    const Link* own = links(node);
+    for (size_t level = 0; level < height; ++level) {
+        Link& previous = links(chain_[level])[level];
+        previous = {own[level].next, previous.width + own[level].width - 1};
+    }
+    for (size_t level = height; level < levels_; ++level) {
+        --links(chain_[level])[level].width;
+    }
+    free_.push_back(node);
+    --size_;
+    return true;
+}
+
+template <typename Real>
+uint32_t BasicOrderStatistics<Real>::node_at(size_t rank) const {
+    // Walk down from the top level, taking every link that does not pass rank
+    size_t remaining = rank + 1;
+    uint32_t current = kNil;
+    for (size_t level = levels_; level-- > 0;) {
+        for (;;) {
+            const Link& link = links(current)[level];
+            if (link.next == kNil || link.width > remaining) {
+                break;
+            }
+            remaining -= link.width;
+            current = link.next;
+        }
+    }
+    return current;
+}
+
+template <typename Real>
+Real BasicOrderStatistics<Real>::operator[](size_t rank) const {
+    return values_[node_at(rank)];
+}
+
+template <typename Real>
+Real BasicOrderStatistics<Real>::quantile(double q) const {
+    const double position = q * static_cast<double>(size_ - 1);
+    const size_t lower = static_cast<size_t>(position);
+    if (lower + 1 >= size_) {
+        return (*this)[size_ - 1];
+    }
+
+    // The value of the next rank follows on the bottom level
+    uint32_t node = node_at(lower);
+    Real low = values_[node];
+    Real fraction = static_cast<Real>(position - static_cast<double>(lower));
+    if (fraction == 0) {
+        return low;
+    }
+    Real high = values_[links(node)[0].next];
+    return low + (high - low) * fraction;
+}
+
+template class BasicOrderStatistics<float>;
+template class BasicOrderStatistics<double>;
+
+// BasicRollingHigherMoments
+
+template <typename Real>
+BasicRollingHigherMoments<Real>::BasicRollingHigherMoments(size_t window_size)
+    : window_size_(window_size), count_(0), shift_(0) {}
+
+template <typename Real>
+void BasicRollingHigherMoments<Real>::reset() {
+    count_ = 0;
+    shift_ = 0;
+    for (CompensatedSum<Real>& sum : sums_) {
+        sum = CompensatedSum<Real>();
+    }
+}
+
+template <typename Real>
+void BasicRollingHigherMoments<Real>::push(Real x) {
+    if (count_ == 0) {
+        shift_ = x;
+    }
+    ++count_;
+    Real d = x - shift_;
+    Real d2 = d * d;
+    sums_[0].add(d);
+    sums_[1].add(d2);
+    sums_[2].add(d2 * d);
+    sums_[3].add(d2 * d2);
+}
+
+template <typename Real>
+void BasicRollingHigherMoments<Real>::slide(Real x_in, Real x_out) {
+    Real d_in = x_in - shift_;
+    Real d_out = x_out - shift_;
+    Real in2 = d_in * d_in;
+    Real out2 = d_out * d_out;
+    sums_[0].add(d_in - d_out);
+    sums_[1].add(in2 - out2);
+    sums_[2].add(in2 * d_in - out2 * d_out);
+    sums_[3].add(in2 * in2 - out2 * out2);
+}
+
+template <typename Real>
+void BasicRollingHigherMoments<Real>::resync(const Real* window, size_t count) {
+    reset();
+    if (count == 0) {
+        return;
+    }
+
+    CompensatedSum<Real> sum;
+    for (size_t i = 0; i < count; ++i) {
+        sum.add(window[i]);
+    }
+    shift_ = sum.value() / static_cast<Real>(count);
+    count_ = count;
+    for (size_t i = 0; i < count; ++i) {
+        Real d = window[i] - shift_;
+        Real d2 = d * d;
+        sums_[0].add(d);
+        sums_[1].add(d2);
+        sums_[2].add(d2 * d);
+        sums_[3].add(d2 * d2);
+    }
+}
+
+template <typename Real>
+void BasicRollingHigherMoments<Real>::restore(size_t count, Real shift, Real sum1, Real sum2, Real sum3,
+                                              Real sum4) {
+    count_ = count;
+    shift_ = shift;
+    sums_[0] = CompensatedSum<Real>(sum1);
+    sums_[1] = CompensatedSum<Real>(sum2);
+    sums_[2] = CompensatedSum<Real>(sum3);
+    sums_[3] = CompensatedSum<Real>(sum4);
+}
+
+template <typename Real>
+bool BasicRollingHigherMoments<Real>::drifted() const {
+    // (s1 / n)^2 > 4 (s2 / n - (s1 / n)^2), without the divisions
+    const Real s1 = power_sum(1);
+    return 5 * s1 * s1 > 4 * static_cast<Real>(count_) * power_sum(2);
+}
+
+template <typename Real>
+Real BasicRollingHigherMoments<Real>::mean() const {
+    return count_ == 0 ? shift_ : shift_ + power_sum(1) / static_cast<Real>(count_);
+}
+
+template <typename Real>
+bool BasicRollingHigherMoments<Real>::central_moments(Real& m2, Real& m3, Real& m4) const {
+    const Real n = static_cast<Real>(count_);
+    const Real d = power_sum(1) / n;
+    const Real a2 = power_sum(2) / n;
+    const Real a3 = power_sum(3) / n;
+    const Real a4 = power_sum(4) / n;
+    const Real d2 = d * d;
+    m2 = a2 - d2;
+    m3 = a3 - 3 * d * a2 + 2 * d2 * d;
+    m4 = a4 - 4 * d * a3 + 6 * d2 * a2 - 3 * d2 * d2;
+
+    // a2 - d^2 cancels to about epsilon a2 when the shift is far from the mean
+    const Real tolerance = kZeroVarianceUlps * std::numeric_limits<Real>::epsilon();
+    const Real floor = tolerance * mean();
+    return m2 > tolerance * a2 + floor * floor;
+}
+
+template <typename Real>
+Real BasicRollingHigherMoments<Real>::variance() const {
+    if (count_ == 0) {
+        return 0;
+    }
+    Real m2;
+    Real m3;
+    Real m4;
+    return central_moments(m2, m3, m4) ? m2 : Real(0);
+}
+
+template <typename Real>
+Real BasicRollingHigherMoments<Real>::skewness() const {
+    Real m2;
+    Real m3;
+    Real m4;
+    if (count_ < 3 || !central_moments(m2, m3, m4)) {
+        return std::numeric_limits<Real>::quiet_NaN();
+    }
+    const Real n = static_cast<Real>(count_);
+    return std::sqrt(n * (n - 1)) / (n - 2) * m3 / (m2 * std::sqrt(m2));
+}
+
+template <typename Real>
+Real BasicRollingHigherMoments<Real>::kurtosis() const {
+    Real m2;
+    Real m3;
+    Real m4;
+    if (count_ < 4 || !central_moments(m2, m3, m4)) {
+        return std::numeric_limits<Real>::quiet_NaN();
+    }
+    const Real n = static_cast<Real>(count_);
+    return ((n * n - 1) * m4 / (m2 * m2) - 3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
+}
+
+template class BasicRollingHigherMoments<float>;
+template class BasicRollingHigherMoments<double>;
+
+template <typename Real>
+Real window_zscore(const BasicRollingMoments<Real>& moments, Real x) {
+    const size_t count = moments.count();
+    if (count < 2) {
+        return std::numeric_limits<Real>::quiet_NaN();
+    }
+    const Real mean = moments.mean();
+    const Real variance = moments.m2() / static_cast<Real>(count - 1);
+    const Real floor = kZeroVarianceUlps * std::numeric_limits<Real>::epsilon() * mean;
+    if (!(variance > floor * floor)) {
+        return std::numeric_limits<Real>::quiet_NaN();
+    }
+    return (x - mean) / std::sqrt(variance);
+}
+
+// Batch functions
+
+template <typename Real>
+std::vector<Real> rolling_max(const std::vector<Real>& data, size_t window_size) {
+    std::vector<Real> values(rolling_output_size(data.size(), window_size));
+    rolling_max(data.data(), data.size(), window_size, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t rolling_max(const Real* data, size_t n, size_t window_size, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_max", n);
+    return rolling_extremum<std::greater<Real>>(data, n, window_size, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t rolling_max(const Real* data, size_t n, size_t window_size, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_max", n);
+    ScratchArena::Scope scope(arena);
+    return rolling_extremum<std::greater<Real>>(data, n, window_size, out, &arena);
+}
+
+template <typename Real>
+std::vector<Real> rolling_min(const std::vector<Real>& data, size_t window_size) {
+    std::vector<Real> values(rolling_output_size(data.size(), window_size));
+    rolling_min(data.data(), data.size(), window_size, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t rolling_min(const Real* data, size_t n, size_t window_size, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_min", n);
+    return rolling_extremum<std::less<Real>>(data, n, window_size, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t rolling_min(const Real* data, size_t n, size_t window_size, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_min", n);
+    ScratchArena::Scope scope(arena);
+    return rolling_extremum<std::less<Real>>(data, n, window_size, out, &arena);
+}
+
+template <typename Real>
+std::vector<Real> rolling_quantile(const std::vector<Real>& data, size_t window_size, double q) {
+    std::vector<Real> values(rolling_output_size(data.size(), window_size));
+    values.resize(rolling_quantile(data.data(), data.size(), window_size, q, values.data()));
+    return values;
+}
+
+template <typename Real>
+size_t rolling_quantile(const Real* data, size_t n, size_t window_size, double q, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_quantile", n);
+    return run_quantiles(data, n, window_size, &q, 1, &out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t rolling_quantile(const Real* data, size_t n, size_t window_size, double q, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_quantile", n);
+    ScratchArena::Scope scope(arena);
+    return run_quantiles(data, n, window_size, &q, 1, &out, &arena);
+}
+
+template <typename Real>
+std::vector<Real> rolling_median(const std::vector<Real>& data, size_t window_size) {
+    return rolling_quantile(data, window_size, 0.5);
+}
+
+template <typename Real>
+size_t rolling_median(const Real* data, size_t n, size_t window_size, Real* out) {
+    return rolling_quantile(data, n, window_size, 0.5, out);
+}
+
+template <typename Real>
+size_t rolling_median(const Real* data, size_t n, size_t window_size, Real* out, ScratchArena& arena) {
+    return rolling_quantile(data, n, window_size, 0.5, out, arena);
+}
+
+template <typename Real>
+size_t rolling_quantiles(const Real* data, size_t n, size_t window_size, const double* qs, size_t count,
+                         Real* const* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_quantiles", n * count);
+    return run_quantiles(data, n, window_size, qs, count, out, std::pmr::get_default_resource());
+}
+
+template <typename Real>
+size_t rolling_quantiles(const Real* data, size_t n, size_t window_size, const double* qs, size_t count,
+                         Real* const* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_quantiles", n * count);
+    ScratchArena::Scope scope(arena);
+    return run_quantiles(data, n, window_size, qs, count, out, &arena);
+}
+
+template <typename Real>
+std::vector<std::vector<Real>> rolling_quantiles(const std::vector<Real>& data, size_t window_size,
+                                                 const std::vector<double>& qs) {
+    std::vector<std::vector<Real>> values(qs.size(), std::vector<Real>(rolling_output_size(data.size(), window_size)));
+    std::vector<Real*> out(qs.size());
+    for (size_t k = 0; k < qs.size(); ++k) {
+        out[k] = values[k].data();
+    }
+    size_t written = rolling_quantiles(data.data(), data.size(), window_size, qs.data(), qs.size(), out.data());
+    for (std::vector<Real>& quantile : values) {
+        quantile.resize(written);
+    }
+    return values;
+}
+
+template <typename Real>
+std::vector<Real> rolling_skewness(const std::vector<Real>& data, size_t window_size) {
+    std::vector<Real> values(rolling_output_size(data.size(), window_size));
+    rolling_skewness(data.data(), data.size(), window_size, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t rolling_skewness(const Real* data, size_t n, size_t window_size, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_skewness", n);
+    return rolling_higher_moment(data, n, window_size, out,
+                                 [](const BasicRollingHigherMoments<Real>& moments) { return moments.skewness(); });
+}
+
+template <typename Real>
+std::vector<Real> rolling_kurtosis(const std::vector<Real>& data, size_t window_size) {
+    std::vector<Real> values(rolling_output_size(data.size(), window_size));
+    rolling_kurtosis(data.data(), data.size(), window_size, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t rolling_kurtosis(const Real* data, size_t n, size_t window_size, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_kurtosis", n);
+    return rolling_higher_moment(data, n, window_size, out,
+                                 [](const BasicRollingHigherMoments<Real>& moments) { return moments.kurtosis(); });
+}
+
+template <typename Real>
+std::vector<Real> rolling_zscore(const std::vector<Real>& data, size_t window_size) {
+    std::vector<Real> values(rolling_output_size(data.size(), window_size));
+    rolling_zscore(data.data(), data.size(), window_size, values.data());
+    return values;
+}
+
+template <typename Real>
+size_t rolling_zscore(const Real* data, size_t n, size_t window_size, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_zscore", n);
+    if (!check_window(n, window_size)) {
+        return 0;
+    }
+
+    size_t outputs = rolling_output_size(n, window_size);
+    const size_t period = rolling_resync_period(window_size);
+
+    BasicRollingMoments<Real> moments(window_size);
+    moments.resync(data, window_size);
+    out[0] = window_zscore(moments, data[window_size - 1]);
+
+    size_t until_resync = period - 1;
+    for (size_t i = 1; i < outputs; ++i) {
+        if (until_resync == 0) {
+            moments.resync(data + i, window_size);
+            until_resync = period;
+        } else {
+            moments.slide(data[i + window_size - 1], data[i - 1]);
+        }
+        --until_resync;
+        out[i] = window_zscore(moments, data[i + window_size - 1]);
+    }
+    return outputs;
+}
+
+template float window_zscore<float>(const BasicRollingMoments<float>&, float);
+template double window_zscore<double>(const BasicRollingMoments<double>&, double);
+template std::vector<float> rolling_max<float>(const std::vector<float>&, size_t);
+template std::vector<double> rolling_max<double>(const std::vector<double>&, size_t);
+template size_t rolling_max<float>(const float*, size_t, size_t, float*);
+template size_t rolling_max<double>(const double*, size_t, size_t, double*);
+template size_t rolling_max<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t rolling_max<double>(const double*, size_t, size_t, double*, ScratchArena&);
+template std::vector<float> rolling_min<float>(const std::vector<float>&, size_t);
+template std::vector<double> rolling_min<double>(const std::vector<double>&, size_t);
+template size_t rolling_min<float>(const float*, size_t, size_t, float*);
+template size_t rolling_min<double>(const double*, size_t, size_t, double*);
+template size_t rolling_min<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t rolling_min<double>(const double*, size_t, size_t, double*, ScratchArena&);
+template std::vector<float> rolling_quantile<float>(const std::vector<float>&, size_t, double);
+template std::vector<double> rolling_quantile<double>(const std::vector<double>&, size_t, double);
+template size_t rolling_quantile<float>(const float*, size_t, size_t, double, float*);
+template size_t rolling_quantile<double>(const double*, size_t, size_t, double, double*);
+template size_t rolling_quantile<float>(const float*, size_t, size_t, double, float*, ScratchArena&);
+template size_t rolling_quantile<double>(const double*, size_t, size_t, double, double*, ScratchArena&);
+template std::vector<float> rolling_median<float>(const std::vector<float>&, size_t);
+template std::vector<double> rolling_median<double>(const std::vector<double>&, size_t);
+template size_t rolling_median<float>(const float*, size_t, size_t, float*);
+template size_t rolling_median<double>(const double*, size_t, size_t, double*);
+template size_t rolling_median<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t rolling_median<double>(const double*, size_t, size_t, double*, ScratchArena&);
+template size_t rolling_quantiles<float>(const float*, size_t, size_t, const double*, size_t, float* const*);
+template size_t rolling_quantiles<double>(const double*, size_t, size_t, const double*, size_t, double* const*);
+template size_t rolling_quantiles<float>(const float*, size_t, size_t, const double*, size_t, float* const*,
+                                        ScratchArena&);
+template size_t rolling_quantiles<double>(const double*, size_t, size_t, const double*, size_t, double* const*,
+                                         ScratchArena&);
+template std::vector<std::vector<float>> rolling_quantiles<float>(const std::vector<float>&, size_t,
+                                                                  const std::vector<double>&);
+template std::vector<std::vector<double>> rolling_quantiles<double>(const std::vector<double>&, size_t,
+                                                                    const std::vector<double>&);
+template std::vector<float> rolling_skewness<float>(const std::vector<float>&, size_t);
+template std::vector<double> rolling_skewness<double>(const std::vector<double>&, size_t);
+template size_t rolling_skewness<float>(const float*, size_t, size_t, float*);
+template size_t rolling_skewness<double>(const double*, size_t, size_t, double*);
+template std::vector<float> rolling_kurtosis<float>(const std::vector<float>&, size_t);
+template std::vector<double> rolling_kurtosis<double>(const std::vector<double>&, size_t);
+template size_t rolling_kurtosis<float>(const float*, size_t, size_t, float*);
+template size_t rolling_kurtosis<double>(const double*, size_t, size_t, double*);
+template std::vector<float> rolling_zscore<float>(const std::vector<float>&, size_t);
+template std::vector<double> rolling_zscore<double>(const std::vector<double>&, size_t);
+template size_t rolling_zscore<float>(const float*, size_t, size_t, float*);
+template size_t rolling_zscore<double>(const double*, size_t, size_t, double*);
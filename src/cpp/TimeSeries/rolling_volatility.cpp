@@ -1,4 +1,6 @@
 #include "finmath/TimeSeries/rolling_volatility.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/TimeSeries/rolling_window.h"
 
 #include <algorithm>
 #include <cmath>
@@ -9,6 +11,11 @@
 // Function to compute the logarithmic returns
 std::vector<double> compute_log_returns(const std::vector<double>& prices) {
     std::vector<double> log_returns;
+    if (prices.size() < 2) {
+        return log_returns;
+    }
+
+    log_returns.reserve(prices.size() - 1);
     for (size_t i = 1; i < prices.size(); ++i) {
         log_returns.push_back(std::log(prices[i] / prices[i - 1]));
     }
@@ -23,26 +30,70 @@ double compute_std(const std::vector<double>& data) {
 }
 
 // Function to compute rolling volatility
+template <typename Real>
+std::vector<Real> rolling_volatility(const std::vector<Real>& prices, size_t window_size) {
+    std::vector<Real> volatilities(rolling_volatility_output_size(prices.size(), window_size));
+    rolling_volatility(prices.data(), prices.size(), window_size, volatilities.data());
+    return volatilities;
+}
+
 std::vector<double> rolling_volatility(const std::vector<double>& prices, size_t window_size) {
-    std::vector<double> volatilities;
+    return rolling_volatility<double>(prices, window_size);
+}
 
-    // Compute log returns
-    std::vector<double> log_returns = compute_log_returns(prices);
+namespace {
 
-    // Rolling window calculation
-    for (size_t i = 0; i <= log_returns.size() - window_size; ++i) {
-        // Get the window of log returns
-        std::vector<double> window(log_returns.begin() + i, log_returns.begin() + i + window_size);
+// Rolling volatility with the log returns in returns[0..n - 1)
+template <typename Real>
+size_t rolling_volatility_into(const Real* prices, size_t n, size_t window_size, Real* returns, Real* out) {
+    if (window_size == 0) {
+        std::cerr << "Window size must be greater than 0." << std::endl;
+        return 0;
+    }
+
+    if (n < 2 || n - 1 < window_size) {
+        std::cerr << "Not enough returns for the window size." << std::endl;
+        return 0;
+    }
 
-        // Compute the standard deviation
-        double std_dev = compute_std(window);
+    // Compute log returns
+    for (size_t i = 1; i < n; ++i) {
+        returns[i - 1] = std::log(prices[i] / prices[i - 1]);
+    }
 
-        // Annualize the standard deviation (multiply by sqrt(252))
-        double annualized_vol = std_dev * std::sqrt(252);
+    // Rolling standard deviation of the returns in a single pass
+    size_t outputs = rolling_output_size(n - 1, window_size);
+    rolling_stddev(returns, n - 1, window_size, out);
 
-        // Store the result
-        volatilities.push_back(annualized_vol);
+    // Annualize the standard deviation (multiply by sqrt(252))
+    const Real annualization = std::sqrt(Real(252));
+    for (size_t i = 0; i < outputs; ++i) {
+        out[i] *= annualization;
     }
 
-    return volatilities;
-}
\ No newline at end of file
+    return outputs;
+}
+
+} // namespace
+
+template <typename Real>
+size_t rolling_volatility(const Real* prices, size_t n, size_t window_size, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_volatility", n);
+    std::vector<Real> log_returns(n < 2 ? 0 : n - 1);
+    return rolling_volatility_into(prices, n, window_size, log_returns.data(), out);
+}
+
+template <typename Real>
+size_t rolling_volatility(const Real* prices, size_t n, size_t window_size, Real* out, ScratchArena& arena) {
+    FINMATH_INSTRUMENT_SAMPLED("rolling_volatility", n);
+    ScratchArena::Scope scope(arena);
+    Real* log_returns = arena.allocate_array<Real>(n < 2 ? 0 : n - 1);
+    return rolling_volatility_into(prices, n, window_size, log_returns, out);
+}
+
+template std::vector<float> rolling_volatility<float>(const std::vector<float>&, size_t);
+template std::vector<double> rolling_volatility<double>(const std::vector<double>&, size_t);
+template size_t rolling_volatility<float>(const float*, size_t, size_t, float*);
+template size_t rolling_volatility<double>(const double*, size_t, size_t, double*);
+template size_t rolling_volatility<float>(const float*, size_t, size_t, float*, ScratchArena&);
+template size_t rolling_volatility<double>(const double*, size_t, size_t, double*, ScratchArena&);
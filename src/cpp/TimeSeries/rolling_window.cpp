@@ -0,0 +1,158 @@
+#include "finmath/TimeSeries/rolling_window.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Running sums are rebuilt from the window contents after this many slides (or one
+// full window, if larger) so rounding error cannot build up over long series. The
+// rebuild costs O(window) per interval, which keeps the total cost O(n).
+constexpr size_t kResyncInterval = 4096;
+
+} // namespace
+
+size_t rolling_resync_period(size_t window_size) {
+    return std::max(window_size, kResyncInterval);
+}
+
+template <typename Real>
+BasicRollingMoments<Real>::BasicRollingMoments(size_t window_size)
+    : window_size_(window_size), count_(0), mean_(0), m2_(0) {}
+
+template <typename Real>
+void BasicRollingMoments<Real>::reset() {
+    count_ = 0;
+    mean_ = CompensatedSum<Real>();
+    m2_ = CompensatedSum<Real>();
+}
+
+template <typename Real>
+void BasicRollingMoments<Real>::push(Real x) {
+    ++count_;
+    Real delta = x - mean();
+    mean_.add(delta / static_cast<Real>(count_));
+    m2_.add(delta * (x - mean()));
+}
+
+template <typename Real>
+void BasicRollingMoments<Real>::slide(Real x_in, Real x_out) {
+    Real old_mean = mean();
+    Real delta = x_in - x_out;
+    mean_.add(delta / static_cast<Real>(window_size_));
+    m2_.add(delta * (x_in - mean() + x_out - old_mean));
+}
+
+template <typename Real>
+void BasicRollingMoments<Real>::resync(const Real* window, size_t count) {
+    // Two-pass recompute: exact mean first, then squared deviations from it
+    count_ = count;
+    if (count == 0) {
+        mean_ = CompensatedSum<Real>();
+        m2_ = CompensatedSum<Real>();
+        return;
+    }
+
+    CompensatedSum<Real> sum;
+    for (size_t i = 0; i < count; ++i) {
+        sum.add(window[i]);
+    }
+    const Real mean = sum.value() / static_cast<Real>(count);
+    mean_ = CompensatedSum<Real>(mean);
+
+    CompensatedSum<Real> m2;
+    for (size_t i = 0; i < count; ++i) {
+        Real d = window[i] - mean;
+        m2.add(d * d);
+    }
+    m2_ = CompensatedSum<Real>(m2.value());
+}
+
+template <typename Real>
+void BasicRollingMoments<Real>::restore(size_t count, Real mean, Real m2) {
+    count_ = count;
+    mean_ = CompensatedSum<Real>(mean);
+    m2_ = CompensatedSum<Real>(m2);
+}
+
+template <typename Real>
+Real BasicRollingMoments<Real>::variance() const {
+    if (count_ == 0) {
+        return 0;
+    }
+    // Cancellation in slide() can leave a tiny negative value for a constant window
+    return std::max(m2(), Real(0)) / static_cast<Real>(count_);
+}
+
+template <typename Real>
+Real BasicRollingMoments<Real>::stddev() const {
+    return std::sqrt(variance());
+}
+
+template class BasicRollingMoments<float>;
+template class BasicRollingMoments<double>;
+
+template <typename Real>
+void rolling_mean(const Real* data, size_t n, size_t window_size, Real* out) {
+    size_t outputs = rolling_output_size(n, window_size);
+    if (outputs == 0) {
+        return;
+    }
+
+    const Real inv_window = Real(1) / static_cast<Real>(window_size);
+    const size_t period = rolling_resync_period(window_size);
+
+    CompensatedSum<Real> sum;
+    for (size_t i = 0; i < window_size; ++i) {
+        sum.add(data[i]);
+    }
+    out[0] = sum.value() * inv_window;
+
+    // Rebuild at outputs i that are multiples of the period, counted down rather than
+    // tested with i % period, which would cost an integer division per output
+    size_t until_resync = period - 1;
+    for (size_t i = 1; i < outputs; ++i) {
+        if (until_resync == 0) {
+            sum = CompensatedSum<Real>();
+            for (size_t j = i; j < i + window_size; ++j) {
+                sum.add(data[j]);
+            }
+            until_resync = period;
+        } else {
+            sum.add(data[i + window_size - 1] - data[i - 1]);
+        }
+        --until_resync;
+        out[i] = sum.value() * inv_window;
+    }
+}
+
+template <typename Real>
+void rolling_stddev(const Real* data, size_t n, size_t window_size, Real* out) {
+    size_t outputs = rolling_output_size(n, window_size);
+    if (outputs == 0) {
+        return;
+    }
+
+    const size_t period = rolling_resync_period(window_size);
+
+    BasicRollingMoments<Real> moments(window_size);
+    moments.resync(data, window_size);
+    out[0] = moments.stddev();
+
+    size_t until_resync = period - 1;
+    for (size_t i = 1; i < outputs; ++i) {
+        if (until_resync == 0) {
+            moments.resync(data + i, window_size);
+            until_resync = period;
+        } else {
+            moments.slide(data[i + window_size - 1], data[i - 1]);
+        }
+        --until_resync;
+        out[i] = moments.stddev();
+    }
+}
+
+template void rolling_mean<float>(const float*, size_t, size_t, float*);
+template void rolling_mean<double>(const double*, size_t, size_t, double*);
+template void rolling_stddev<float>(const float*, size_t, size_t, float*);
+template void rolling_stddev<double>(const double*, size_t, size_t, double*);
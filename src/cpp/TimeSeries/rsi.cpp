@@ -1,4 +1,6 @@
 #include "finmath/TimeSeries/rsi.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/TimeSeries/rolling_window.h"
 
 #include<numeric>
 #include<cmath>
@@ -32,34 +34,65 @@ double compute_avg_loss(const std::vector<double>& price_changes, size_t window_
     return total_loss / window_size;
 }
 
+template <typename Real>
+std::vector<Real> compute_rsi(const std::vector<Real>& prices, size_t window_size)
+{
+    std::vector<Real> rsi_values(rsi_output_size(prices.size()));
+    compute_rsi(prices.data(), prices.size(), window_size, rsi_values.data());
+    return rsi_values;
+}
+
 std::vector<double> compute_rsi(const std::vector<double>& prices, size_t window_size)
 {
-    std::vector<double> rsi_values; 
-    std::vector<double> price_changes;
+    return compute_rsi<double>(prices, window_size);
+}
+
+template <typename Real>
+size_t compute_rsi(const Real* prices, size_t n, size_t window_size, Real* out)
+{
+    FINMATH_INSTRUMENT_SAMPLED("compute_rsi", n);
+    // Price changes are recomputed from adjacent prices instead of being stored
+    CompensatedSum<Real> total_gain;
+    CompensatedSum<Real> total_loss;
 
-    for(size_t i = 1; i < prices.size(); i++)
+    for(size_t i = 1; i < n; i++)
     {
-        price_changes.push_back(prices[i] - prices[i-1]);
+        Real change = prices[i] - prices[i-1];
+        if(change > 0)
+        {
+            total_gain.add(change);
+        }
+        else if(change < 0)
+        {
+            total_loss.add(std::abs(change));
+        }
     }
 
-    double avg_gain = compute_avg_gain(price_changes, window_size);
-    double avg_loss = compute_avg_loss(price_changes, window_size);
+    Real avg_gain = total_gain.value() / window_size;
+    Real avg_loss = total_loss.value() / window_size;
 
-    double rs = (avg_loss == 0) ? 0 : avg_gain / avg_loss;  // Avoid division by zero;
+    const Real hundred = 100;
+    const Real one = 1;
+    Real rs = (avg_loss == 0) ? 0 : avg_gain / avg_loss;  // Avoid division by zero;
 
-    double rsi = 100.0 - (100.0 / (1.0 + rs));
-    rsi_values.push_back(rsi);
+    Real rsi = hundred - (hundred / (one + rs));
+    out[0] = rsi;
 
-    for(size_t i = 0; i < price_changes.size(); i++)
+    for(size_t i = 1; i < n; i++)
     {
-        double change = price_changes[i];
+        Real change = prices[i] - prices[i-1];
         avg_gain = (avg_gain * (window_size - 1)) + (change > 0 ? change : 0) / window_size;
         avg_loss = (avg_loss * (window_size - 1)) + (change < 0 ? std::abs(change) : 0) / window_size;
 
         rs = (avg_loss == 0) ? 0 : avg_gain / avg_loss;  // Avoid division by zero
-        rsi = (avg_loss == 0) ? 100.0 : 100.0 - (100.0 / (1.0 + rs));
-        rsi_values.push_back(rsi);
+        rsi = (avg_loss == 0) ? hundred : hundred - (hundred / (one + rs));
+        out[i] = rsi;
     }
 
-    return rsi_values;
-}
\ No newline at end of file
+    return rsi_output_size(n);
+}
+
+template std::vector<float> compute_rsi<float>(const std::vector<float>&, size_t);
+template std::vector<double> compute_rsi<double>(const std::vector<double>&, size_t);
+template size_t compute_rsi<float>(const float*, size_t, size_t, float*);
+template size_t compute_rsi<double>(const double*, size_t, size_t, double*);
@@ -0,0 +1,393 @@
+#include "finmath/TimeSeries/series_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FINMATH_HAS_MMAP 1
+#endif
+
+namespace {
+
+const char kMagic[8] = {'F', 'M', 'S', 'E', 'R', 'I', 'E', 'S'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint32_t kVersion = 1;
+constexpr uint64_t kColumnAlignment = 4096;
+constexpr size_t kMaxNameLength = 47;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t byte_order;
+    uint32_t version;
+    uint64_t column_count;
+    uint64_t capacity;
+    uint64_t rows;
+    uint64_t reserved[3];
+};
+
+struct ColumnDescriptor {
+    char name[kMaxNameLength + 1];
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t offset;
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+static_assert(sizeof(ColumnDescriptor) == 64, "ColumnDescriptor must be 64 bytes");
+
+uint64_t align_up(uint64_t x, uint64_t alignment) {
+    return (x + alignment - 1) / alignment * alignment;
+}
+
+FileHeader make_header(size_t column_count, size_t capacity, size_t rows) {
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.byte_order = kByteOrderMark;
+    header.version = kVersion;
+    header.column_count = column_count;
+    header.capacity = capacity;
+    header.rows = rows;
+    return header;
+}
+
+// Platform layer: plain file writes and a read-only mapping
+
+#ifdef FINMATH_HAS_MMAP
+
+std::string system_error(const std::string& what, const std::string& path) {
+    return what + " " + path + ": " + std::strerror(errno);
+}
+
+int create_file(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(system_error("cannot create", path));
+    }
+    return fd;
+}
+
+void resize_file(int fd, uint64_t size) {
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        throw std::runtime_error(system_error("cannot resize", "series store"));
+    }
+}
+
+void write_at(int fd, const void* data, size_t size, uint64_t offset) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, bytes, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(system_error("cannot write", "series store"));
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+void close_file(int fd) {
+    if (::close(fd) != 0) {
+        throw std::runtime_error(system_error("cannot close", "series store"));
+    }
+}
+
+// Close on cleanup paths, where an error has nowhere to go
+void close_quietly(int fd) {
+    ::close(fd);
+}
+
+void* map_file(const std::string& path, size_t& size) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(system_error("cannot open", path));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close_quietly(fd);
+        throw std::runtime_error("not a series store: " + path);
+    }
+    size = static_cast<size_t>(info.st_size);
+    void* map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps the file open
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error(system_error("cannot map", path));
+    }
+    return map;
+}
+
+void unmap_file(void* map, size_t size) {
+    ::munmap(map, size);
+}
+
+constexpr int kAdviseWillNeed = MADV_WILLNEED;
+constexpr int kAdviseDontNeed = MADV_DONTNEED;
+
+void advise_range(void* map, size_t size, size_t begin, size_t end, int advice) {
+    // madvise works on whole pages: round outwards to prefetch, inwards to release
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    if (advice == kAdviseDontNeed) {
+        begin = static_cast<size_t>(align_up(begin, page));
+        end = end / page * page;
+    } else {
+        begin = begin / page * page;
+        end = std::min(size, static_cast<size_t>(align_up(end, page)));
+    }
+    if (begin < end) {
+        ::madvise(static_cast<char*>(map) + begin, end - begin, advice);
+    }
+}
+
+#else
+
+[[noreturn]] void unsupported() {
+    throw std::runtime_error("series stores need POSIX file mapping, which this platform lacks");
+}
+
+int create_file(const std::string&) { unsupported(); }
+void resize_file(int, uint64_t) { unsupported(); }
+void write_at(int, const void*, size_t, uint64_t) { unsupported(); }
+void close_file(int) { unsupported(); }
+void close_quietly(int) {}
+void* map_file(const std::string&, size_t&) { unsupported(); }
+void unmap_file(void*, size_t) {}
+
+constexpr int kAdviseWillNeed = 0;
+constexpr int kAdviseDontNeed = 1;
+
+void advise_range(void*, size_t, size_t, size_t, int) {}
+
+#endif
+
+} // namespace
+
+SeriesStoreWriter::SeriesStoreWriter(const std::string& path, std::vector<ColumnSpec> columns, size_t capacity)
+    : fd_(-1), columns_(std::move(columns)), rows_(columns_.size(), 0), capacity_(capacity) {
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        const std::string& name = columns_[c].name;
+        if (name.empty() || name.size() > kMaxNameLength) {
+            throw std::invalid_argument("Column names must be 1 to 47 bytes long");
+        }
+        for (size_t d = 0; d < c; ++d) {
+            if (columns_[d].name == name) {
+                throw std::invalid_argument("Duplicate column name: " + name);
+            }
+        }
+    }
+
+    const uint64_t column_bytes = align_up(static_cast<uint64_t>(capacity) * 8, kColumnAlignment);
+    uint64_t offset = align_up(sizeof(FileHeader) + columns_.size() * sizeof(ColumnDescriptor), kColumnAlignment);
+    std::vector<ColumnDescriptor> descriptors(columns_.size());
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        ColumnDescriptor& descriptor = descriptors[c];
+        std::memset(&descriptor, 0, sizeof(descriptor));
+        std::memcpy(descriptor.name, columns_[c].name.data(), columns_[c].name.size());
+        descriptor.type = static_cast<uint32_t>(columns_[c].type);
+        descriptor.offset = offset;
+        offsets_.push_back(offset);
+        offset += column_bytes;
+    }
+
+    fd_ = create_file(path);
+    try {
+        // The file is created at full size; pages that are never written stay sparse
+        resize_file(fd_, offset);
+        FileHeader header = make_header(columns_.size(), capacity_, 0);
+        write_at(fd_, &header, sizeof(header), 0);
+        write_at(fd_, descriptors.data(), descriptors.size() * sizeof(ColumnDescriptor), sizeof(header));
+    } catch (...) {
+        close_quietly(fd_);
+        throw;
+    }
+}
+
+SeriesStoreWriter::~SeriesStoreWriter() {
+    if (fd_ >= 0) {
+        try {
+            close();
+        } catch (...) {
+            // Unequal columns: leave the header at zero rows
+            close_quietly(fd_);
+        }
+    }
+}
+
+void SeriesStoreWriter::append(size_t column, const double* values, size_t count) {
+    write_column(column, ColumnType::FLOAT64, values, count);
+}
+
+void SeriesStoreWriter::append(size_t column, const int64_t* values, size_t count) {
+    write_column(column, ColumnType::TIMESTAMP, values, count);
+}
+
+size_t SeriesStoreWriter::rows(size_t column) const {
+    return rows_.at(column);
+}
+
+void SeriesStoreWriter::write_column(size_t column, ColumnType type, const void* values, size_t count) {
+    if (fd_ < 0) {
+        throw std::logic_error("SeriesStoreWriter is closed");
+    }
+    if (columns_.at(column).type != type) {
+        throw std::invalid_argument("Value type does not match column " + columns_[column].name);
+    }
+    if (count > capacity_ - rows_[column]) {
+        throw std::length_error("Column " + columns_[column].name + " is full");
+    }
+    write_at(fd_, values, count * 8, offsets_[column] + static_cast<uint64_t>(rows_[column]) * 8);
+    rows_[column] += count;
+}
+
+void SeriesStoreWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    size_t rows = rows_.empty() ? 0 : rows_[0];
+    for (size_t r : rows_) {
+        if (r != rows) {
+            throw std::logic_error("Columns of a series store must have the same number of rows");
+        }
+    }
+    FileHeader header = make_header(columns_.size(), capacity_, rows);
+    write_at(fd_, &header, sizeof(header), 0);
+    int fd = fd_;
+    fd_ = -1;
+    close_file(fd);
+}
+
+SeriesStore::SeriesStore(const std::string& path) : map_(nullptr), map_size_(0), rows_(0) {
+    map_ = map_file(path, map_size_);
+    try {
+        const unsigned char* bytes = static_cast<const unsigned char*>(map_);
+        FileHeader header;
+        std::memcpy(&header, bytes, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.byte_order != kByteOrderMark ||
+            header.version != kVersion || header.rows > header.capacity) {
+            throw std::runtime_error("not a series store (or written on another architecture): " + path);
+        }
+
+        const uint64_t descriptors_end = sizeof(FileHeader) + header.column_count * sizeof(ColumnDescriptor);
+        if (header.column_count > map_size_ / sizeof(ColumnDescriptor) || descriptors_end > map_size_) {
+            throw std::runtime_error("truncated series store: " + path);
+        }
+        for (uint64_t c = 0; c < header.column_count; ++c) {
+            ColumnDescriptor descriptor;
+            std::memcpy(&descriptor, bytes + sizeof(FileHeader) + c * sizeof(ColumnDescriptor), sizeof(descriptor));
+            descriptor.name[kMaxNameLength] = '\0';
+            ColumnType type = static_cast<ColumnType>(descriptor.type);
+            if ((type != ColumnType::FLOAT64 && type != ColumnType::TIMESTAMP) || descriptor.offset % 8 != 0 ||
+                descriptor.offset > map_size_ || header.capacity > (map_size_ - descriptor.offset) / 8) {
+                throw std::runtime_error("corrupt column in series store: " + path);
+            }
+            columns_.push_back({descriptor.name, type});
+            offsets_.push_back(descriptor.offset);
+        }
+        rows_ = static_cast<size_t>(header.rows);
+    } catch (...) {
+        unmap_file(map_, map_size_);
+        throw;
+    }
+}
+
+SeriesStore::~SeriesStore() {
+    unmap_file(map_, map_size_);
+}
+
+size_t SeriesStore::column_index(const std::string& name) const {
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        if (columns_[c].name == name) {
+            return c;
+        }
+    }
+    throw std::out_of_range("No column named " + name);
+}
+
+const unsigned char* SeriesStore::column_data(size_t c, ColumnType type) const {
+    if (column(c).type != type) {
+        throw std::invalid_argument("Column " + columns_[c].name + " has another type");
+    }
+    return static_cast<const unsigned char*>(map_) + offsets_[c];
+}
+
+const double* SeriesStore::values(size_t c) const {
+    return reinterpret_cast<const double*>(column_data(c, ColumnType::FLOAT64));
+}
+
+const int64_t* SeriesStore::timestamps(size_t c) const {
+    return reinterpret_cast<const int64_t*>(column_data(c, ColumnType::TIMESTAMP));
+}
+
+void SeriesStore::will_need(size_t c, size_t begin, size_t end) const {
+    advise(c, begin, end, kAdviseWillNeed);
+}
+
+void SeriesStore::release(size_t c, size_t begin, size_t end) const {
+    advise(c, begin, end, kAdviseDontNeed);
+}
+
+void SeriesStore::advise(size_t c, size_t begin, size_t end, int advice) const {
+    end = std::min(end, rows_);
+    if (begin >= end) {
+        return;
+    }
+    const size_t offset = static_cast<size_t>(offsets_.at(c));
+    advise_range(map_, map_size_, offset + begin * 8, offset + end * 8, advice);
+}
+
+void compute_indicators(const SeriesStore& store, size_t column, const IndicatorPipeline& pipeline,
+                        size_t chunk_rows, const IndicatorSink& sink) {
+    if (chunk_rows == 0) {
+        throw std::invalid_argument("compute_indicators needs chunk_rows > 0");
+    }
+    const double* prices = store.values(column);
+    const size_t n = store.rows();
+    const size_t indicator_count = pipeline.indicators().size();
+
+    // Windows read back at most window_size + 1 prices before the current one
+    size_t reach = 1;
+    for (const IndicatorSpec& spec : pipeline.indicators()) {
+        reach = std::max(reach, spec.window_size + 1);
+    }
+
+    store.will_need(column, 0, chunk_rows);
+
+    std::vector<std::vector<double>> buffers(indicator_count, std::vector<double>(chunk_rows + 1));
+    std::vector<double*> outs(indicator_count);
+    for (size_t k = 0; k < indicator_count; ++k) {
+        outs[k] = buffers[k].data();
+    }
+
+    // With RSI this reads the whole column once for compute_rsi's seed
+    IndicatorCursor cursor(pipeline, prices, n);
+    std::vector<size_t> first(indicator_count);
+    size_t released = 0;
+    do {
+        const size_t begin = cursor.position();
+        const size_t end = std::min(n, begin + chunk_rows);
+        store.will_need(column, end, end + chunk_rows);
+
+        for (size_t k = 0; k < indicator_count; ++k) {
+            first[k] = cursor.produced(k);
+        }
+        cursor.advance(end, outs.data());
+        for (size_t k = 0; k < indicator_count; ++k) {
+            if (cursor.produced(k) > first[k]) {
+                sink(k, first[k], outs[k], cursor.produced(k) - first[k]);
+            }
+        }
+
+        if (end > reach && end - reach > released) {
+            store.release(column, released, end - reach);
+            released = end - reach;
+        }
+    } while (cursor.position() < n);
+}
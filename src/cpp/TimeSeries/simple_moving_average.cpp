@@ -1,34 +1,41 @@
 #include "finmath/TimeSeries/simple_moving_average.h"
+#include "finmath/TimeSeries/rolling_window.h"
+#include "finmath/Helper/instrumentation.h"
 
-#include <algorithm>
-#include <cmath>
 #include <iostream>
-#include <numeric>
 #include <vector>
 
+template <typename Real>
+std::vector<Real> simple_moving_average(const std::vector<Real>& data, size_t window_size) {
+    std::vector<Real> averages(rolling_output_size(data.size(), window_size));
+    simple_moving_average(data.data(), data.size(), window_size, averages.data());
+    return averages;
+}
+
 std::vector<double> simple_moving_average(const std::vector<double>& data, size_t window_size) {
-    std::vector<double> averages;
+    return simple_moving_average<double>(data, window_size);
+}
 
+template <typename Real>
+size_t simple_moving_average(const Real* data, size_t n, size_t window_size, Real* out) {
+    FINMATH_INSTRUMENT_SAMPLED("simple_moving_average", n);
     // Check for valid window size
     if (window_size == 0) {
         std::cerr << "Window size must be greater than 0." << std::endl;
-        return averages;
+        return 0;
     }
 
-    if (data.size() < window_size) {
+    if (n < window_size) {
         std::cerr << "Data size is smaller than the window size." << std::endl;
-        return averages;
+        return 0;
     }
 
-    // Compute moving averages using a sliding window
-    for (size_t i = 0; i <= data.size() - window_size; ++i) {
-        // Calculate the sum of the current window
-        double sum = std::accumulate(data.begin() + i, data.begin() + i + window_size, 0.0);
-
-        // Compute the average and store it
-        double avg = sum / static_cast<double>(window_size);
-        averages.push_back(avg);
-    }
-
-    return averages;
+    // Compute moving averages with a running window sum in one pass
+    rolling_mean(data, n, window_size, out);
+    return rolling_output_size(n, window_size);
 }
+
+template std::vector<float> simple_moving_average<float>(const std::vector<float>&, size_t);
+template std::vector<double> simple_moving_average<double>(const std::vector<double>&, size_t);
+template size_t simple_moving_average<float>(const float*, size_t, size_t, float*);
+template size_t simple_moving_average<double>(const double*, size_t, size_t, double*);
@@ -0,0 +1,884 @@
+#include "finmath/TimeSeries/streaming_indicators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// First element of every snapshot, so state cannot be restored into the wrong indicator
+constexpr double kSmaTag = 1.0;
+constexpr double kVolatilityTag = 2.0;
+constexpr double kRsiTag = 3.0;
+constexpr double kEmaTag = 4.0;
+constexpr double kDemaTag = 5.0;
+constexpr double kTemaTag = 6.0;
+constexpr double kWmaTag = 7.0;
+constexpr double kMaxTag = 8.0;
+constexpr double kMinTag = 9.0;
+constexpr double kQuantileTag = 10.0;
+constexpr double kSkewnessTag = 11.0;
+constexpr double kKurtosisTag = 12.0;
+constexpr double kZScoreTag = 13.0;
+
+// Fields of one EMA stage within a DEMA / TEMA snapshot: count, sum, value
+constexpr size_t kEmaStageSize = 3;
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+void check_window(size_t window_size) {
+    if (window_size == 0) {
+        throw std::invalid_argument("Window size must be greater than 0.");
+    }
+}
+
+void check_snapshot(const std::vector<double>& state, double tag, size_t header_size, size_t window_size) {
+    if (state.size() < header_size || state[0] != tag || state[1] != static_cast<double>(window_size)) {
+        throw std::invalid_argument("Snapshot does not belong to this indicator.");
+    }
+}
+
+// Largest count a snapshot can carry exactly as a double
+constexpr double kMaxSnapshotCount = 9007199254740992.0;  // 2^53
+
+// state[index] as a count: throws std::invalid_argument unless it is an integer in [0, limit]
+size_t snapshot_count(const std::vector<double>& state, size_t index, size_t limit) {
+    const double x = state[index];
+    const double bound = std::min(static_cast<double>(limit), kMaxSnapshotCount);
+    if (!(x >= 0.0 && x <= bound) || x != std::floor(x)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    return static_cast<size_t>(x);
+}
+
+// Append the window contents in arrival order
+void append_window(std::vector<double>& state, const RingBuffer& window) {
+    for (size_t i = 0; i < window.size(); ++i) {
+        state.push_back(window[i]);
+    }
+}
+
+// Refill the window from a snapshot, returning false if the sample count is inconsistent
+bool load_window(RingBuffer& window, const std::vector<double>& state, size_t offset, size_t count) {
+    if (count > window.capacity() || state.size() != offset + count) {
+        return false;
+    }
+    window.clear();
+    for (size_t i = 0; i < count; ++i) {
+        window.push(state[offset + i]);
+    }
+    return true;
+}
+
+// Append the count, sum and value of an EMA stage
+void append_stage(std::vector<double>& state, const RollingEMA& stage) {
+    std::vector<double> fields = stage.snapshot();
+    state.insert(state.end(), fields.begin() + 2, fields.end());
+}
+
+// Load an EMA stage from the kEmaStageSize fields at state[offset]
+void load_stage(RollingEMA& stage, const std::vector<double>& state, size_t offset) {
+    std::vector<double> fields = {kEmaTag, static_cast<double>(stage.span())};
+    fields.insert(fields.end(), state.begin() + offset, state.begin() + offset + kEmaStageSize);
+    stage.restore(fields);
+}
+
+// Fold a price into a window and its higher moments. The moments are rebuilt about the
+// mean when the window fills, every rolling_resync_period slides and whenever the mean
+// drifts from the shift: the schedule rolling_skewness and rolling_kurtosis follow.
+void update_higher_moments(RingBuffer& window, BasicRollingHigherMoments<double>& moments, size_t& slides,
+                           double price) {
+    if (!window.full()) {
+        window.push(price);
+        moments.push(price);
+        if (window.full()) {
+            moments.resync(window.data(), window.size());
+        }
+        return;
+    }
+
+    double oldest = window.oldest();
+    window.push(price);
+    if (++slides == rolling_resync_period(window.capacity())) {
+        moments.resync(window.data(), window.size());
+        slides = 0;
+    } else {
+        moments.slide(price, oldest);
+        if (moments.drifted()) {
+            moments.resync(window.data(), window.size());
+            slides = 0;
+        }
+    }
+}
+
+std::vector<double> snapshot_higher_moments(double tag, const RingBuffer& window,
+                                            const BasicRollingHigherMoments<double>& moments, size_t slides) {
+    // Layout: tag, window size, count, shift, four power sums, slides since resync, window values
+    std::vector<double> state = {
+        tag,
+        static_cast<double>(window.capacity()),
+        static_cast<double>(moments.count()),
+        moments.shift(),
+        moments.power_sum(1),
+        moments.power_sum(2),
+        moments.power_sum(3),
+        moments.power_sum(4),
+        static_cast<double>(slides),
+    };
+    append_window(state, window);
+    return state;
+}
+
+void restore_higher_moments(const std::vector<double>& state, double tag, RingBuffer& window,
+                            BasicRollingHigherMoments<double>& moments, size_t& slides) {
+    const size_t header_size = 9;
+    check_snapshot(state, tag, header_size, window.capacity());
+
+    size_t count = snapshot_count(state, 2, window.capacity());
+    size_t resync_slides = snapshot_count(state, 8, rolling_resync_period(window.capacity()) - 1);
+    if (!load_window(window, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    moments.restore(count, state[3], state[4], state[5], state[6], state[7]);
+    slides = resync_slides;
+}
+
+} // namespace
+
+size_t snapshot_window_size(const std::vector<double>& state) {
+    if (state.size() < 2) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    size_t window_size = snapshot_count(state, 1, std::numeric_limits<size_t>::max());
+    if (window_size == 0) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    return window_size;
+}
+
+double snapshot_quantile(const std::vector<double>& state) {
+    if (state.size() < 3 || !(state[2] >= 0.0 && state[2] <= 1.0)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    return state[2];
+}
+
+RingBuffer::RingBuffer(size_t capacity) : data_(capacity, 0.0), head_(0), size_(0) {}
+
+void RingBuffer::push(double x) {
+    if (size_ < data_.size()) {
+        size_t tail = head_ + size_;
+        if (tail >= data_.size()) {
+            tail -= data_.size();
+        }
+        data_[tail] = x;
+        ++size_;
+    } else {
+        data_[head_] = x;
+        if (++head_ == data_.size()) {
+            head_ = 0;
+        }
+    }
+}
+
+double RingBuffer::operator[](size_t i) const {
+    size_t index = head_ + i;
+    if (index >= data_.size()) {
+        index -= data_.size();
+    }
+    return data_[index];
+}
+
+void RingBuffer::clear() {
+    head_ = 0;
+    size_ = 0;
+}
+
+// RollingSMA
+
+RollingSMA::RollingSMA(size_t window_size)
+    : window_((check_window(window_size), window_size)), moments_(window_size), slides_since_resync_(0) {}
+
+double RollingSMA::update(double price) {
+    if (!window_.full()) {
+        window_.push(price);
+        moments_.push(price);
+        return value();
+    }
+
+    double oldest = window_.oldest();
+    window_.push(price);
+
+    // The mean does not depend on sample order, so the rotated storage can be resynced directly
+    if (++slides_since_resync_ == rolling_resync_period(window_.capacity())) {
+        moments_.resync(window_.data(), window_.size());
+        slides_since_resync_ = 0;
+    } else {
+        moments_.slide(price, oldest);
+    }
+    return value();
+}
+
+double RollingSMA::value() const {
+    return ready() ? moments_.mean() : kNaN;
+}
+
+void RollingSMA::reset() {
+    window_.clear();
+    moments_.reset();
+    slides_since_resync_ = 0;
+}
+
+std::vector<double> RollingSMA::snapshot() const {
+    // Layout: tag, window size, count, mean, m2, slides since resync, window values
+    std::vector<double> state = {
+        kSmaTag,
+        static_cast<double>(window_.capacity()),
+        static_cast<double>(moments_.count()),
+        moments_.mean(),
+        moments_.m2(),
+        static_cast<double>(slides_since_resync_),
+    };
+    append_window(state, window_);
+    return state;
+}
+
+void RollingSMA::restore(const std::vector<double>& state) {
+    const size_t header_size = 6;
+    check_snapshot(state, kSmaTag, header_size, window_.capacity());
+
+    size_t count = snapshot_count(state, 2, window_.capacity());
+    size_t slides = snapshot_count(state, 5, rolling_resync_period(window_.capacity()) - 1);
+    if (!load_window(window_, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    moments_.restore(count, state[3], state[4]);
+    slides_since_resync_ = slides;
+}
+
+// RollingVolatility
+
+RollingVolatility::RollingVolatility(size_t window_size)
+    : returns_((check_window(window_size), window_size)), moments_(window_size), slides_since_resync_(0),
+      last_price_(0.0), has_last_price_(false) {}
+
+double RollingVolatility::update(double price) {
+    if (!has_last_price_) {
+        last_price_ = price;
+        has_last_price_ = true;
+        return value();
+    }
+
+    double log_return = std::log(price / last_price_);
+    last_price_ = price;
+
+    if (!returns_.full()) {
+        returns_.push(log_return);
+        moments_.push(log_return);
+        return value();
+    }
+
+    double oldest = returns_.oldest();
+    returns_.push(log_return);
+
+    if (++slides_since_resync_ == rolling_resync_period(returns_.capacity())) {
+        moments_.resync(returns_.data(), returns_.size());
+        slides_since_resync_ = 0;
+    } else {
+        moments_.slide(log_return, oldest);
+    }
+    return value();
+}
+
+double RollingVolatility::value() const {
+    // Annualize the standard deviation (multiply by sqrt(252))
+    return ready() ? moments_.stddev() * std::sqrt(252) : kNaN;
+}
+
+void RollingVolatility::reset() {
+    returns_.clear();
+    moments_.reset();
+    slides_since_resync_ = 0;
+    last_price_ = 0.0;
+    has_last_price_ = false;
+}
+
+std::vector<double> RollingVolatility::snapshot() const {
+    // Layout: tag, window size, count, mean, m2, slides since resync, has last price, last price, returns
+    std::vector<double> state = {
+        kVolatilityTag,
+        static_cast<double>(returns_.capacity()),
+        static_cast<double>(moments_.count()),
+        moments_.mean(),
+        moments_.m2(),
+        static_cast<double>(slides_since_resync_),
+        has_last_price_ ? 1.0 : 0.0,
+        last_price_,
+    };
+    append_window(state, returns_);
+    return state;
+}
+
+void RollingVolatility::restore(const std::vector<double>& state) {
+    const size_t header_size = 8;
+    check_snapshot(state, kVolatilityTag, header_size, returns_.capacity());
+
+    size_t count = snapshot_count(state, 2, returns_.capacity());
+    size_t slides = snapshot_count(state, 5, rolling_resync_period(returns_.capacity()) - 1);
+    if (!load_window(returns_, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    moments_.restore(count, state[3], state[4]);
+    slides_since_resync_ = slides;
+    has_last_price_ = state[6] != 0.0;
+    last_price_ = state[7];
+}
+
+// WilderRSI
+
+WilderRSI::WilderRSI(size_t period)
+    : period_((check_window(period), period)), changes_seen_(0), avg_gain_(0.0), avg_loss_(0.0),
+      last_price_(0.0), has_last_price_(false) {}
+
+double WilderRSI::update(double price) {
+    if (!has_last_price_) {
+        last_price_ = price;
+        has_last_price_ = true;
+        return value();
+    }
+
+    double change = price - last_price_;
+    last_price_ = price;
+    double gain = change > 0 ? change : 0.0;
+    double loss = change < 0 ? -change : 0.0;
+
+    if (changes_seen_ < period_) {
+        // Seed phase: accumulate sums, then turn them into simple averages
+        avg_gain_ += gain;
+        avg_loss_ += loss;
+        if (++changes_seen_ == period_) {
+            avg_gain_ /= static_cast<double>(period_);
+            avg_loss_ /= static_cast<double>(period_);
+        }
+    } else {
+        double n = static_cast<double>(period_);
+        avg_gain_ = (avg_gain_ * (n - 1) + gain) / n;
+        avg_loss_ = (avg_loss_ * (n - 1) + loss) / n;
+        ++changes_seen_;
+    }
+    return value();
+}
+
+double WilderRSI::value() const {
+    if (!ready()) {
+        return kNaN;
+    }
+    if (avg_loss_ == 0) {
+        // Flat prices are neutral, pure gains saturate at 100
+        return avg_gain_ == 0 ? 50.0 : 100.0;
+    }
+    double rs = avg_gain_ / avg_loss_;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+void WilderRSI::reset() {
+    changes_seen_ = 0;
+    avg_gain_ = 0.0;
+    avg_loss_ = 0.0;
+    last_price_ = 0.0;
+    has_last_price_ = false;
+}
+
+std::vector<double> WilderRSI::snapshot() const {
+    // Layout: tag, period, changes seen, average gain, average loss, has last price, last price
+    return {
+        kRsiTag,
+        static_cast<double>(period_),
+        static_cast<double>(changes_seen_),
+        avg_gain_,
+        avg_loss_,
+        has_last_price_ ? 1.0 : 0.0,
+        last_price_,
+    };
+}
+
+void WilderRSI::restore(const std::vector<double>& state) {
+    const size_t header_size = 7;
+    check_snapshot(state, kRsiTag, header_size, period_);
+    if (state.size() != header_size) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+
+    changes_seen_ = snapshot_count(state, 2, std::numeric_limits<size_t>::max());
+    avg_gain_ = state[3];
+    avg_loss_ = state[4];
+    has_last_price_ = state[5] != 0.0;
+    last_price_ = state[6];
+}
+
+// RollingEMA
+
+RollingEMA::RollingEMA(size_t span)
+    : span_((check_window(span), span)), alpha_(2.0 / static_cast<double>(span + 1)), count_(0), sum_(0.0),
+      value_(0.0) {}
+
+double RollingEMA::update(double price) {
+    if (count_ < span_) {
+        sum_ += price;
+        if (++count_ == span_) {
+            value_ = sum_ / static_cast<double>(span_);
+        }
+    } else {
+        value_ += alpha_ * (price - value_);
+    }
+    return value();
+}
+
+double RollingEMA::value() const {
+    return ready() ? value_ : kNaN;
+}
+
+void RollingEMA::reset() {
+    count_ = 0;
+    sum_ = 0.0;
+    value_ = 0.0;
+}
+
+std::vector<double> RollingEMA::snapshot() const {
+    // Layout: tag, span, count, sum, value
+    return {kEmaTag, static_cast<double>(span_), static_cast<double>(count_), sum_, value_};
+}
+
+void RollingEMA::restore(const std::vector<double>& state) {
+    const size_t header_size = 5;
+    check_snapshot(state, kEmaTag, header_size, span_);
+    if (state.size() != header_size) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    size_t count = snapshot_count(state, 2, span_);
+
+    count_ = count;
+    sum_ = state[3];
+    value_ = state[4];
+}
+
+// RollingDEMA
+
+RollingDEMA::RollingDEMA(size_t span) : first_(span), second_(span) {}
+
+double RollingDEMA::update(double price) {
+    double e1 = first_.update(price);
+    if (first_.ready()) {
+        second_.update(e1);
+    }
+    return value();
+}
+
+double RollingDEMA::value() const {
+    return ready() ? 2.0 * first_.value() - second_.value() : kNaN;
+}
+
+void RollingDEMA::reset() {
+    first_.reset();
+    second_.reset();
+}
+
+std::vector<double> RollingDEMA::snapshot() const {
+    // Layout: tag, span, then count, sum, value of each stage
+    std::vector<double> state = {kDemaTag, static_cast<double>(span())};
+    append_stage(state, first_);
+    append_stage(state, second_);
+    return state;
+}
+
+void RollingDEMA::restore(const std::vector<double>& state) {
+    const size_t header_size = 2;
+    check_snapshot(state, kDemaTag, header_size, span());
+    if (state.size() != header_size + 2 * kEmaStageSize) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+
+    load_stage(first_, state, header_size);
+    load_stage(second_, state, header_size + kEmaStageSize);
+}
+
+// RollingTEMA
+
+RollingTEMA::RollingTEMA(size_t span) : first_(span), second_(span), third_(span) {}
+
+double RollingTEMA::update(double price) {
+    double e1 = first_.update(price);
+    if (first_.ready()) {
+        double e2 = second_.update(e1);
+        if (second_.ready()) {
+            third_.update(e2);
+        }
+    }
+    return value();
+}
+
+double RollingTEMA::value() const {
+    return ready() ? 3.0 * (first_.value() - second_.value()) + third_.value() : kNaN;
+}
+
+void RollingTEMA::reset() {
+    first_.reset();
+    second_.reset();
+    third_.reset();
+}
+
+std::vector<double> RollingTEMA::snapshot() const {
+    // Layout: tag, span, then count, sum, value of each stage
+    std::vector<double> state = {kTemaTag, static_cast<double>(span())};
+    append_stage(state, first_);
+    append_stage(state, second_);
+    append_stage(state, third_);
+    return state;
+}
+
+void RollingTEMA::restore(const std::vector<double>& state) {
+    const size_t header_size = 2;
+    check_snapshot(state, kTemaTag, header_size, span());
+    if (state.size() != header_size + 3 * kEmaStageSize) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+
+    load_stage(first_, state, header_size);
+    load_stage(second_, state, header_size + kEmaStageSize);
+    load_stage(third_, state, header_size + 2 * kEmaStageSize);
+}
+
+// RollingWMA
+
+RollingWMA::RollingWMA(size_t window_size)
+    : window_((check_window(window_size), window_size)),
+      inv_weights_(2.0 / (static_cast<double>(window_size) * static_cast<double>(window_size + 1))), sum_(0.0),
+      weighted_(0.0), slides_since_resync_(0) {}
+
+double RollingWMA::update(double price) {
+    if (!window_.full()) {
+        weighted_ += static_cast<double>(window_.size() + 1) * price;
+        sum_ += price;
+        window_.push(price);
+        return value();
+    }
+
+    double oldest = window_.oldest();
+    window_.push(price);
+
+    // Same operations and order as weighted_moving_average, so the values match it exactly
+    if (++slides_since_resync_ == rolling_resync_period(window_.capacity())) {
+        sum_ = 0.0;
+        weighted_ = 0.0;
+        for (size_t i = 0; i < window_.size(); ++i) {
+            sum_ += window_[i];
+            weighted_ += static_cast<double>(i + 1) * window_[i];
+        }
+        slides_since_resync_ = 0;
+    } else {
+        // Every weight drops by one as the window slides: subtract the old window sum
+        weighted_ += static_cast<double>(window_.capacity()) * price - sum_;
+        sum_ += price - oldest;
+    }
+    return value();
+}
+
+double RollingWMA::value() const {
+    return ready() ? weighted_ * inv_weights_ : kNaN;
+}
+
+void RollingWMA::reset() {
+    window_.clear();
+    sum_ = 0.0;
+    weighted_ = 0.0;
+    slides_since_resync_ = 0;
+}
+
+std::vector<double> RollingWMA::snapshot() const {
+    // Layout: tag, window size, count, sum, weighted sum, slides since resync, window values
+    std::vector<double> state = {
+        kWmaTag,
+        static_cast<double>(window_.capacity()),
+        static_cast<double>(window_.size()),
+        sum_,
+        weighted_,
+        static_cast<double>(slides_since_resync_),
+    };
+    append_window(state, window_);
+    return state;
+}
+
+void RollingWMA::restore(const std::vector<double>& state) {
+    const size_t header_size = 6;
+    check_snapshot(state, kWmaTag, header_size, window_.capacity());
+
+    size_t count = snapshot_count(state, 2, window_.capacity());
+    size_t slides = snapshot_count(state, 5, rolling_resync_period(window_.capacity()) - 1);
+    if (!load_window(window_, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    sum_ = state[3];
+    weighted_ = state[4];
+    slides_since_resync_ = slides;
+}
+
+// RollingMax
+
+RollingMax::RollingMax(size_t window_size)
+    : window_((check_window(window_size), window_size)), extremum_(window_size) {}
+
+double RollingMax::update(double price) {
+    window_.push(price);
+    extremum_.push(price);
+    return value();
+}
+
+double RollingMax::value() const {
+    return ready() ? extremum_.value() : kNaN;
+}
+
+void RollingMax::reset() {
+    window_.clear();
+    extremum_.reset();
+}
+
+std::vector<double> RollingMax::snapshot() const {
+    // Layout: tag, window size, count, window values
+    std::vector<double> state = {kMaxTag, static_cast<double>(window_.capacity()), static_cast<double>(window_.size())};
+    append_window(state, window_);
+    return state;
+}
+
+void RollingMax::restore(const std::vector<double>& state) {
+    const size_t header_size = 3;
+    check_snapshot(state, kMaxTag, header_size, window_.capacity());
+
+    size_t count = snapshot_count(state, 2, window_.capacity());
+    if (!load_window(window_, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    // Replaying the window leaves the same candidates as the original run
+    extremum_.reset();
+    for (size_t i = 0; i < count; ++i) {
+        extremum_.push(window_[i]);
+    }
+}
+
+// RollingMin
+
+RollingMin::RollingMin(size_t window_size)
+    : window_((check_window(window_size), window_size)), extremum_(window_size) {}
+
+double RollingMin::update(double price) {
+    window_.push(price);
+    extremum_.push(price);
+    return value();
+}
+
+double RollingMin::value() const {
+    return ready() ? extremum_.value() : kNaN;
+}
+
+void RollingMin::reset() {
+    window_.clear();
+    extremum_.reset();
+}
+
+std::vector<double> RollingMin::snapshot() const {
+    // Layout: tag, window size, count, window values
+    std::vector<double> state = {kMinTag, static_cast<double>(window_.capacity()), static_cast<double>(window_.size())};
+    append_window(state, window_);
+    return state;
+}
+
+void RollingMin::restore(const std::vector<double>& state) {
+    const size_t header_size = 3;
+    check_snapshot(state, kMinTag, header_size, window_.capacity());
+
+    size_t count = snapshot_count(state, 2, window_.capacity());
+    if (!load_window(window_, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    extremum_.reset();
+    for (size_t i = 0; i < count; ++i) {
+        extremum_.push(window_[i]);
+    }
+}
+
+// RollingQuantile
+
+RollingQuantile::RollingQuantile(size_t window_size, double q)
+    : window_((check_window(window_size), window_size)), sorted_(window_size), q_(q) {
+    if (!(q >= 0.0 && q <= 1.0)) {
+        throw std::invalid_argument("Quantile must lie between 0 and 1.");
+    }
+}
+
+double RollingQuantile::update(double price) {
+    if (window_.full()) {
+        sorted_.erase(window_.oldest());
+    }
+    window_.push(price);
+    sorted_.insert(price);
+    return value();
+}
+
+double RollingQuantile::value() const {
+    return ready() ? sorted_.quantile(q_) : kNaN;
+}
+
+void RollingQuantile::reset() {
+    window_.clear();
+    sorted_.clear();
+}
+
+std::vector<double> RollingQuantile::snapshot() const {
+    // Layout: tag, window size, q, count, window values
+    std::vector<double> state = {
+        kQuantileTag,
+        static_cast<double>(window_.capacity()),
+        q_,
+        static_cast<double>(window_.size()),
+    };
+    append_window(state, window_);
+    return state;
+}
+
+void RollingQuantile::restore(const std::vector<double>& state) {
+    const size_t header_size = 4;
+    check_snapshot(state, kQuantileTag, header_size, window_.capacity());
+    if (state[2] != q_) {
+        throw std::invalid_argument("Snapshot does not belong to this indicator.");
+    }
+
+    size_t count = snapshot_count(state, 3, window_.capacity());
+    if (!load_window(window_, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    sorted_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        sorted_.insert(window_[i]);
+    }
+}
+
+// RollingSkewness
+
+RollingSkewness::RollingSkewness(size_t window_size)
+    : window_((check_window(window_size), window_size)), moments_(window_size), slides_since_resync_(0) {}
+
+double RollingSkewness::update(double price) {
+    update_higher_moments(window_, moments_, slides_since_resync_, price);
+    return value();
+}
+
+double RollingSkewness::value() const {
+    return ready() ? moments_.skewness() : kNaN;
+}
+
+void RollingSkewness::reset() {
+    window_.clear();
+    moments_.reset();
+    slides_since_resync_ = 0;
+}
+
+std::vector<double> RollingSkewness::snapshot() const {
+    return snapshot_higher_moments(kSkewnessTag, window_, moments_, slides_since_resync_);
+}
+
+void RollingSkewness::restore(const std::vector<double>& state) {
+    restore_higher_moments(state, kSkewnessTag, window_, moments_, slides_since_resync_);
+}
+
+// RollingKurtosis
+
+RollingKurtosis::RollingKurtosis(size_t window_size)
+    : window_((check_window(window_size), window_size)), moments_(window_size), slides_since_resync_(0) {}
+
+double RollingKurtosis::update(double price) {
+    update_higher_moments(window_, moments_, slides_since_resync_, price);
+    return value();
+}
+
+double RollingKurtosis::value() const {
+    return ready() ? moments_.kurtosis() : kNaN;
+}
+
+void RollingKurtosis::reset() {
+    window_.clear();
+    moments_.reset();
+    slides_since_resync_ = 0;
+}
+
+std::vector<double> RollingKurtosis::snapshot() const {
+    return snapshot_higher_moments(kKurtosisTag, window_, moments_, slides_since_resync_);
+}
+
+void RollingKurtosis::restore(const std::vector<double>& state) {
+    restore_higher_moments(state, kKurtosisTag, window_, moments_, slides_since_resync_);
+}
+
+// RollingZScore
+
+RollingZScore::RollingZScore(size_t window_size)
+    : window_((check_window(window_size), window_size)), moments_(window_size), slides_since_resync_(0) {}
+
+double RollingZScore::update(double price) {
+    if (!window_.full()) {
+        window_.push(price);
+        moments_.push(price);
+        // Rebuild exactly once the window fills, as rolling_zscore starts out
+        if (window_.full()) {
+            moments_.resync(window_.data(), window_.size());
+        }
+        return value();
+    }
+
+    double oldest = window_.oldest();
+    window_.push(price);
+    if (++slides_since_resync_ == rolling_resync_period(window_.capacity())) {
+        moments_.resync(window_.data(), window_.size());
+        slides_since_resync_ = 0;
+    } else {
+        moments_.slide(price, oldest);
+    }
+    return value();
+}
+
+double RollingZScore::value() const {
+    return ready() ? window_zscore(moments_, window_[window_.size() - 1]) : kNaN;
+}
+
+void RollingZScore::reset() {
+    window_.clear();
+    moments_.reset();
+    slides_since_resync_ = 0;
+}
+
+std::vector<double> RollingZScore::snapshot() const {
+    // Layout: tag, window size, count, mean, m2, slides since resync, window values
+    std::vector<double> state = {
+        kZScoreTag,
+        static_cast<double>(window_.capacity()),
+        static_cast<double>(moments_.count()),
+        moments_.mean(),
+        moments_.m2(),
+        static_cast<double>(slides_since_resync_),
+    };
+    append_window(state, window_);
+    return state;
+}
+
+void RollingZScore::restore(const std::vector<double>& state) {
+    const size_t header_size = 6;
+    check_snapshot(state, kZScoreTag, header_size, window_.capacity());
+
+    size_t count = snapshot_count(state, 2, window_.capacity());
+    size_t slides = snapshot_count(state, 5, rolling_resync_period(window_.capacity()) - 1);
+    if (!load_window(window_, state, header_size, count)) {
+        throw std::invalid_argument("Snapshot is malformed.");
+    }
+    moments_.restore(count, state[3], state[4]);
+    slides_since_resync_ = slides;
+}
@@ -1,15 +1,180 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>  // Automatic conversion between Python lists and std::vector
+#include <pybind11/numpy.h>
 
+#include <algorithm>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/Helper/normal_distribution.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/InterestAndAnnuities/cash_flows.h"
 #include "finmath/InterestAndAnnuities/compound_interest.h"
 #include "finmath/OptionPricing/black_scholes.h"
 #include "finmath/OptionPricing/binomial_tree.h"
+#include "finmath/OptionPricing/finite_difference.h"
+#include "finmath/OptionPricing/greeks.h"
+#include "finmath/OptionPricing/implied_volatility.h"
+#include "finmath/OptionPricing/monte_carlo.h"
+#include "finmath/OptionPricing/parallel_pricing.h"
+#include "finmath/OptionPricing/pricing_cache.h"
+#include "finmath/OptionPricing/scenario_engine.h"
+#include "finmath/OptionPricing/trinomial_tree.h"
+#include "finmath/OptionPricing/vol_surface.h"
+#include "finmath/TimeSeries/indicator_pipeline.h"
+#include "finmath/TimeSeries/moving_averages.h"
+#include "finmath/TimeSeries/parallel_indicators.h"
+#include "finmath/TimeSeries/rolling_statistics.h"
 #include "finmath/TimeSeries/rolling_volatility.h"
 #include "finmath/TimeSeries/simple_moving_average.h"
 #include "finmath/TimeSeries/rsi.h"
+#include "finmath/TimeSeries/series_store.h"
+#include "finmath/TimeSeries/streaming_indicators.h"
 
 namespace py = pybind11;
 
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+// No forcecast: registered after a DoubleArray overload, only float32 input selects the
+// float32 kernels and everything else still converts to float64
+using FloatArray = py::array_t<float, py::array::c_style>;
+using IntArray = py::array_t<int, py::array::c_style | py::array::forcecast>;
+
+// Check that the structure-of-arrays option inputs line up and decode types (0 = CALL, 1 = PUT;
+// any other code throws std::invalid_argument, i.e. ValueError)
+template <typename Array>
+std::vector<OptionType> option_types_from(const IntArray& types, std::initializer_list<const Array*> inputs) {
+    size_t n = static_cast<size_t>(types.size());
+    FINMATH_INSTRUMENT_SAMPLED("python:option_types_from", n);
+    for (const Array* input : inputs) {
+        if (static_cast<size_t>(input->size()) != n) {
+            throw std::invalid_argument("All inputs must have the same length.");
+        }
+    }
+
+    std::vector<OptionType> option_types(n);
+    const int* raw_types = types.data();
+    for (size_t i = 0; i < n; ++i) {
+        if (raw_types[i] != 0 && raw_types[i] != 1) {
+            throw std::invalid_argument("Option type codes must be 0 (CALL) or 1 (PUT).");
+        }
+        option_types[i] = raw_types[i] == 0 ? OptionType::CALL : OptionType::PUT;
+    }
+    return option_types;
+}
+
+// Scratch for the indicator kernels: one arena per calling thread, kept between calls so
+// repeated calls from Python stop allocating
+ScratchArena& thread_scratch_arena() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+// Run an indicator over a float64 or float32 buffer (NumPy array, memoryview or anything else
+// with the buffer protocol, read-only included) without copying it. The result, of the same
+// dtype, is allocated as a NumPy array up front and the kernel writes straight into it with
+// the GIL released.
+template <typename Real, int Flags>
+py::array_t<Real> indicator_array(IndicatorType indicator, const py::array_t<Real, Flags>& prices,
+                                  size_t window_size) {
+    size_t n = static_cast<size_t>(prices.size());
+    FINMATH_INSTRUMENT_SAMPLED("python:indicator_array", n);
+    py::array_t<Real> result(indicator_output_size(indicator, n, window_size));
+    const Real* in = prices.data();
+    Real* out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        compute_indicator(indicator, in, n, window_size, out, thread_scratch_arena());
+    }
+    return result;
+}
+
+// Rolling statistic kernel(data, n, window_size, out) over a float64 or float32 buffer, read in
+// place like indicator_array
+template <typename Real, int Flags>
+py::array_t<Real> statistic_array(size_t (*kernel)(const Real*, size_t, size_t, Real*),
+                                  const py::array_t<Real, Flags>& data, size_t window_size) {
+    size_t n = static_cast<size_t>(data.size());
+    py::array_t<Real> result(rolling_output_size(n, window_size));
+    const Real* in = data.data();
+    Real* out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        kernel(in, n, window_size, out);
+    }
+    return result;
+}
+
+// Bind a rolling statistic for float64 and float32 input
+void bind_rolling_statistic(py::module_& m, const char* name, const char* doc,
+                            size_t (*double_kernel)(const double*, size_t, size_t, double*),
+                            size_t (*float_kernel)(const float*, size_t, size_t, float*)) {
+    m.def(name,
+          [double_kernel](DoubleArray data, size_t window_size) {
+              return statistic_array(double_kernel, data, window_size);
+          },
+          doc, py::arg("data"), py::arg("window_size"));
+    m.def(name,
+          [float_kernel](FloatArray data, size_t window_size) {
+              return statistic_array(float_kernel, data, window_size);
+          },
+          doc, py::arg("data"), py::arg("window_size"));
+}
+
+void check_quantile(double q) {
+    if (!(q >= 0.0 && q <= 1.0)) {
+        throw std::invalid_argument("Quantiles must lie between 0 and 1.");
+    }
+}
+
+// Methods every streaming indicator class shares: update/update_many/value/ready/reset and
+// snapshot/restore
+template <typename Indicator>
+py::class_<Indicator> bind_streaming_methods(py::module_& m, const char* name, const char* doc) {
+    return py::class_<Indicator>(m, name, doc)
+        .def("update", &Indicator::update, "Fold in one price and return the current value (NaN until ready)",
+             py::arg("price"))
+        .def("update_many",
+             [](Indicator& indicator, DoubleArray prices) {
+                 // Reads float64 buffers (NumPy arrays, memoryviews) in place
+                 auto in = prices.unchecked<1>();
+                 py::array_t<double> values(in.shape(0));
+                 auto out = values.mutable_unchecked<1>();
+                 for (py::ssize_t i = 0; i < in.shape(0); ++i) {
+                     out(i) = indicator.update(in(i));
+                 }
+                 return values;
+             },
+             "Fold in a batch of prices and return the value after each one", py::arg("prices"))
+        .def_property_readonly("value", &Indicator::value)
+        .def_property_readonly("ready", &Indicator::ready)
+        .def("reset", &Indicator::reset)
+        .def("snapshot", &Indicator::snapshot, "Serialize the indicator state to a list of floats")
+        .def("restore", &Indicator::restore, "Load state produced by snapshot()", py::arg("state"));
+}
+
+// Bind a streaming indicator class constructed from its window size / period, pickled
+// through the snapshot
+template <typename Indicator>
+void bind_streaming_indicator(py::module_& m, const char* name, const char* doc, const char* size_arg) {
+    bind_streaming_methods<Indicator>(m, name, doc)
+        .def(py::init<size_t>(), py::arg(size_arg))
+        .def(py::pickle(
+            [](const Indicator& indicator) { return indicator.snapshot(); },
+            [](const std::vector<double>& state) {
+                // The second snapshot field is always the window size / period
+                Indicator indicator(snapshot_window_size(state));
+                indicator.restore(state);
+                return indicator;
+            }));
+}
+
 PYBIND11_MODULE(finmath, m) {
     m.doc() = "Financial Math Library";
 
@@ -23,21 +188,989 @@ PYBIND11_MODULE(finmath, m) {
     m.def("compound_interest", &compound_interest, "Calculate compound interest",
           py::arg("principal"), py::arg("rate"), py::arg("time"), py::arg("frequency"));
 
+    // Cash-flow engine: annuities, amortization, NPV / IRR and scenario discounting
+    m.def("annuity_present_value", &annuity_present_value, "Present value of level payments",
+          py::arg("payment"), py::arg("rate"), py::arg("periods"), py::arg("due") = false);
+    m.def("annuity_future_value", &annuity_future_value, "Future value of level payments",
+          py::arg("payment"), py::arg("rate"), py::arg("periods"), py::arg("due") = false);
+    m.def("annuity_payment", &annuity_payment, "Level payment that repays a principal",
+          py::arg("principal"), py::arg("rate"), py::arg("periods"), py::arg("due") = false);
+
+    py::class_<AmortizationSchedule>(m, "AmortizationSchedule", "Period-by-period breakdown of a level-payment loan")
+        .def_readonly("payment", &AmortizationSchedule::payment)
+        .def_readonly("interest", &AmortizationSchedule::interest)
+        .def_readonly("principal", &AmortizationSchedule::principal)
+        .def_readonly("balance", &AmortizationSchedule::balance);
+
+    m.def("amortization_schedule", &amortization_schedule, "Amortization schedule of a level-payment loan",
+          py::arg("principal"), py::arg("rate"), py::arg("periods"));
+
+    py::class_<DiscountCurve>(m, "DiscountCurve", "Discount factor curve, log-linear between pillars")
+        .def(py::init<std::vector<double>, std::vector<double>>(), py::arg("times"), py::arg("discount_factors"))
+        .def_static("from_zero_rates", &DiscountCurve::from_zero_rates,
+                    "Curve through continuously compounded zero rates", py::arg("times"), py::arg("zero_rates"))
+        .def_property_readonly("times", &DiscountCurve::times)
+        .def_property_readonly("discount_factors", &DiscountCurve::discount_factors)
+        .def("discount", &DiscountCurve::discount, "Discount factor P(0, t)", py::arg("t"))
+        .def("discount",
+             [](const DiscountCurve& curve, DoubleArray times) {
+                 size_t n = static_cast<size_t>(times.size());
+                 py::array_t<double> result(n);
+                 double* out = result.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     curve.discount_batch(times.data(), out, n);
+                 }
+                 return result;
+             },
+             "Discount factors over an array of times", py::arg("times"))
+        .def("zero_rate", &DiscountCurve::zero_rate, "Continuously compounded zero rate", py::arg("t"))
+        .def("forward_rate", &DiscountCurve::forward_rate, "Continuously compounded forward rate between t1 and t2",
+             py::arg("t1"), py::arg("t2"));
+
+    m.def("net_present_value",
+          static_cast<double (*)(double, const std::vector<double>&)>(&net_present_value),
+          "NPV of one cash flow per period, the first undiscounted", py::arg("rate"), py::arg("cash_flows"));
+    m.def("net_present_value",
+          [](const DiscountCurve& curve, DoubleArray times, DoubleArray amounts) {
+              if (times.size() != amounts.size()) {
+                  throw std::invalid_argument("All inputs must have the same length.");
+              }
+              return net_present_value(curve, times.data(), amounts.data(), static_cast<size_t>(times.size()));
+          },
+          "NPV of dated cash flows against a discount curve", py::arg("curve"), py::arg("times"), py::arg("amounts"));
+
+    // IRR: statuses come back as the integer values of IrrStatus
+    py::enum_<IrrStatus>(m, "IrrStatus")
+        .value("CONVERGED", IrrStatus::CONVERGED)
+        .value("NO_SOLUTION", IrrStatus::NO_SOLUTION)
+        .value("INVALID_INPUT", IrrStatus::INVALID_INPUT);
+
+    m.def("internal_rate_of_return",
+          [](DoubleArray cash_flows, double guess) {
+              return internal_rate_of_return(cash_flows.data(), static_cast<size_t>(cash_flows.size()), nullptr,
+                                             guess);
+          },
+          "Rate at which the NPV of one cash flow per period is zero (NaN when there is none)",
+          py::arg("cash_flows"), py::arg("guess") = 0.0);
+
+    m.def("internal_rate_of_return_batch",
+          [](DoubleArray cash_flows) {
+              if (cash_flows.ndim() != 2) {
+                  throw std::invalid_argument("cash_flows must be 2-D (schedules, periods).");
+              }
+              size_t schedules = static_cast<size_t>(cash_flows.shape(0));
+              size_t periods = static_cast<size_t>(cash_flows.shape(1));
+
+              py::array_t<double> result(schedules);
+              std::vector<IrrStatus> status(schedules);
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  internal_rate_of_return_batch(cash_flows.data(), schedules, periods, out, status.data());
+              }
+
+              py::array_t<int> codes(schedules);
+              int* code = codes.mutable_data();
+              for (size_t i = 0; i < schedules; ++i) {
+                  code[i] = static_cast<int>(status[i]);
+              }
+              return py::make_tuple(result, codes);
+          },
+          "IRRs of a (schedules, periods) array, returned as (rates, statuses)", py::arg("cash_flows"));
+
+    m.def("discount_factor_matrix",
+          [](const std::vector<DiscountCurve>& curves, DoubleArray times) {
+              size_t num_times = static_cast<size_t>(times.size());
+              py::array_t<double> result({num_times, curves.size()});
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  discount_factor_matrix(curves.data(), curves.size(), times.data(), num_times, out);
+              }
+              return result;
+          },
+          "Discount factors of scenario curves as a (times, scenarios) array", py::arg("curves"), py::arg("times"));
+
+    m.def("present_value_matrix",
+          [](DoubleArray cash_flows, DoubleArray discount_factors) {
+              if (cash_flows.ndim() != 2 || discount_factors.ndim() != 2 ||
+                  cash_flows.shape(1) != discount_factors.shape(0)) {
+                  throw std::invalid_argument(
+                      "cash_flows must be (schedules, times) and discount_factors (times, scenarios).");
+              }
+              size_t schedules = static_cast<size_t>(cash_flows.shape(0));
+              size_t num_times = static_cast<size_t>(cash_flows.shape(1));
+              size_t scenarios = static_cast<size_t>(discount_factors.shape(1));
+              py::array_t<double> result({schedules, scenarios});
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  parallel_present_value_matrix(cash_flows.data(), schedules, num_times, discount_factors.data(),
+                                                scenarios, out);
+              }
+              return result;
+          },
+          "Present values of every schedule under every scenario, on every core (the GIL is released)",
+          py::arg("cash_flows"), py::arg("discount_factors"));
+
     // Bind Black-Scholes function
-    m.def("black_scholes", &black_scholes, "Black Scholes Option Pricing",
+    m.def("black_scholes", static_cast<double (*)(OptionType, double, double, double, double, double)>(&black_scholes),
+          "Black Scholes Option Pricing",
           py::arg("type"), py::arg("strike"), py::arg("price"), py::arg("time"), py::arg("rate"), py::arg("volatility"));
 
+    // Bind batch Black-Scholes over NumPy arrays (types: 0 = CALL, 1 = PUT)
+    m.def("black_scholes_batch",
+          [](IntArray types, DoubleArray strikes, DoubleArray prices,
+             DoubleArray times, DoubleArray rates, DoubleArray volatilities) {
+              std::vector<OptionType> option_types =
+                  option_types_from(types, {&strikes, &prices, &times, &rates, &volatilities});
+              size_t n = option_types.size();
+
+              py::array_t<double> result(n);
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  black_scholes_batch(option_types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                                      volatilities.data(), out, n);
+              }
+              return result;
+          },
+          "Vectorized Black Scholes pricing over arrays",
+          py::arg("types"), py::arg("strikes"), py::arg("prices"), py::arg("times"), py::arg("rates"), py::arg("volatilities"));
+
+    // float32 inputs select the single-precision kernels and return float32 prices
+    m.def("black_scholes_batch",
+          [](IntArray types, FloatArray strikes, FloatArray prices,
+             FloatArray times, FloatArray rates, FloatArray volatilities) {
+              std::vector<OptionType> option_types =
+                  option_types_from(types, {&strikes, &prices, &times, &rates, &volatilities});
+              size_t n = option_types.size();
+
+              py::array_t<float> result(n);
+              float* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  black_scholes_batch(option_types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                                      volatilities.data(), out, n);
+              }
+              return result;
+          },
+          "Vectorized Black Scholes pricing over float32 arrays",
+          py::arg("types"), py::arg("strikes"), py::arg("prices"), py::arg("times"), py::arg("rates"), py::arg("volatilities"));
+
+    // Bind analytic Greeks
+    py::class_<Greeks>(m, "Greeks", "Black-Scholes price and sensitivities")
+        .def_readonly("price", &Greeks::price)
+        .def_readonly("delta", &Greeks::delta)
+        .def_readonly("gamma", &Greeks::gamma)
+        .def_readonly("vega", &Greeks::vega)
+        .def_readonly("theta", &Greeks::theta)
+        .def_readonly("rho", &Greeks::rho)
+        .def_readonly("vanna", &Greeks::vanna)
+        .def_readonly("volga", &Greeks::volga)
+        .def_readonly("charm", &Greeks::charm)
+        .def_readonly("veta", &Greeks::veta);
+
+    m.def("black_scholes_greeks", &black_scholes_greeks, "Black Scholes price and Greeks",
+          py::arg("type"), py::arg("strike"), py::arg("price"), py::arg("time"), py::arg("rate"), py::arg("volatility"));
+
+    m.def("black_scholes_greeks_batch",
+          [](IntArray types, DoubleArray strikes, DoubleArray prices,
+             DoubleArray times, DoubleArray rates, DoubleArray volatilities) {
+              std::vector<OptionType> option_types =
+                  option_types_from(types, {&strikes, &prices, &times, &rates, &volatilities});
+              size_t n = option_types.size();
+
+              std::vector<Greeks> greeks(n);
+              {
+                  py::gil_scoped_release release;
+                  black_scholes_greeks_batch(option_types.data(), strikes.data(), prices.data(), times.data(),
+                                             rates.data(), volatilities.data(), greeks.data(), n);
+              }
+
+              // One NumPy array per Greek
+              py::dict result;
+              const char* names[] = {"price", "delta", "gamma", "vega", "theta", "rho", "vanna", "volga", "charm", "veta"};
+              for (size_t k = 0; k < sizeof(names) / sizeof(names[0]); ++k) {
+                  py::array_t<double> column(n);
+                  double* out = column.mutable_data();
+                  for (size_t i = 0; i < n; ++i) {
+                      out[i] = (&greeks[i].price)[k];
+                  }
+                  result[names[k]] = column;
+              }
+              return result;
+          },
+          "Black Scholes price and Greeks over arrays, returned as a dict of arrays",
+          py::arg("types"), py::arg("strikes"), py::arg("prices"), py::arg("times"), py::arg("rates"), py::arg("volatilities"));
+
+    m.def("simd_level", []() { return std::string(simd_level_name(active_simd_level())); },
+          "Instruction set used by the batch kernels");
+
+    // Normal distribution at selectable accuracy; without an accuracy argument the global tier applies
+    py::enum_<NormalAccuracy>(m, "NormalAccuracy")
+        .value("EXACT", NormalAccuracy::EXACT)
+        .value("HIGH", NormalAccuracy::HIGH)
+        .value("FAST", NormalAccuracy::FAST);
+
+    m.def("normal_accuracy", &normal_accuracy, "Accuracy tier used by normal_cdf / normal_pdf and the scalar pricers");
+    m.def("set_normal_accuracy", &set_normal_accuracy, "Set the global normal CDF / PDF accuracy tier",
+          py::arg("accuracy"));
+
+    auto normal_array = [](void (*function)(const double*, double*, size_t, NormalAccuracy)) {
+        return [function](DoubleArray x, std::optional<NormalAccuracy> accuracy) {
+            py::array_t<double> result(std::vector<py::ssize_t>(x.shape(), x.shape() + x.ndim()));
+            double* out = result.mutable_data();
+            size_t n = static_cast<size_t>(x.size());
+            NormalAccuracy tier = accuracy.value_or(normal_accuracy());
+            {
+                py::gil_scoped_release release;
+                function(x.data(), out, n, tier);
+            }
+            return result;
+        };
+    };
+    m.def("normal_cdf", normal_array(&normal_cdf_batch), "Standard normal CDF of every element",
+          py::arg("x"), py::arg("accuracy") = py::none());
+    m.def("normal_pdf", normal_array(&normal_pdf_batch), "Standard normal PDF of every element",
+          py::arg("x"), py::arg("accuracy") = py::none());
+
+    m.def("normal_accuracy_report",
+          [](NormalAccuracy accuracy, double lo, double hi, size_t samples) {
+              NormalErrorReport report;
+              {
+                  py::gil_scoped_release release;
+                  report = normal_accuracy_report(accuracy, lo, hi, samples);
+              }
+              py::dict result;
+              result["max_abs_cdf"] = report.max_abs_cdf;
+              result["max_rel_cdf"] = report.max_rel_cdf;
+              result["worst_cdf_x"] = report.worst_cdf_x;
+              result["max_abs_pdf"] = report.max_abs_pdf;
+              result["max_rel_pdf"] = report.max_rel_pdf;
+              result["worst_pdf_x"] = report.worst_pdf_x;
+              return result;
+          },
+          "Largest errors of a tier against EXACT over evenly spaced points of [lo, hi]",
+          py::arg("accuracy"), py::arg("lo") = -10.0, py::arg("hi") = 10.0, py::arg("samples") = 1000001);
+
+    // Instrumentation (recorded only when built with -DFINMATH_INSTRUMENTATION=ON)
+    m.def("instrumentation_enabled", &instrumentation_enabled, "Whether this build records instrumentation");
+    m.def("instrumentation_json", &instrumentation_json,
+          "Call counts, items and latency histograms per function since start-up or the last reset, as JSON");
+    m.def("reset_instrumentation", &reset_instrumentation, "Start all instrumentation counters from zero");
+
     // Bind binomial option pricing function
-    m.def("binomial_option_pricing", &binomial_option_pricing, "Binomial Option Pricing",
+    m.def("binomial_option_pricing",
+          static_cast<double (*)(OptionType, double, double, double, double, double, long)>(&binomial_option_pricing),
+          "Binomial Option Pricing",
           py::arg("type"), py::arg("S0"), py::arg("K"), py::arg("T"), py::arg("r"), py::arg("sigma"), py::arg("N"));
 
-    // Bind rolling volatility
-    m.def("rolling_volatility", &rolling_volatility, "Rolling Volatility",
-          py::arg("prices"), py::arg("window_size"));
+    py::enum_<ExerciseStyle>(m, "ExerciseStyle")
+        .value("EUROPEAN", ExerciseStyle::EUROPEAN)
+        .value("AMERICAN", ExerciseStyle::AMERICAN)
+        .value("BERMUDAN", ExerciseStyle::BERMUDAN);
+
+    py::enum_<BinomialMethod>(m, "BinomialMethod")
+        .value("CRR", BinomialMethod::CRR)
+        .value("BBS", BinomialMethod::BBS)
+        .value("BBSR", BinomialMethod::BBSR);
+
+    m.def("binomial_lattice_pricing",
+          static_cast<double (*)(OptionType, ExerciseStyle, double, double, double, double, double, long, BinomialMethod,
+                                 const std::vector<double>&)>(&binomial_lattice_pricing),
+          "Binomial lattice pricing with early exercise",
+          py::arg("type"), py::arg("style"), py::arg("S0"), py::arg("K"), py::arg("T"), py::arg("r"), py::arg("sigma"),
+          py::arg("N"), py::arg("method") = BinomialMethod::CRR, py::arg("exercise_times") = std::vector<double>{},
+          py::call_guard<py::gil_scoped_release>());
+
+    // Crank-Nicolson PDE pricing
+    py::enum_<ExerciseSolver>(m, "ExerciseSolver")
+        .value("BRENNAN_SCHWARTZ", ExerciseSolver::BRENNAN_SCHWARTZ)
+        .value("PSOR", ExerciseSolver::PSOR);
+
+    py::class_<FiniteDifferenceSettings>(m, "FiniteDifferenceSettings", "Grid size and solver of the PDE pricer")
+        .def(py::init<>())
+        .def_readwrite("space_steps", &FiniteDifferenceSettings::space_steps)
+        .def_readwrite("time_steps", &FiniteDifferenceSettings::time_steps)
+        .def_readwrite("rannacher_steps", &FiniteDifferenceSettings::rannacher_steps)
+        .def_readwrite("concentration", &FiniteDifferenceSettings::concentration)
+        .def_readwrite("std_devs", &FiniteDifferenceSettings::std_devs)
+        .def_readwrite("exercise_solver", &FiniteDifferenceSettings::exercise_solver)
+        .def_readwrite("extrapolate", &FiniteDifferenceSettings::extrapolate);
+
+    py::class_<FiniteDifferenceResult>(m, "FiniteDifferenceResult", "PDE price and Greeks at S0")
+        .def_readonly("price", &FiniteDifferenceResult::price)
+        .def_readonly("delta", &FiniteDifferenceResult::delta)
+        .def_readonly("gamma", &FiniteDifferenceResult::gamma)
+        .def_readonly("theta", &FiniteDifferenceResult::theta);
+
+    m.def("finite_difference_pricing", &finite_difference_pricing,
+          "Crank-Nicolson finite difference pricing with early exercise",
+          py::arg("type"), py::arg("style"), py::arg("S0"), py::arg("K"), py::arg("T"), py::arg("r"), py::arg("sigma"),
+          py::arg("settings") = FiniteDifferenceSettings(), py::arg("exercise_times") = std::vector<double>{},
+          py::call_guard<py::gil_scoped_release>());
+
+    // Parallel execution layer: every entry point releases the GIL while the pool runs
+    m.def("set_thread_count", &set_default_thread_count,
+          "Resize the thread pool used by the parallel functions (0 = one thread per core)",
+          py::arg("num_threads"), py::arg("pin_threads") = false);
+
+    m.def("thread_count", []() { return default_thread_pool().thread_count(); },
+          "Number of threads used by the parallel functions");
+
+    m.def("parallel_price",
+          [](IntArray types, DoubleArray strikes, DoubleArray prices, DoubleArray times, DoubleArray rates,
+             DoubleArray volatilities) {
+              std::vector<OptionType> option_types =
+                  option_types_from(types, {&strikes, &prices, &times, &rates, &volatilities});
+              size_t n = option_types.size();
+
+              py::array_t<double> result(n);
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  parallel_price(option_types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                                 volatilities.data(), out, n);
+              }
+              return result;
+          },
+          "Multithreaded Black Scholes pricing over arrays",
+          py::arg("types"), py::arg("strikes"), py::arg("prices"), py::arg("times"), py::arg("rates"), py::arg("volatilities"));
+
+    m.def("parallel_binomial_price",
+          [](IntArray types, DoubleArray strikes, DoubleArray prices, DoubleArray times, DoubleArray rates,
+             DoubleArray volatilities, ExerciseStyle style, long N, BinomialMethod method) {
+              std::vector<OptionType> option_types =
+                  option_types_from(types, {&strikes, &prices, &times, &rates, &volatilities});
+              size_t n = option_types.size();
+
+              py::array_t<double> result(n);
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  parallel_binomial_price(option_types.data(), strikes.data(), prices.data(), times.data(),
+                                          rates.data(), volatilities.data(), style, N, method, out, n);
+              }
+              return result;
+          },
+          "Multithreaded binomial lattice pricing over arrays",
+          py::arg("types"), py::arg("strikes"), py::arg("prices"), py::arg("times"), py::arg("rates"), py::arg("volatilities"),
+          py::arg("style"), py::arg("N"), py::arg("method") = BinomialMethod::CRR);
+
+    // Implied volatility: statuses come back as the integer values of ImpliedVolStatus
+    py::enum_<ImpliedVolStatus>(m, "ImpliedVolStatus")
+        .value("CONVERGED", ImpliedVolStatus::CONVERGED)
+        .value("MAX_ITERATIONS", ImpliedVolStatus::MAX_ITERATIONS)
+        .value("BELOW_INTRINSIC", ImpliedVolStatus::BELOW_INTRINSIC)
+        .value("ABOVE_MAXIMUM", ImpliedVolStatus::ABOVE_MAXIMUM)
+        .value("INVALID_INPUT", ImpliedVolStatus::INVALID_INPUT);
+
+    m.def("implied_volatility",
+          [](OptionType type, double option_price, double strike, double price, double time, double rate) {
+              return implied_volatility(type, option_price, strike, price, time, rate);
+          },
+          "Black Scholes implied volatility (NaN when the price has no solution)",
+          py::arg("type"), py::arg("option_price"), py::arg("strike"), py::arg("price"), py::arg("time"), py::arg("rate"));
+
+    m.def("parallel_implied_volatility",
+          [](IntArray types, DoubleArray option_prices, DoubleArray strikes, DoubleArray prices, DoubleArray times,
+             DoubleArray rates) {
+              std::vector<OptionType> option_types =
+                  option_types_from(types, {&option_prices, &strikes, &prices, &times, &rates});
+              size_t n = option_types.size();
+
+              py::array_t<double> result(n);
+              std::vector<ImpliedVolStatus> status(n);
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  parallel_implied_volatility(option_types.data(), option_prices.data(), strikes.data(),
+                                              prices.data(), times.data(), rates.data(), out, status.data(), n);
+              }
+
+              py::array_t<int> codes(n);
+              int* code = codes.mutable_data();
+              for (size_t i = 0; i < n; ++i) {
+                  code[i] = static_cast<int>(status[i]);
+              }
+              return py::make_tuple(result, codes);
+          },
+          "Multithreaded implied volatilities over arrays, returned as (volatilities, statuses)",
+          py::arg("types"), py::arg("option_prices"), py::arg("strikes"), py::arg("prices"), py::arg("times"),
+          py::arg("rates"));
+
+    // Implied volatility surface over a strike x expiry grid
+    py::enum_<VolInterpolation>(m, "VolInterpolation")
+        .value("BICUBIC", VolInterpolation::BICUBIC)
+        .value("SVI", VolInterpolation::SVI);
+
+    py::class_<SviParameters>(m, "SviParameters", "Raw SVI smile in log strike")
+        .def_readonly("a", &SviParameters::a)
+        .def_readonly("b", &SviParameters::b)
+        .def_readonly("rho", &SviParameters::rho)
+        .def_readonly("m", &SviParameters::m)
+        .def_readonly("sigma", &SviParameters::sigma);
+
+    py::class_<VolSurface>(m, "VolSurface", "Implied volatility surface interpolated in total variance")
+        .def(py::init([](std::vector<double> strikes, std::vector<double> expiries, DoubleArray volatilities,
+                         VolInterpolation method) {
+                 if (volatilities.ndim() != 2 || static_cast<size_t>(volatilities.shape(0)) != expiries.size() ||
+                     static_cast<size_t>(volatilities.shape(1)) != strikes.size()) {
+                     throw std::invalid_argument("volatilities must have shape (len(expiries), len(strikes)).");
+                 }
+                 const double* vols = volatilities.data();
+                 return VolSurface(std::move(strikes), std::move(expiries),
+                                   std::vector<double>(vols, vols + volatilities.size()), method);
+             }),
+             "volatilities: array of shape (len(expiries), len(strikes))", py::arg("strikes"), py::arg("expiries"),
+             py::arg("volatilities"), py::arg("method") = VolInterpolation::BICUBIC)
+        .def_property_readonly("method", &VolSurface::method)
+        .def_property_readonly("strikes", &VolSurface::strikes)
+        .def_property_readonly("expiries", &VolSurface::expiries)
+        .def("quote", &VolSurface::quote, "Quoted volatility at a grid point", py::arg("strike_index"),
+             py::arg("expiry_index"))
+        .def("volatility", &VolSurface::volatility, "Interpolated volatility", py::arg("strike"), py::arg("time"))
+        .def("volatility",
+             [](const VolSurface& surface, DoubleArray strikes, DoubleArray times) {
+                 if (strikes.size() != times.size()) {
+                     throw std::invalid_argument("All inputs must have the same length.");
+                 }
+                 size_t n = static_cast<size_t>(strikes.size());
+                 py::array_t<double> result(n);
+                 double* out = result.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     surface.volatility_batch(strikes.data(), times.data(), out, n);
+                 }
+                 return result;
+             },
+             "Interpolated volatilities over arrays", py::arg("strikes"), py::arg("times"))
+        .def("total_variance", &VolSurface::total_variance, "Interpolated total variance sigma^2 T",
+             py::arg("strike"), py::arg("time"))
+        .def("update", static_cast<void (VolSurface::*)(size_t, size_t, double)>(&VolSurface::update),
+             "Replace one quote and rebuild what depends on it", py::arg("strike_index"), py::arg("expiry_index"),
+             py::arg("volatility"))
+        .def("update",
+             [](VolSurface& surface, const std::vector<std::tuple<size_t, size_t, double>>& quotes) {
+                 std::vector<VolQuote> changes;
+                 for (const auto& quote : quotes) {
+                     changes.push_back({std::get<0>(quote), std::get<1>(quote), std::get<2>(quote)});
+                 }
+                 surface.update(changes.data(), changes.size());
+             },
+             "Replace quotes given as (strike_index, expiry_index, volatility) and rebuild what depends on them",
+             py::arg("quotes"))
+        .def("svi_slice", &VolSurface::svi_slice, "Fitted SVI smile of an expiry", py::arg("expiry_index"));
+
+    m.def("black_scholes_batch",
+          [](IntArray types, DoubleArray strikes, DoubleArray prices, DoubleArray times, DoubleArray rates,
+             const VolSurface& surface) {
+              std::vector<OptionType> option_types = option_types_from(types, {&strikes, &prices, &times, &rates});
+              size_t n = option_types.size();
+
+              py::array_t<double> result(n);
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  black_scholes_batch(option_types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                                      surface, out, n);
+              }
+              return result;
+          },
+          "Vectorized Black Scholes pricing with volatilities looked up on a surface",
+          py::arg("types"), py::arg("strikes"), py::arg("prices"), py::arg("times"), py::arg("rates"), py::arg("surface"));
+
+    // Monte Carlo pricing of path-dependent payoffs
+    py::enum_<PathPayoff>(m, "PathPayoff")
+        .value("EUROPEAN", PathPayoff::EUROPEAN)
+        .value("ASIAN_ARITHMETIC", PathPayoff::ASIAN_ARITHMETIC)
+        .value("ASIAN_GEOMETRIC", PathPayoff::ASIAN_GEOMETRIC)
+        .value("UP_AND_OUT", PathPayoff::UP_AND_OUT)
+        .value("UP_AND_IN", PathPayoff::UP_AND_IN)
+        .value("DOWN_AND_OUT", PathPayoff::DOWN_AND_OUT)
+        .value("DOWN_AND_IN", PathPayoff::DOWN_AND_IN)
+        .value("LOOKBACK_FIXED", PathPayoff::LOOKBACK_FIXED)
+        .value("LOOKBACK_FLOATING", PathPayoff::LOOKBACK_FLOATING);
+
+    py::enum_<RandomSource>(m, "RandomSource")
+        .value("PHILOX", RandomSource::PHILOX)
+        .value("SOBOL", RandomSource::SOBOL);
+
+    py::class_<MonteCarloSettings>(m, "MonteCarloSettings", "Path count, time steps and variance reduction")
+        .def(py::init<>())
+        .def_readwrite("paths", &MonteCarloSettings::paths)
+        .def_readwrite("steps", &MonteCarloSettings::steps)
+        .def_readwrite("seed", &MonteCarloSettings::seed)
+        .def_readwrite("source", &MonteCarloSettings::source)
+        .def_readwrite("antithetic", &MonteCarloSettings::antithetic)
+        .def_readwrite("control_variate", &MonteCarloSettings::control_variate);
+
+    py::class_<MonteCarloResult>(m, "MonteCarloResult", "Monte Carlo price estimate")
+        .def_readonly("price", &MonteCarloResult::price)
+        .def_readonly("std_error", &MonteCarloResult::std_error)
+        .def_readonly("paths", &MonteCarloResult::paths);
+
+    m.def("monte_carlo_price",
+          [](OptionType type, PathPayoff payoff, double S0, double K, double T, double r, double sigma, double barrier,
+             const MonteCarloSettings& settings) {
+              return monte_carlo_price(type, payoff, S0, K, T, r, sigma, barrier, settings);
+          },
+          "Multithreaded Monte Carlo pricing of path-dependent options",
+          py::arg("type"), py::arg("payoff"), py::arg("S0"), py::arg("K"), py::arg("T"), py::arg("r"), py::arg("sigma"),
+          py::arg("barrier") = 0.0, py::arg("settings") = MonteCarloSettings(),
+          py::call_guard<py::gil_scoped_release>());
+
+    // Trinomial lattice with adaptive mesh refinement (vanilla and barrier payoffs)
+    py::class_<TrinomialSettings>(m, "TrinomialSettings", "Node spacing, mesh refinement and barrier fitting")
+        .def(py::init<>())
+        .def_readwrite("stretch", &TrinomialSettings::stretch)
+        .def_readwrite("refinement_levels", &TrinomialSettings::refinement_levels)
+        .def_readwrite("fit_barrier", &TrinomialSettings::fit_barrier);
+
+    m.def("trinomial_lattice_pricing", &trinomial_lattice_pricing,
+          "Trinomial lattice pricing of vanilla and barrier options with early exercise",
+          py::arg("type"), py::arg("style"), py::arg("S0"), py::arg("K"), py::arg("T"), py::arg("r"), py::arg("sigma"),
+          py::arg("N"), py::arg("payoff") = PathPayoff::EUROPEAN, py::arg("barrier") = 0.0,
+          py::arg("settings") = TrinomialSettings(), py::arg("exercise_times") = std::vector<double>{},
+          py::call_guard<py::gil_scoped_release>());
+
+    // Memo of pricer results; lookups release the GIL, so Python threads share one cache
+    py::class_<PricingCache>(m, "PricingCache", "Sharded LRU cache of pricer results keyed on quantized inputs")
+        .def(py::init<size_t, double, size_t>(),
+             "tolerance in [0, 0.25); 0 keys on exact inputs. num_shards = 0 picks a count from the hardware "
+             "threads",
+             py::arg("capacity") = 65536, py::arg("tolerance") = 0.0, py::arg("num_shards") = 0)
+        .def("black_scholes", &PricingCache::black_scholes, "Cached Black-Scholes price", py::arg("type"),
+             py::arg("strike"), py::arg("price"), py::arg("time"), py::arg("rate"), py::arg("volatility"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("binomial_option_pricing", &PricingCache::binomial_option_pricing, "Cached binomial price",
+             py::arg("type"), py::arg("S0"), py::arg("K"), py::arg("T"), py::arg("r"), py::arg("sigma"), py::arg("N"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("binomial_lattice_pricing", &PricingCache::binomial_lattice_pricing,
+             "Cached binomial lattice price (Bermudan calls with exercise times are not cached)",
+             py::arg("type"), py::arg("style"), py::arg("S0"), py::arg("K"), py::arg("T"), py::arg("r"),
+             py::arg("sigma"), py::arg("N"), py::arg("method") = BinomialMethod::CRR,
+             py::arg("exercise_times") = std::vector<double>{}, py::call_guard<py::gil_scoped_release>())
+        .def("stats",
+             [](const PricingCache& cache) {
+                 PricingCacheStats stats = cache.stats();
+                 py::dict result;
+                 result["hits"] = stats.hits;
+                 result["misses"] = stats.misses;
+                 result["evictions"] = stats.evictions;
+                 result["size"] = stats.size;
+                 result["capacity"] = stats.capacity;
+                 result["hit_rate"] = stats.hit_rate();
+                 return result;
+             },
+             "Hits, misses, evictions, size, capacity and hit rate")
+        .def("reset_stats", &PricingCache::reset_stats, "Start the counters from zero")
+        .def("clear", &PricingCache::clear, "Drop every entry")
+        .def("resize", &PricingCache::resize, "Change the capacity, evicting least recently used entries",
+             py::arg("capacity"))
+        .def("__len__", [](const PricingCache& cache) { return cache.stats().size; })
+        .def_property_readonly("capacity", &PricingCache::capacity)
+        .def_property_readonly("shard_count", &PricingCache::shard_count)
+        .def_property_readonly("tolerance", &PricingCache::tolerance);
+
+    m.def("default_pricing_cache", &default_pricing_cache, "Process-wide pricing cache (65536 entries, exact keys)",
+          py::return_value_policy::reference);
+
+    // Stress-grid revaluation: the P&L cube comes back summed by book
+    py::enum_<ScenarioModel>(m, "ScenarioModel")
+        .value("BLACK_SCHOLES", ScenarioModel::BLACK_SCHOLES)
+        .value("BINOMIAL", ScenarioModel::BINOMIAL);
+
+    m.def("scenario_pnl",
+          [](IntArray types, DoubleArray strikes, DoubleArray prices, DoubleArray times, DoubleArray rates,
+             DoubleArray volatilities, DoubleArray quantities, std::vector<double> spot_shocks,
+             std::vector<double> vol_shocks, std::vector<double> time_shifts, std::optional<IntArray> books,
+             ScenarioModel model, ExerciseStyle style, long steps, BinomialMethod method,
+             std::vector<double> exercise_times) {
+              std::vector<OptionType> option_types =
+                  option_types_from(types, {&strikes, &prices, &times, &rates, &volatilities, &quantities});
+              size_t n = option_types.size();
+
+              std::vector<size_t> book_index;
+              size_t num_books = 1;
+              if (books) {
+                  if (static_cast<size_t>(books->size()) != n) {
+                      throw std::invalid_argument("All inputs must have the same length.");
+                  }
+                  const int* raw_books = books->data();
+                  for (size_t i = 0; i < n; ++i) {
+                      if (raw_books[i] < 0) {
+                          throw std::invalid_argument("Book indices must be non-negative.");
+                      }
+                      book_index.push_back(static_cast<size_t>(raw_books[i]));
+                      num_books = std::max(num_books, book_index.back() + 1);
+                  }
+              }
+
+              StressGrid grid{std::move(spot_shocks), std::move(vol_shocks), std::move(time_shifts)};
+              ScenarioSettings settings;
+              settings.model = model;
+              settings.style = style;
+              settings.steps = steps;
+              settings.method = method;
+              settings.exercise_times = std::move(exercise_times);
+
+              py::array_t<double> result(std::vector<py::ssize_t>{
+                  static_cast<py::ssize_t>(num_books), static_cast<py::ssize_t>(grid.time_shifts.size()),
+                  static_cast<py::ssize_t>(grid.vol_shocks.size()), static_cast<py::ssize_t>(grid.spot_shocks.size())});
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  scenario_pnl(option_types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                               volatilities.data(), quantities.data(), books ? book_index.data() : nullptr, n,
+                               num_books, grid, out, settings);
+              }
+              return result;
+          },
+          "P&L of a portfolio over a spot x vol x time stress grid, summed by book, as an array of shape "
+          "(books, time_shifts, vol_shocks, spot_shocks)",
+          py::arg("types"), py::arg("strikes"), py::arg("prices"), py::arg("times"), py::arg("rates"),
+          py::arg("volatilities"), py::arg("quantities"), py::arg("spot_shocks"), py::arg("vol_shocks"),
+          py::arg("time_shifts"), py::arg("books") = py::none(), py::arg("model") = ScenarioModel::BLACK_SCHOLES,
+          py::arg("style") = ExerciseStyle::EUROPEAN, py::arg("steps") = 200, py::arg("method") = BinomialMethod::CRR,
+          py::arg("exercise_times") = std::vector<double>{});
+
+    py::enum_<IndicatorType>(m, "IndicatorType")
+        .value("SMA", IndicatorType::SMA)
+        .value("VOLATILITY", IndicatorType::VOLATILITY)
+        .value("RSI", IndicatorType::RSI)
+        .value("EMA", IndicatorType::EMA)
+        .value("DEMA", IndicatorType::DEMA)
+        .value("TEMA", IndicatorType::TEMA)
+        .value("WMA", IndicatorType::WMA);
+
+    m.def("parallel_indicators",
+          [](const std::vector<DoubleArray>& series, IndicatorType indicator, size_t window_size) {
+              size_t count = series.size();
+              std::vector<const double*> inputs(count);
+              std::vector<size_t> lengths(count);
+              std::vector<double*> outputs(count);
+              py::list result;
+              for (size_t i = 0; i < count; ++i) {
+                  inputs[i] = series[i].data();
+                  lengths[i] = static_cast<size_t>(series[i].size());
+                  py::array_t<double> values(indicator_output_size(indicator, lengths[i], window_size));
+                  outputs[i] = values.mutable_data();
+                  result.append(values);
+              }
+              {
+                  py::gil_scoped_release release;
+                  parallel_indicators(inputs.data(), lengths.data(), count, indicator, window_size, outputs.data());
+              }
+              return result;
+          },
+          "Compute one indicator over many price series in parallel, in input order",
+          py::arg("series"), py::arg("indicator"), py::arg("window_size"));
+
+    py::class_<IndicatorPipeline>(m, "IndicatorPipeline",
+                                  "Several indicators computed together in one fused pass per series")
+        .def(py::init([](const std::vector<std::pair<IndicatorType, size_t>>& indicators) {
+                 std::vector<IndicatorSpec> specs;
+                 for (const auto& indicator : indicators) {
+                     specs.push_back({indicator.first, indicator.second});
+                 }
+                 return IndicatorPipeline(specs);
+             }),
+             "indicators: list of (IndicatorType, window_size)", py::arg("indicators"))
+        .def("compute",
+             [](const IndicatorPipeline& pipeline, DoubleArray prices) {
+                 // 1-D prices give one array per indicator. 2-D prices of shape (tickers, time)
+                 // give one (tickers, values) array per indicator, all views of one buffer.
+                 if (prices.ndim() != 1 && prices.ndim() != 2) {
+                     throw std::invalid_argument("prices must be 1-D or 2-D (tickers, time).");
+                 }
+                 size_t columns = prices.ndim() == 2 ? static_cast<size_t>(prices.shape(0)) : 1;
+                 size_t rows = static_cast<size_t>(prices.shape(prices.ndim() - 1));
+                 size_t stride = pipeline.column_size(rows);
+                 py::array_t<double> buffer({columns, stride});
+                 const double* in = prices.data();
+                 double* out = buffer.mutable_data();
+                 {
+                     py::gil_scoped_release release;
+                     pipeline.compute(in, rows, columns, out);
+                 }
+
+                 py::list result;
+                 for (size_t k = 0; k < pipeline.indicators().size(); ++k) {
+                     double* values = out + pipeline.offset(k, rows);
+                     size_t size = pipeline.output_size(k, rows);
+                     if (prices.ndim() == 1) {
+                         result.append(py::array_t<double>({size}, {sizeof(double)}, values, buffer));
+                     } else {
+                         result.append(py::array_t<double>({columns, size}, {stride * sizeof(double), sizeof(double)},
+                                                           values, buffer));
+                     }
+                 }
+                 return result;
+             },
+             "Compute every indicator, with tickers spread across threads", py::arg("prices"))
+        .def("column_size", &IndicatorPipeline::column_size, "Values produced for a series of n prices",
+             py::arg("n"));
+
+    // Memory-mapped series store for data sets larger than memory
+    py::enum_<ColumnType>(m, "ColumnType")
+        .value("FLOAT64", ColumnType::FLOAT64)
+        .value("TIMESTAMP", ColumnType::TIMESTAMP)
+        .export_values();
+
+    py::class_<SeriesStoreWriter>(m, "SeriesStoreWriter", "Writes a columnar series store file")
+        .def(py::init([](const std::string& path, const std::vector<std::pair<std::string, ColumnType>>& columns,
+                         size_t capacity) {
+                 std::vector<ColumnSpec> specs;
+                 for (const auto& column : columns) {
+                     specs.push_back({column.first, column.second});
+                 }
+                 return std::unique_ptr<SeriesStoreWriter>(new SeriesStoreWriter(path, specs, capacity));
+             }),
+             "columns: list of (name, ColumnType); capacity: rows reserved per column",
+             py::arg("path"), py::arg("columns"), py::arg("capacity"))
+        .def("append",
+             [](SeriesStoreWriter& writer, size_t column, py::array values) {
+                 // Convert to the column's own type, so int64 timestamps never pass through double
+                 if (writer.column(column).type == ColumnType::TIMESTAMP) {
+                     auto timestamps = py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(values);
+                     if (!timestamps) {
+                         throw py::error_already_set();
+                     }
+                     writer.append(column, timestamps.data(), static_cast<size_t>(timestamps.size()));
+                 } else {
+                     DoubleArray doubles = DoubleArray::ensure(values);
+                     if (!doubles) {
+                         throw py::error_already_set();
+                     }
+                     writer.append(column, doubles.data(), static_cast<size_t>(doubles.size()));
+                 }
+             },
+             "Append values to a column", py::arg("column"), py::arg("values"))
+        .def("rows", &SeriesStoreWriter::rows, "Rows written so far to a column", py::arg("column"))
+        .def("close", &SeriesStoreWriter::close, "Record the row count and close the file")
+        .def("__enter__", [](SeriesStoreWriter& writer) -> SeriesStoreWriter& { return writer; },
+             py::return_value_policy::reference)
+        .def("__exit__", [](SeriesStoreWriter& writer, py::object, py::object, py::object) { writer.close(); });
+
+    py::class_<SeriesStore>(m, "SeriesStore", "Read-only memory-mapped series store")
+        .def(py::init<const std::string&>(), py::arg("path"))
+        .def_property_readonly("rows", &SeriesStore::rows)
+        .def_property_readonly("columns", [](const SeriesStore& store) {
+            std::vector<std::pair<std::string, ColumnType>> columns;
+            for (size_t c = 0; c < store.column_count(); ++c) {
+                columns.emplace_back(store.column(c).name, store.column(c).type);
+            }
+            return columns;
+        })
+        .def("column_index", &SeriesStore::column_index, py::arg("name"))
+        .def("values",
+             [](py::object self, size_t column) {
+                 // Read-only view of the mapping; the array keeps the store (and mapping) alive
+                 const SeriesStore& store = self.cast<const SeriesStore&>();
+                 py::array result;
+                 if (store.column(column).type == ColumnType::TIMESTAMP) {
+                     result = py::array_t<int64_t>({store.rows()}, {sizeof(int64_t)}, store.timestamps(column), self);
+                 } else {
+                     result = py::array_t<double>({store.rows()}, {sizeof(double)}, store.values(column), self);
+                 }
+                 result.attr("setflags")(py::arg("write") = false);
+                 return result;
+             },
+             "Column as a read-only NumPy array backed by the file", py::arg("column"));
+
+    m.def("compute_indicators",
+          [](const SeriesStore& store, size_t column, const IndicatorPipeline& pipeline, size_t chunk_rows,
+             py::function sink) {
+              py::gil_scoped_release release;
+              compute_indicators(store, column, pipeline, chunk_rows,
+                                 [&](size_t k, size_t first, const double* values, size_t count) {
+                                     py::gil_scoped_acquire acquire;
+                                     // Copied: the chunk buffer is reused for the next chunk
+                                     sink(k, first, py::array_t<double>(count, values));
+                                 });
+          },
+          "Run a pipeline over a store column chunk_rows rows at a time, calling "
+          "sink(indicator_index, first_output_index, values) for each chunk",
+          py::arg("store"), py::arg("column"), py::arg("pipeline"), py::arg("chunk_rows"), py::arg("sink"));
+
+    // Time-series indicators read float64 (or, through the second overload, float32) buffers
+    // in place and return NumPy arrays of the same dtype
+    m.def("rolling_volatility",
+          [](DoubleArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::VOLATILITY, prices, window_size);
+          },
+          "Rolling Volatility", py::arg("prices"), py::arg("window_size"));
+    m.def("rolling_volatility",
+          [](FloatArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::VOLATILITY, prices, window_size);
+          },
+          "Rolling Volatility in float32", py::arg("prices"), py::arg("window_size"));
+
+    m.def("simple_moving_average",
+          [](DoubleArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::SMA, prices, window_size);
+          },
+          "Simple Moving Average", py::arg("prices"), py::arg("window_size"));
+    m.def("simple_moving_average",
+          [](FloatArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::SMA, prices, window_size);
+          },
+          "Simple Moving Average in float32", py::arg("prices"), py::arg("window_size"));
+
+    m.def("rsi",
+          [](DoubleArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::RSI, prices, window_size);
+          },
+          "Relative Strength Index(RSI)", py::arg("prices"), py::arg("window_size"));
+    m.def("rsi",
+          [](FloatArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::RSI, prices, window_size);
+          },
+          "Relative Strength Index(RSI) in float32", py::arg("prices"), py::arg("window_size"));
+
+    m.def("exponential_moving_average",
+          [](DoubleArray prices, size_t span) { return indicator_array(IndicatorType::EMA, prices, span); },
+          "Exponential Moving Average", py::arg("prices"), py::arg("span"));
+    m.def("exponential_moving_average",
+          [](FloatArray prices, size_t span) { return indicator_array(IndicatorType::EMA, prices, span); },
+          "Exponential Moving Average in float32", py::arg("prices"), py::arg("span"));
+
+    m.def("double_exponential_moving_average",
+          [](DoubleArray prices, size_t span) { return indicator_array(IndicatorType::DEMA, prices, span); },
+          "Double Exponential Moving Average", py::arg("prices"), py::arg("span"));
+    m.def("double_exponential_moving_average",
+          [](FloatArray prices, size_t span) { return indicator_array(IndicatorType::DEMA, prices, span); },
+          "Double Exponential Moving Average in float32", py::arg("prices"), py::arg("span"));
+
+    m.def("triple_exponential_moving_average",
+          [](DoubleArray prices, size_t span) { return indicator_array(IndicatorType::TEMA, prices, span); },
+          "Triple Exponential Moving Average", py::arg("prices"), py::arg("span"));
+    m.def("triple_exponential_moving_average",
+          [](FloatArray prices, size_t span) { return indicator_array(IndicatorType::TEMA, prices, span); },
+          "Triple Exponential Moving Average in float32", py::arg("prices"), py::arg("span"));
+
+    m.def("weighted_moving_average",
+          [](DoubleArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::WMA, prices, window_size);
+          },
+          "Weighted Moving Average", py::arg("prices"), py::arg("window_size"));
+    m.def("weighted_moving_average",
+          [](FloatArray prices, size_t window_size) {
+              return indicator_array(IndicatorType::WMA, prices, window_size);
+          },
+          "Weighted Moving Average in float32", py::arg("prices"), py::arg("window_size"));
+
+    m.def("moving_averages",
+          [](DoubleArray prices, IndicatorType indicator, const std::vector<size_t>& spans) {
+              size_t n = static_cast<size_t>(prices.size());
+              std::vector<double*> outputs(spans.size());
+              py::list result;
+              for (size_t k = 0; k < spans.size(); ++k) {
+                  py::array_t<double> values(indicator_output_size(indicator, n, spans[k]));
+                  outputs[k] = values.mutable_data();
+                  result.append(values);
+              }
+              const double* in = prices.data();
+              {
+                  py::gil_scoped_release release;
+                  moving_averages(indicator, in, n, spans.data(), spans.size(), outputs.data(),
+                                  thread_scratch_arena());
+              }
+              return result;
+          },
+          "One moving average (EMA, DEMA, TEMA or WMA) for several spans in a single pass, in span order",
+          py::arg("prices"), py::arg("indicator"), py::arg("spans"));
+
+    // Streaming indicators for tick-by-tick updates
+    bind_streaming_indicator<RollingSMA>(m, "RollingSMA", "Streaming Simple Moving Average", "window_size");
+    bind_streaming_indicator<RollingVolatility>(m, "RollingVolatility", "Streaming Rolling Volatility", "window_size");
+    bind_streaming_indicator<WilderRSI>(m, "WilderRSI", "Streaming Relative Strength Index (Wilder smoothing)", "period");
+    bind_streaming_indicator<RollingEMA>(m, "RollingEMA", "Streaming Exponential Moving Average", "span");
+    bind_streaming_indicator<RollingDEMA>(m, "RollingDEMA", "Streaming Double Exponential Moving Average", "span");
+    bind_streaming_indicator<RollingTEMA>(m, "RollingTEMA", "Streaming Triple Exponential Moving Average", "span");
+    bind_streaming_indicator<RollingWMA>(m, "RollingWMA", "Streaming Weighted Moving Average", "window_size");
+
+    // Rolling statistics: float64 or float32 buffers read in place, results of the same dtype
+    bind_rolling_statistic(m, "rolling_max", "Rolling maximum", &rolling_max<double>, &rolling_max<float>);
+    bind_rolling_statistic(m, "rolling_min", "Rolling minimum", &rolling_min<double>, &rolling_min<float>);
+    bind_rolling_statistic(m, "rolling_median", "Rolling median", &rolling_median<double>, &rolling_median<float>);
+    bind_rolling_statistic(m, "rolling_skewness", "Rolling skewness (bias-corrected, as pandas)",
+                           &rolling_skewness<double>, &rolling_skewness<float>);
+    bind_rolling_statistic(m, "rolling_kurtosis", "Rolling excess kurtosis (bias-corrected, as pandas)",
+                           &rolling_kurtosis<double>, &rolling_kurtosis<float>);
+    bind_rolling_statistic(m, "rolling_zscore", "Rolling z-score of each value against its window",
+                           &rolling_zscore<double>, &rolling_zscore<float>);
+
+    m.def("rolling_quantile",
+          [](DoubleArray data, size_t window_size, double q) {
+              check_quantile(q);
+              size_t n = static_cast<size_t>(data.size());
+              py::array_t<double> result(rolling_output_size(n, window_size));
+              const double* in = data.data();
+              double* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  rolling_quantile(in, n, window_size, q, out, thread_scratch_arena());
+              }
+              return result;
+          },
+          "Rolling quantile, interpolated linearly like numpy.quantile", py::arg("data"), py::arg("window_size"),
+          py::arg("q"));
+    m.def("rolling_quantile",
+          [](FloatArray data, size_t window_size, double q) {
+              check_quantile(q);
+              size_t n = static_cast<size_t>(data.size());
+              py::array_t<float> result(rolling_output_size(n, window_size));
+              const float* in = data.data();
+              float* out = result.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  rolling_quantile(in, n, window_size, q, out, thread_scratch_arena());
+              }
+              return result;
+          },
+          "Rolling quantile in float32", py::arg("data"), py::arg("window_size"), py::arg("q"));
 
-    m.def("simple_moving_average", &simple_moving_average, "Simple Moving Average",
-          py::arg("prices"), py::arg("window_size"));
+    m.def("rolling_quantiles",
+          [](DoubleArray data, size_t window_size, const std::vector<double>& qs) {
+              for (double q : qs) {
+                  check_quantile(q);
+              }
+              size_t n = static_cast<size_t>(data.size());
+              std::vector<double*> outputs(qs.size());
+              py::list result;
+              for (size_t k = 0; k < qs.size(); ++k) {
+                  py::array_t<double> values(rolling_output_size(n, window_size));
+                  outputs[k] = values.mutable_data();
+                  result.append(values);
+              }
+              const double* in = data.data();
+              {
+                  py::gil_scoped_release release;
+                  rolling_quantiles(in, n, window_size, qs.data(), qs.size(), outputs.data(),
+                                    thread_scratch_arena());
+              }
+              return result;
+          },
+          "Several rolling quantiles from one sorted window, in the order given", py::arg("data"),
+          py::arg("window_size"), py::arg("qs"));
 
-    m.def("rsi", &compute_rsi, "Relative Strength Index(RSI)",
-          py::arg("prices"), py::arg("window_size"));
+    bind_streaming_indicator<RollingMax>(m, "RollingMax", "Streaming rolling maximum", "window_size");
+    bind_streaming_indicator<RollingMin>(m, "RollingMin", "Streaming rolling minimum", "window_size");
+    bind_streaming_indicator<RollingSkewness>(m, "RollingSkewness", "Streaming rolling skewness", "window_size");
+    bind_streaming_indicator<RollingKurtosis>(m, "RollingKurtosis", "Streaming rolling excess kurtosis",
+                                              "window_size");
+    bind_streaming_indicator<RollingZScore>(m, "RollingZScore", "Streaming rolling z-score", "window_size");
+    bind_streaming_methods<RollingQuantile>(m, "RollingQuantile", "Streaming rolling quantile")
+        .def(py::init<size_t, double>(), py::arg("window_size"), py::arg("q"))
+        .def(py::pickle(
+            [](const RollingQuantile& indicator) { return indicator.snapshot(); },
+            [](const std::vector<double>& state) {
+                RollingQuantile indicator(snapshot_window_size(state), snapshot_quantile(state));
+                indicator.restore(state);
+                return indicator;
+            }));
 }
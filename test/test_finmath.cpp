@@ -1,19 +1,102 @@
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 #include "finmath/finmath.h"
 #include "finmath/OptionPricing/black_scholes.h"
+#include "finmath/Helper/simd.h"
+#include "finmath/OptionPricing/greeks.h"
+#include "finmath/OptionPricing/implied_volatility.h"
+#include "finmath/Helper/thread_pool.h"
+#include "finmath/OptionPricing/parallel_pricing.h"
+#include "finmath/TimeSeries/parallel_indicators.h"
+#include "finmath/TimeSeries/series_store.h"
+#include "finmath/OptionPricing/vol_surface.h"
+#include "finmath/OptionPricing/finite_difference.h"
+#include "finmath/Helper/tridiagonal.h"
+#include "finmath/TimeSeries/moving_averages.h"
+#include "finmath/Helper/instrumentation.h"
+#include "finmath/TimeSeries/rolling_statistics.h"
+#include "finmath/InterestAndAnnuities/cash_flows.h"
+#include "finmath/Helper/normal_distribution.h"
+#include "finmath/OptionPricing/pricing_cache.h"
+#include "finmath/OptionPricing/scenario_engine.h"
+#include "finmath/OptionPricing/trinomial_tree.h"
+#include "finmath/OptionPricing/pricing_service.h"
+#include "finmath/Helper/scratch_arena.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <new>
+#include <thread>
 
 int compound_interest_tests();
 int black_scholes_tests();
 int rsi_tests();
+int rolling_window_tests();
+int streaming_indicator_tests();
+int black_scholes_batch_tests();
+int greeks_tests();
+int binomial_option_pricing_tests();
+int parallel_tests();
+int span_indicator_tests();
+int monte_carlo_tests();
+int implied_volatility_tests();
+int indicator_pipeline_tests();
+int series_store_tests();
+int float_kernel_tests();
+int vol_surface_tests();
+int finite_difference_tests();
+int moving_average_tests();
+int instrumentation_tests();
+int rolling_statistics_tests();
+int cash_flow_tests();
+int normal_distribution_tests();
+int pricing_cache_tests();
+int scenario_engine_tests();
+int trinomial_tree_tests();
+int scratch_arena_tests();
+int pricing_service_tests();
 
 int main() {
     std::cout << "Starting Unit Tests\n";
     compound_interest_tests();
     black_scholes_tests();
+    black_scholes_batch_tests();
+    greeks_tests();
+    binomial_option_pricing_tests();
     rsi_tests();
+    rolling_window_tests();
+    streaming_indicator_tests();
+    parallel_tests();
+    span_indicator_tests();
+    monte_carlo_tests();
+    implied_volatility_tests();
+    indicator_pipeline_tests();
+    series_store_tests();
+    float_kernel_tests();
+    vol_surface_tests();
+    finite_difference_tests();
+    moving_average_tests();
+    instrumentation_tests();
+    rolling_statistics_tests();
+    cash_flow_tests();
+    normal_distribution_tests();
+    pricing_cache_tests();
+    scenario_engine_tests();
+    trinomial_tree_tests();
+    scratch_arena_tests();
+    pricing_service_tests();
 
     return 0;
 }
@@ -23,6 +106,61 @@ bool almost_equal(double a, double b, double tolerance) {
     return std::abs(a - b) <= tolerance * std::max(std::abs(a), std::abs(b));
 }
 
+// Element-wise equality where NaN matches NaN
+bool same_values(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i] && !(std::isnan(a[i]) && std::isnan(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Counts every global operator new, so tests can assert that a steady-state loop stays off
+// the heap
+
+std::atomic<size_t> heap_allocation_count{0};
+
+void* counted_allocation(size_t size, size_t alignment) {
+    heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    size = size == 0 ? 1 : size;
+    void* p = alignment <= alignof(std::max_align_t)
+                  ? std::malloc(size)
+                  : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new(size_t size) {
+    return counted_allocation(size, 0);
+}
+
+void* operator new[](size_t size) {
+    return counted_allocation(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return counted_allocation(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return counted_allocation(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
 // Unit Tests
 
 int compound_interest_tests() {
@@ -225,9 +363,185 @@ int black_scholes_tests() {
     return 0;
 }
 
+int black_scholes_batch_tests() {
+    double tolerance = 1e-12;
+
+    // Contract grid covering ITM/OTM, short/long expiries and low/high vols; 1001 is
+    // deliberately not a multiple of the vector width so the tail path is exercised
+    size_t n = 1001;
+    std::vector<OptionType> types(n);
+    std::vector<double> strikes(n), prices(n), times(n), rates(n), vols(n), expected(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+        types[i] = (i % 2 == 0) ? OptionType::CALL : OptionType::PUT;
+        strikes[i] = 50.0 + 0.1 * i;
+        prices[i] = 100.0;
+        times[i] = 0.01 + 0.005 * (i % 997);
+        rates[i] = 0.0001 * (i % 100);
+        vols[i] = 0.05 + 0.01 * (i % 89);
+        expected[i] = black_scholes(types[i], strikes[i], prices[i], times[i], rates[i], vols[i]);
+    }
+
+    // Test 1: Every kernel the CPU supports matches the scalar pricer
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        set_simd_level(level);
+        black_scholes_batch(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                            out.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(std::abs(out[i] - expected[i]) <= tolerance * std::max(1.0, expected[i]));
+        }
+    }
+    set_simd_level(detect_simd_level());
+
+    // Test 2: Batch of one prices the reference call
+    {
+        OptionType type = OptionType::CALL;
+        double strike = 100, price = 105, time = 1, rate = 0.05, vol = 0.2, result = 0.0;
+        black_scholes_batch(&type, &strike, &price, &time, &rate, &vol, &result, 1);
+        assert(almost_equal(result, 13.8579, 0.001));
+    }
+
+    std::cout << "Black-Scholes Batch Tests Passed!" << std::endl;
+    return 0;
+}
+
+int greeks_tests() {
+    double tolerance = 1e-4;
+
+    // Central differences of black_scholes as the reference
+    auto price_at = [](OptionType type, double S, double T, double r, double vol) {
+        return black_scholes(type, 100.0, S, T, r, vol);
+    };
+
+    for (OptionType type : {OptionType::CALL, OptionType::PUT}) {
+        double S = 105, T = 0.75, r = 0.03, vol = 0.25;
+        double hS = 1e-2, hv = 1e-4, ht = 1e-4, hr = 1e-5;
+        Greeks g = black_scholes_greeks(type, 100.0, S, T, r, vol);
+
+        // Test 1: Price and first-order Greeks
+        assert(almost_equal(g.price, price_at(type, S, T, r, vol), 1e-12));
+        assert(almost_equal(g.delta, (price_at(type, S + hS, T, r, vol) - price_at(type, S - hS, T, r, vol)) / (2 * hS), tolerance));
+        assert(almost_equal(g.vega, (price_at(type, S, T, r, vol + hv) - price_at(type, S, T, r, vol - hv)) / (2 * hv), tolerance));
+        assert(almost_equal(g.theta, -(price_at(type, S, T + ht, r, vol) - price_at(type, S, T - ht, r, vol)) / (2 * ht), tolerance));
+        assert(almost_equal(g.rho, (price_at(type, S, T, r + hr, vol) - price_at(type, S, T, r - hr, vol)) / (2 * hr), tolerance));
+
+        // Test 2: Second-order Greeks as differences of first-order ones
+        auto greeks_at = [&](double S_, double T_, double vol_) {
+            return black_scholes_greeks(type, 100.0, S_, T_, r, vol_);
+        };
+        assert(almost_equal(g.gamma, (greeks_at(S + hS, T, vol).delta - greeks_at(S - hS, T, vol).delta) / (2 * hS), tolerance));
+        assert(almost_equal(g.vanna, (greeks_at(S, T, vol + hv).delta - greeks_at(S, T, vol - hv).delta) / (2 * hv), tolerance));
+        assert(almost_equal(g.volga, (greeks_at(S, T, vol + hv).vega - greeks_at(S, T, vol - hv).vega) / (2 * hv), tolerance));
+        assert(almost_equal(g.charm, -(greeks_at(S, T + ht, vol).delta - greeks_at(S, T - ht, vol).delta) / (2 * ht), tolerance));
+        assert(almost_equal(g.veta, -(greeks_at(S, T + ht, vol).vega - greeks_at(S, T - ht, vol).vega) / (2 * ht), tolerance));
+    }
+
+    // Test 3: Put-call parity on delta and gamma
+    {
+        Greeks call = black_scholes_greeks(OptionType::CALL, 100, 95, 1, 0.05, 0.2);
+        Greeks put = black_scholes_greeks(OptionType::PUT, 100, 95, 1, 0.05, 0.2);
+        assert(almost_equal(call.delta - put.delta, 1.0, 1e-12));
+        assert(almost_equal(call.gamma, put.gamma, 1e-12));
+        assert(almost_equal(call.vega, put.vega, 1e-12));
+    }
+
+    // Test 4: Batch kernels match the scalar Greeks
+    {
+        size_t n = 203;
+        std::vector<OptionType> types(n);
+        std::vector<double> strikes(n), prices(n, 100.0), times(n), rates(n), vols(n);
+        std::vector<Greeks> out(n);
+        for (size_t i = 0; i < n; ++i) {
+            types[i] = (i % 3 == 0) ? OptionType::PUT : OptionType::CALL;
+            strikes[i] = 60.0 + 0.4 * i;
+            times[i] = 0.05 + 0.02 * i;
+            rates[i] = 0.0002 * i;
+            vols[i] = 0.1 + 0.003 * i;
+        }
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+            set_simd_level(level);
+            black_scholes_greeks_batch(types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                                       vols.data(), out.data(), n);
+            for (size_t i = 0; i < n; ++i) {
+                Greeks e = black_scholes_greeks(types[i], strikes[i], prices[i], times[i], rates[i], vols[i]);
+                const double* got = &out[i].price;
+                const double* want = &e.price;
+                for (size_t k = 0; k < sizeof(Greeks) / sizeof(double); ++k) {
+                    assert(std::abs(got[k] - want[k]) <= 1e-10 * std::max(1.0, std::abs(want[k])));
+                }
+            }
+        }
+        set_simd_level(detect_simd_level());
+    }
+
+    std::cout << "Greeks Tests Passed!" << std::endl;
+    return 0;
+}
+
 int binomial_option_pricing_tests() {
     double tolerance = 0.001;
-    
+    double european_put = black_scholes(OptionType::PUT, 100, 100, 1, 0.05, 0.2);
+    double european_call = black_scholes(OptionType::CALL, 100, 100, 1, 0.05, 0.2);
+
+    // Test 1: European CRR tree converges to Black-Scholes
+    {
+        double result = binomial_option_pricing(OptionType::CALL, 100, 100, 1, 0.05, 0.2, 1000);
+        assert(almost_equal(result, european_call, tolerance));
+        result = binomial_option_pricing(OptionType::PUT, 100, 100, 1, 0.05, 0.2, 1000);
+        assert(almost_equal(result, european_put, tolerance));
+    }
+
+    // Test 2: Large N no longer underflows
+    {
+        double result = binomial_option_pricing(OptionType::CALL, 100, 100, 1, 0.05, 0.2, 100000);
+        assert(almost_equal(result, european_call, 1e-5));
+    }
+
+    // Test 3: BBS with Richardson extrapolation at N = 500 beats plain CRR at N = 5000
+    {
+        double bbsr = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::EUROPEAN, 100, 100, 1, 0.05, 0.2, 500,
+                                               BinomialMethod::BBSR);
+        double crr = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::EUROPEAN, 100, 100, 1, 0.05, 0.2, 5000);
+        assert(std::abs(bbsr - european_put) < std::abs(crr - european_put));
+        assert(std::abs(bbsr - european_put) < 1e-5);
+    }
+
+    // Test 4: American put carries an early-exercise premium (reference 6.0904)
+    {
+        double result = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100, 100, 1, 0.05, 0.2, 500,
+                                                 BinomialMethod::BBSR);
+        assert(almost_equal(result, 6.0904, 1e-4));
+        assert(result > european_put);
+    }
+
+    // Test 5: American call without dividends is never exercised early
+    {
+        double result = binomial_lattice_pricing(OptionType::CALL, ExerciseStyle::AMERICAN, 100, 100, 1, 0.05, 0.2, 1000);
+        assert(almost_equal(result, binomial_option_pricing(OptionType::CALL, 100, 100, 1, 0.05, 0.2, 1000), 1e-12));
+    }
+
+    // Test 6: Bermudan sits between European and American
+    {
+        std::vector<double> quarterly = {0.25, 0.5, 0.75, 1.0};
+        double bermudan = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::BERMUDAN, 100, 100, 1, 0.05, 0.2, 1000,
+                                                   BinomialMethod::CRR, quarterly);
+        double american = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100, 100, 1, 0.05, 0.2, 1000);
+        double european = binomial_option_pricing(OptionType::PUT, 100, 100, 1, 0.05, 0.2, 1000);
+        assert(bermudan > european && bermudan < american);
+
+        // No exercise dates at all is European
+        double none = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::BERMUDAN, 100, 100, 1, 0.05, 0.2, 1000,
+                                               BinomialMethod::CRR, {});
+        assert(almost_equal(none, european, 1e-12));
+    }
+
+    // Test 7: SIMD rollback kernels match the scalar loop
+    {
+        set_simd_level(SimdLevel::SCALAR);
+        double scalar = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100, 90, 0.5, 0.03, 0.3, 777);
+        set_simd_level(detect_simd_level());
+        double vectorized = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100, 90, 0.5, 0.03, 0.3, 777);
+        assert(almost_equal(scalar, vectorized, 1e-12));
+    }
 
     std::cout << "Binomial-Tree Tests Passed!" << std::endl;
     return 0;
@@ -304,3 +618,2955 @@ int rsi_tests() {
     return 0;
 }
 
+int rolling_window_tests() {
+    double tolerance = 1e-9;
+
+    // Reference: recompute every window from scratch
+    auto naive_mean = [](const std::vector<double>& data, size_t start, size_t window_size) {
+        return std::accumulate(data.begin() + start, data.begin() + start + window_size, 0.0) / window_size;
+    };
+    auto naive_std = [&](const std::vector<double>& data, size_t start, size_t window_size) {
+        double mean = naive_mean(data, start, window_size);
+        double sq_sum = 0.0;
+        for (size_t i = start; i < start + window_size; ++i) {
+            sq_sum += (data[i] - mean) * (data[i] - mean);
+        }
+        return std::sqrt(sq_sum / window_size);
+    };
+
+    std::vector<double> prices;
+    for (int i = 0; i < 500; ++i) {
+        prices.push_back(100.0 + 10.0 * std::sin(0.1 * i) + 0.01 * (i % 7));
+    }
+
+    // Test 1: SMA matches the naive window sum
+    {
+        std::vector<double> sma = simple_moving_average(prices, 20);
+        assert(sma.size() == prices.size() - 20 + 1);
+        for (size_t i = 0; i < sma.size(); ++i) {
+            assert(almost_equal(sma[i], naive_mean(prices, i, 20), tolerance));
+        }
+    }
+
+    // Test 2: Rolling volatility matches the naive per-window standard deviation
+    {
+        std::vector<double> vol = rolling_volatility(prices, 20);
+        std::vector<double> log_returns = compute_log_returns(prices);
+        assert(vol.size() == log_returns.size() - 20 + 1);
+        for (size_t i = 0; i < vol.size(); ++i) {
+            assert(almost_equal(vol[i], naive_std(log_returns, i, 20) * std::sqrt(252), 1e-7));
+        }
+    }
+
+    // Test 3: Window larger than the series gives no output
+    {
+        std::vector<double> short_prices = {100, 101, 102};
+        assert(simple_moving_average(short_prices, 5).empty());
+        assert(rolling_volatility(short_prices, 5).empty());
+    }
+
+    // Test 4: Constant series has zero volatility
+    {
+        std::vector<double> flat(50, 42.0);
+        std::vector<double> vol = rolling_volatility(flat, 10);
+        for (double v : vol) {
+            assert(v == 0.0);
+        }
+    }
+
+    // Test 5: No drift over a long series with a large offset
+    {
+        std::vector<double> data;
+        for (int i = 0; i < 200000; ++i) {
+            data.push_back(1e6 + std::sin(0.37 * i));
+        }
+        size_t window_size = 250;
+        std::vector<double> stddev(rolling_output_size(data.size(), window_size));
+        rolling_stddev(data.data(), data.size(), window_size, stddev.data());
+        std::vector<double> mean(stddev.size());
+        rolling_mean(data.data(), data.size(), window_size, mean.data());
+
+        size_t last = stddev.size() - 1;
+        assert(almost_equal(stddev[last], naive_std(data, last, window_size), 1e-6));
+        assert(almost_equal(mean[last], naive_mean(data, last, window_size), 1e-12));
+    }
+
+    // Test 6: Streaming kernel agrees with the batch kernel
+    {
+        RollingMoments moments(20);
+        for (size_t i = 0; i < 20; ++i) {
+            moments.push(prices[i]);
+        }
+        for (size_t i = 20; i < prices.size(); ++i) {
+            moments.slide(prices[i], prices[i - 20]);
+        }
+        assert(moments.full());
+        assert(almost_equal(moments.mean(), naive_mean(prices, prices.size() - 20, 20), tolerance));
+        assert(almost_equal(moments.stddev(), naive_std(prices, prices.size() - 20, 20), 1e-6));
+    }
+
+    std::cout << "Rolling Window Tests Passed!" << std::endl;
+    return 0;
+}
+
+int streaming_indicator_tests() {
+    double tolerance = 1e-9;
+
+    std::vector<double> prices;
+    for (int i = 0; i < 300; ++i) {
+        prices.push_back(100.0 + 5.0 * std::sin(0.2 * i) + 0.05 * (i % 11));
+    }
+
+    // Test 1: RollingSMA reproduces simple_moving_average tick by tick
+    {
+        RollingSMA sma(10);
+        std::vector<double> batch = simple_moving_average(prices, 10);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            double value = sma.update(prices[i]);
+            if (i + 1 < 10) {
+                assert(std::isnan(value));
+            } else {
+                assert(almost_equal(value, batch[i + 1 - 10], tolerance));
+            }
+        }
+    }
+
+    // Test 2: RollingVolatility reproduces rolling_volatility tick by tick
+    {
+        RollingVolatility vol(20);
+        std::vector<double> batch = rolling_volatility(prices, 20);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            double value = vol.update(prices[i]);
+            if (i < 20) {
+                assert(!vol.ready());
+            } else {
+                assert(almost_equal(value, batch[i - 20], 1e-7));
+            }
+        }
+    }
+
+    // Test 3: WilderRSI seeds with the simple average of the first 14 changes
+    {
+        std::vector<double> sample = {44.34, 44.09, 44.15, 43.61, 44.33, 44.83, 45.10, 45.42, 45.84, 46.08, 45.89, 46.03, 45.61, 46.28, 46.28};
+        WilderRSI rsi(14);
+        double value = 0.0;
+        for (double price : sample) {
+            value = rsi.update(price);
+        }
+        assert(rsi.ready());
+        assert(almost_equal(value, 100.0 - 100.0 / (1.0 + 3.34 / 1.40), 1e-4));
+
+        // Next change is smoothed: avg = (avg * 13 + change) / 14
+        double avg_gain = (3.34 / 14 * 13 + 0.0) / 14;
+        double avg_loss = (1.40 / 14 * 13 + (46.28 - 46.00)) / 14;
+        value = rsi.update(46.00);
+        assert(almost_equal(value, 100.0 - 100.0 / (1.0 + avg_gain / avg_loss), 1e-4));
+    }
+
+    // Test 4: WilderRSI edge cases (flat and monotonic prices)
+    {
+        WilderRSI flat(5);
+        WilderRSI rising(5);
+        for (int i = 0; i < 10; ++i) {
+            flat.update(50.0);
+            rising.update(50.0 + i);
+        }
+        assert(flat.value() == 50.0);
+        assert(rising.value() == 100.0);
+    }
+
+    // Test 5: snapshot/restore resumes exactly where the original left off
+    {
+        RollingSMA sma(15);
+        RollingVolatility vol(15);
+        WilderRSI rsi(14);
+        for (size_t i = 0; i < 100; ++i) {
+            sma.update(prices[i]);
+            vol.update(prices[i]);
+            rsi.update(prices[i]);
+        }
+
+        RollingSMA sma_copy(15);
+        RollingVolatility vol_copy(15);
+        WilderRSI rsi_copy(14);
+        sma_copy.restore(sma.snapshot());
+        vol_copy.restore(vol.snapshot());
+        rsi_copy.restore(rsi.snapshot());
+
+        for (size_t i = 100; i < prices.size(); ++i) {
+            [[maybe_unused]] double sma_value = sma.update(prices[i]);
+            [[maybe_unused]] double sma_restored = sma_copy.update(prices[i]);
+            [[maybe_unused]] double vol_value = vol.update(prices[i]);
+            [[maybe_unused]] double vol_restored = vol_copy.update(prices[i]);
+            [[maybe_unused]] double rsi_value = rsi.update(prices[i]);
+            [[maybe_unused]] double rsi_restored = rsi_copy.update(prices[i]);
+            assert(sma_value == sma_restored);
+            assert(vol_value == vol_restored);
+            assert(rsi_value == rsi_restored);
+        }
+    }
+
+    // Test 6: Restoring a snapshot from a different indicator or window is rejected
+    {
+        RollingSMA sma(10);
+        RollingSMA other_window(12);
+        WilderRSI rsi(10);
+        bool threw_window = false;
+        bool threw_kind = false;
+        try {
+            other_window.restore(sma.snapshot());
+        } catch (const std::invalid_argument&) {
+            threw_window = true;
+        }
+        try {
+            rsi.restore(sma.snapshot());
+        } catch (const std::invalid_argument&) {
+            threw_kind = true;
+        }
+        assert(threw_window && threw_kind);
+
+        // Counts that are negative, fractional, NaN or out of range are rejected: the sample
+        // count (field 2) beyond the window, the slides since resync (field 5) beyond the
+        // resync period
+        for (size_t i = 0; i < 15; ++i) {
+            sma.update(100.0 + static_cast<double>(i));
+        }
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const std::vector<std::pair<size_t, std::vector<double>>> corrupt = {{2, {-1.0, 2.5, nan, 11.0}},
+                                                                             {5, {-1.0, 2.5, nan, 1e300}}};
+        for (const auto& [field, values] : corrupt) {
+            for (double value : values) {
+                std::vector<double> state = sma.snapshot();
+                state[field] = value;
+                bool threw = false;
+                try {
+                    RollingSMA(10).restore(state);
+                } catch (const std::invalid_argument&) {
+                    threw = true;
+                }
+                assert(threw);
+            }
+        }
+        std::vector<double> rsi_state = WilderRSI(10).snapshot();
+        rsi_state[2] = -3.0;
+        bool threw_count = false;
+        try {
+            rsi.restore(rsi_state);
+        } catch (const std::invalid_argument&) {
+            threw_count = true;
+        }
+        assert(threw_count);
+
+        // The window size a pickled snapshot is rebuilt from must be a positive integer
+        assert(snapshot_window_size(sma.snapshot()) == 10);
+        for (double size : {0.0, -1.0, 2.5, nan, 1e300}) {
+            std::vector<double> state = sma.snapshot();
+            state[1] = size;
+            bool threw_size = false;
+            try {
+                snapshot_window_size(state);
+            } catch (const std::invalid_argument&) {
+                threw_size = true;
+            }
+            assert(threw_size);
+        }
+    }
+
+    // Test 7: Ring buffer keeps the most recent values in arrival order
+    {
+        RingBuffer ring(3);
+        for (int i = 1; i <= 5; ++i) {
+            ring.push(i);
+        }
+        assert(ring.full());
+        assert(ring[0] == 3 && ring[1] == 4 && ring[2] == 5);
+        assert(ring.oldest() == 3);
+    }
+
+    std::cout << "Streaming Indicator Tests Passed!" << std::endl;
+    return 0;
+}
+
+int parallel_tests() {
+    // Test 1: parallel_for visits every index exactly once
+    {
+        ThreadPool pool(4);
+        assert(pool.thread_count() == 4);
+        std::vector<int> visits(100003, 0);
+        pool.parallel_for(visits.size(), 100, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ++visits[i];
+            }
+        });
+        for (int v : visits) {
+            assert(v == 1);
+        }
+    }
+
+    // Test 2: Nested parallel_for from inside a task completes
+    {
+        ThreadPool pool(3);
+        std::vector<double> sums(16, 0.0);
+        pool.parallel_for(sums.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                std::vector<double> inner(1000, 0.0);
+                pool.parallel_for(inner.size(), 10, [&](size_t b, size_t e) {
+                    for (size_t j = b; j < e; ++j) {
+                        inner[j] = static_cast<double>(i);
+                    }
+                });
+                sums[i] = std::accumulate(inner.begin(), inner.end(), 0.0);
+            }
+        });
+        for (size_t i = 0; i < sums.size(); ++i) {
+            assert(sums[i] == 1000.0 * static_cast<double>(i));
+        }
+    }
+
+    // Test 3: Exceptions thrown by a task reach the caller
+    {
+        ThreadPool pool(4);
+        bool caught = false;
+        try {
+            pool.parallel_for(1000, 1, [](size_t begin, size_t) {
+                if (begin == 500) {
+                    throw std::runtime_error("task failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        assert(caught);
+    }
+
+    // Test 4: parallel_price matches black_scholes_batch for any thread count
+    {
+        const size_t n = 20000;
+        std::vector<OptionType> types(n);
+        std::vector<double> strikes(n), prices(n), times(n), rates(n), vols(n);
+        for (size_t i = 0; i < n; ++i) {
+            types[i] = (i % 3 == 0) ? OptionType::PUT : OptionType::CALL;
+            strikes[i] = 60.0 + static_cast<double>(i % 80);
+            prices[i] = 100.0;
+            times[i] = 0.1 + static_cast<double>(i % 40) * 0.1;
+            rates[i] = 0.03;
+            vols[i] = 0.1 + static_cast<double>(i % 7) * 0.05;
+        }
+        std::vector<double> expected(n), result(n);
+        black_scholes_batch(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                            expected.data(), n);
+        for (size_t threads : {1, 2, 5}) {
+            ThreadPool pool(threads);
+            parallel_price(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                           result.data(), n, pool);
+            assert(result == expected);
+        }
+
+        // Binomial lattice on a subset
+        const size_t m = 64;
+        std::vector<double> lattice(m);
+        ThreadPool pool(4);
+        parallel_binomial_price(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                                ExerciseStyle::AMERICAN, 200, BinomialMethod::CRR, lattice.data(), m, pool);
+        for (size_t i = 0; i < m; ++i) {
+            assert(lattice[i] == binomial_lattice_pricing(types[i], ExerciseStyle::AMERICAN, prices[i], strikes[i],
+                                                          times[i], rates[i], vols[i], 200));
+        }
+    }
+
+    // Test 5: parallel_indicators keeps the input order
+    {
+        std::vector<std::vector<double>> series(37);
+        for (size_t k = 0; k < series.size(); ++k) {
+            for (size_t i = 0; i < 200 + k; ++i) {
+                series[k].push_back(100.0 + std::sin(0.1 * static_cast<double>(i * (k + 1))));
+            }
+        }
+        ThreadPool pool(4);
+        std::vector<std::vector<double>> sma = parallel_indicators(series, IndicatorType::SMA, 20, pool);
+        std::vector<std::vector<double>> vol = parallel_indicators(series, IndicatorType::VOLATILITY, 20, pool);
+        assert(sma.size() == series.size() && vol.size() == series.size());
+        for (size_t k = 0; k < series.size(); ++k) {
+            assert(sma[k] == simple_moving_average(series[k], 20));
+            assert(vol[k] == rolling_volatility(series[k], 20));
+        }
+    }
+
+    std::cout << "Parallel Tests Passed!" << std::endl;
+    return 0;
+}
+
+int span_indicator_tests() {
+    std::vector<double> prices;
+    for (size_t i = 0; i < 500; ++i) {
+        prices.push_back(100.0 + 5.0 * std::sin(0.05 * static_cast<double>(i)) + 0.01 * static_cast<double>(i % 7));
+    }
+    const size_t n = prices.size();
+
+    // Test 1: Pointer + length entry points write the same values as the vector versions
+    {
+        std::vector<double> out(n);
+        size_t written = simple_moving_average(prices.data(), n, 20, out.data());
+        assert(written == rolling_output_size(n, 20));
+        out.resize(written);
+        assert(out == simple_moving_average(prices, 20));
+
+        out.assign(n, 0.0);
+        written = rolling_volatility(prices.data(), n, 20, out.data());
+        assert(written == rolling_volatility_output_size(n, 20));
+        out.resize(written);
+        assert(out == rolling_volatility(prices, 20));
+
+        out.assign(n, 0.0);
+        written = compute_rsi(prices.data(), n, 14, out.data());
+        assert(written == rsi_output_size(n));
+        out.resize(written);
+        // compute_rsi overflows to NaN on long series; the pointer version must match that too
+        assert(same_values(out, compute_rsi(prices, 14)));
+    }
+
+    // Test 2: Invalid windows write nothing
+    {
+        double out[4] = {0.0, 0.0, 0.0, 0.0};
+        assert(simple_moving_average(prices.data(), 3, 4, out) == 0);
+        assert(rolling_volatility(prices.data(), 4, 4, out) == 0);
+        assert(simple_moving_average(prices.data(), 3, 0, out) == 0);
+        assert(out[0] == 0.0);
+    }
+
+    // Test 3: Span-style parallel_indicators over caller-owned buffers
+    {
+        const double* series[] = {prices.data(), prices.data() + 100, prices.data() + 250};
+        size_t lengths[] = {n, 150, 250};
+        std::vector<std::vector<double>> expected;
+        std::vector<std::vector<double>> results;
+        for (size_t i = 0; i < 3; ++i) {
+            std::vector<double> input(series[i], series[i] + lengths[i]);
+            expected.push_back(rolling_volatility(input, 30));
+            results.emplace_back(indicator_output_size(IndicatorType::VOLATILITY, lengths[i], 30));
+        }
+        double* outputs[] = {results[0].data(), results[1].data(), results[2].data()};
+        ThreadPool pool(2);
+        parallel_indicators(series, lengths, 3, IndicatorType::VOLATILITY, 30, outputs, pool);
+        assert(results == expected);
+    }
+
+    std::cout << "Span Indicator Tests Passed!" << std::endl;
+    return 0;
+}
+
+int monte_carlo_tests() {
+    // Test 1: Philox4x32-10 known-answer vector (Random123, counter and key all ones)
+    {
+        PhiloxCounter bits = philox4x32({0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu}, {0xFFFFFFFFu, 0xFFFFFFFFu});
+        assert(bits[0] == 0x408F276Du && bits[1] == 0x41C83B0Eu && bits[2] == 0xA20BC7C6u && bits[3] == 0x6D5451FDu);
+    }
+
+    // Test 2: inverse_normal_cdf inverts normal_cdf, including the tails
+    {
+        for (double x = -8.0; x <= 5.0; x += 0.25) {
+            assert(std::abs(inverse_normal_cdf(normal_cdf(x)) - x) < 1e-9);
+        }
+        assert(almost_equal(inverse_normal_cdf(0.975), 1.959963984540054, 1e-14));
+        assert(inverse_normal_cdf(0.5) == 0.0);
+    }
+
+    // Test 3: Sobol points stratify each dimension, and next() matches point()
+    {
+        SobolSequence sobol(50, 7);
+        std::vector<uint32_t> x(50), y(50);
+        std::vector<std::vector<int>> counts(50, std::vector<int>(16, 0));
+        sobol.point(0, x.data());
+        for (uint64_t i = 0; i < 256; ++i) {
+            for (size_t d = 0; d < 50; ++d) {
+                ++counts[d][x[d] >> 28];
+            }
+            sobol.next(i, x.data());
+            sobol.point(i + 1, y.data());
+            assert(x == y);
+        }
+        for (const std::vector<int>& dimension : counts) {
+            for (int c : dimension) {
+                assert(c == 16);
+            }
+        }
+    }
+
+    // Test 4: Brownian bridge paths have covariance min(i, j)
+    {
+        const size_t steps = 5;
+        BrownianBridge bridge(steps);
+        std::vector<double> z(steps, 0.0), w(steps);
+        std::vector<std::vector<double>> columns;
+        for (size_t i = 0; i < steps; ++i) {
+            z.assign(steps, 0.0);
+            z[i] = 1.0;
+            bridge.build(z.data(), w.data());
+            columns.push_back(w);
+        }
+        for (size_t i = 0; i < steps; ++i) {
+            for (size_t j = 0; j < steps; ++j) {
+                double cov = 0.0;
+                for (size_t k = 0; k < steps; ++k) {
+                    cov += columns[k][i] * columns[k][j];
+                }
+                assert(std::abs(cov - static_cast<double>(std::min(i, j) + 1)) < 1e-12);
+            }
+        }
+    }
+
+    const double S0 = 100.0, K = 100.0, T = 1.0, r = 0.05, sigma = 0.2;
+    ThreadPool pool(2);
+    MonteCarloSettings settings;
+    settings.paths = 200000;
+    settings.steps = 12;
+
+    // Test 5: European price matches Black-Scholes within a few standard errors
+    {
+        for (RandomSource source : {RandomSource::PHILOX, RandomSource::SOBOL}) {
+            settings.source = source;
+            for (OptionType type : {OptionType::CALL, OptionType::PUT}) {
+                MonteCarloResult result = monte_carlo_price(type, PathPayoff::EUROPEAN, S0, K, T, r, sigma, 0.0,
+                                                            settings, pool);
+                assert(result.paths == 200000);
+                assert(std::abs(result.price - black_scholes(type, K, S0, T, r, sigma)) < 4.0 * result.std_error);
+            }
+        }
+        settings.source = RandomSource::PHILOX;
+    }
+
+    // Test 6: Geometric Asian matches its closed form; antithetic and control variates shrink the error
+    {
+        const double n = static_cast<double>(settings.steps);
+        const double mu = std::log(S0) + (r - 0.5 * sigma * sigma) * T * (n + 1.0) / (2.0 * n);
+        const double v = sigma * sigma * T * (n + 1.0) * (2.0 * n + 1.0) / (6.0 * n * n);
+        const double d2 = (mu - std::log(K)) / std::sqrt(v);
+        const double exact = std::exp(-r * T) * (std::exp(mu + 0.5 * v) * normal_cdf(d2 + std::sqrt(v)) - K * normal_cdf(d2));
+
+        MonteCarloResult plain = monte_carlo_price(OptionType::CALL, PathPayoff::ASIAN_GEOMETRIC, S0, K, T, r, sigma,
+                                                   0.0, settings, pool);
+        assert(std::abs(plain.price - exact) < 4.0 * plain.std_error);
+
+        MonteCarloSettings reduced = settings;
+        reduced.antithetic = true;
+        reduced.control_variate = true;
+        MonteCarloResult better = monte_carlo_price(OptionType::CALL, PathPayoff::ASIAN_GEOMETRIC, S0, K, T, r, sigma,
+                                                    0.0, reduced, pool);
+        assert(std::abs(better.price - exact) < 4.0 * better.std_error);
+        assert(better.std_error < 0.6 * plain.std_error);
+    }
+
+    // Test 7: Knock-out plus knock-in equals the European price on the same paths
+    {
+        MonteCarloResult european = monte_carlo_price(OptionType::CALL, PathPayoff::EUROPEAN, S0, K, T, r, sigma, 0.0,
+                                                      settings, pool);
+        MonteCarloResult out = monte_carlo_price(OptionType::CALL, PathPayoff::UP_AND_OUT, S0, K, T, r, sigma, 130.0,
+                                                 settings, pool);
+        MonteCarloResult in = monte_carlo_price(OptionType::CALL, PathPayoff::UP_AND_IN, S0, K, T, r, sigma, 130.0,
+                                                settings, pool);
+        assert(out.price > 0.0 && in.price > 0.0);
+        assert(almost_equal(out.price + in.price, european.price, 1e-12));
+
+        MonteCarloResult floating = monte_carlo_price(OptionType::PUT, PathPayoff::LOOKBACK_FLOATING, S0, K, T, r,
+                                                      sigma, 0.0, settings, pool);
+        assert(floating.price > black_scholes(OptionType::PUT, K, S0, T, r, sigma));
+    }
+
+    // Test 8: Results do not depend on the thread count or the SIMD kernel
+    {
+        ThreadPool single(1);
+        ThreadPool several(3);
+        MonteCarloResult a = monte_carlo_price(OptionType::PUT, PathPayoff::ASIAN_ARITHMETIC, S0, K, T, r, sigma, 0.0,
+                                               settings, single);
+        MonteCarloResult b = monte_carlo_price(OptionType::PUT, PathPayoff::ASIAN_ARITHMETIC, S0, K, T, r, sigma, 0.0,
+                                               settings, several);
+        assert(a.price == b.price && a.std_error == b.std_error);
+
+        SimdLevel level = active_simd_level();
+        set_simd_level(SimdLevel::SCALAR);
+        MonteCarloResult scalar = monte_carlo_price(OptionType::PUT, PathPayoff::ASIAN_ARITHMETIC, S0, K, T, r, sigma,
+                                                    0.0, settings, single);
+        set_simd_level(level);
+        assert(almost_equal(scalar.price, a.price, 1e-8));
+    }
+
+    // Test 9: Invalid inputs return NaN
+    {
+        MonteCarloResult result = monte_carlo_price(OptionType::CALL, PathPayoff::EUROPEAN, S0, K, T, r, -0.2, 0.0,
+                                                    settings, pool);
+        assert(std::isnan(result.price) && result.paths == 0);
+    }
+
+    std::cout << "Monte Carlo Tests Passed!" << std::endl;
+    return 0;
+}
+
+int implied_volatility_tests() {
+    // Test 1: Round trip through black_scholes for calls and puts across strikes, expiries and vols
+    {
+        const double times[] = {7.0 / 365.0, 0.25, 1.0, 5.0};
+        const double vols[] = {0.05, 0.2, 0.6, 1.5};
+        for (double time : times) {
+            for (double vol : vols) {
+                for (double strike = 60.0; strike <= 160.0; strike += 10.0) {
+                    for (OptionType type : {OptionType::CALL, OptionType::PUT}) {
+                        double price = black_scholes(type, strike, 100.0, time, 0.03, vol);
+                        double intrinsic = type == OptionType::CALL
+                                               ? std::max(100.0 - strike * std::exp(-0.03 * time), 0.0)
+                                               : std::max(strike * std::exp(-0.03 * time) - 100.0, 0.0);
+                        if (price - intrinsic < 1e-8) {
+                            continue;  // too little time value left to pin down the volatility
+                        }
+                        ImpliedVolStatus status;
+                        double implied = implied_volatility(type, price, strike, 100.0, time, 0.03, &status);
+                        assert(status == ImpliedVolStatus::CONVERGED);
+                        assert(std::abs(implied - vol) < 1e-6 * vol);
+                    }
+                }
+            }
+        }
+    }
+
+    // Test 2: Far out-of-the-money quotes still converge to machine precision
+    {
+        double price = black_scholes(OptionType::CALL, 300.0, 100.0, 0.1, 0.0, 0.25);
+        assert(price > 0.0 && price < 1e-30);
+        ImpliedVolStatus status;
+        double implied = implied_volatility(OptionType::CALL, price, 300.0, 100.0, 0.1, 0.0, &status);
+        assert(status == ImpliedVolStatus::CONVERGED);
+        assert(almost_equal(implied, 0.25, 1e-10));
+    }
+
+    // Test 3: Prices outside the no-arbitrage bounds and invalid inputs are flagged
+    {
+        ImpliedVolStatus status;
+        assert(std::isnan(implied_volatility(OptionType::CALL, 4.0, 95.0, 100.0, 1.0, 0.0, &status)));
+        assert(status == ImpliedVolStatus::BELOW_INTRINSIC);
+        assert(std::isnan(implied_volatility(OptionType::CALL, 100.0, 95.0, 100.0, 1.0, 0.0, &status)));
+        assert(status == ImpliedVolStatus::ABOVE_MAXIMUM);
+        assert(std::isnan(implied_volatility(OptionType::PUT, 5.0, 100.0, 100.0, 0.0, 0.0, &status)));
+        assert(status == ImpliedVolStatus::INVALID_INPUT);
+        assert(implied_volatility(OptionType::PUT, 5.0, 105.0, 100.0, 1.0, 0.0, &status) == 0.0);
+        assert(status == ImpliedVolStatus::CONVERGED);
+    }
+
+    // Test 4: Batch and parallel forms match the scalar solver element by element
+    {
+        const size_t n = 5000;
+        std::vector<OptionType> types(n);
+        std::vector<double> strikes(n), prices(n, 100.0), times(n), rates(n, 0.02), vols(n), quotes(n);
+        for (size_t i = 0; i < n; ++i) {
+            types[i] = i % 2 == 0 ? OptionType::CALL : OptionType::PUT;
+            strikes[i] = 70.0 + 60.0 * static_cast<double>(i % 97) / 96.0;
+            times[i] = 0.05 + 2.0 * static_cast<double>(i % 13) / 12.0;
+            vols[i] = 0.1 + 0.5 * static_cast<double>(i % 11) / 10.0;
+        }
+        black_scholes_batch(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                            quotes.data(), n);
+        quotes[7] = -1.0;
+
+        std::vector<double> batch(n), parallel(n);
+        std::vector<ImpliedVolStatus> batch_status(n), parallel_status(n);
+        implied_volatility_batch(types.data(), quotes.data(), strikes.data(), prices.data(), times.data(),
+                                 rates.data(), batch.data(), batch_status.data(), n);
+        ThreadPool pool(3);
+        parallel_implied_volatility(types.data(), quotes.data(), strikes.data(), prices.data(), times.data(),
+                                    rates.data(), parallel.data(), parallel_status.data(), n, pool);
+        assert(same_values(batch, parallel));
+        assert(batch_status == parallel_status);
+        assert(batch_status[7] == ImpliedVolStatus::BELOW_INTRINSIC);
+        for (size_t i = 0; i < n; i += 101) {
+            double scalar = implied_volatility(types[i], quotes[i], strikes[i], prices[i], times[i], rates[i]);
+            assert(same_values({scalar}, {batch[i]}));
+        }
+
+        implied_volatility_batch(types.data(), quotes.data(), strikes.data(), prices.data(), times.data(),
+                                 rates.data(), batch.data(), nullptr, n);
+        assert(same_values(batch, parallel));
+    }
+
+    std::cout << "Implied Volatility Tests Passed!" << std::endl;
+    return 0;
+}
+
+int indicator_pipeline_tests() {
+    // Random walk long enough to cross several blocks and resync periods
+    std::vector<double> prices(20000);
+    double price = 100.0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        price *= std::exp(0.01 * std::sin(0.37 * static_cast<double>(i)) + 0.002 * std::cos(1.3 * static_cast<double>(i)));
+        prices[i] = price;
+    }
+
+    const std::vector<IndicatorSpec> specs = {
+        {IndicatorType::SMA, 10},   {IndicatorType::VOLATILITY, 20},   {IndicatorType::RSI, 14},
+        {IndicatorType::SMA, 5000}, {IndicatorType::VOLATILITY, 3000}, {IndicatorType::RSI, 2},
+    };
+    IndicatorPipeline pipeline(specs);
+
+    // Test 1: Fused results match the standalone indicators exactly
+    {
+        std::vector<std::vector<double>> result = pipeline.compute(prices);
+        assert(result.size() == specs.size());
+        assert(same_values(result[0], simple_moving_average(prices, 10)));
+        assert(same_values(result[1], rolling_volatility(prices, 20)));
+        assert(same_values(result[2], compute_rsi(prices, 14)));
+        assert(same_values(result[3], simple_moving_average(prices, 5000)));
+        assert(same_values(result[4], rolling_volatility(prices, 3000)));
+        assert(same_values(result[5], compute_rsi(prices, 2)));
+    }
+
+    // Test 2: Panel output is columnar and independent of the thread count
+    {
+        const size_t rows = 4500;
+        const size_t columns = 4;
+        std::vector<double> panel(prices.begin(), prices.begin() + rows * columns);
+        const size_t stride = pipeline.column_size(rows);
+        assert(stride == pipeline.offset(specs.size() - 1, rows) + pipeline.output_size(specs.size() - 1, rows));
+
+        std::vector<double> serial(stride * columns);
+        std::vector<double> threaded(stride * columns);
+        ThreadPool one(1);
+        ThreadPool three(3);
+        pipeline.compute(panel.data(), rows, columns, serial.data(), one);
+        pipeline.compute(panel.data(), rows, columns, threaded.data(), three);
+        assert(same_values(serial, threaded));
+
+        for (size_t c = 0; c < columns; ++c) {
+            std::vector<double> column(panel.begin() + c * rows, panel.begin() + (c + 1) * rows);
+            std::vector<std::vector<double>> expected = pipeline.compute(column);
+            for (size_t k = 0; k < specs.size(); ++k) {
+                const double* slice = serial.data() + c * stride + pipeline.offset(k, rows);
+                assert(same_values(std::vector<double>(slice, slice + pipeline.output_size(k, rows)), expected[k]));
+            }
+        }
+    }
+
+    // Test 3: Windows longer than the series produce nothing; RSI keeps its seed value
+    {
+        std::vector<double> short_prices(prices.begin(), prices.begin() + 15);
+        std::vector<std::vector<double>> result = pipeline.compute(short_prices);
+        assert(result[0].size() == 6 && result[1].size() == 0 && result[3].size() == 0 && result[4].size() == 0);
+        assert(same_values(result[2], compute_rsi(short_prices, 14)));
+    }
+
+    // Test 4: Invalid specs throw
+    {
+        bool caught = false;
+        try {
+            IndicatorPipeline invalid({{IndicatorType::SMA, 0}});
+        } catch (const std::invalid_argument&) {
+            caught = true;
+        }
+        assert(caught);
+
+        caught = false;
+        try {
+            IndicatorPipeline empty({});
+        } catch (const std::invalid_argument&) {
+            caught = true;
+        }
+        assert(caught);
+    }
+
+    // Test 5: Chunked runs reassemble to the in-memory result for any chunk size
+    {
+        std::vector<std::vector<double>> expected = pipeline.compute(prices);
+        for (size_t chunk_rows : {size_t(1), size_t(7), size_t(4096), prices.size() + 1}) {
+            std::vector<std::vector<double>> result(specs.size());
+            pipeline.compute_chunked(prices.data(), prices.size(), chunk_rows,
+                                     [&](size_t k, size_t first, const double* values, size_t count) {
+                                         assert(first == result[k].size());
+                                         assert(count <= chunk_rows + 1);
+                                         result[k].insert(result[k].end(), values, values + count);
+                                     });
+            for (size_t k = 0; k < specs.size(); ++k) {
+                assert(same_values(result[k], expected[k]));
+            }
+        }
+    }
+
+    std::cout << "Indicator Pipeline Tests Passed!" << std::endl;
+    return 0;
+}
+
+int series_store_tests() {
+    const std::string path = "finmath_series_store_test.fms";
+    const size_t rows = 10000;
+    std::vector<int64_t> times(rows);
+    std::vector<double> prices(rows);
+    std::vector<double> volumes(rows);
+    double price = 50.0;
+    for (size_t i = 0; i < rows; ++i) {
+        times[i] = 1700000000000000000LL + static_cast<int64_t>(i) * 60000000000LL;
+        price *= std::exp(0.01 * std::sin(0.21 * static_cast<double>(i)));
+        prices[i] = price;
+        volumes[i] = static_cast<double>(i % 97);
+    }
+
+    // Test 1: Columns appended in uneven pieces read back intact
+    {
+        SeriesStoreWriter writer(path, {{"time", ColumnType::TIMESTAMP}, {"close", ColumnType::FLOAT64},
+                                        {"volume", ColumnType::FLOAT64}}, rows + 500);
+        writer.append(0, times.data(), rows);
+        for (size_t i = 0; i < rows; i += 333) {
+            size_t count = std::min<size_t>(333, rows - i);
+            writer.append(1, prices.data() + i, count);
+            writer.append(2, volumes.data() + i, count);
+        }
+        assert(writer.rows(1) == rows);
+        writer.close();
+
+        SeriesStore store(path);
+        assert(store.rows() == rows && store.column_count() == 3);
+        assert(store.column(0).name == "time" && store.column(0).type == ColumnType::TIMESTAMP);
+        assert(store.column_index("volume") == 2);
+        assert(std::equal(times.begin(), times.end(), store.timestamps(0)));
+        assert(std::equal(prices.begin(), prices.end(), store.values(1)));
+        assert(std::equal(volumes.begin(), volumes.end(), store.values(2)));
+    }
+
+    // Test 2: Out-of-core indicators match the in-memory pipeline for any chunk size
+    {
+        SeriesStore store(path);
+        IndicatorPipeline pipeline({{IndicatorType::SMA, 50}, {IndicatorType::RSI, 14}, {IndicatorType::VOLATILITY, 500}});
+        std::vector<std::vector<double>> expected = pipeline.compute(prices);
+        for (size_t chunk_rows : {size_t(1), size_t(7), size_t(1000), rows + 1}) {
+            std::vector<std::vector<double>> result(3);
+            compute_indicators(store, store.column_index("close"), pipeline, chunk_rows,
+                               [&](size_t k, size_t first, const double* values, size_t count) {
+                                   assert(first == result[k].size());
+                                   result[k].insert(result[k].end(), values, values + count);
+                               });
+            for (size_t k = 0; k < 3; ++k) {
+                assert(same_values(result[k], expected[k]));
+            }
+        }
+    }
+
+    // Test 3: Misuse is reported
+    {
+        SeriesStore store(path);
+        bool caught = false;
+        try {
+            store.values(0);
+        } catch (const std::invalid_argument&) {
+            caught = true;
+        }
+        assert(caught);
+
+        caught = false;
+        try {
+            store.column_index("open");
+        } catch (const std::out_of_range&) {
+            caught = true;
+        }
+        assert(caught);
+
+        SeriesStoreWriter writer(path + ".tmp", {{"a", ColumnType::FLOAT64}, {"b", ColumnType::FLOAT64}}, 4);
+        caught = false;
+        try {
+            writer.append(0, times.data(), 1);
+        } catch (const std::invalid_argument&) {
+            caught = true;
+        }
+        assert(caught);
+
+        caught = false;
+        try {
+            writer.append(0, prices.data(), 5);
+        } catch (const std::length_error&) {
+            caught = true;
+        }
+        assert(caught);
+
+        writer.append(0, prices.data(), 2);
+        caught = false;
+        try {
+            writer.close();
+        } catch (const std::logic_error&) {
+            caught = true;
+        }
+        assert(caught);
+        writer.append(1, prices.data(), 2);
+        writer.close();
+        assert(SeriesStore(path + ".tmp").rows() == 2);
+        std::remove((path + ".tmp").c_str());
+    }
+
+    // Test 4: Files that are not stores are rejected
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        const char junk[128] = "not a series store";
+        std::fwrite(junk, 1, sizeof(junk), file);
+        std::fclose(file);
+        bool caught = false;
+        try {
+            SeriesStore store(path);
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        assert(caught);
+    }
+
+    std::remove(path.c_str());
+    std::cout << "Series Store Tests Passed!" << std::endl;
+    return 0;
+}
+
+int float_kernel_tests() {
+    // Prices rounded to float once, so both precisions see the same inputs
+    const size_t n = 200000;
+    std::vector<float> prices_f(n);
+    std::vector<double> prices_d(n);
+    double price = 100.0;
+    for (size_t i = 0; i < n; ++i) {
+        price *= std::exp(0.01 * std::sin(0.37 * static_cast<double>(i)) + 0.004 * std::cos(1.7 * static_cast<double>(i)));
+        prices_f[i] = static_cast<float>(price);
+        prices_d[i] = prices_f[i];
+    }
+
+    auto max_relative_error = [](const auto& approx, const std::vector<double>& exact) {
+        assert(approx.size() == exact.size());
+        double worst = 0.0;
+        for (size_t i = 0; i < exact.size(); ++i) {
+            worst = std::max(worst, std::abs(approx[i] - exact[i]) / std::max(std::abs(exact[i]), 1e-300));
+        }
+        return worst;
+    };
+
+    // Test 1: Compensated float rolling sums stay within a few float ulps of double, even
+    // with a window long enough that the running sum is never rebuilt
+    {
+        for (size_t window : {size_t(10), size_t(200), size_t(5000)}) {
+            assert(max_relative_error(simple_moving_average(prices_f, window), simple_moving_average(prices_d, window)) < 1e-6);
+            assert(max_relative_error(rolling_volatility(prices_f, window), rolling_volatility(prices_d, window)) < 1e-4);
+        }
+
+        std::vector<float> short_f(prices_f.begin(), prices_f.begin() + 2000);
+        std::vector<double> short_d(prices_d.begin(), prices_d.begin() + 2000);
+        std::vector<float> rsi_f = compute_rsi(short_f, 2);
+        std::vector<double> rsi_d = compute_rsi(short_d, 2);
+        for (size_t i = 0; i < rsi_d.size(); ++i) {
+            assert(std::abs(rsi_f[i] - rsi_d[i]) < 1e-3);
+        }
+
+        std::vector<float> out(n);
+        assert(compute_indicator(IndicatorType::SMA, prices_f.data(), n, 20, out.data()) == n - 19);
+    }
+
+    // Test 2: float Black-Scholes, scalar and on every SIMD level
+    {
+        const size_t count = 1003;  // not a multiple of any vector width
+        std::vector<OptionType> types(count);
+        std::vector<float> strikes(count), spots(count), times(count), rates(count), vols(count), out(count);
+        std::vector<double> expected(count);
+        for (size_t i = 0; i < count; ++i) {
+            double x = static_cast<double>(i);
+            types[i] = i % 2 == 0 ? OptionType::CALL : OptionType::PUT;
+            strikes[i] = static_cast<float>(80.0 + 40.0 * std::abs(std::sin(0.7 * x)));
+            spots[i] = static_cast<float>(80.0 + 40.0 * std::abs(std::cos(1.3 * x)));
+            times[i] = static_cast<float>(0.1 + std::abs(std::sin(0.11 * x)));
+            rates[i] = static_cast<float>(0.05 * std::abs(std::cos(0.5 * x)));
+            vols[i] = static_cast<float>(0.1 + 0.4 * std::abs(std::sin(0.3 * x)));
+            expected[i] = black_scholes(types[i], static_cast<double>(strikes[i]), static_cast<double>(spots[i]),
+                                        static_cast<double>(times[i]), static_cast<double>(rates[i]),
+                                        static_cast<double>(vols[i]));
+        }
+
+        float single = black_scholes<float>(OptionType::CALL, 100.0f, 100.0f, 1.0f, 0.05f, 0.2f);
+        assert(std::abs(single - black_scholes(OptionType::CALL, 100, 100, 1, 0.05, 0.2)) < 1e-4);
+
+        const SimdLevel detected = detect_simd_level();
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+            set_simd_level(level);
+            black_scholes_batch(types.data(), strikes.data(), spots.data(), times.data(), rates.data(), vols.data(),
+                                out.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                assert(std::abs(out[i] - expected[i]) <= 1e-4 * std::max(1.0, expected[i]));
+            }
+        }
+        set_simd_level(detected);
+    }
+
+    // Test 3: float lattices track the double ones
+    {
+        for (BinomialMethod method : {BinomialMethod::CRR, BinomialMethod::BBSR}) {
+            double exact = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05,
+                                                    0.2, 1000, method);
+            float approx = binomial_lattice_pricing<float>(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0f, 100.0f,
+                                                           1.0f, 0.05f, 0.2f, 1000, method);
+            assert(almost_equal(approx, exact, 1e-4));
+        }
+        float european = binomial_option_pricing<float>(OptionType::CALL, 100.0f, 95.0f, 0.5f, 0.03f, 0.3f, 500);
+        assert(almost_equal(european, binomial_option_pricing(OptionType::CALL, 100, 95, 0.5, 0.03, 0.3, 500), 1e-4));
+    }
+
+    // Test 4: Braced lists still select the double indicators
+    {
+        assert(simple_moving_average({1.0, 2.0, 3.0}, 2) == std::vector<double>({1.5, 2.5}));
+        assert(compute_rsi({1.0, 2.0, 1.5, 2.5}, 2).size() == 4);
+        assert(rolling_volatility({100.0, 101.0, 99.0, 102.0}, 2).size() == 2);
+    }
+
+    std::cout << "Float Kernel Tests Passed!" << std::endl;
+    return 0;
+}
+
+int vol_surface_tests() {
+    // Smooth surface sampled on an uneven grid: vol = 0.2 + 0.3 ln(K / 100)^2 + 0.05 sqrt(T)
+    auto smooth_vol = [](double strike, double time) {
+        double x = std::log(strike / 100.0);
+        return 0.2 + 0.3 * x * x + 0.05 * std::sqrt(time);
+    };
+    const std::vector<double> strikes = {60.0, 70.0, 80.0, 85.0, 90.0, 95.0, 100.0, 105.0, 110.0, 120.0, 140.0};
+    const std::vector<double> expiries = {7.0 / 365.0, 30.0 / 365.0, 0.25, 0.5, 1.0, 2.0, 5.0};
+    std::vector<double> vols;
+    for (double time : expiries) {
+        for (double strike : strikes) {
+            vols.push_back(smooth_vol(strike, time));
+        }
+    }
+
+    // Test 1: Bicubic surface passes through its quotes and stays close to the function between them
+    {
+        VolSurface surface(strikes, expiries, vols);
+        for (size_t j = 0; j < expiries.size(); ++j) {
+            for (size_t i = 0; i < strikes.size(); ++i) {
+                assert(almost_equal(surface.volatility(strikes[i], expiries[j]), surface.quote(i, j), 1e-13));
+            }
+        }
+        for (double strike = 62.5; strike < 140.0; strike += 3.7) {
+            for (double time = 0.1; time < 5.0; time += 0.3) {
+                // Resolution of the grid: the coarsest cell spans T = 2 to 5
+                assert(std::abs(surface.volatility(strike, time) - smooth_vol(strike, time)) < 5e-3);
+            }
+        }
+
+        // Flat extrapolation: strike clamped to the grid, volatility held past the last expiry
+        assert(almost_equal(surface.volatility(30.0, 1.0), surface.quote(0, 4), 1e-13));
+        assert(almost_equal(surface.volatility(500.0, 1.0), surface.quote(strikes.size() - 1, 4), 1e-13));
+        assert(almost_equal(surface.volatility(100.0, 10.0), surface.quote(6, 6), 1e-13));
+        assert(almost_equal(surface.volatility(100.0, 1.0 / 365.0), surface.quote(6, 0), 1e-13));
+        assert(std::isnan(surface.volatility(0.0, 1.0)));
+        assert(std::isnan(surface.volatility(100.0, 0.0)));
+        assert(std::isnan(surface.total_variance(-1.0, 1.0)));
+    }
+
+    // Test 2: A flat surface is flat everywhere
+    {
+        VolSurface surface({90.0, 100.0, 110.0}, {0.5, 1.0}, std::vector<double>(6, 0.25));
+        for (double strike = 50.0; strike < 200.0; strike += 7.0) {
+            for (double time = 0.05; time < 3.0; time += 0.15) {
+                assert(almost_equal(surface.volatility(strike, time), 0.25, 1e-13));
+            }
+        }
+    }
+
+    // Test 3: Incremental updates give the same surface, bit for bit, as a full rebuild
+    {
+        VolSurface surface(strikes, expiries, vols);
+        std::vector<VolQuote> changes = {{0, 0, 0.41}, {5, 3, 0.22}, {10, 6, 0.35}, {6, 3, 0.21}};
+        surface.update(changes.data(), changes.size());
+        surface.update(2, 5, 0.27);
+
+        std::vector<double> updated = vols;
+        for (const VolQuote& change : changes) {
+            updated[change.expiry_index * strikes.size() + change.strike_index] = change.volatility;
+        }
+        updated[5 * strikes.size() + 2] = 0.27;
+        VolSurface rebuilt(strikes, expiries, updated);
+        for (double strike = 55.0; strike < 150.0; strike += 1.3) {
+            for (double time = 0.01; time < 6.0; time += 0.07) {
+                assert(surface.volatility(strike, time) == rebuilt.volatility(strike, time));
+            }
+        }
+        assert(surface.quote(5, 3) == 0.22);
+
+        // Rejected updates leave the surface untouched
+        std::vector<VolQuote> bad = {{1, 1, 0.3}, {1, 1, -0.3}};
+        bool threw = false;
+        try {
+            surface.update(bad.data(), bad.size());
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw && surface.quote(1, 1) == rebuilt.quote(1, 1));
+        threw = false;
+        try {
+            surface.update(strikes.size(), 0, 0.3);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Test 4: Invalid grids are rejected
+    {
+        int failures = 0;
+        auto expect_invalid = [&](std::vector<double> k, std::vector<double> t, std::vector<double> v,
+                                  VolInterpolation method) {
+            try {
+                VolSurface surface(k, t, v, method);
+            } catch (const std::invalid_argument&) {
+                ++failures;
+            }
+        };
+        expect_invalid({100.0}, {1.0, 2.0}, {0.2, 0.2}, VolInterpolation::BICUBIC);
+        expect_invalid({100.0, 90.0}, {1.0, 2.0}, std::vector<double>(4, 0.2), VolInterpolation::BICUBIC);
+        expect_invalid({90.0, 100.0}, {1.0, 2.0}, std::vector<double>(3, 0.2), VolInterpolation::BICUBIC);
+        expect_invalid({90.0, 100.0}, {1.0, 2.0}, {0.2, 0.2, 0.0, 0.2}, VolInterpolation::BICUBIC);
+        expect_invalid({90.0, 100.0, 110.0, 120.0}, {1.0}, std::vector<double>(4, 0.2), VolInterpolation::SVI);
+        assert(failures == 5);
+
+        VolSurface bicubic({90.0, 100.0}, {1.0, 2.0}, std::vector<double>(4, 0.2));
+        bool threw = false;
+        try {
+            bicubic.svi_slice(0);
+        } catch (const std::logic_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Test 5: SVI slices recover the smiles the quotes were generated from
+    {
+        const std::vector<SviParameters> truth = {
+            {0.002, 0.08, -0.5, std::log(105.0), 0.1},
+            {0.010, 0.10, -0.4, std::log(102.0), 0.15},
+            {0.030, 0.12, -0.3, std::log(100.0), 0.2},
+        };
+        const std::vector<double> svi_expiries = {0.25, 1.0, 2.0};
+        auto svi_vol = [](const SviParameters& p, double strike, double time) {
+            double y = std::log(strike) - p.m;
+            return std::sqrt((p.a + p.b * (p.rho * y + std::sqrt(y * y + p.sigma * p.sigma))) / time);
+        };
+        std::vector<double> svi_vols;
+        for (size_t j = 0; j < truth.size(); ++j) {
+            for (double strike : strikes) {
+                svi_vols.push_back(svi_vol(truth[j], strike, svi_expiries[j]));
+            }
+        }
+
+        VolSurface surface(strikes, svi_expiries, svi_vols, VolInterpolation::SVI);
+        for (size_t j = 0; j < truth.size(); ++j) {
+            const SviParameters& fitted = surface.svi_slice(j);
+            assert(std::abs(fitted.m - truth[j].m) < 1e-4);
+            assert(std::abs(fitted.rho - truth[j].rho) < 1e-4);
+            for (double strike = 50.0; strike < 200.0; strike += 5.0) {
+                assert(std::abs(surface.volatility(strike, svi_expiries[j]) - svi_vol(truth[j], strike, svi_expiries[j])) <
+                       1e-6);
+            }
+        }
+
+        // Linear in total variance between expiries
+        double w0 = surface.total_variance(95.0, 1.0);
+        double w1 = surface.total_variance(95.0, 2.0);
+        assert(almost_equal(surface.total_variance(95.0, 1.25), 0.75 * w0 + 0.25 * w1, 1e-12));
+
+        // Requoting one expiry refits that slice only
+        SviParameters moved = {0.015, 0.11, -0.2, std::log(98.0), 0.12};
+        std::vector<VolQuote> changes;
+        for (size_t i = 0; i < strikes.size(); ++i) {
+            changes.push_back({i, 1, svi_vol(moved, strikes[i], svi_expiries[1])});
+        }
+        SviParameters untouched = surface.svi_slice(2);
+        surface.update(changes.data(), changes.size());
+        assert(std::abs(surface.svi_slice(1).m - moved.m) < 1e-4);
+        assert(std::abs(surface.volatility(90.0, 1.0) - svi_vol(moved, 90.0, 1.0)) < 1e-6);
+        assert(surface.svi_slice(2).a == untouched.a && surface.svi_slice(2).m == untouched.m);
+    }
+
+    // Test 6: Batch lookups feed the pricers
+    {
+        VolSurface surface(strikes, expiries, vols);
+        const size_t n = 1000;
+        std::vector<OptionType> types(n);
+        std::vector<double> option_strikes(n), prices(n, 100.0), times(n), rates(n, 0.03);
+        for (size_t i = 0; i < n; ++i) {
+            types[i] = i % 3 == 0 ? OptionType::PUT : OptionType::CALL;
+            option_strikes[i] = 65.0 + 70.0 * static_cast<double>(i % 89) / 88.0;
+            times[i] = 0.02 + 4.0 * static_cast<double>(i % 23) / 22.0;
+        }
+        std::vector<double> looked_up(n), expected(n), priced(n);
+        surface.volatility_batch(option_strikes.data(), times.data(), looked_up.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(looked_up[i] == surface.volatility(option_strikes[i], times[i]));
+        }
+        black_scholes_batch(types.data(), option_strikes.data(), prices.data(), times.data(), rates.data(),
+                            looked_up.data(), expected.data(), n);
+        black_scholes_batch(types.data(), option_strikes.data(), prices.data(), times.data(), rates.data(), surface,
+                            priced.data(), n);
+        assert(same_values(priced, expected));
+    }
+
+    std::cout << "Vol Surface Tests Passed!" << std::endl;
+    return 0;
+}
+
+int finite_difference_tests() {
+    // Test 1: Thomas solves match a dense elimination, in both sweep orders
+    {
+        const size_t n = 7;
+        std::vector<double> lower(n), diagonal(n), upper(n), d(n);
+        for (size_t i = 0; i < n; ++i) {
+            lower[i] = -0.3 - 0.05 * static_cast<double>(i);
+            upper[i] = -0.7 + 0.04 * static_cast<double>(i);
+            diagonal[i] = 2.0 + 0.1 * static_cast<double>(i % 3);
+            d[i] = std::sin(static_cast<double>(i) + 1.0);
+        }
+        // Dense Gaussian elimination of the same system
+        std::vector<std::vector<double>> a(n, std::vector<double>(n + 1, 0.0));
+        for (size_t i = 0; i < n; ++i) {
+            a[i][i] = diagonal[i];
+            if (i > 0) {
+                a[i][i - 1] = lower[i];
+            }
+            if (i + 1 < n) {
+                a[i][i + 1] = upper[i];
+            }
+            a[i][n] = d[i];
+        }
+        for (size_t k = 0; k < n; ++k) {
+            for (size_t i = k + 1; i < n; ++i) {
+                double f = a[i][k] / a[k][k];
+                for (size_t j = k; j <= n; ++j) {
+                    a[i][j] -= f * a[k][j];
+                }
+            }
+        }
+        std::vector<double> expected(n);
+        for (size_t i = n; i-- > 0;) {
+            double sum = a[i][n];
+            for (size_t j = i + 1; j < n; ++j) {
+                sum -= a[i][j] * expected[j];
+            }
+            expected[i] = sum / a[i][i];
+        }
+
+        TridiagonalSolver solver;
+        for (bool reverse : {false, true}) {
+            solver.factorize(lower.data(), diagonal.data(), upper.data(), n, reverse);
+            std::vector<double> x = d;
+            solver.solve(x.data());
+            for (size_t i = 0; i < n; ++i) {
+                assert(std::abs(x[i] - expected[i]) < 1e-13);
+            }
+            // A floor below the solution changes nothing
+            std::vector<double> floor(n, -10.0);
+            std::vector<double> projected = d;
+            solver.solve_projected(projected.data(), floor.data());
+            assert(same_values(projected, x));
+        }
+    }
+
+    // Test 2: European prices and Greeks match Black-Scholes
+    {
+        for (OptionType type : {OptionType::CALL, OptionType::PUT}) {
+            for (double S0 : {85.0, 100.0, 120.0}) {
+                FiniteDifferenceResult fd =
+                    finite_difference_pricing(type, ExerciseStyle::EUROPEAN, S0, 100.0, 1.0, 0.05, 0.2);
+                Greeks bs = black_scholes_greeks(type, 100.0, S0, 1.0, 0.05, 0.2);
+                assert(std::abs(fd.price - bs.price) < 1e-4);
+                assert(std::abs(fd.delta - bs.delta) < 1e-5);
+                assert(std::abs(fd.gamma - bs.gamma) < 1e-5);
+                assert(std::abs(fd.theta - bs.theta) < 1e-4);
+            }
+        }
+    }
+
+    // Test 3: American puts converge to the reference value, with either exercise solver
+    {
+        // Reference from 4000 x 4000 grids, stable to about 1e-7
+        const double reference_atm = 6.0903706;
+        const double reference_otm = 1.3671102;
+        FiniteDifferenceResult atm =
+            finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05, 0.2);
+        FiniteDifferenceResult otm =
+            finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 120.0, 100.0, 1.0, 0.05, 0.2);
+        assert(std::abs(atm.price - reference_atm) < 1e-4);
+        assert(std::abs(otm.price - reference_otm) < 1e-4);
+        assert(std::abs(atm.price - binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0,
+                                                             1.0, 0.05, 0.2, 2000, BinomialMethod::BBSR)) < 1e-3);
+
+        FiniteDifferenceSettings psor;
+        psor.exercise_solver = ExerciseSolver::PSOR;
+        FiniteDifferenceResult iterated =
+            finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05, 0.2, psor);
+        assert(std::abs(iterated.price - atm.price) < 1e-7);
+
+        // In the money, with the exercise boundary just below S0, and at high volatility.
+        // References from 3200 x 1600 grids, within about 1e-6 of 2400 x 2400 grids on a
+        // wider domain.
+        struct AmericanCase {
+            double S0;
+            double T;
+            double sigma;
+            double reference;
+            double tolerance;
+        };
+        for (const AmericanCase& c : {AmericanCase{70.0, 1.0, 0.3, 30.0088913, 1e-4},
+                                      AmericanCase{70.0, 3.0, 0.6, 43.3203818, 1e-4},
+                                      AmericanCase{100.0, 3.0, 0.1, 3.0942289, 1e-4},
+                                      AmericanCase{90.0, 5.0, 0.9, 57.9404107, 1.5e-4}}) {
+            double price =
+                finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, c.S0, 100.0, c.T, 0.05, c.sigma)
+                    .price;
+            assert(std::abs(price - c.reference) < c.tolerance);
+        }
+
+        // Deep in the money the put is exercised: worth its intrinsic value, delta -1, no time decay
+        FiniteDifferenceResult deep =
+            finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 70.0, 100.0, 1.0, 0.05, 0.2);
+        assert(almost_equal(deep.price, 30.0, 1e-12));
+        assert(std::abs(deep.delta + 1.0) < 1e-9 && deep.theta == 0.0);
+
+        // Without dividends an American call is never exercised early
+        FiniteDifferenceResult call =
+            finite_difference_pricing(OptionType::CALL, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05, 0.2);
+        assert(std::abs(call.price - black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.2)) < 1e-4);
+    }
+
+    // Test 4: Bermudan puts lie between the European and American prices
+    {
+        const double european =
+            finite_difference_pricing(OptionType::PUT, ExerciseStyle::EUROPEAN, 100.0, 100.0, 1.0, 0.05, 0.2).price;
+        const double american =
+            finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05, 0.2).price;
+        const double quarterly = finite_difference_pricing(OptionType::PUT, ExerciseStyle::BERMUDAN, 100.0, 100.0, 1.0,
+                                                           0.05, 0.2, FiniteDifferenceSettings(), {0.25, 0.5, 0.75})
+                                     .price;
+        assert(european < quarterly && quarterly < american);
+        double lattice = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::BERMUDAN, 100.0, 100.0, 1.0, 0.05, 0.2,
+                                                  2000, BinomialMethod::CRR, {0.25, 0.5, 0.75});
+        assert(std::abs(quarterly - lattice) < 2e-3);
+
+        // With no exercise dates it is European
+        double none = finite_difference_pricing(OptionType::PUT, ExerciseStyle::BERMUDAN, 100.0, 100.0, 1.0, 0.05, 0.2)
+                          .price;
+        assert(none == european);
+    }
+
+    // Test 5: Invalid inputs give NaN
+    {
+        FiniteDifferenceSettings coarse;
+        coarse.space_steps = 5;
+        assert(std::isnan(finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05,
+                                                    0.2, coarse).price));
+        coarse.extrapolate = false;
+        assert(!std::isnan(finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05,
+                                                     0.2, coarse).price));
+        assert(std::isnan(finite_difference_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, -1.0, 100.0, 1.0, 0.05,
+                                                    0.2).price));
+        assert(std::isnan(finite_difference_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, 100.0, 100.0, 0.0, 0.05,
+                                                    0.2).delta));
+        assert(std::isnan(finite_difference_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, 100.0, 100.0, 1.0, 0.05,
+                                                    0.0).gamma));
+    }
+
+    std::cout << "Finite Difference Tests Passed!" << std::endl;
+    return 0;
+}
+
+int moving_average_tests() {
+    // Random walk long enough to cross several blocks and WMA resync periods
+    std::vector<double> prices(20000);
+    double price = 100.0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        price *= std::exp(0.01 * std::sin(0.37 * static_cast<double>(i)) + 0.002 * std::cos(1.3 * static_cast<double>(i)));
+        prices[i] = price;
+    }
+
+    // Straight from the definitions: SMA-seeded EMA and an O(n w) weighted sum
+    auto naive_ema = [](const std::vector<double>& x, size_t span) {
+        std::vector<double> result;
+        if (x.size() < span) {
+            return result;
+        }
+        double alpha = 2.0 / static_cast<double>(span + 1);
+        double value = std::accumulate(x.begin(), x.begin() + span, 0.0) / static_cast<double>(span);
+        result.push_back(value);
+        for (size_t t = span; t < x.size(); ++t) {
+            value += alpha * (x[t] - value);
+            result.push_back(value);
+        }
+        return result;
+    };
+    auto naive_wma = [](const std::vector<double>& x, size_t span) {
+        std::vector<double> result;
+        for (size_t t = span - 1; t < x.size(); ++t) {
+            double weighted = 0.0;
+            for (size_t j = 0; j < span; ++j) {
+                weighted += static_cast<double>(j + 1) * x[t + 1 - span + j];
+            }
+            result.push_back(weighted / (static_cast<double>(span) * static_cast<double>(span + 1) / 2.0));
+        }
+        return result;
+    };
+    auto max_relative_error = [](const std::vector<double>& approx, const std::vector<double>& exact) {
+        assert(approx.size() == exact.size());
+        double worst = 0.0;
+        for (size_t i = 0; i < exact.size(); ++i) {
+            worst = std::max(worst, std::abs(approx[i] - exact[i]) / std::abs(exact[i]));
+        }
+        return worst;
+    };
+
+    const SimdLevel detected = detect_simd_level();
+
+    // Test 1: The scalar batch functions match the definitions
+    {
+        set_simd_level(SimdLevel::SCALAR);
+        for (size_t span : {size_t(1), size_t(10), size_t(300)}) {
+            std::vector<double> e1 = naive_ema(prices, span);
+            std::vector<double> e2 = naive_ema(e1, span);
+            std::vector<double> e3 = naive_ema(e2, span);
+            std::vector<double> dema(e2.size());
+            std::vector<double> tema(e3.size());
+            for (size_t i = 0; i < e2.size(); ++i) {
+                dema[i] = 2.0 * e1[i + span - 1] - e2[i];
+            }
+            for (size_t i = 0; i < e3.size(); ++i) {
+                tema[i] = 3.0 * (e1[i + 2 * span - 2] - e2[i + span - 1]) + e3[i];
+            }
+
+            assert(same_values(exponential_moving_average(prices, span), e1));
+            assert(same_values(double_exponential_moving_average(prices, span), dema));
+            assert(same_values(triple_exponential_moving_average(prices, span), tema));
+            assert(dema.size() == dema_output_size(prices.size(), span));
+            assert(tema.size() == tema_output_size(prices.size(), span));
+            // The running sums drift between rebuilds, by a few 1e-12 at most for short windows
+            assert(max_relative_error(weighted_moving_average(prices, span), naive_wma(prices, span)) < 1e-10);
+        }
+        set_simd_level(detected);
+    }
+
+    // Test 2: The vectorized EMA scan agrees with the scalar recurrence on every SIMD level
+    {
+        set_simd_level(SimdLevel::SCALAR);
+        std::vector<std::vector<double>> scalar;
+        for (size_t span : {size_t(2), size_t(20), size_t(500)}) {
+            scalar.push_back(triple_exponential_moving_average(prices, span));
+        }
+        for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+            set_simd_level(level);
+            size_t k = 0;
+            for (size_t span : {size_t(2), size_t(20), size_t(500)}) {
+                assert(max_relative_error(triple_exponential_moving_average(prices, span), scalar[k++]) < 1e-12);
+            }
+        }
+        set_simd_level(detected);
+    }
+
+    // Test 3: The streaming classes reproduce the scalar batch values exactly
+    {
+        set_simd_level(SimdLevel::SCALAR);
+        const size_t span = 15;
+        std::vector<double> ema = exponential_moving_average(prices, span);
+        std::vector<double> dema = double_exponential_moving_average(prices, span);
+        std::vector<double> tema = triple_exponential_moving_average(prices, span);
+        std::vector<double> wma = weighted_moving_average(prices, span);
+        set_simd_level(detected);
+
+        RollingEMA rolling_ema(span);
+        RollingDEMA rolling_dema(span);
+        RollingTEMA rolling_tema(span);
+        RollingWMA rolling_wma(span);
+        for (size_t t = 0; t < prices.size(); ++t) {
+            double e = rolling_ema.update(prices[t]);
+            double d = rolling_dema.update(prices[t]);
+            double r = rolling_tema.update(prices[t]);
+            double w = rolling_wma.update(prices[t]);
+            assert(t + 1 < span ? std::isnan(e) : e == ema[t + 1 - span]);
+            assert(t + 2 < 2 * span ? std::isnan(d) : d == dema[t + 2 - 2 * span]);
+            assert(t + 3 < 3 * span ? std::isnan(r) : r == tema[t + 3 - 3 * span]);
+            assert(t + 1 < span ? std::isnan(w) : w == wma[t + 1 - span]);
+        }
+    }
+
+    // Test 4: Several spans in one pass are identical to one span at a time, float included
+    {
+        const std::vector<size_t> spans = {3, 50, 1000, 30000};
+        for (IndicatorType indicator :
+             {IndicatorType::EMA, IndicatorType::DEMA, IndicatorType::TEMA, IndicatorType::WMA}) {
+            std::vector<std::vector<double>> result = moving_averages(indicator, prices, spans);
+            assert(result.size() == spans.size() && result[3].empty());
+            for (size_t k = 0; k < spans.size(); ++k) {
+                std::vector<double> single(indicator_output_size(indicator, prices.size(), spans[k]));
+                compute_indicator(indicator, prices.data(), prices.size(), spans[k], single.data());
+                assert(same_values(result[k], single));
+            }
+        }
+
+        std::vector<float> prices_f(prices.begin(), prices.end());
+        std::vector<double> widened(prices_f.begin(), prices_f.end());
+        for (size_t span : {size_t(5), size_t(200)}) {
+            std::vector<float> ema_f = exponential_moving_average(prices_f, span);
+            std::vector<float> wma_f = weighted_moving_average(prices_f, span);
+            assert(max_relative_error(std::vector<double>(ema_f.begin(), ema_f.end()),
+                                      exponential_moving_average(widened, span)) < 1e-5);
+            assert(max_relative_error(std::vector<double>(wma_f.begin(), wma_f.end()),
+                                      weighted_moving_average(widened, span)) < 1e-5);
+        }
+    }
+
+    // Test 5: A pipeline gives the streaming values for any chunking
+    {
+        IndicatorPipeline pipeline({{IndicatorType::EMA, 12}, {IndicatorType::SMA, 20}, {IndicatorType::TEMA, 9},
+                                    {IndicatorType::WMA, 30}, {IndicatorType::DEMA, 400}});
+        std::vector<std::vector<double>> result = pipeline.compute(prices);
+        std::vector<std::vector<double>> expected(5);
+        RollingEMA ema(12);
+        RollingTEMA tema(9);
+        RollingWMA wma(30);
+        RollingDEMA dema(400);
+        for (double p : prices) {
+            for (auto entry : {std::make_pair(0, ema.update(p)), std::make_pair(2, tema.update(p)),
+                               std::make_pair(3, wma.update(p)), std::make_pair(4, dema.update(p))}) {
+                if (!std::isnan(entry.second)) {
+                    expected[entry.first].push_back(entry.second);
+                }
+            }
+        }
+        for (size_t k : {0, 2, 3, 4}) {
+            assert(same_values(result[k], expected[k]));
+        }
+
+        std::vector<std::vector<double>> chunked(5);
+        pipeline.compute_chunked(prices.data(), prices.size(), 97,
+                                 [&](size_t k, size_t first, const double* values, size_t count) {
+                                     assert(first == chunked[k].size());
+                                     chunked[k].insert(chunked[k].end(), values, values + count);
+                                 });
+        for (size_t k = 0; k < 5; ++k) {
+            assert(same_values(chunked[k], result[k]));
+        }
+    }
+
+    // Test 6: Snapshots resume exactly, and belong to one indicator and span
+    {
+        RollingEMA ema(10);
+        RollingDEMA dema(10);
+        RollingTEMA tema(10);
+        RollingWMA wma(10);
+        for (size_t t = 0; t < 25; ++t) {
+            ema.update(prices[t]);
+            dema.update(prices[t]);
+            tema.update(prices[t]);
+            wma.update(prices[t]);
+        }
+        RollingEMA ema_copy(10);
+        RollingDEMA dema_copy(10);
+        RollingTEMA tema_copy(10);
+        RollingWMA wma_copy(10);
+        ema_copy.restore(ema.snapshot());
+        dema_copy.restore(dema.snapshot());
+        tema_copy.restore(tema.snapshot());
+        wma_copy.restore(wma.snapshot());
+        // TEMA is restored mid warm-up, with its third stage still seeding
+        for (size_t t = 25; t < 3000; ++t) {
+            [[maybe_unused]] double ema_value = ema.update(prices[t]);
+            [[maybe_unused]] double ema_restored = ema_copy.update(prices[t]);
+            [[maybe_unused]] double dema_value = dema.update(prices[t]);
+            [[maybe_unused]] double dema_restored = dema_copy.update(prices[t]);
+            [[maybe_unused]] double tema_value = tema.update(prices[t]);
+            [[maybe_unused]] double tema_restored = tema_copy.update(prices[t]);
+            [[maybe_unused]] double wma_value = wma.update(prices[t]);
+            [[maybe_unused]] double wma_restored = wma_copy.update(prices[t]);
+            assert(ema_value == ema_restored);
+            assert(dema_value == dema_restored);
+            assert(same_values({tema_value}, {tema_restored}));
+            assert(wma_value == wma_restored);
+        }
+
+        bool threw_kind = false;
+        bool threw_span = false;
+        try {
+            tema.restore(dema.snapshot());
+        } catch (const std::invalid_argument&) {
+            threw_kind = true;
+        }
+        try {
+            RollingEMA(11).restore(ema.snapshot());
+        } catch (const std::invalid_argument&) {
+            threw_span = true;
+        }
+        assert(threw_kind && threw_span);
+
+        // Counts that are negative, fractional, NaN or out of range are rejected
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        for (double count : {-1.0, 2.5, nan, 11.0}) {
+            std::vector<double> ema_state = ema.snapshot();
+            std::vector<double> wma_state = wma.snapshot();
+            ema_state[2] = count;
+            wma_state[2] = count;
+            bool threw_ema = false;
+            bool threw_wma = false;
+            try {
+                RollingEMA(10).restore(ema_state);
+            } catch (const std::invalid_argument&) {
+                threw_ema = true;
+            }
+            try {
+                RollingWMA(10).restore(wma_state);
+            } catch (const std::invalid_argument&) {
+                threw_wma = true;
+            }
+            assert(threw_ema && threw_wma);
+        }
+    }
+
+    // Test 7: Invalid spans and short series produce nothing
+    {
+        std::vector<double> short_prices(prices.begin(), prices.begin() + 20);
+        assert(exponential_moving_average(prices, 0).empty());
+        assert(weighted_moving_average(short_prices, 21).empty());
+        assert(double_exponential_moving_average(short_prices, 11).empty());
+        assert(double_exponential_moving_average(short_prices, 10).size() == 2);
+        assert(triple_exponential_moving_average(short_prices, 7).size() == 2);
+
+        bool threw = false;
+        try {
+            RollingWMA invalid(0);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "Moving Average Tests Passed!" << std::endl;
+    return 0;
+}
+
+// Number following "key": within the entry of function name in an instrumentation dump
+static uint64_t instrumentation_field(const std::string& json, const std::string& name, const std::string& key) {
+    size_t entry = json.find("\"" + name + "\": {");
+    if (entry == std::string::npos) {
+        return 0;
+    }
+    size_t field = json.find("\"" + key + "\": ", entry);
+    return std::stoull(json.substr(field + key.size() + 4));
+}
+
+int instrumentation_tests() {
+    if (!instrumentation_enabled()) {
+        // Compiled out: nothing is recorded
+        std::vector<double> prices(100, 100.0), out(100);
+        simple_moving_average(prices.data(), prices.size(), 10, out.data());
+        assert(instrumentation_json() == "{\"enabled\": false, \"functions\": {}}");
+        std::cout << "Instrumentation Tests Passed! (disabled)" << std::endl;
+        return 0;
+    }
+
+    const size_t n = 1000;
+    std::vector<OptionType> types(n, OptionType::CALL);
+    std::vector<double> strikes(n), prices(n), times(n, 0.5), rates(n, 0.03), vols(n, 0.2), out(n);
+    for (size_t i = 0; i < n; ++i) {
+        strikes[i] = 80.0 + 0.04 * static_cast<double>(i);
+        prices[i] = 100.0;
+    }
+
+    // Test 1: Batch calls and items are counted exactly, across threads that exit
+    {
+        reset_instrumentation();
+        for (int r = 0; r < 3; ++r) {
+            black_scholes_batch(types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                                vols.data(), out.data(), n);
+        }
+        std::thread worker([&] {
+            black_scholes_batch(types.data(), strikes.data(), prices.data(), times.data(), rates.data(),
+                                vols.data(), out.data(), n);
+        });
+        worker.join();
+
+        std::string json = instrumentation_json();
+        assert(json.find("\"enabled\": true") != std::string::npos);
+        assert(instrumentation_field(json, "black_scholes_batch", "calls") == 4);
+        assert(instrumentation_field(json, "black_scholes_batch", "items") == 4 * n);
+        assert(instrumentation_field(json, "black_scholes_batch", "timed_calls") == 4);
+    }
+
+    // Test 2: Sampled functions count every call and time one in kInstrumentationSamplePeriod
+    {
+        reset_instrumentation();
+        for (size_t i = 0; i < n; ++i) {
+            black_scholes(OptionType::PUT, strikes[i], 100.0, 0.5, 0.03, 0.2);
+        }
+        std::string json = instrumentation_json();
+        assert(instrumentation_field(json, "black_scholes", "calls") == n);
+        uint64_t timed = instrumentation_field(json, "black_scholes", "timed_calls");
+        assert(timed >= n / kInstrumentationSamplePeriod && timed <= n / kInstrumentationSamplePeriod + 1);
+        // Functions not called since the reset are left out
+        assert(json.find("\"black_scholes_batch\"") == std::string::npos);
+    }
+
+    // Test 3: Buckets grow with latency and stay in range
+    {
+        size_t previous = 0;
+        for (uint64_t ticks = 0; ticks < (uint64_t{1} << 20); ticks = ticks * 5 / 4 + 1) {
+            size_t bucket = instrumentation_bucket(ticks);
+            assert(bucket >= previous && bucket < kInstrumentationBuckets);
+            previous = bucket;
+        }
+        assert(instrumentation_bucket(~uint64_t{0}) == kInstrumentationBuckets - 1);
+    }
+
+    std::cout << "Instrumentation Tests Passed!" << std::endl;
+    return 0;
+}
+
+int rolling_statistics_tests() {
+    // Random walk on a 0.01 tick grid, so windows hold ties, long enough to cross resyncs
+    std::vector<double> prices(10000);
+    double price = 100.0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        price += 0.5 * std::sin(0.37 * static_cast<double>(i)) + 0.3 * std::cos(1.3 * static_cast<double>(i) + 0.2);
+        prices[i] = std::round(price * 100.0) / 100.0;
+    }
+    const std::vector<size_t> windows = {1, 5, 50};
+
+    // Sorted copy of window t
+    auto sorted_window = [&](size_t t, size_t w) {
+        std::vector<double> window(prices.begin() + t, prices.begin() + t + w);
+        std::sort(window.begin(), window.end());
+        return window;
+    };
+    // Central moments m2, m3, m4 of window t, two-pass
+    auto central_moments = [&](size_t t, size_t w, double& m2, double& m3, double& m4) {
+        double mean = std::accumulate(prices.begin() + t, prices.begin() + t + w, 0.0) / static_cast<double>(w);
+        m2 = m3 = m4 = 0.0;
+        for (size_t j = t; j < t + w; ++j) {
+            double d = prices[j] - mean;
+            m2 += d * d / static_cast<double>(w);
+            m3 += d * d * d / static_cast<double>(w);
+            m4 += d * d * d * d / static_cast<double>(w);
+        }
+        return mean;
+    };
+
+    // Test 1: Max, min and quantiles match a sort of every window exactly
+    {
+        const std::vector<double> qs = {0.0, 0.1, 0.5, 0.9, 1.0};
+        for (size_t w : windows) {
+            std::vector<double> highs = rolling_max(prices, w);
+            std::vector<double> lows = rolling_min(prices, w);
+            std::vector<std::vector<double>> quantiles = rolling_quantiles(prices, w, qs);
+            assert(highs.size() == prices.size() - w + 1 && lows.size() == highs.size());
+            assert(same_values(rolling_median(prices, w), quantiles[2]));
+            for (size_t k = 0; k < qs.size(); ++k) {
+                assert(same_values(rolling_quantile(prices, w, qs[k]), quantiles[k]));
+            }
+
+            for (size_t t = 0; t < highs.size(); ++t) {
+                std::vector<double> window = sorted_window(t, w);
+                assert(highs[t] == window.back() && lows[t] == window.front());
+                for (size_t k = 0; k < qs.size(); ++k) {
+                    double position = qs[k] * static_cast<double>(w - 1);
+                    size_t lower = static_cast<size_t>(position);
+                    double expected = window[lower];
+                    if (lower + 1 < w) {
+                        expected += (window[lower + 1] - window[lower]) * (position - static_cast<double>(lower));
+                    }
+                    assert(quantiles[k][t] == expected);
+                }
+            }
+        }
+    }
+
+    // Test 2: Skewness, kurtosis and z-score match two-pass moments
+    {
+        for (size_t w : {size_t(5), size_t(50)}) {
+            std::vector<double> skew = rolling_skewness(prices, w);
+            std::vector<double> kurt = rolling_kurtosis(prices, w);
+            std::vector<double> z = rolling_zscore(prices, w);
+            const double n = static_cast<double>(w);
+            for (size_t t = 0; t < skew.size(); ++t) {
+                double m2, m3, m4;
+                double mean = central_moments(t, w, m2, m3, m4);
+                double expected_skew = std::sqrt(n * (n - 1)) / (n - 2) * m3 / std::pow(m2, 1.5);
+                double expected_kurt = ((n * n - 1) * m4 / (m2 * m2) - 3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
+                double expected_z = (prices[t + w - 1] - mean) / std::sqrt(m2 * n / (n - 1));
+                // Absolute tolerances: near-zero skewness has no meaningful relative error
+                assert(std::abs(skew[t] - expected_skew) <= 1e-7);
+                assert(std::abs(kurt[t] - expected_kurt) <= 1e-7);
+                assert(std::abs(z[t] - expected_z) <= 1e-9);
+            }
+        }
+    }
+
+    // Test 3: Streaming classes match the batch functions, and resume from a snapshot
+    {
+        const size_t w = 50;
+        std::vector<double> highs = rolling_max(prices, w);
+        std::vector<double> lows = rolling_min(prices, w);
+        std::vector<double> p90 = rolling_quantile(prices, w, 0.9);
+        std::vector<double> skew = rolling_skewness(prices, w);
+        std::vector<double> kurt = rolling_kurtosis(prices, w);
+        std::vector<double> z = rolling_zscore(prices, w);
+
+        RollingMax max_stream(w);
+        RollingMin min_stream(w);
+        RollingQuantile quantile_stream(w, 0.9);
+        RollingSkewness skew_stream(w);
+        RollingKurtosis kurt_stream(w);
+        RollingZScore z_stream(w);
+        for (size_t t = 0; t < 6000; ++t) {
+            double high = max_stream.update(prices[t]);
+            double low = min_stream.update(prices[t]);
+            double q = quantile_stream.update(prices[t]);
+            double s = skew_stream.update(prices[t]);
+            double k = kurt_stream.update(prices[t]);
+            double zt = z_stream.update(prices[t]);
+            if (t + 1 < w) {
+                assert(std::isnan(high) && std::isnan(low) && std::isnan(q) && std::isnan(s) && std::isnan(zt));
+                continue;
+            }
+            size_t i = t + 1 - w;
+            assert(high == highs[i] && low == lows[i] && q == p90[i]);
+            assert(std::abs(s - skew[i]) <= 1e-9 && std::abs(k - kurt[i]) <= 1e-9 && std::abs(zt - z[i]) <= 1e-9);
+        }
+
+        RollingMax max_copy(w);
+        RollingMin min_copy(w);
+        RollingQuantile quantile_copy(w, 0.9);
+        RollingSkewness skew_copy(w);
+        RollingKurtosis kurt_copy(w);
+        RollingZScore z_copy(w);
+        max_copy.restore(max_stream.snapshot());
+        min_copy.restore(min_stream.snapshot());
+        quantile_copy.restore(quantile_stream.snapshot());
+        skew_copy.restore(skew_stream.snapshot());
+        kurt_copy.restore(kurt_stream.snapshot());
+        z_copy.restore(z_stream.snapshot());
+        for (size_t t = 6000; t < prices.size(); ++t) {
+            [[maybe_unused]] double high = max_stream.update(prices[t]);
+            [[maybe_unused]] double high_restored = max_copy.update(prices[t]);
+            [[maybe_unused]] double low = min_stream.update(prices[t]);
+            [[maybe_unused]] double low_restored = min_copy.update(prices[t]);
+            [[maybe_unused]] double q = quantile_stream.update(prices[t]);
+            [[maybe_unused]] double q_restored = quantile_copy.update(prices[t]);
+            [[maybe_unused]] double s = skew_stream.update(prices[t]);
+            [[maybe_unused]] double s_restored = skew_copy.update(prices[t]);
+            [[maybe_unused]] double k = kurt_stream.update(prices[t]);
+            [[maybe_unused]] double k_restored = kurt_copy.update(prices[t]);
+            [[maybe_unused]] double zt = z_stream.update(prices[t]);
+            [[maybe_unused]] double zt_restored = z_copy.update(prices[t]);
+            assert(high == high_restored && low == low_restored && q == q_restored);
+            assert(same_values({s, k, zt}, {s_restored, k_restored, zt_restored}));
+        }
+
+        bool threw_kind = false;
+        bool threw_q = false;
+        try {
+            max_copy.restore(min_stream.snapshot());
+        } catch (const std::invalid_argument&) {
+            threw_kind = true;
+        }
+        try {
+            RollingQuantile(w, 0.5).restore(quantile_stream.snapshot());
+        } catch (const std::invalid_argument&) {
+            threw_q = true;
+        }
+        assert(threw_kind && threw_q);
+
+        // Counts that are negative, fractional, NaN or past the window are rejected
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        for (double count : {-1.0, 2.5, nan, static_cast<double>(w + 1)}) {
+            std::vector<double> max_state = max_stream.snapshot();
+            std::vector<double> quantile_state = quantile_stream.snapshot();
+            std::vector<double> skew_state = skew_stream.snapshot();
+            std::vector<double> z_state = z_stream.snapshot();
+            max_state[2] = count;
+            quantile_state[3] = count;
+            skew_state[2] = count;
+            z_state[2] = count;
+            int threw = 0;
+            try {
+                RollingMax(w).restore(max_state);
+            } catch (const std::invalid_argument&) {
+                ++threw;
+            }
+            try {
+                RollingQuantile(w, 0.9).restore(quantile_state);
+            } catch (const std::invalid_argument&) {
+                ++threw;
+            }
+            try {
+                RollingSkewness(w).restore(skew_state);
+            } catch (const std::invalid_argument&) {
+                ++threw;
+            }
+            try {
+                RollingZScore(w).restore(z_state);
+            } catch (const std::invalid_argument&) {
+                ++threw;
+            }
+            assert(threw == 4);
+        }
+
+        // The quantile a pickled snapshot is rebuilt from must lie in [0, 1]
+        assert(snapshot_quantile(quantile_stream.snapshot()) == 0.9);
+        for (double q : {-0.1, 1.5, nan}) {
+            std::vector<double> quantile_state = quantile_stream.snapshot();
+            quantile_state[2] = q;
+            bool threw_quantile = false;
+            try {
+                snapshot_quantile(quantile_state);
+            } catch (const std::invalid_argument&) {
+                threw_quantile = true;
+            }
+            assert(threw_quantile);
+        }
+        bool threw_short = false;
+        try {
+            snapshot_quantile({0.0, static_cast<double>(w)});
+        } catch (const std::invalid_argument&) {
+            threw_short = true;
+        }
+        assert(threw_short);
+    }
+
+    // Test 4: Order statistics under random inserts and erases, duplicates included
+    {
+        BasicOrderStatistics<double> sorted(300);
+        std::vector<double> reference;
+        uint64_t state = 12345;
+        for (int step = 0; step < 20000; ++step) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            double value = static_cast<double>((state >> 33) % 97);
+            if (reference.size() < 300 && ((state >> 20) & 1) == 0) {
+                sorted.insert(value);
+                reference.insert(std::upper_bound(reference.begin(), reference.end(), value), value);
+            } else {
+                auto found = std::lower_bound(reference.begin(), reference.end(), value);
+                bool present = found != reference.end() && *found == value;
+                [[maybe_unused]] bool erased = sorted.erase(value);
+                assert(erased == present);
+                if (present) {
+                    reference.erase(found);
+                }
+            }
+            assert(sorted.size() == reference.size());
+            if (step % 100 == 0) {
+                for (size_t rank = 0; rank < reference.size(); ++rank) {
+                    assert(sorted[rank] == reference[rank]);
+                }
+            }
+        }
+
+        BasicOrderStatistics<double> full(2);
+        full.insert(1.0);
+        full.insert(1.0);
+        bool threw = false;
+        try {
+            full.insert(2.0);
+        } catch (const std::length_error&) {
+            threw = true;
+        }
+        assert(threw && full.quantile(0.5) == 1.0);
+    }
+
+    // Test 5: Degenerate windows, invalid arguments and float data
+    {
+        std::vector<double> flat(30, 101.37);
+        for (double value : rolling_skewness(flat, 10)) {
+            assert(std::isnan(value));
+        }
+        for (double value : rolling_kurtosis(flat, 10)) {
+            assert(std::isnan(value));
+        }
+        for (double value : rolling_zscore(flat, 10)) {
+            assert(std::isnan(value));
+        }
+        // Too few samples per window for the statistic
+        std::vector<double> pairs = rolling_skewness(prices, 2);
+        assert(pairs.size() == prices.size() - 1 && std::isnan(pairs[0]) && std::isnan(pairs.back()));
+        assert(std::isnan(rolling_kurtosis(prices, 3)[0]));
+
+        assert(rolling_max(flat, 31).empty());
+        assert(rolling_min(flat, 0).empty());
+        assert(rolling_quantile(prices, 10, 1.5).empty());
+
+        bool threw = false;
+        try {
+            RollingQuantile invalid(10, -0.1);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+
+        std::vector<float> prices_f(prices.begin(), prices.end());
+        std::vector<double> skew = rolling_skewness(prices, 50);
+        std::vector<float> highs_f = rolling_max(prices_f, 50);
+        std::vector<float> median_f = rolling_median(prices_f, 50);
+        std::vector<float> skew_f = rolling_skewness(prices_f, 50);
+        std::vector<double> median = rolling_median(prices, 50);
+        std::vector<double> highs = rolling_max(prices, 50);
+        for (size_t t = 0; t < highs.size(); ++t) {
+            assert(highs_f[t] == static_cast<float>(highs[t]));
+            assert(almost_equal(median_f[t], median[t], 1e-6));
+            assert(std::abs(skew_f[t] - skew[t]) <= 2e-3);
+        }
+    }
+
+    std::cout << "Rolling Statistics Tests Passed!" << std::endl;
+    return 0;
+}
+
+int cash_flow_tests() {
+    // Test 1: Annuities and amortization
+    {
+        assert(almost_equal(annuity_present_value(100.0, 0.05, 10), 772.1734929184818, 1e-12));
+        assert(almost_equal(annuity_present_value(100.0, 0.05, 10, true), 772.1734929184818 * 1.05, 1e-12));
+        assert(almost_equal(annuity_future_value(100.0, 0.05, 10), 1257.789253554884, 1e-12));
+        assert(almost_equal(annuity_payment(200000.0, 0.06 / 12, 360), 1199.1010503055138, 1e-12));
+        assert(annuity_present_value(100.0, 0.0, 12) == 1200.0);
+        // A tiny rate agrees with the zero-rate limit instead of losing digits to cancellation
+        assert(almost_equal(annuity_future_value(100.0, 1e-12, 12), 1200.0, 1e-9));
+        assert(std::isnan(annuity_present_value(100.0, -1.0, 10)));
+        assert(std::isnan(annuity_payment(100.0, 0.05, 0)));
+
+        AmortizationSchedule schedule = amortization_schedule(200000.0, 0.005, 360);
+        assert(schedule.payment.size() == 360 && schedule.balance.back() == 0.0);
+        assert(almost_equal(schedule.interest[0], 1000.0, 1e-12));
+        double repaid = 0.0;
+        for (size_t k = 0; k < 360; ++k) {
+            assert(almost_equal(schedule.payment[k], 1199.1010503055138, 1e-9));
+            assert(almost_equal(schedule.payment[k], schedule.interest[k] + schedule.principal[k], 1e-12));
+            repaid += schedule.principal[k];
+        }
+        assert(almost_equal(repaid, 200000.0, 1e-12));
+        assert(amortization_schedule(1000.0, 0.05, 0).payment.empty());
+    }
+
+    // Test 2: Discount curve, log-linear between pillars and flat forward past the last
+    {
+        DiscountCurve curve({1.0, 2.0, 5.0}, {0.95, 0.90, 0.75});
+        assert(curve.discount(0.0) == 1.0);
+        assert(almost_equal(curve.discount(2.0), 0.90, 1e-14));
+        assert(almost_equal(curve.discount(0.5), std::sqrt(0.95), 1e-14));
+        assert(almost_equal(curve.discount(1.5), std::sqrt(0.95 * 0.90), 1e-14));
+        assert(almost_equal(curve.discount(6.0), 0.75 * std::pow(0.75 / 0.90, 1.0 / 3.0), 1e-14));
+        assert(almost_equal(curve.zero_rate(2.0), -std::log(0.90) / 2.0, 1e-14));
+        assert(almost_equal(curve.zero_rate(0.0), -std::log(0.95), 1e-14));
+        assert(almost_equal(curve.forward_rate(1.0, 2.0), std::log(0.95 / 0.90), 1e-14));
+        assert(std::isnan(curve.discount(-1.0)) && std::isnan(curve.forward_rate(2.0, 1.0)));
+
+        // Batches agree with single lookups in sorted and shuffled order
+        std::vector<double> times = {0.0, 0.25, 1.0, 1.0, 3.7, 0.1, 12.0, 4.99, 5.0, 2.5};
+        std::vector<double> factors(times.size());
+        curve.discount_batch(times.data(), factors.data(), times.size());
+        for (size_t i = 0; i < times.size(); ++i) {
+            assert(factors[i] == curve.discount(times[i]));
+        }
+
+        DiscountCurve zeros = DiscountCurve::from_zero_rates({1.0, 10.0}, {0.02, 0.03});
+        assert(almost_equal(zeros.zero_rate(10.0), 0.03, 1e-14));
+
+        std::vector<double> amounts = {-100.0, 5.0, 5.0, 105.0};
+        std::vector<double> dates = {0.0, 1.0, 2.0, 3.0};
+        double expected = 0.0;
+        for (size_t i = 0; i < dates.size(); ++i) {
+            expected += amounts[i] * curve.discount(dates[i]);
+        }
+        assert(almost_equal(net_present_value(curve, dates.data(), amounts.data(), dates.size()), expected, 1e-14));
+
+        bool threw = false;
+        try {
+            DiscountCurve invalid({1.0, 1.0}, {0.9, 0.8});
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Test 3: NPV and scalar IRR, including cases where plain Newton does not converge
+    {
+        std::vector<double> flows = {-100.0, 39.0, 59.0, 55.0, 20.0};
+        double expected = -100.0 + 39.0 / 1.1 + 59.0 / 1.21 + 55.0 / 1.331 + 20.0 / 1.4641;
+        assert(almost_equal(net_present_value(0.1, flows), expected, 1e-14));
+
+        IrrStatus status;
+        double rate = internal_rate_of_return(flows, &status);
+        assert(status == IrrStatus::CONVERGED && almost_equal(rate, 0.28094842115996094, 1e-12));
+        assert(std::abs(net_present_value(rate, flows)) < 1e-10);
+
+        // Far from the starting guess
+        std::vector<double> steep(40, 0.0);
+        steep[0] = -1.0;
+        steep[39] = 1e6;
+        rate = internal_rate_of_return(steep, &status);
+        assert(status == IrrStatus::CONVERGED && almost_equal(rate, std::pow(1e6, 1.0 / 39.0) - 1.0, 1e-12));
+
+        // Two roots, at 0% and 100%: either is an IRR
+        rate = internal_rate_of_return(std::vector<double>{-1.0, 3.0, -2.0}, &status);
+        assert(status == IrrStatus::CONVERGED && (std::abs(rate) < 1e-12 || std::abs(rate - 1.0) < 1e-12));
+
+        assert(std::isnan(internal_rate_of_return(std::vector<double>{1.0, -1.0, 1.0}, &status)));
+        assert(status == IrrStatus::NO_SOLUTION);
+        assert(std::isnan(internal_rate_of_return(std::vector<double>{100.0, 5.0}, &status)));
+        assert(status == IrrStatus::INVALID_INPUT);
+    }
+
+    // Test 4: Batched IRR agrees with the scalar solver at every SIMD level
+    {
+        const size_t periods = 120;
+        const size_t schedules = 53;
+        std::vector<double> flows(schedules * periods);
+        uint64_t state = 7;
+        auto uniform = [&state]() {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<double>(state >> 11) / 9007199254740992.0;
+        };
+        for (size_t s = 0; s < schedules; ++s) {
+            double* row = flows.data() + s * periods;
+            row[0] = -1000.0 * (1.0 + uniform());
+            for (size_t k = 1; k < periods; ++k) {
+                row[k] = 15.0 * (0.5 + uniform());
+            }
+        }
+        // An invalid schedule, one with no solution and one Newton cannot reach from 10%
+        std::fill(flows.begin() + 3 * periods, flows.begin() + 4 * periods, 1.0);
+        flows[10 * periods] = 1.0;
+        flows[10 * periods + 1] = -1.0;
+        flows[10 * periods + 2] = 1.0;
+        std::fill(flows.begin() + 10 * periods + 3, flows.begin() + 11 * periods, 0.0);
+        std::fill(flows.begin() + 20 * periods, flows.begin() + 21 * periods, 0.0);
+        flows[20 * periods] = -1.0;
+        flows[21 * periods - 1] = 1e9;
+
+        const SimdLevel detected = active_simd_level();
+        for (SimdLevel level : {SimdLevel::SCALAR, detected}) {
+            set_simd_level(level);
+            std::vector<double> rates(schedules);
+            std::vector<IrrStatus> statuses(schedules);
+            internal_rate_of_return_batch(flows.data(), schedules, periods, rates.data(), statuses.data());
+            for (size_t s = 0; s < schedules; ++s) {
+                IrrStatus expected_status;
+                double expected = internal_rate_of_return(flows.data() + s * periods, periods, &expected_status);
+                assert(statuses[s] == expected_status);
+                assert(same_values({rates[s]}, {expected}) || almost_equal(rates[s], expected, 1e-12));
+            }
+            assert(statuses[3] == IrrStatus::INVALID_INPUT && statuses[10] == IrrStatus::NO_SOLUTION);
+            assert(statuses[20] == IrrStatus::CONVERGED);
+        }
+        set_simd_level(detected);
+    }
+
+    // Test 5: Scenario discounting against a naive product, with ragged block edges
+    {
+        const size_t schedules = 37, times = 300, scenarios = 131;
+        std::vector<double> grid(times);
+        for (size_t k = 0; k < times; ++k) {
+            grid[k] = (k + 1) / 12.0;
+        }
+        std::vector<DiscountCurve> curves;
+        for (size_t j = 0; j < scenarios; ++j) {
+            double shift = 0.0001 * static_cast<double>(j);
+            curves.push_back(DiscountCurve::from_zero_rates({1.0, 5.0, 30.0}, {0.02 + shift, 0.03 + shift, 0.035}));
+        }
+        std::vector<double> factors(times * scenarios);
+        discount_factor_matrix(curves.data(), scenarios, grid.data(), times, factors.data());
+        assert(factors[17 * scenarios + 5] == curves[5].discount(grid[17]));
+
+        std::vector<double> flows(schedules * times);
+        for (size_t i = 0; i < flows.size(); ++i) {
+            flows[i] = std::sin(0.37 * static_cast<double>(i)) * 100.0 + 50.0;
+        }
+
+        const SimdLevel detected = active_simd_level();
+        std::vector<double> serial;
+        for (SimdLevel level : {SimdLevel::SCALAR, detected}) {
+            set_simd_level(level);
+            std::vector<double> values(schedules * scenarios);
+            present_value_matrix(flows.data(), schedules, times, factors.data(), scenarios, values.data());
+            for (size_t s = 0; s < schedules; ++s) {
+                for (size_t j = 0; j < scenarios; ++j) {
+                    double expected = 0.0;
+                    for (size_t k = 0; k < times; ++k) {
+                        expected += flows[s * times + k] * factors[k * scenarios + j];
+                    }
+                    assert(std::abs(values[s * scenarios + j] - expected) <= 1e-12 * 150.0 * times);
+                }
+            }
+            serial = values;
+        }
+
+        ThreadPool pool(4);
+        std::vector<double> parallel(schedules * scenarios);
+        parallel_present_value_matrix(flows.data(), schedules, times, factors.data(), scenarios, parallel.data(),
+                                      pool);
+        assert(same_values(parallel, serial));
+        set_simd_level(detected);
+    }
+
+    std::cout << "Cash Flow Tests Passed!" << std::endl;
+    return 0;
+}
+
+int normal_distribution_tests() {
+    const NormalAccuracy tiers[] = {NormalAccuracy::EXACT, NormalAccuracy::HIGH, NormalAccuracy::FAST};
+
+    // Test 1: Measured errors against the EXACT tier at every SIMD level
+    {
+        const SimdLevel detected = active_simd_level();
+        for (SimdLevel level : {SimdLevel::SCALAR, detected}) {
+            set_simd_level(level);
+            NormalErrorReport high = normal_accuracy_report(NormalAccuracy::HIGH, -10.0, 10.0, 200001);
+            assert(high.max_abs_cdf <= 1e-15 && high.max_abs_pdf <= 1e-15);
+            // EXACT's own rounding of x / sqrt(2) is x^2 / 2 ulps of relative error at x = -10
+            assert(high.max_rel_cdf <= 5e-14 && high.max_rel_pdf <= 1e-14);
+
+            NormalErrorReport fast = normal_accuracy_report(NormalAccuracy::FAST, -12.0, 12.0, 200001);
+            assert(fast.max_abs_cdf <= 1e-7 && fast.max_abs_pdf <= 1e-7);
+            assert(fast.worst_cdf_x >= -12.0 && fast.worst_cdf_x <= 12.0);
+
+            NormalErrorReport exact = normal_accuracy_report(NormalAccuracy::EXACT, -5.0, 5.0, 1001);
+            assert(exact.max_abs_cdf == 0.0 && exact.max_rel_pdf == 0.0);
+        }
+        set_simd_level(detected);
+        assert(std::isnan(normal_accuracy_report(NormalAccuracy::HIGH, 1.0, -1.0, 10).max_abs_cdf));
+    }
+
+    // Test 2: HIGH stays accurate deep in the lower tail (references from erfcl in 80-bit precision)
+    {
+        assert(almost_equal(normal_cdf(-10.0, NormalAccuracy::HIGH), 7.619853024160526e-24, 2e-15));
+        assert(almost_equal(normal_cdf(-20.0, NormalAccuracy::HIGH), 2.7536241186062337e-89, 2e-15));
+        assert(almost_equal(normal_cdf(-30.0, NormalAccuracy::HIGH), 4.9067139271481871e-198, 2e-15));
+        assert(almost_equal(normal_cdf(3.0, NormalAccuracy::HIGH), 0.99865010196836991, 1e-15));
+    }
+
+    // Test 3: Batches agree with the scalar forms; special values at every tier
+    {
+        std::vector<double> x;
+        for (int i = -900; i <= 900; ++i) {
+            x.push_back(i / 97.0);
+        }
+        x.push_back(-45.0);
+        x.push_back(50.0);
+        const double inf = std::numeric_limits<double>::infinity();
+        std::vector<double> special = {NAN, inf, -inf};
+        x.insert(x.end(), special.begin(), special.end());
+        const size_t n = x.size();  // not a multiple of any vector width
+
+        const SimdLevel detected = active_simd_level();
+        for (SimdLevel level : {SimdLevel::SCALAR, detected}) {
+            set_simd_level(level);
+            for (NormalAccuracy tier : tiers) {
+                std::vector<double> cdf(n), pdf(n);
+                normal_cdf_batch(x.data(), cdf.data(), n, tier);
+                normal_pdf_batch(x.data(), pdf.data(), n, tier);
+                for (size_t i = 0; i + 3 < n; ++i) {
+                    assert(std::abs(cdf[i] - normal_cdf(x[i], tier)) <= 1e-15);
+                    assert(std::abs(pdf[i] - normal_pdf(x[i], tier)) <= 1e-7);
+                    assert(cdf[i] >= 0.0 && cdf[i] <= 1.0 && pdf[i] >= 0.0);
+                }
+                assert(std::isnan(cdf[n - 3]) && std::isnan(pdf[n - 3]));
+                assert(cdf[n - 2] == 1.0 && cdf[n - 1] == 0.0 && pdf[n - 2] == 0.0 && pdf[n - 1] == 0.0);
+                assert(std::isnan(normal_cdf(NAN, tier)) && normal_cdf(-inf, tier) == 0.0);
+                assert(normal_cdf(inf, tier) == 1.0 && normal_pdf(inf, tier) == 0.0);
+            }
+        }
+        set_simd_level(detected);
+    }
+
+    // Test 4: The global tier reaches normal_cdf(x) and the scalar pricer; implied volatility
+    // stays on EXACT
+    {
+        assert(normal_accuracy() == NormalAccuracy::EXACT);
+        volatile double x = 0.3;  // keep the compiler from folding erfc at compile time
+        assert(normal_cdf(x) == 0.5 * std::erfc(-x / std::sqrt(2)));
+        double quote = black_scholes(OptionType::CALL, 100.0, 95.0, 0.75, 0.03, 0.25);
+
+        set_normal_accuracy(NormalAccuracy::FAST);
+        assert(normal_cdf(0.3) == normal_cdf(0.3, NormalAccuracy::FAST));
+        assert(std::string(normal_accuracy_name(normal_accuracy())) == "fast");
+        double screened = black_scholes(OptionType::CALL, 100.0, 95.0, 0.75, 0.03, 0.25);
+        assert(screened != quote && std::abs(screened - quote) < 1e-5);
+        assert(almost_equal(implied_volatility(OptionType::CALL, quote, 100.0, 95.0, 0.75, 0.03), 0.25, 1e-13));
+        set_normal_accuracy(NormalAccuracy::EXACT);
+    }
+
+    std::cout << "Normal Distribution Tests Passed!" << std::endl;
+    return 0;
+}
+
+int pricing_cache_tests() {
+    // Test 1: Exact keys return the pricers' values bit for bit and count hits and misses
+    {
+        PricingCache cache(1024, 0.0, 4);
+        assert(cache.shard_count() == 4 && cache.capacity() == 1024);
+        double direct = black_scholes(OptionType::CALL, 100.0, 95.0, 0.5, 0.03, 0.2);
+        assert(cache.black_scholes(OptionType::CALL, 100.0, 95.0, 0.5, 0.03, 0.2) == direct);
+        assert(cache.black_scholes(OptionType::CALL, 100.0, 95.0, 0.5, 0.03, 0.2) == direct);
+        assert(cache.black_scholes(OptionType::PUT, 100.0, 95.0, 0.5, 0.03, 0.2) ==
+               black_scholes(OptionType::PUT, 100.0, 95.0, 0.5, 0.03, 0.2));
+
+        double lattice = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05,
+                                                  0.2, 1000, BinomialMethod::BBSR);
+        for (int i = 0; i < 3; ++i) {
+            assert(cache.binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05,
+                                                  0.2, 1000, BinomialMethod::BBSR) == lattice);
+        }
+        // Other steps, methods and pricers are other keys
+        assert(cache.binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05,
+                                              0.2, 1000) ==
+               binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, 100.0, 100.0, 1.0, 0.05, 0.2, 1000));
+        assert(cache.binomial_option_pricing(OptionType::PUT, 100.0, 100.0, 1.0, 0.05, 0.2, 500) ==
+               binomial_option_pricing(OptionType::PUT, 100.0, 100.0, 1.0, 0.05, 0.2, 500));
+
+        PricingCacheStats stats = cache.stats();
+        assert(stats.hits == 3 && stats.misses == 5 && stats.size == 5 && stats.evictions == 0);
+        assert(almost_equal(stats.hit_rate(), 3.0 / 8.0, 1e-15));
+
+        // NaN inputs and dated Bermudan calls bypass the cache
+        assert(std::isnan(cache.black_scholes(OptionType::CALL, 100.0, NAN, 0.5, 0.03, 0.2)));
+        std::vector<double> dates = {0.25, 0.5};
+        cache.binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::BERMUDAN, 100.0, 100.0, 1.0, 0.05, 0.2, 200,
+                                       BinomialMethod::CRR, dates);
+        assert(cache.stats().size == 5 && cache.stats().misses == 5);
+
+        cache.clear();
+        assert(cache.stats().size == 0 && cache.stats().hits == 3);
+        cache.reset_stats();
+        assert(cache.stats().hits == 0 && cache.stats().misses == 0);
+    }
+
+    // Test 2: Least recently used entries go first; resize evicts down to the new capacity
+    {
+        PricingCache cache(2, 0.0, 1);
+        cache.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.1);
+        cache.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.2);
+        cache.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.1);  // hit, now most recent
+        cache.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.3);  // evicts 0.2
+        assert(cache.stats().evictions == 1 && cache.stats().size == 2);
+        cache.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.1);
+        assert(cache.stats().hits == 2);
+        cache.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.2);
+        assert(cache.stats().misses == 4);
+
+        cache.resize(1);
+        assert(cache.capacity() == 1 && cache.stats().size == 1 && cache.stats().evictions == 3);
+        cache.resize(0);
+        cache.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.05, 0.2);
+        assert(cache.stats().size == 0 && cache.stats().misses == 5);
+    }
+
+    // Test 3: With a tolerance, nearby quotes share one grid point and are priced there
+    {
+        PricingCache cache(1024, 1.0 / 4096.0);
+        double first = cache.black_scholes(OptionType::CALL, 100.0, 100.004, 1.0, 0.05, 0.2);
+        double second = cache.black_scholes(OptionType::CALL, 100.0, 99.998, 1.0, 0.05000001, 0.2);
+        assert(first == second && cache.stats().hits == 1);
+        // Spot to 100, the rate to 205 / 4096 and the volatility to 3277 / 16384
+        assert(first == black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 205.0 / 4096.0, 3277.0 / 16384.0));
+        cache.black_scholes(OptionType::CALL, 100.0, 101.0, 1.0, 0.05, 0.2);
+        assert(cache.stats().misses == 2);
+
+        // Negative, non-finite and coarse tolerances are rejected; from 0.5 up inputs could snap to zero
+        for (double tolerance : {-1.0, 0.25, 1.0, std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN()}) {
+            bool threw = false;
+            try {
+                PricingCache invalid(16, tolerance);
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+        // With steps of 1 / 8 the strike snaps to 64, the rate to 0 and the volatility to 3 / 16
+        PricingCache coarse(16, 0.125);
+        assert(coarse.black_scholes(OptionType::CALL, 60.0, 64.0, 1.0, 0.05, 0.2) ==
+               black_scholes(OptionType::CALL, 64.0, 64.0, 1.0, 0.0, 0.1875));
+    }
+
+    // Test 4: Threads sharing a cache see the pricers' values and every call is counted once
+    {
+        PricingCache cache(64);
+        std::vector<double> expected(100);
+        for (size_t k = 0; k < expected.size(); ++k) {
+            expected[k] = binomial_option_pricing(OptionType::CALL, 100.0, 80.0 + k * 0.4, 1.0, 0.05, 0.2, 64);
+        }
+        ThreadPool pool(4);
+        const size_t calls = 20000;
+        std::vector<double> out(calls);
+        pool.parallel_for(calls, 64, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t k = (i * 7919) % expected.size();
+                out[i] = cache.binomial_option_pricing(OptionType::CALL, 100.0, 80.0 + k * 0.4, 1.0, 0.05, 0.2, 64);
+            }
+        });
+        for (size_t i = 0; i < calls; ++i) {
+            assert(out[i] == expected[(i * 7919) % expected.size()]);
+        }
+        PricingCacheStats stats = cache.stats();
+        assert(stats.hits + stats.misses == calls && stats.size <= stats.capacity);
+    }
+
+    // Test 5: Black-Scholes prices are kept per normal CDF tier
+    {
+        PricingCache cache(64);
+        set_normal_accuracy(NormalAccuracy::FAST);
+        double fast = cache.black_scholes(OptionType::CALL, 100.0, 97.0, 0.5, 0.03, 0.25);
+        assert(fast == black_scholes(OptionType::CALL, 100.0, 97.0, 0.5, 0.03, 0.25));
+        set_normal_accuracy(NormalAccuracy::EXACT);
+        double exact = black_scholes(OptionType::CALL, 100.0, 97.0, 0.5, 0.03, 0.25);
+        assert(fast != exact);
+        assert(cache.black_scholes(OptionType::CALL, 100.0, 97.0, 0.5, 0.03, 0.25) == exact);
+        assert(cache.stats().misses == 2 && cache.stats().hits == 0);
+    }
+
+    std::cout << "Pricing Cache Tests Passed!" << std::endl;
+    return 0;
+}
+
+int scenario_engine_tests() {
+    // A small portfolio over two books; the 0.05-year call expires inside the grid
+    std::vector<OptionType> types = {OptionType::CALL, OptionType::PUT, OptionType::CALL, OptionType::PUT,
+                                     OptionType::CALL};
+    std::vector<double> strikes = {100.0, 95.0, 110.0, 105.0, 90.0};
+    std::vector<double> prices = {100.0, 100.0, 100.0, 98.0, 102.0};
+    std::vector<double> times = {1.0, 0.5, 0.05, 2.0, 0.75};
+    std::vector<double> rates = {0.05, 0.03, 0.05, 0.01, 0.04};
+    std::vector<double> vols = {0.2, 0.25, 0.3, 0.18, 0.22};
+    std::vector<double> quantities = {10.0, -5.0, 3.0, 7.0, -2.0};
+    std::vector<size_t> books = {0, 1, 0, 1, 1};
+    const size_t n = types.size();
+
+    StressGrid grid;
+    grid.spot_shocks = {-0.2, -0.05, 0.0, 0.05, 0.2};
+    grid.vol_shocks = {-0.3, 0.0, 0.1};  // -0.3 floors every volatility at zero
+    grid.time_shifts = {0.0, 0.1};
+    const size_t cells = grid.cells();
+
+    // Value of position i in cell (t, v, s), from the scalar pricers
+    auto reference = [&](size_t i, size_t t, size_t v, size_t s, bool binomial, const ScenarioSettings& settings) {
+        double S = prices[i] * (1.0 + grid.spot_shocks[s]);
+        double T = std::max(times[i] - grid.time_shifts[t], 0.0);
+        double sigma = std::max(vols[i] + grid.vol_shocks[v], 0.0);
+        double intrinsic = types[i] == OptionType::CALL ? std::max(S - strikes[i], 0.0) : std::max(strikes[i] - S, 0.0);
+        if (T == 0.0) {
+            return intrinsic;
+        }
+        if (binomial) {
+            std::vector<double> dates;
+            for (double date : settings.exercise_times) {
+                dates.push_back(date - grid.time_shifts[t]);
+            }
+            return binomial_lattice_pricing(types[i], settings.style, S, strikes[i], T, rates[i], sigma,
+                                            settings.steps, settings.method, dates);
+        }
+        if (sigma == 0.0) {
+            double forward_strike = strikes[i] * std::exp(-rates[i] * T);
+            return types[i] == OptionType::CALL ? std::max(S - forward_strike, 0.0) : std::max(forward_strike - S, 0.0);
+        }
+        return black_scholes(types[i], strikes[i], S, T, rates[i], sigma);
+    };
+    auto check_cube = [&](const std::vector<double>& cube, bool binomial, const ScenarioSettings& settings,
+                          double tolerance) {
+        size_t base_t = 0, base_v = 1, base_s = 2;
+        for (size_t b = 0; b < 2; ++b) {
+            for (size_t t = 0; t < grid.time_shifts.size(); ++t) {
+                for (size_t v = 0; v < grid.vol_shocks.size(); ++v) {
+                    for (size_t s = 0; s < grid.spot_shocks.size(); ++s) {
+                        if (binomial && v == 0) {
+                            continue;  // a lattice needs a positive volatility
+                        }
+                        double expected = 0.0;
+                        for (size_t i = 0; i < n; ++i) {
+                            if (books[i] == b) {
+                                expected += quantities[i] * (reference(i, t, v, s, binomial, settings) -
+                                                             reference(i, base_t, base_v, base_s, binomial, settings));
+                            }
+                        }
+                        double value = cube[((b * 2 + t) * 3 + v) * 5 + s];
+                        assert(std::abs(value - expected) <= tolerance);
+                    }
+                }
+            }
+        }
+        // The unshocked cell is exactly zero
+        assert(cube[(0 * 2 + 0) * 15 + 1 * 5 + 2] == 0.0 && cube[(1 * 2 + 0) * 15 + 1 * 5 + 2] == 0.0);
+    };
+
+    // Test 1: Black-Scholes cube against the scalar pricer, for any thread count
+    {
+        ScenarioSettings settings;
+        std::vector<double> cube(2 * cells), single(2 * cells);
+        ThreadPool pool(3), serial(1);
+        scenario_pnl(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                     quantities.data(), books.data(), n, 2, grid, cube.data(), settings, pool);
+        scenario_pnl(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                     quantities.data(), books.data(), n, 2, grid, single.data(), settings, serial);
+        check_cube(cube, false, settings, 1e-11);
+        assert(cube == single);
+
+        // Without books every position lands in book 0
+        std::vector<double> total(cells);
+        scenario_pnl(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                     quantities.data(), nullptr, n, 1, grid, total.data(), settings, pool);
+        for (size_t c = 0; c < cells; ++c) {
+            size_t t = c / 15, rest = c % 15;
+            assert(std::abs(total[c] - (cube[t * 15 + rest] + cube[(2 + t) * 15 + rest])) < 1e-11);
+        }
+    }
+
+    // Test 2: Binomial cubes reuse one lattice per cell row and match the lattice pricer
+    {
+        ScenarioSettings settings;
+        settings.model = ScenarioModel::BINOMIAL;
+        settings.style = ExerciseStyle::AMERICAN;
+        settings.steps = 60;
+        std::vector<double> cube(2 * cells);
+        ThreadPool pool(2);
+        scenario_pnl(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                     quantities.data(), books.data(), n, 2, grid, cube.data(), settings, pool);
+        check_cube(cube, true, settings, 1e-10);
+
+        settings.style = ExerciseStyle::BERMUDAN;
+        settings.method = BinomialMethod::BBSR;
+        settings.exercise_times = {0.25, 0.5, 0.75};
+        scenario_pnl(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                     quantities.data(), books.data(), n, 2, grid, cube.data(), settings, pool);
+        check_cube(cube, true, settings, 1e-10);
+    }
+
+    // Test 3: Invalid inputs fill the cube with NaN
+    {
+        std::vector<double> cube(cells, 0.0);
+        std::vector<size_t> bad_books = {0, 1, 0, 0, 0};
+        scenario_pnl(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                     quantities.data(), bad_books.data(), n, 1, grid, cube.data());
+        assert(std::all_of(cube.begin(), cube.end(), [](double x) { return std::isnan(x); }));
+
+        StressGrid crash = grid;
+        crash.spot_shocks.push_back(-1.0);
+        std::vector<double> crash_cube(crash.cells(), 0.0);
+        scenario_pnl(types.data(), strikes.data(), prices.data(), times.data(), rates.data(), vols.data(),
+                     quantities.data(), nullptr, n, 1, crash, crash_cube.data());
+        assert(std::isnan(crash_cube[0]));
+    }
+
+    std::cout << "Scenario Engine Tests Passed!" << std::endl;
+    return 0;
+}
+
+int trinomial_tree_tests() {
+    const double S0 = 100.0, T = 1.0, r = 0.05, sigma = 0.2;
+    TrinomialSettings plain;
+    plain.refinement_levels = 0;
+
+    // Test 1: European prices converge to Black-Scholes; the adaptive mesh removes most of
+    // the error the strike causes at the same number of steps
+    {
+        for (double K : {90.0, 100.0, 110.0}) {
+            double exact = black_scholes(OptionType::CALL, K, S0, T, r, sigma);
+            double refined = trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, 200);
+            assert(std::abs(refined - exact) < 2e-3);
+        }
+        double exact = black_scholes(OptionType::CALL, 100.0, S0, T, r, sigma);
+        double refined = trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, 100.0, T, r, sigma, 200);
+        double unrefined = trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, 100.0, T, r, sigma,
+                                                     200, PathPayoff::EUROPEAN, 0.0, plain);
+        assert(std::abs(refined - exact) * 5 < std::abs(unrefined - exact));
+
+        double put = trinomial_lattice_pricing(OptionType::PUT, ExerciseStyle::EUROPEAN, S0, 100.0, T, r, sigma, 200);
+        assert(almost_equal(refined - put, S0 - 100.0 * std::exp(-r * T), 1e-10));
+    }
+
+    // Test 2: American puts agree with an extrapolated binomial reference
+    {
+        double reference = binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, S0, 100.0, T, r, sigma,
+                                                    4000, BinomialMethod::BBSR);
+        double refined = trinomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, S0, 100.0, T, r, sigma, 400);
+        double unrefined = trinomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, S0, 100.0, T, r, sigma,
+                                                     400, PathPayoff::EUROPEAN, 0.0, plain);
+        assert(std::abs(refined - reference) < 3e-3);
+        assert(std::abs(refined - reference) < std::abs(unrefined - reference));
+    }
+
+    // Test 3: Down-and-out call with the barrier fitted onto a row of nodes matches the
+    // continuously monitored closed form; in + out = vanilla
+    {
+        const double K = 100.0, B = 90.0;
+        double lambda = (r + sigma * sigma / 2) / (sigma * sigma);
+        double y = std::log(B * B / (S0 * K)) / (sigma * std::sqrt(T)) + lambda * sigma * std::sqrt(T);
+        double exact = black_scholes(OptionType::CALL, K, S0, T, r, sigma) -
+                       S0 * std::pow(B / S0, 2 * lambda) * normal_cdf(y) +
+                       K * std::exp(-r * T) * std::pow(B / S0, 2 * lambda - 2) * normal_cdf(y - sigma * std::sqrt(T));
+        double out = trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, 400,
+                                               PathPayoff::DOWN_AND_OUT, B);
+        assert(std::abs(out - exact) < 2e-3);
+
+        double in = trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, 400,
+                                              PathPayoff::DOWN_AND_IN, B);
+        double vanilla = trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, 400);
+        assert(almost_equal(in + out, vanilla, 1e-12));
+
+        // A barrier already crossed knocks out (or in) at once
+        assert(trinomial_lattice_pricing(OptionType::PUT, ExerciseStyle::AMERICAN, S0, K, T, r, sigma, 50,
+                                         PathPayoff::UP_AND_OUT, 95.0) == 0.0);
+        assert(trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, 50,
+                                         PathPayoff::DOWN_AND_IN, 105.0) ==
+               trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, K, T, r, sigma, 50));
+    }
+
+    // Test 4: Unsupported payoffs and invalid inputs give NaN
+    {
+        assert(std::isnan(trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, 100.0, T, r, sigma,
+                                                    50, PathPayoff::ASIAN_ARITHMETIC)));
+        assert(std::isnan(trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::AMERICAN, S0, 100.0, T, r, sigma,
+                                                    50, PathPayoff::UP_AND_IN, 120.0)));
+        assert(std::isnan(trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, 100.0, T, r, sigma,
+                                                    50, PathPayoff::UP_AND_OUT, 0.0)));
+        assert(std::isnan(trinomial_lattice_pricing(OptionType::CALL, ExerciseStyle::EUROPEAN, S0, 100.0, T, r, sigma, 0)));
+    }
+
+    std::cout << "Trinomial Tree Tests Passed!" << std::endl;
+    return 0;
+}
+
+int scratch_arena_tests() {
+    // Test 1: Bump allocation, alignment, nested scopes and coalescing of an outgrown chain
+    {
+        ScratchArena arena(1024);
+        assert(arena.capacity() == 0 && arena.heap_allocations() == 0);
+        {
+            ScratchArena::Scope outer(arena);
+            double* a = arena.allocate_array<double>(10);
+            assert(reinterpret_cast<uintptr_t>(a) % 64 == 0);
+            size_t after_a = arena.used();
+            {
+                ScratchArena::Scope inner(arena);
+                char* b = arena.allocate_array<char>(3);
+                assert(reinterpret_cast<uintptr_t>(b) % 64 == 0 && b >= reinterpret_cast<char*>(a + 10));
+            }
+            assert(arena.used() == after_a);
+            // Outgrow the first block: a second, larger block is chained on
+            arena.allocate_array<double>(1000);
+            assert(arena.heap_allocations() == 2);
+        }
+        assert(arena.used() == 0);
+        // Rewinding to empty merged the chain into one block that holds the whole pass
+        assert(arena.heap_allocations() == 3);
+        size_t capacity = arena.capacity();
+        {
+            ScratchArena::Scope scope(arena);
+            arena.allocate_array<double>(10);
+            arena.allocate_array<char>(3);
+            arena.allocate_array<double>(1000);
+        }
+        assert(arena.heap_allocations() == 3 && arena.capacity() == capacity);
+
+        // The arena serves std::pmr containers
+        std::pmr::vector<int> values(&arena);
+        values.assign(100, 7);
+        assert(std::accumulate(values.begin(), values.end(), 0) == 700);
+        arena.reset();
+        assert(arena.used() == 0);
+    }
+
+    std::vector<double> prices;
+    for (int i = 0; i < 600; ++i) {
+        prices.push_back(100.0 + 10.0 * std::sin(0.05 * i) + 0.3 * std::cos(1.7 * i) + 0.01 * (i % 13));
+    }
+    const size_t n = prices.size();
+    const size_t w = 20;
+    const double qs[3] = {0.1, 0.5, 0.9};
+
+    // Test 2: Arena overloads give exactly the results of the allocating ones
+    {
+        ScratchArena arena(256);
+        std::vector<double> expected(n), actual(n);
+        const IndicatorType indicators[] = {IndicatorType::SMA, IndicatorType::VOLATILITY, IndicatorType::RSI,
+                                            IndicatorType::EMA, IndicatorType::DEMA, IndicatorType::TEMA,
+                                            IndicatorType::WMA};
+        for (IndicatorType indicator : indicators) {
+            size_t count = compute_indicator(indicator, prices.data(), n, w, expected.data());
+            [[maybe_unused]] size_t arena_count =
+                compute_indicator(indicator, prices.data(), n, w, actual.data(), arena);
+            assert(arena_count == count);
+            // RSI leads with NaNs, hence same_values
+            assert(count > 0 && same_values(std::vector<double>(expected.begin(), expected.begin() + count),
+                                            std::vector<double>(actual.begin(), actual.begin() + count)));
+            assert(arena.used() == 0);
+        }
+
+        size_t count = rolling_max(prices.data(), n, w, expected.data());
+        [[maybe_unused]] size_t arena_count = rolling_max(prices.data(), n, w, actual.data(), arena);
+        assert(arena_count == count);
+        assert(std::equal(expected.begin(), expected.begin() + count, actual.begin()));
+        count = rolling_min(prices.data(), n, w, expected.data());
+        arena_count = rolling_min(prices.data(), n, w, actual.data(), arena);
+        assert(arena_count == count);
+        assert(std::equal(expected.begin(), expected.begin() + count, actual.begin()));
+        count = rolling_median(prices.data(), n, w, expected.data());
+        arena_count = rolling_median(prices.data(), n, w, actual.data(), arena);
+        assert(arena_count == count);
+        assert(std::equal(expected.begin(), expected.begin() + count, actual.begin()));
+        count = rolling_quantile(prices.data(), n, w, 0.25, expected.data());
+        arena_count = rolling_quantile(prices.data(), n, w, 0.25, actual.data(), arena);
+        assert(arena_count == count);
+        assert(std::equal(expected.begin(), expected.begin() + count, actual.begin()));
+
+        const size_t spans[3] = {5, 20, 60};
+        std::vector<std::vector<double>> many = moving_averages(IndicatorType::TEMA, prices, {5, 20, 60});
+        std::vector<double> a(n), b(n), c(n);
+        double* outs[3] = {a.data(), b.data(), c.data()};
+        moving_averages(IndicatorType::TEMA, prices.data(), n, spans, 3, outs, arena);
+        for (size_t k = 0; k < 3; ++k) {
+            assert(std::equal(many[k].begin(), many[k].end(), outs[k]));
+        }
+        assert(arena.used() == 0);
+
+        std::vector<float> fprices(prices.begin(), prices.end());
+        std::vector<float> fexpected(n), factual(n);
+        count = rolling_volatility(fprices.data(), n, w, fexpected.data());
+        arena_count = rolling_volatility(fprices.data(), n, w, factual.data(), arena);
+        assert(arena_count == count);
+        assert(std::equal(fexpected.begin(), fexpected.begin() + count, factual.begin()));
+
+        // Invalid arguments report the same way and leave the arena empty
+        [[maybe_unused]] size_t invalid_volatility = rolling_volatility(prices.data(), n, 0, actual.data(), arena);
+        [[maybe_unused]] size_t invalid_ema = exponential_moving_average(prices.data(), n, 0, actual.data(), arena);
+        assert(invalid_volatility == 0 && invalid_ema == 0);
+        assert(arena.used() == 0);
+    }
+
+    // Test 3: A steady-state pass over a panel of tickers makes no heap allocations
+    {
+        const size_t tickers = 50;
+        std::vector<std::vector<double>> panel(tickers);
+        for (size_t t = 0; t < tickers; ++t) {
+            // Lengths differ, so the arena has to cover the longest
+            for (size_t i = 0; i < 400 + 7 * t; ++i) {
+                panel[t].push_back(50.0 + t + 5.0 * std::sin(0.03 * (i + 11 * t)) + 0.02 * ((i * (t + 3)) % 17));
+            }
+        }
+        const IndicatorType indicators[] = {IndicatorType::SMA, IndicatorType::VOLATILITY, IndicatorType::RSI,
+                                            IndicatorType::EMA, IndicatorType::DEMA, IndicatorType::TEMA,
+                                            IndicatorType::WMA};
+        const size_t spans[3] = {10, 30, 90};
+        const size_t longest = panel.back().size();
+        std::vector<double> out(longest), q0(longest), q1(longest), q2(longest);
+        double* quantile_outs[3] = {q0.data(), q1.data(), q2.data()};
+        ScratchArena arena(512);
+
+        auto run_panel = [&]() {
+            double checksum = 0.0;
+            for (const std::vector<double>& series : panel) {
+                const double* x = series.data();
+                const size_t m = series.size();
+                for (IndicatorType indicator : indicators) {
+                    size_t count = compute_indicator(indicator, x, m, w, out.data(), arena);
+                    checksum += std::isnan(out[count - 1]) ? 0.0 : out[count - 1];  // RSI may give NaN
+                }
+                moving_averages(IndicatorType::EMA, x, m, spans, 3, quantile_outs, arena);
+                checksum += rolling_max(x, m, w, out.data(), arena) > 0 ? out[0] : 0.0;
+                checksum += rolling_min(x, m, w, out.data(), arena) > 0 ? out[0] : 0.0;
+                checksum += rolling_median(x, m, w, out.data(), arena) > 0 ? out[0] : 0.0;
+                checksum += rolling_quantiles(x, m, w, qs, 3, quantile_outs, arena) > 0 ? q2[0] : 0.0;
+                checksum += rolling_skewness(x, m, w, out.data()) > 0 ? out[0] : 0.0;
+                checksum += rolling_kurtosis(x, m, w, out.data()) > 0 ? out[0] : 0.0;
+                checksum += rolling_zscore(x, m, w, out.data()) > 0 ? out[0] : 0.0;
+            }
+            return checksum;
+        };
+
+        double warm = run_panel();
+        size_t arena_blocks = arena.heap_allocations();
+        size_t before = heap_allocation_count.load();
+        double steady = run_panel();
+        size_t allocations = heap_allocation_count.load() - before;
+        assert(allocations == 0);
+        assert(arena.heap_allocations() == arena_blocks);
+        assert(steady == warm && std::isfinite(steady));
+
+        // The allocating overloads do touch the heap, which is what the counter is for
+        before = heap_allocation_count.load();
+        rolling_median(panel[0].data(), panel[0].size(), w, out.data());
+        assert(heap_allocation_count.load() > before);
+    }
+
+    // Test 4: The pointer form of parallel_indicators (one arena per worker) still matches
+    {
+        ThreadPool pool(3);
+        std::vector<std::vector<double>> series = {prices, std::vector<double>(prices.begin(), prices.begin() + 250)};
+        for (IndicatorType indicator : {IndicatorType::VOLATILITY, IndicatorType::DEMA, IndicatorType::WMA}) {
+            std::vector<std::vector<double>> expected = parallel_indicators(series, indicator, w, pool);
+            std::vector<double> first(expected[0].size()), second(expected[1].size());
+            const double* inputs[2] = {series[0].data(), series[1].data()};
+            const size_t lengths[2] = {series[0].size(), series[1].size()};
+            double* outs[2] = {first.data(), second.data()};
+            parallel_indicators(inputs, lengths, 2, indicator, w, outs, pool);
+            assert(first == expected[0] && second == expected[1]);
+        }
+    }
+
+    std::cout << "Scratch Arena Tests Passed!" << std::endl;
+    return 0;
+}
+
+int pricing_service_tests() {
+    // Test 1: Every kind of request gets the single-request pricer's result
+    {
+        ThreadPool pool(2);
+        PricingService service(PricingServiceSettings(), pool);
+        std::vector<std::future<double>> bs, iv, lattice;
+        for (int i = 0; i < 40; ++i) {
+            OptionType type = i % 2 == 0 ? OptionType::CALL : OptionType::PUT;
+            double strike = 80.0 + i;
+            bs.push_back(service.black_scholes(type, strike, 100.0, 0.5, 0.03, 0.15 + 0.005 * i));
+            iv.push_back(service.implied_volatility(type, black_scholes(type, strike, 100.0, 0.5, 0.03, 0.25), strike,
+                                                    100.0, 0.5, 0.03));
+            ExerciseStyle style = i % 3 == 0 ? ExerciseStyle::AMERICAN : ExerciseStyle::EUROPEAN;
+            lattice.push_back(service.binomial_lattice_pricing(type, style, 100.0, strike, 0.5, 0.03, 0.2,
+                                                               i % 4 == 0 ? 50 : 64, BinomialMethod::BBS));
+        }
+        for (int i = 0; i < 40; ++i) {
+            OptionType type = i % 2 == 0 ? OptionType::CALL : OptionType::PUT;
+            double strike = 80.0 + i;
+            [[maybe_unused]] double bs_price = bs[i].get();
+            [[maybe_unused]] double iv_value = iv[i].get();
+            [[maybe_unused]] double lattice_price = lattice[i].get();
+            assert(almost_equal(bs_price, black_scholes(type, strike, 100.0, 0.5, 0.03, 0.15 + 0.005 * i), 1e-13));
+            assert(iv_value == implied_volatility(type, black_scholes(type, strike, 100.0, 0.5, 0.03, 0.25), strike,
+                                                  100.0, 0.5, 0.03));
+            [[maybe_unused]] ExerciseStyle style = i % 3 == 0 ? ExerciseStyle::AMERICAN : ExerciseStyle::EUROPEAN;
+            assert(lattice_price == binomial_lattice_pricing(type, style, 100.0, strike, 0.5, 0.03, 0.2,
+                                                             i % 4 == 0 ? 50 : 64, BinomialMethod::BBS));
+        }
+
+        // Invalid inputs come back as NaN, like the pricers
+        [[maybe_unused]] double invalid =
+            service.implied_volatility(OptionType::CALL, 0.0, 100.0, 100.0, 0.5, 0.03).get();
+        assert(std::isnan(invalid));
+        PricingServiceStats stats = service.stats();
+        assert(stats.requests == 121 && stats.batches >= 1 && stats.largest_batch <= 256);
+    }
+
+    // Test 2: Requests coalesce up to the batch size, and a lone request leaves at the deadline
+    {
+        PricingServiceSettings settings;
+        settings.max_batch_size = 64;
+        settings.max_delay = std::chrono::microseconds(2000000);
+        PricingService service(settings);
+        std::vector<std::future<double>> results;
+        for (int i = 0; i < 64; ++i) {
+            results.push_back(service.black_scholes(OptionType::CALL, 90.0 + i, 100.0, 1.0, 0.02, 0.3));
+        }
+        for (std::future<double>& result : results) {
+            result.get();
+        }
+        PricingServiceStats stats = service.stats();
+        assert(stats.batches == 1 && stats.full_batches == 1 && stats.largest_batch == 64);
+        assert(stats.average_batch_size() == 64.0);
+
+        PricingServiceSettings quick;
+        quick.max_delay = std::chrono::microseconds(200);
+        PricingService lone(quick);
+        auto start = std::chrono::steady_clock::now();
+        double price = lone.black_scholes(OptionType::PUT, 100.0, 100.0, 1.0, 0.02, 0.3).get();
+        assert(std::chrono::steady_clock::now() - start >= std::chrono::microseconds(200));
+        assert(almost_equal(price, black_scholes(OptionType::PUT, 100.0, 100.0, 1.0, 0.02, 0.3), 1e-13));
+        assert(lone.stats().deadline_batches == 1);
+    }
+
+    // Test 3: Many producers at once; every future resolves to its own request's price
+    {
+        PricingService service;
+        const int producers = 4;
+        const int per_producer = 500;
+        std::vector<std::vector<std::future<double>>> results(producers);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < producers; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < per_producer; ++i) {
+                    results[t].push_back(service.black_scholes(OptionType::CALL, 50.0 + t * 10 + 0.01 * i, 100.0, 0.75,
+                                                               0.01, 0.2));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        for (int t = 0; t < producers; ++t) {
+            for (int i = 0; i < per_producer; ++i) {
+                [[maybe_unused]] double expected =
+                    black_scholes(OptionType::CALL, 50.0 + t * 10 + 0.01 * i, 100.0, 0.75, 0.01, 0.2);
+                [[maybe_unused]] double price = results[t][i].get();
+                assert(almost_equal(price, expected, 1e-13));
+            }
+        }
+        assert(service.stats().requests == static_cast<uint64_t>(producers * per_producer));
+    }
+
+    // Test 4: The destructor prices what is still queued; invalid settings throw
+    {
+        std::vector<std::future<double>> results;
+        {
+            PricingServiceSettings settings;
+            settings.max_delay = std::chrono::microseconds(1000000);
+            PricingService service(settings);
+            for (int i = 0; i < 10; ++i) {
+                results.push_back(service.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.0, 0.2));
+            }
+        }
+        for (std::future<double>& result : results) {
+            assert(result.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+            [[maybe_unused]] double price = result.get();
+            assert(almost_equal(price, black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.0, 0.2), 1e-13));
+        }
+
+        bool threw_size = false, threw_delay = false;
+        PricingServiceSettings settings;
+        settings.max_batch_size = 0;
+        try {
+            PricingService service(settings);
+        } catch (const std::invalid_argument&) {
+            threw_size = true;
+        }
+        settings.max_batch_size = 8;
+        settings.max_delay = std::chrono::microseconds(-1);
+        try {
+            PricingService service(settings);
+        } catch (const std::invalid_argument&) {
+            threw_delay = true;
+        }
+        assert(threw_size && threw_delay);
+    }
+
+    // Test 5: A throwing kernel call fails only its own rows. A lattice too large to allocate
+    // throws from its group; the other group and the other kinds in the batch are priced.
+    {
+        PricingServiceSettings settings;
+        settings.max_batch_size = 4;
+        settings.max_delay = std::chrono::microseconds(2000000);
+        PricingService service(settings);
+        const long huge = std::numeric_limits<long>::max() / 2;
+        std::future<double> bs = service.black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.02, 0.2);
+        std::future<double> failing = service.binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::EUROPEAN, 100.0,
+                                                                       100.0, 1.0, 0.02, 0.2, huge);
+        std::future<double> lattice = service.binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::EUROPEAN, 100.0,
+                                                                       100.0, 1.0, 0.02, 0.2, 100);
+        std::future<double> iv = service.implied_volatility(OptionType::CALL, 10.0, 100.0, 100.0, 1.0, 0.02);
+
+        bool threw = false;
+        try {
+            failing.get();
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        [[maybe_unused]] double bs_price = bs.get();
+        [[maybe_unused]] double lattice_price = lattice.get();
+        [[maybe_unused]] double iv_value = iv.get();
+        assert(threw && service.stats().batches == 1);
+        assert(almost_equal(bs_price, black_scholes(OptionType::CALL, 100.0, 100.0, 1.0, 0.02, 0.2), 1e-13));
+        assert(lattice_price == binomial_lattice_pricing(OptionType::PUT, ExerciseStyle::EUROPEAN, 100.0, 100.0, 1.0,
+                                                         0.02, 0.2, 100));
+        assert(iv_value == implied_volatility(OptionType::CALL, 10.0, 100.0, 100.0, 1.0, 0.02));
+    }
+
+    std::cout << "Pricing Service Tests Passed!" << std::endl;
+    return 0;
+}